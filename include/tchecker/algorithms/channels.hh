@@ -0,0 +1,187 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_CHANNELS_HH
+#define TCHECKER_ALGORITHMS_CHANNELS_HH
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*!
+ \file channels.hh
+ \brief Communication channels between worker threads of parallel algorithms
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \class channels_t
+ \brief Mailboxes for exchanging shared pointers between worker threads
+ \tparam T : type of exchanged objects (shared pointers)
+ \note states and nodes are reference-counted without synchronization. Hence,
+ a shared pointer must be copied and released by the thread that owns the
+ pointed object. Objects sent to a worker are handed back to their sender once
+ they have been received, and the sender releases them (see collect()). The
+ receiver should only access received objects through const references
+ \note pending counts the number of messages in transit plus the number of
+ active workers. As every increment of pending is performed by a worker that
+ accounts for a pending unit, the computation is over when pending reaches 0
+ */
+template <class T> class channels_t {
+public:
+  /*!
+   \class message_t
+   \brief Objects sent by a worker to another worker
+   */
+  class message_t {
+  public:
+    std::size_t sender;    /*!< Index of sending worker */
+    std::vector<T> values; /*!< Sent objects (owned by sender) */
+  };
+
+  /*!
+   \brief Constructor
+   \param workers_count : number of workers
+   \param active_workers : number of active workers
+   */
+  channels_t(std::size_t workers_count, std::size_t active_workers)
+      : _mailboxes(workers_count), pending(static_cast<long>(active_workers)), stop(false)
+  {
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  channels_t(tchecker::algorithms::channels_t<T> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  channels_t(tchecker::algorithms::channels_t<T> &&) = delete;
+
+  /*!
+   \brief Destructor
+   \note must not be called while worker threads are running
+   */
+  ~channels_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::algorithms::channels_t<T> & operator=(tchecker::algorithms::channels_t<T> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::algorithms::channels_t<T> & operator=(tchecker::algorithms::channels_t<T> &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return number of workers
+   */
+  inline std::size_t workers_count() const { return _mailboxes.size(); }
+
+  /*!
+   \brief Send objects
+   \param sender : index of sending worker
+   \param receiver : index of receiving worker
+   \param values : objects
+   \pre sender is active
+   \post values have been moved to the inbox of receiver, and values is empty
+   */
+  void send(std::size_t sender, std::size_t receiver, std::vector<T> & values)
+  {
+    ++pending;
+    std::lock_guard<std::mutex> lock(_mailboxes[receiver].mutex);
+    _mailboxes[receiver].inbox.push_back(message_t{sender, std::move(values)});
+    values.clear();
+  }
+
+  /*!
+   \brief Receive objects
+   \param receiver : index of receiving worker
+   \param messages : container of messages
+   \pre messages is empty
+   \post the inbox of receiver has been moved to messages
+   \note received messages are still accounted in pending, and should be handed
+   back to their senders after processing
+   */
+  void receive(std::size_t receiver, std::vector<message_t> & messages)
+  {
+    std::lock_guard<std::mutex> lock(_mailboxes[receiver].mutex);
+    messages.swap(_mailboxes[receiver].inbox);
+  }
+
+  /*!
+   \brief Hand objects back to their sender
+   \param message : a message that has been received
+   \post the objects in message have been moved to the garbage of their sender
+   */
+  void give_back(message_t & message)
+  {
+    std::lock_guard<std::mutex> lock(_mailboxes[message.sender].mutex);
+    _mailboxes[message.sender].garbage.push_back(std::move(message.values));
+  }
+
+  /*!
+   \brief Release objects handed back to a worker
+   \param owner : index of worker
+   \post all objects in the garbage of owner have been released
+   \note must be called by worker owner
+   */
+  void collect(std::size_t owner)
+  {
+    std::vector<std::vector<T>> garbage;
+    {
+      std::lock_guard<std::mutex> lock(_mailboxes[owner].mutex);
+      garbage.swap(_mailboxes[owner].garbage);
+    }
+    garbage.clear();
+  }
+
+  /*!
+   \brief Clear all mailboxes
+   \post all objects in mailboxes have been released
+   \note must be called when no worker thread is running
+   */
+  void clear()
+  {
+    for (mailbox_t & mailbox : _mailboxes) {
+      mailbox.inbox.clear();
+      mailbox.garbage.clear();
+    }
+  }
+
+private:
+  /*!
+   \class mailbox_t
+   \brief Mailbox of a worker
+   */
+  class mailbox_t {
+  public:
+    std::mutex mutex;                   /*!< Lock on mailbox */
+    std::vector<message_t> inbox;       /*!< Received messages */
+    std::vector<std::vector<T>> garbage; /*!< Sent objects that have been received */
+  };
+
+  std::vector<mailbox_t> _mailboxes; /*!< Mailboxes, one per worker */
+
+public:
+  std::atomic<long> pending; /*!< Messages in transit and active workers */
+  std::atomic<bool> stop;    /*!< Stop flag */
+};
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_CHANNELS_HH
@@ -13,7 +13,12 @@
  \brief Reachability algorithm with covering
  */
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <iterator>
+#include <stdexcept>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
@@ -38,10 +43,29 @@ namespace covreach {
  state in TS.
  For correctness of the algorithm, the covering relation over nodes in GRAPH
  should be a trace inclusion, and it should be irreflexive: a node should not
- cover itself
+ cover itself.
+ TS and GRAPH should have a method memsize() that yields the memory allocated
+ for states and nodes, nodes in GRAPH should derive from
+ tchecker::waiting::element_t and have methods last_use() and set_last_use().
+ These are used to keep the memory within a budget (see constructor)
 */
 template <class TS, class GRAPH> class algorithm_t {
 public:
+  /*!
+   \brief Constructor
+   \param max_memory : memory budget in bytes (0: no budget)
+   \note when TS and GRAPH have allocated more than max_memory bytes, nodes
+   that are not waiting are evicted from the graph (least recently used first,
+   w.r.t. creation and covering of successor nodes) so that the memory of
+   evicted nodes is reused instead of allocating more. Evicted nodes may be
+   visited again, but nodes with a given hash value in GRAPH (i.e. with a given
+   discrete part for the graphs in tck-reach) are evicted at most once. Since
+   there are finitely many discrete parts, the algorithm still terminates, even
+   if TS has infinitely many states. The memory may still exceed max_memory
+   since waiting nodes are never evicted
+   */
+  algorithm_t(std::size_t max_memory = 0) : _max_memory(max_memory), _time(0), _memsize(0), _nodes_limit(0) {}
+
   /*!
    \brief Build a covering reachability graph of a transition system from its
    initial states
@@ -59,6 +83,10 @@ public:
    The order in which the nodes of ts are visited depends on policy.
    \return Statistics on the run
    \note if labels is empty, the algorithm explores the entire state-space
+   \note if nodes have been evicted (see constructor), graph is not a covering
+   reachability graph anymore: evicted nodes and their edges are missing
+   \throw std::invalid_argument : if a memory budget has been set and policy
+   is not a fast remove policy (eviction relies on the waiting status of nodes)
   */
   tchecker::algorithms::covreach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                                               enum tchecker::waiting::policy_t policy)
@@ -69,6 +97,14 @@ public:
     tchecker::algorithms::covreach::stats_t stats;
     std::vector<node_sptr_t> nodes, covered_nodes;
 
+    if (_max_memory != 0 && policy != tchecker::waiting::FAST_REMOVE_QUEUE && policy != tchecker::waiting::FAST_REMOVE_STACK)
+      throw std::invalid_argument("Memory budget requires a fast remove waiting policy");
+
+    _time = 0;
+    _memsize = 0;
+    _nodes_limit = 0;
+    _evicted.clear();
+
     stats.set_start_time();
 
     expand_initial_nodes(ts, graph, nodes, stats);
@@ -81,6 +117,7 @@ public:
       waiting->remove_first();
 
       ++stats.visited_states();
+      ++_time;
 
       if (ts.satisfies(node->state_ptr(), labels)) {
         stats.reachable() = true;
@@ -97,6 +134,9 @@ public:
         covered_nodes.clear();
       }
       nodes.clear();
+
+      if (_max_memory != 0)
+        enforce_memory_budget(ts, graph, stats);
     }
 
     waiting->clear();
@@ -150,26 +190,51 @@ public:
    For each successor node that is not maximal, a subsumption edge has been
    created from node to a covering node.
    All covered successor nodes have been counted in stats.
+   \note successors that are covered by a node in graph are filtered by ts
+   before they are allocated (see tchecker::ts::full_ts_t::next), hence no node
+   is allocated for them. A node is only allocated, then removed, for a
+   successor that is covered by another successor of node
    */
   void expand_next_nodes(typename GRAPH::node_sptr_t const & node, TS & ts, GRAPH & graph,
                          std::vector<typename GRAPH::node_sptr_t> & next_nodes, tchecker::algorithms::covreach::stats_t & stats)
   {
-    std::vector<typename TS::sst_t> sst;
     typename GRAPH::node_sptr_t covering_node;
 
-    ts.next(node->state_ptr(), sst);
-    for (auto && [status, s, t] : sst) {
+    auto uncovered = [&](typename TS::const_state_t const & s) {
+      if (!graph.is_covered(typename GRAPH::node_t{s}, covering_node))
+        return true;
+      _covering_nodes.push_back(covering_node);
+      return false;
+    };
+
+    ts.next(node->state_ptr(), _sst, tchecker::STATE_OK, uncovered);
+
+    auto covering_it = _covering_nodes.begin();
+    for (auto && [status, s, t] : _sst) {
+      if (s.ptr() == nullptr) {
+        assert(covering_it != _covering_nodes.end());
+        graph.add_edge(node, *covering_it, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
+        (*covering_it)->set_last_use(_time);
+        ++covering_it;
+        ++stats.covered_states();
+        continue;
+      }
+
       typename GRAPH::node_sptr_t next_node = graph.add_node(s);
       if (graph.is_covered(next_node, covering_node)) {
         graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
+        covering_node->set_last_use(_time);
         graph.remove_node(next_node);
         ++stats.covered_states();
       }
       else {
         graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
+        next_node->set_last_use(_time);
         next_nodes.push_back(next_node);
       }
     }
+    _sst.clear();
+    _covering_nodes.clear();
   }
 
   /*!
@@ -199,6 +264,64 @@ public:
       ++stats.covered_states();
     }
   }
+
+  /*!
+   \brief Keep memory within budget
+   \param ts : a transition system
+   \param graph : a subsumption graph
+   \param stats : statistics
+   \post if ts and graph have allocated more memory than the budget since the
+   last call, the current number of nodes in graph has been taken as the limit.
+   If graph has reached the limit, the least recently used nodes that are not
+   waiting, and whose hash value in graph has not been evicted before, have
+   been removed from graph (with their edges) to bring the number of nodes down
+   to 3/4 of the limit.
+   If not enough nodes could be evicted, the limit has been raised above the
+   number of nodes in graph. Evicted nodes have been counted in stats
+   */
+  void enforce_memory_budget(TS & ts, GRAPH & graph, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    std::size_t const memsize = ts.memsize() + graph.memsize();
+    if (memsize > _max_memory && memsize > _memsize) {
+      _memsize = memsize;
+      if (_nodes_limit == 0 || graph.nodes_count() < _nodes_limit)
+        _nodes_limit = graph.nodes_count();
+    }
+
+    if (_nodes_limit == 0 || graph.nodes_count() < _nodes_limit)
+      return;
+
+    std::vector<typename GRAPH::node_sptr_t> candidates;
+    for (typename GRAPH::node_sptr_t const & n : graph.nodes())
+      if (!n->is_waiting() && _evicted.find(graph.node_hash(*n)) == _evicted.end())
+        candidates.push_back(n);
+
+    std::size_t const count = std::min(candidates.size(), graph.nodes_count() - (_nodes_limit - _nodes_limit / 4));
+    std::nth_element(candidates.begin(), candidates.begin() + count, candidates.end(),
+                     [](typename GRAPH::node_sptr_t const & n1, typename GRAPH::node_sptr_t const & n2) {
+                       return n1->last_use() < n2->last_use();
+                     });
+
+    for (std::size_t i = 0; i < count; ++i) {
+      _evicted.insert(graph.node_hash(*candidates[i]));
+      graph.remove_edges(candidates[i]);
+      graph.remove_node(candidates[i]);
+      ++stats.evicted_states();
+    }
+
+    // Remaining nodes cannot be evicted: raise the limit rather than scanning the graph at each step
+    if (graph.nodes_count() > _nodes_limit - _nodes_limit / 4)
+      _nodes_limit = graph.nodes_count() + graph.nodes_count() / 4 + 1;
+  }
+
+protected:
+  std::size_t const _max_memory;                            /*!< Memory budget in bytes (0: no budget) */
+  std::uint32_t _time;                                      /*!< Number of visited nodes (time of last use of nodes) */
+  std::size_t _memsize;                                     /*!< Allocated memory when the limit on nodes was last updated */
+  std::size_t _nodes_limit;                                 /*!< Limit on number of nodes (0: no limit) */
+  std::unordered_set<std::size_t> _evicted;                 /*!< Hash values of evicted nodes */
+  std::vector<typename TS::sst_t> _sst;                     /*!< Buffer of successors, reused across expansions */
+  std::vector<typename GRAPH::node_sptr_t> _covering_nodes; /*!< Covering nodes of filtered successors, in order */
 };
 
 } // end of namespace covreach
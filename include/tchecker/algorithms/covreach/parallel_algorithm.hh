@@ -0,0 +1,297 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COVREACH_PARALLEL_ALGORITHM_HH
+#define TCHECKER_ALGORITHMS_COVREACH_PARALLEL_ALGORITHM_HH
+
+/*!
+ \file parallel_algorithm.hh
+ \brief Multi-threaded reachability algorithm with covering
+ */
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/channels.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/waiting/factory.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace covreach {
+
+/*!
+ \class parallel_algorithm_t
+ \brief Multi-threaded covering reachability algorithm
+ \tparam TS : type of transition system, should derive from tchecker::ts::ts_t,
+ and should provide a method clone_state(s) that returns a copy of a state s
+ allocated by another instance of TS, accessing s through const references only
+ \tparam GRAPH : type of graph, should derive from
+ tchecker::graph::subsumption::graph_t, and nodes of type GRAPH::shared_node_t
+ should have a method state_ptr() that yields a pointer to the corresponding
+ state in TS. Nodes of type GRAPH::node_t should be constructible from states
+ of TS
+ The state-space is partitioned among worker threads w.r.t. the hash value of
+ nodes in GRAPH: each worker owns a transition system, a graph (shard) and a
+ waiting list, and it stores and expands the nodes with hash value equal to its
+ index modulo the number of workers. Successor states owned by another worker
+ are sent to their owner that clones them in its own transition system. Since
+ nodes can only be covered by nodes with the same hash value, covering is
+ decided locally in each shard, and the algorithm yields the same reachability
+ verdict as tchecker::algorithms::covreach::algorithm_t.
+ For correctness of the algorithm, the covering relation over nodes in GRAPH
+ should be a trace inclusion, and it should be irreflexive: a node should not
+ cover itself
+ \note states and nodes are reference-counted without synchronization, hence
+ all shared pointers to a state are created and released by the thread that
+ owns it
+*/
+template <class TS, class GRAPH> class parallel_algorithm_t {
+public:
+  /*!
+   \brief Build a covering reachability graph of a transition system from its
+   initial states, using one thread per transition system
+   \param ts : transition systems, one per worker thread
+   \param graphs : graphs, one per worker thread
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \pre ts and graphs are not empty and have the same size. All transition
+   systems in ts are built from the same system, and all graphs in graphs use
+   the same node hash function and covering predicate
+   \post the union of the graphs is a covering reachability graph of ts built
+   from its initial states, until a state that satisfies labels is reached if
+   any, or until the entire state-space has been exhausted.
+   A node is created in graphs[i] for each maximal state in ts owned by worker
+   i. No edge is created since the source and target of a transition may belong
+   to different graphs.
+   The order in which the nodes of ts are visited by each worker depends on
+   policy.
+   \return Statistics on the run, accumulated over all worker threads
+   \throw std::invalid_argument : if ts and graphs are empty or have distinct
+   sizes
+   \note if labels is empty, the algorithm explores the entire state-space
+  */
+  tchecker::algorithms::covreach::stats_t run(std::vector<std::shared_ptr<TS>> const & ts,
+                                              std::vector<std::shared_ptr<GRAPH>> const & graphs,
+                                              boost::dynamic_bitset<> const & labels, enum tchecker::waiting::policy_t policy)
+  {
+    if (ts.empty() || (ts.size() != graphs.size()))
+      throw std::invalid_argument("parallel covering reachability expects one transition system and one graph per worker");
+
+    std::size_t const workers_count = ts.size();
+    tchecker::algorithms::covreach::stats_t stats;
+    std::vector<tchecker::algorithms::covreach::stats_t> workers_stats(workers_count);
+    std::vector<std::exception_ptr> workers_errors(workers_count);
+    channels_t channels(workers_count, workers_count);
+
+    stats.set_start_time();
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < workers_count; ++i)
+      threads.emplace_back([&, i]() {
+        try {
+          worker(i, *ts[i], *graphs[i], labels, policy, channels, workers_stats[i]);
+        }
+        catch (...) {
+          workers_errors[i] = std::current_exception();
+          channels.stop = true;
+        }
+      });
+
+    for (std::thread & thread : threads)
+      thread.join();
+
+    // All threads are done: states still in transit can be released from here
+    channels.clear();
+
+    for (std::exception_ptr const & error : workers_errors)
+      if (error != nullptr)
+        std::rethrow_exception(error);
+
+    stats.stored_states() = 0;
+    for (std::size_t i = 0; i < workers_count; ++i) {
+      stats.visited_states() += workers_stats[i].visited_states();
+      stats.covered_states() += workers_stats[i].covered_states();
+      stats.stored_states() += graphs[i]->nodes_count();
+      stats.reachable() = stats.reachable() || workers_stats[i].reachable();
+    }
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  /*!
+   \brief Type of shared pointer to states of TS
+   */
+  using state_sptr_t = typename TS::state_t;
+
+  /*!
+   \brief Type of communication channels between workers
+   */
+  using channels_t = tchecker::algorithms::channels_t<state_sptr_t>;
+
+  /*!
+   \brief Type of messages between workers
+   */
+  using message_t = typename channels_t::message_t;
+
+  /*!
+   \brief Owner of a state
+   \param graph : a graph
+   \param s : a state
+   \param workers_count : number of workers
+   \return index of the worker that owns s
+   */
+  std::size_t owner(GRAPH const & graph, state_sptr_t const & s, std::size_t workers_count) const
+  {
+    return graph.node_hash(typename GRAPH::node_t{s}) % workers_count;
+  }
+
+  /*!
+   \brief Exploration by a worker thread
+   \param id : index of the worker
+   \param ts : transition system of the worker
+   \param graph : graph of the worker
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \param channels : communication channels
+   \param stats : statistics of the worker
+   \post all states owned by worker id that are reachable from the initial
+   states have been visited, unless a state satisfying labels has been found
+   */
+  void worker(std::size_t id, TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+              enum tchecker::waiting::policy_t policy, channels_t & channels, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    using node_sptr_t = typename GRAPH::node_sptr_t;
+
+    std::size_t const workers_count = channels.workers_count();
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    std::vector<node_sptr_t> covered_nodes;
+    std::vector<typename TS::sst_t> sst;
+    std::vector<message_t> messages;
+    std::vector<std::vector<state_sptr_t>> outbox(workers_count);
+    bool active = true;
+
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      if (owner(graph, s, workers_count) == id)
+        add_node(s, graph, *waiting, covered_nodes, stats);
+    sst.clear();
+
+    while (!channels.stop) {
+      channels.collect(id);
+
+      channels.receive(id, messages);
+      if (!messages.empty()) {
+        if (!active) {
+          ++channels.pending;
+          active = true;
+        }
+        for (message_t & message : messages) {
+          for (state_sptr_t const & s : message.values)
+            add_node(ts.clone_state(*s), graph, *waiting, covered_nodes, stats);
+          channels.give_back(message);
+        }
+        channels.pending -= messages.size();
+        messages.clear();
+      }
+
+      if (waiting->empty()) {
+        if (active) {
+          active = false;
+          --channels.pending;
+        }
+        if (channels.pending == 0)
+          break;
+        std::this_thread::yield();
+        continue;
+      }
+
+      node_sptr_t node = waiting->first();
+      waiting->remove_first();
+
+      ++stats.visited_states();
+
+      if (ts.satisfies(node->state_ptr(), labels)) {
+        stats.reachable() = true;
+        channels.stop = true;
+        break;
+      }
+
+      ts.next(node->state_ptr(), sst);
+      for (auto && [status, s, t] : sst) {
+        std::size_t const s_owner = owner(graph, s, workers_count);
+        if (s_owner == id)
+          add_node(s, graph, *waiting, covered_nodes, stats);
+        else
+          outbox[s_owner].push_back(s);
+      }
+      sst.clear();
+
+      for (std::size_t i = 0; i < workers_count; ++i)
+        if (!outbox[i].empty())
+          channels.send(id, i, outbox[i]);
+    }
+
+    waiting->clear();
+  }
+
+  /*!
+   \brief Add a node for a state, if maximal
+   \param s : a state
+   \param graph : a subsumption graph
+   \param waiting : waiting list
+   \param covered_nodes : a container of nodes
+   \param stats : statistics
+   \post if s is covered by a node in graph, it has been counted in stats.
+   Otherwise, a node for s has been added to graph and to waiting, and all the
+   nodes covered by s have been removed from graph and waiting, and counted in
+   stats
+   */
+  void add_node(state_sptr_t const & s, GRAPH & graph,
+                tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t> & waiting,
+                std::vector<typename GRAPH::node_sptr_t> & covered_nodes, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    typename GRAPH::node_sptr_t covering_node;
+    typename GRAPH::node_sptr_t node = graph.add_node(s);
+
+    if (graph.is_covered(node, covering_node)) {
+      graph.remove_node(node);
+      ++stats.covered_states();
+      return;
+    }
+
+    waiting.insert(node);
+
+    auto covered_nodes_inserter = std::back_inserter(covered_nodes);
+    graph.covered_nodes(node, covered_nodes_inserter);
+    for (typename GRAPH::node_sptr_t const & covered_node : covered_nodes) {
+      graph.remove_node(covered_node);
+      waiting.remove(covered_node);
+      ++stats.covered_states();
+    }
+    covered_nodes.clear();
+  }
+};
+
+} // end of namespace covreach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COVREACH_PARALLEL_ALGORITHM_HH
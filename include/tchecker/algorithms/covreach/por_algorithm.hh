@@ -0,0 +1,230 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_COVREACH_POR_ALGORITHM_HH
+#define TCHECKER_ALGORITHMS_COVREACH_POR_ALGORITHM_HH
+
+/*!
+ \file por_algorithm.hh
+ \brief Reachability algorithm with covering and partial-order reduction
+ */
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/waiting/factory.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace covreach {
+
+/*!
+ \class por_algorithm_t
+ \brief Covering reachability algorithm with partial-order reduction
+ \tparam TS : type of transition system (see tchecker::algorithms::covreach::algorithm_t)
+ \tparam GRAPH : type of graph (see tchecker::algorithms::covreach::algorithm_t)
+ \tparam PERSISTENT_SETS : type of persistent sets, should have a method
+ next(ts, s, v) that pushes to v the successors of s along a persistent set of
+ transitions and returns the set of processes involved in these transitions (or
+ an empty set if there is no such persistent set), and a method
+ next_except(ts, s, processes, v) that pushes to v the successors of s along
+ the other transitions
+ \note nodes are only expanded along a persistent set of transitions, when
+ there is one. To avoid ignoring the other transitions forever along a cycle
+ (cycle proviso), a node is fully expanded as soon as one of its successors
+ along the persistent set is covered by, or covers, a node in the graph. This
+ is conservative: a cycle can only be closed by such a successor
+ */
+template <class TS, class GRAPH, class PERSISTENT_SETS>
+class por_algorithm_t : public tchecker::algorithms::covreach::algorithm_t<TS, GRAPH> {
+public:
+  using tchecker::algorithms::covreach::algorithm_t<TS, GRAPH>::algorithm_t;
+
+  /*!
+   \brief Build a covering reachability graph of a transition system from its
+   initial states, with partial-order reduction
+   \param ts : a transition system
+   \param graph : a graph
+   \param persistent_sets : persistent sets of transitions in ts
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \post graph is a reduced covering reachability graph of ts built from its
+   initial states, until a state that satisfies labels is reached if any, or
+   until the entire reduced state-space has been exhausted (see
+   tchecker::algorithms::covreach::algorithm_t::run).
+   A state that satisfies labels is reached if and only if one is reachable in
+   ts, provided persistent_sets have been computed w.r.t. labels
+   \return Statistics on the run
+   \throw std::invalid_argument : if a memory budget has been set and policy
+   is not a fast remove policy
+   */
+  tchecker::algorithms::covreach::por_stats_t run(TS & ts, GRAPH & graph, PERSISTENT_SETS const & persistent_sets,
+                                                  boost::dynamic_bitset<> const & labels,
+                                                  enum tchecker::waiting::policy_t policy)
+  {
+    using node_sptr_t = typename GRAPH::node_sptr_t;
+
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    tchecker::algorithms::covreach::por_stats_t stats;
+    std::vector<node_sptr_t> nodes, covered_nodes;
+
+    if (this->_max_memory != 0 && policy != tchecker::waiting::FAST_REMOVE_QUEUE &&
+        policy != tchecker::waiting::FAST_REMOVE_STACK)
+      throw std::invalid_argument("Memory budget requires a fast remove waiting policy");
+
+    this->_time = 0;
+    this->_memsize = 0;
+    this->_nodes_limit = 0;
+    this->_evicted.clear();
+
+    stats.set_start_time();
+
+    this->expand_initial_nodes(ts, graph, nodes, stats);
+    for (node_sptr_t const & n : nodes)
+      waiting->insert(n);
+    nodes.clear();
+
+    while (!waiting->empty()) {
+      node_sptr_t node = waiting->first();
+      waiting->remove_first();
+
+      ++stats.visited_states();
+      ++this->_time;
+
+      if (ts.satisfies(node->state_ptr(), labels)) {
+        stats.reachable() = true;
+        break;
+      }
+
+      expand_persistent_nodes(node, ts, graph, persistent_sets, nodes, stats);
+
+      for (node_sptr_t const & next_node : nodes) {
+        waiting->insert(next_node);
+        this->remove_covered_nodes(graph, next_node, covered_nodes, stats);
+        for (node_sptr_t const & covered_node : covered_nodes)
+          waiting->remove(covered_node);
+        covered_nodes.clear();
+      }
+      nodes.clear();
+
+      if (this->_max_memory != 0)
+        this->enforce_memory_budget(ts, graph, stats);
+    }
+
+    waiting->clear();
+
+    stats.stored_states() = graph.nodes_count();
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+  /*!
+   \brief Create successor nodes of a node along a persistent set
+   \param node : a node
+   \param ts : a transition system
+   \param graph : a subsumption graph
+   \param persistent_sets : persistent sets of transitions in ts
+   \param next_nodes : nodes container
+   \param stats : statistics
+   \post successor nodes of node along a persistent set of transitions have been
+   added to graph and to next_nodes (see
+   tchecker::algorithms::covreach::algorithm_t::expand_next_nodes). If there is
+   no persistent set, or if a successor along the persistent set is covered,
+   or covers a node in graph, the successor nodes along all the other
+   transitions have been added as well.
+   The expansion has been counted in stats as reduced or full
+   */
+  void expand_persistent_nodes(typename GRAPH::node_sptr_t const & node, TS & ts, GRAPH & graph,
+                               PERSISTENT_SETS const & persistent_sets, std::vector<typename GRAPH::node_sptr_t> & next_nodes,
+                               tchecker::algorithms::covreach::por_stats_t & stats)
+  {
+    std::vector<typename TS::sst_t> sst;
+
+    auto processes = persistent_sets.next(ts, node->state_ptr(), sst);
+    if (processes.none()) {
+      ts.next(node->state_ptr(), sst);
+      add_next_nodes(node, sst, graph, next_nodes, stats, false);
+      ++stats.full_expansions();
+      return;
+    }
+
+    if (!add_next_nodes(node, sst, graph, next_nodes, stats, true)) {
+      ++stats.reduced_expansions();
+      return;
+    }
+
+    // cycle proviso
+    sst.clear();
+    persistent_sets.next_except(ts, node->state_ptr(), processes, sst);
+    add_next_nodes(node, sst, graph, next_nodes, stats, false);
+    ++stats.full_expansions();
+  }
+
+private:
+  /*!
+   \brief Create successor nodes of a node
+   \param node : a node
+   \param sst : successors of node
+   \param graph : a subsumption graph
+   \param next_nodes : nodes container
+   \param stats : statistics
+   \param check_revisits : detect successors that cover nodes in graph
+   \post successor nodes in sst have been added to graph and next_nodes, or
+   subsumption edges to covering nodes have been added to graph (see
+   tchecker::algorithms::covreach::algorithm_t::expand_next_nodes)
+   \return true if some successor in sst is covered, or if check_revisits and
+   some successor in sst covers a node in graph, false otherwise
+   */
+  bool add_next_nodes(typename GRAPH::node_sptr_t const & node, std::vector<typename TS::sst_t> const & sst, GRAPH & graph,
+                      std::vector<typename GRAPH::node_sptr_t> & next_nodes, tchecker::algorithms::covreach::stats_t & stats,
+                      bool check_revisits)
+  {
+    typename GRAPH::node_sptr_t covering_node;
+    std::vector<typename GRAPH::node_sptr_t> covered_nodes;
+    auto covered_nodes_inserter = std::back_inserter(covered_nodes);
+    bool covered = false;
+
+    for (auto && [status, s, t] : sst) {
+      typename GRAPH::node_sptr_t next_node = graph.add_node(s);
+      if (graph.is_covered(next_node, covering_node)) {
+        graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
+        covering_node->set_last_use(this->_time);
+        graph.remove_node(next_node);
+        ++stats.covered_states();
+        covered = true;
+      }
+      else {
+        graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
+        next_node->set_last_use(this->_time);
+        next_nodes.push_back(next_node);
+        if (check_revisits && !covered) {
+          graph.covered_nodes(next_node, covered_nodes_inserter);
+          covered = !covered_nodes.empty();
+        }
+      }
+    }
+    return covered;
+  }
+};
+
+} // end of namespace covreach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_COVREACH_POR_ALGORITHM_HH
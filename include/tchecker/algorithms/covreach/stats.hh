@@ -71,6 +71,18 @@ public:
   */
   unsigned long stored_states() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the number of evicted states
+   */
+  unsigned long & evicted_states();
+
+  /*!
+   \brief Accessor
+   \return The number of evicted states
+  */
+  unsigned long evicted_states() const;
+
   /*!
    \brief Accessor
    \return A reference to the reachable state flag
@@ -86,7 +98,8 @@ public:
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post every statistics has been added to m
+   \post every statistics has been added to m (the number of evicted states
+   only if some states have been evicted)
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
@@ -94,9 +107,58 @@ private:
   unsigned long _visited_states; /*!< Number of visited states */
   unsigned long _covered_states; /*!< Number of covered states */
   unsigned long _stored_states;  /*!< Number of stored states */
+  unsigned long _evicted_states; /*!< Number of states evicted to stay within memory budget */
   bool _reachable;               /*!< Reachability of satisfying state */
 };
 
+/*!
+ \class por_stats_t
+ \brief Statistics for covering reachability algorithm with partial-order
+ reduction
+ */
+class por_stats_t : public tchecker::algorithms::covreach::stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  por_stats_t();
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of states expanded along a persistent set
+   */
+  unsigned long & reduced_expansions();
+
+  /*!
+   \brief Accessor
+   \return The number of states expanded along a persistent set
+   */
+  unsigned long reduced_expansions() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of states fully expanded
+   */
+  unsigned long & full_expansions();
+
+  /*!
+   \brief Accessor
+   \return The number of states fully expanded
+   */
+  unsigned long full_expansions() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post every statistics has been added to m
+  */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  unsigned long _reduced_expansions; /*!< Number of states expanded along a persistent set */
+  unsigned long _full_expansions;    /*!< Number of states fully expanded */
+};
+
 } // end of namespace covreach
 
 } // end of namespace algorithms
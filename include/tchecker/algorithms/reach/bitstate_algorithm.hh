@@ -0,0 +1,136 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_BITSTATE_ALGORITHM_HH
+#define TCHECKER_ALGORITHMS_REACH_BITSTATE_ALGORITHM_HH
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/utils/bitstate.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+
+/*!
+ \file bitstate_algorithm.hh
+ \brief Reachability algorithm with bitstate hashing
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class bitstate_algorithm_t
+ \brief Reachability algorithm with bitstate hashing (supertrace)
+ \tparam TS : type of transition system, should derive from tchecker::ts::ts_t,
+ and hash_value should be defined on the states of TS
+ \note Visited states are only represented by their bits in a
+ tchecker::bitstate_t, hence the memory used to store visited states does not
+ grow during exploration. A state whose bits have all been set by other states
+ is not visited, hence the exploration may be incomplete: a negative answer is
+ not conclusive, but a positive answer is
+ */
+template <class TS> class bitstate_algorithm_t {
+public:
+  /*!
+   \brief Traversal of a transition system from its initial states
+   \param ts : a transition system
+   \param visited : set of visited states
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \post ts has been traversed from its initial states, until a state that
+   satisfies labels is reached (if any). The states that have been visited have
+   been inserted in visited. The order in which the states of ts are visited
+   depends on policy
+   \return statistics on the run
+   */
+  tchecker::algorithms::reach::bitstate_stats_t run(TS & ts, tchecker::bitstate_t & visited,
+                                                    boost::dynamic_bitset<> const & labels,
+                                                    enum tchecker::waiting::policy_t policy)
+  {
+    using state_t = typename TS::state_t;
+    using const_state_t = typename TS::const_state_t;
+
+    std::unique_ptr<tchecker::waiting::waiting_t<state_t>> waiting{waiting_factory<state_t>(policy)};
+
+    tchecker::algorithms::reach::bitstate_stats_t stats;
+
+    stats.set_start_time();
+
+    std::vector<typename TS::sst_t> sst;
+    ts.initial(sst);
+    for (auto && [status, s, t] : sst)
+      if (visited.insert(hash_value(*s)))
+        waiting->insert(s);
+    sst.clear();
+
+    while (!waiting->empty()) {
+      const_state_t s{waiting->first()};
+      waiting->remove_first();
+
+      ++stats.visited_states();
+
+      if (ts.satisfies(s, labels)) {
+        stats.reachable() = true;
+        break;
+      }
+
+      ts.next(s, sst);
+      for (auto && [status, next_s, t] : sst)
+        if (visited.insert(hash_value(*next_s)))
+          waiting->insert(next_s);
+      sst.clear();
+    }
+
+    waiting->clear();
+
+    stats.set_end_time();
+    stats.set_bitstate(visited);
+
+    return stats;
+  }
+
+private:
+  /*!
+   \brief Factory of waiting containers
+   \param policy : waiting policy
+   \return a waiting container that implements policy
+   \note states are never removed from the waiting container, hence policies
+   with fast removal are implemented by the corresponding plain containers,
+   which do not require a status on the waiting elements
+   \throw std::invalid_argument : if policy is unknown
+   */
+  template <class T> static tchecker::waiting::waiting_t<T> * waiting_factory(enum tchecker::waiting::policy_t policy)
+  {
+    switch (policy) {
+    case tchecker::waiting::QUEUE:
+    case tchecker::waiting::FAST_REMOVE_QUEUE:
+      return new tchecker::waiting::queue_t<T>{};
+    case tchecker::waiting::STACK:
+    case tchecker::waiting::FAST_REMOVE_STACK:
+      return new tchecker::waiting::stack_t<T>{};
+    default:
+      throw std::invalid_argument("Unknown waiting policy");
+    }
+  }
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_BITSTATE_ALGORITHM_HH
@@ -0,0 +1,318 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_REACH_PARALLEL_ALGORITHM_HH
+#define TCHECKER_ALGORITHMS_REACH_PARALLEL_ALGORITHM_HH
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/channels.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/graph/allocators.hh"
+#include "tchecker/graph/concurrent_find_graph.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/waiting/factory.hh"
+
+/*!
+ \file parallel_algorithm.hh
+ \brief Multi-threaded reachability algorithm
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace reach {
+
+/*!
+ \class parallel_algorithm_t
+ \brief Multi-threaded reachability algorithm
+ \tparam TS : type of transition system, should derive from tchecker::ts::ts_t,
+ and should provide a method clone_state(s) that returns a copy of a state s
+ allocated by another instance of TS, accessing s through const references only
+ \tparam NODE : type of nodes, should derive from tchecker::waiting::element_t,
+ should be constructible from states of TS, and should have a method state_ptr()
+ that yields a pointer to the corresponding state in TS. A specialization of
+ tchecker::allocation_size_t should be defined for NODE
+ \tparam NODE_HASH : hash function on nodes
+ \tparam NODE_EQUAL : equality predicate on nodes
+ Worker threads share a set of visited nodes
+ (tchecker::graph::concurrent_find::graph_t), and each worker owns a transition
+ system, a node allocator and a waiting list. A worker that computes a successor
+ node inserts it in the shared set, and pushes it to its own waiting list if it
+ is new. When a worker runs out of nodes, it signals that it is idle, and a
+ busy worker sends half of its waiting nodes to it. The idle worker clones the
+ corresponding states in its own transition system.
+ \note states and nodes are reference-counted without synchronization, hence
+ all shared pointers to a node or a state are created and released by the
+ thread that owns it. Nodes in the shared set are only accessed through const
+ references by the other threads
+ \note no edge is stored, hence the algorithm does not build a reachability
+ graph. It computes the same reachability verdict as
+ tchecker::algorithms::reach::algorithm_t
+ */
+template <class TS, class NODE, class NODE_HASH, class NODE_EQUAL> class parallel_algorithm_t {
+public:
+  /*!
+   \brief Traverse a transition system from its initial states, using one
+   thread per transition system
+   \param ts : transition systems, one per worker thread
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \param block_size : number of nodes allocated in one block
+   \param table_size : initial size of the table of visited nodes
+   \pre ts is not empty, and all transition systems in ts are built from the
+   same system
+   \post ts has been traversed from its initial states until a state that
+   satisfies labels is reached (if any), or until all reachable states have
+   been visited. The order in which each worker visits the nodes of ts depends
+   on policy
+   \return statistics on the run, accumulated over all worker threads
+   \throw std::invalid_argument : if ts is empty
+   \note if labels is empty, the entire state-space is visited
+   */
+  tchecker::algorithms::reach::stats_t run(std::vector<std::shared_ptr<TS>> const & ts, boost::dynamic_bitset<> const & labels,
+                                           enum tchecker::waiting::policy_t policy, std::size_t block_size,
+                                           std::size_t table_size)
+  {
+    if (ts.empty())
+      throw std::invalid_argument("parallel reachability expects one transition system per worker");
+
+    std::size_t const workers_count = ts.size();
+    tchecker::algorithms::reach::stats_t stats;
+    std::vector<tchecker::algorithms::reach::stats_t> workers_stats(workers_count);
+    std::vector<std::exception_ptr> workers_errors(workers_count);
+    std::vector<std::atomic<bool>> idle(workers_count);
+    channels_t channels(workers_count, 1); // only worker 0 is active initially
+    visited_t visited(table_size);
+
+    // Nodes are released once all threads are done, since workers access the
+    // nodes of each other through visited
+    std::vector<std::unique_ptr<node_allocator_t>> allocators;
+    std::vector<std::vector<node_sptr_t>> stored(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+      allocators.emplace_back(new node_allocator_t(block_size));
+      idle[i] = (i != 0);
+    }
+
+    stats.set_start_time();
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < workers_count; ++i)
+      threads.emplace_back([&, i]() {
+        try {
+          worker(i, *ts[i], *allocators[i], stored[i], visited, labels, policy, channels, idle, workers_stats[i]);
+        }
+        catch (...) {
+          workers_errors[i] = std::current_exception();
+          channels.stop = true;
+        }
+      });
+
+    for (std::thread & thread : threads)
+      thread.join();
+
+    // All threads are done: nodes and states can be released from here
+    channels.clear();
+    stored.clear();
+
+    for (std::exception_ptr const & error : workers_errors)
+      if (error != nullptr)
+        std::rethrow_exception(error);
+
+    for (std::size_t i = 0; i < workers_count; ++i) {
+      stats.visited_states() += workers_stats[i].visited_states();
+      stats.reachable() = stats.reachable() || workers_stats[i].reachable();
+    }
+
+    stats.set_end_time();
+
+    return stats;
+  }
+
+private:
+  /*!
+   \brief Type of shared nodes
+   */
+  using shared_node_t = tchecker::make_shared_t<NODE>;
+
+  /*!
+   \brief Type of shared pointers to nodes
+   */
+  using node_sptr_t = tchecker::intrusive_shared_ptr_t<shared_node_t>;
+
+  /*!
+   \brief Type of node allocators
+   */
+  using node_allocator_t = tchecker::graph::node_pool_allocator_t<shared_node_t>;
+
+  /*!
+   \brief Type of set of visited nodes
+   */
+  using visited_t = tchecker::graph::concurrent_find::graph_t<NODE, NODE_HASH, NODE_EQUAL>;
+
+  /*!
+   \brief Type of shared pointers to states
+   */
+  using state_sptr_t = typename TS::state_t;
+
+  /*!
+   \brief Type of shared pointers to const states
+   */
+  using const_state_sptr_t = typename TS::const_state_t;
+
+  /*!
+   \brief Type of communication channels between workers
+   */
+  using channels_t = tchecker::algorithms::channels_t<const_state_sptr_t>;
+
+  /*!
+   \brief Type of messages between workers
+   */
+  using message_t = typename channels_t::message_t;
+
+  /*!
+   \brief Exploration by a worker thread
+   \param id : index of the worker
+   \param ts : transition system of the worker
+   \param allocator : node allocator of the worker
+   \param stored : nodes of the worker in visited
+   \param visited : set of visited nodes
+   \param labels : accepting labels
+   \param policy : waiting list policy
+   \param channels : communication channels
+   \param idle : idle flags of the workers
+   \param stats : statistics of the worker
+   \post the nodes computed by worker id have been visited, unless a state
+   satisfying labels has been found
+   */
+  void worker(std::size_t id, TS & ts, node_allocator_t & allocator, std::vector<node_sptr_t> & stored, visited_t & visited,
+              boost::dynamic_bitset<> const & labels, enum tchecker::waiting::policy_t policy, channels_t & channels,
+              std::vector<std::atomic<bool>> & idle, tchecker::algorithms::reach::stats_t & stats)
+  {
+    std::size_t const workers_count = channels.workers_count();
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    std::size_t waiting_count = 0;
+    std::vector<typename TS::sst_t> sst;
+    std::vector<message_t> messages;
+    std::vector<const_state_sptr_t> shared;
+    bool active = (id == 0);
+
+    if (id == 0) {
+      ts.initial(sst);
+      for (auto && [status, s, t] : sst)
+        if (add_node(s, allocator, stored, visited, *waiting))
+          ++waiting_count;
+      sst.clear();
+    }
+
+    while (!channels.stop) {
+      channels.collect(id);
+
+      channels.receive(id, messages);
+      if (!messages.empty()) {
+        if (!active) {
+          ++channels.pending;
+          active = true;
+        }
+        // Received nodes are already in visited
+        for (message_t & message : messages) {
+          for (const_state_sptr_t const & s : message.values) {
+            waiting->insert(allocator.construct(ts.clone_state(*s)));
+            ++waiting_count;
+          }
+          channels.give_back(message);
+        }
+        channels.pending -= messages.size();
+        messages.clear();
+      }
+
+      if (waiting_count == 0) {
+        if (active) {
+          active = false;
+          idle[id] = true;
+          --channels.pending;
+        }
+        if (channels.pending == 0)
+          break;
+        std::this_thread::yield();
+        continue;
+      }
+
+      node_sptr_t node = waiting->first();
+      waiting->remove_first();
+      --waiting_count;
+
+      ++stats.visited_states();
+
+      if (ts.satisfies(node->state_ptr(), labels)) {
+        stats.reachable() = true;
+        channels.stop = true;
+        break;
+      }
+
+      ts.next(node->state_ptr(), sst);
+      for (auto && [status, s, t] : sst)
+        if (add_node(s, allocator, stored, visited, *waiting))
+          ++waiting_count;
+      sst.clear();
+      node = nullptr;
+
+      // Share work with idle workers
+      for (std::size_t i = 0; (i < workers_count) && (waiting_count > 1); ++i) {
+        if (i == id || !idle[i].load(std::memory_order_relaxed) || !idle[i].exchange(false))
+          continue;
+        for (std::size_t k = waiting_count / 2; k > 0; --k) {
+          shared.push_back(waiting->first()->state_ptr());
+          waiting->remove_first();
+          --waiting_count;
+        }
+        channels.send(id, i, shared);
+      }
+    }
+
+    waiting->clear();
+  }
+
+  /*!
+   \brief Add a node for a state, if not visited yet
+   \param s : a state
+   \param allocator : node allocator
+   \param stored : nodes in visited owned by this worker
+   \param visited : set of visited nodes
+   \param waiting : waiting list
+   \post if no node equivalent to s was in visited, a node for s has been added
+   to visited, to stored and to waiting
+   \return true if a node has been added, false otherwise
+   */
+  bool add_node(state_sptr_t const & s, node_allocator_t & allocator, std::vector<node_sptr_t> & stored, visited_t & visited,
+                tchecker::waiting::waiting_t<node_sptr_t> & waiting)
+  {
+    node_sptr_t node = allocator.construct(s);
+    auto && [is_new_node, visited_node] = visited.add_node(node.ptr());
+    if (!is_new_node)
+      return false; // node is collected by allocator once released
+    stored.push_back(node);
+    waiting.insert(node);
+    return true;
+  }
+};
+
+} // end of namespace reach
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_REACH_PARALLEL_ALGORITHM_HH
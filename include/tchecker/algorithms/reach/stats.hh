@@ -12,6 +12,7 @@
 #include <string>
 
 #include "tchecker/algorithms/stats.hh"
+#include "tchecker/utils/bitstate.hh"
 
 /*!
  \file stats.hh
@@ -71,6 +72,46 @@ private:
   bool _reachable;               /*!< Reachability of satisfying state */
 };
 
+/*!
+ \class bitstate_stats_t
+ \brief Statistics for reachability algorithm with bitstate hashing
+ */
+class bitstate_stats_t : public tchecker::algorithms::reach::stats_t {
+public:
+  /*!
+  \brief Constructor
+  */
+  bitstate_stats_t();
+
+  /*!
+   \brief Set statistics on the set of visited states
+   \param bitstate : set of visited states
+   \post statistics on bitstate have been recorded
+   */
+  void set_bitstate(tchecker::bitstate_t const & bitstate);
+
+  /*!
+   \brief Accessor
+   \return Estimated ratio of reachable states that have been visited
+   */
+  double estimated_coverage() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post every statistics has been added to m
+  */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  std::size_t _stored_states;   /*!< Number of states stored in the bitstate */
+  std::size_t _bitstate_size;   /*!< Number of bits in the bitstate */
+  unsigned int _hash_count;     /*!< Number of bits per state */
+  std::size_t _set_bits;        /*!< Number of set bits */
+  double _omission_probability; /*!< Probability that an unvisited state is considered visited */
+  double _estimated_coverage;   /*!< Estimated ratio of reachable states that have been visited */
+};
+
 } // end of namespace reach
 
 } // end of namespace algorithms
@@ -27,6 +27,11 @@ namespace algorithms {
  */
 class stats_t {
 public:
+  /*!
+   \brief Constructor
+   */
+  stats_t();
+
   /*!
    \brief Set starting time
   */
@@ -55,16 +60,81 @@ public:
   */
   double running_time() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the number of hits of the cache of outgoing edges
+   */
+  unsigned long & edges_cache_hits();
+
+  /*!
+   \brief Accessor
+   \return The number of hits of the cache of outgoing edges
+   */
+  unsigned long edges_cache_hits() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of misses of the cache of outgoing edges
+   */
+  unsigned long & edges_cache_misses();
+
+  /*!
+   \brief Accessor
+   \return The number of misses of the cache of outgoing edges
+   */
+  unsigned long edges_cache_misses() const;
+
+  /*!
+   \brief Set the number of successor states allocated by the transition system
+   \param n : number of allocated successor states
+   \post the number of allocated successor states is n, and it is reported by
+   attributes (even if n is 0)
+   */
+  void set_successor_allocations(unsigned long n);
+
+  /*!
+   \brief Accessor
+   \return The number of successor states allocated by the transition system
+   \note covering reachability allocates a node for each allocated successor
+   state (see tchecker::algorithms::covreach::algorithm_t), hence this is also
+   its number of allocated successor nodes
+   */
+  unsigned long successor_allocations() const;
+
+  /*!
+   \brief Set the number of successor states discarded by the transition system
+   without copying the zone of their source state
+   \param n : number of avoided zone copies
+   \post the number of avoided zone copies is n, and it is reported by
+   attributes (even if n is 0)
+   */
+  void set_avoided_zone_copies(unsigned long n);
+
+  /*!
+   \brief Accessor
+   \return The number of successor states discarded by the transition system
+   without copying the zone of their source state
+   */
+  unsigned long avoided_zone_copies() const;
+
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post Starting time, ending time and running time have been added to m
+   \post Running time has been added to m, as well as hits and misses of the
+   cache of outgoing edges if it has been accessed, the number of allocated
+   successors and the number of avoided zone copies if they have been set
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
 private:
   std::chrono::time_point<std::chrono::steady_clock> _start_time; /*!< Start time */
   std::chrono::time_point<std::chrono::steady_clock> _end_time;   /*!< End time */
+  unsigned long _edges_cache_hits;                                /*!< Number of hits of the cache of outgoing edges */
+  unsigned long _edges_cache_misses;                              /*!< Number of misses of the cache of outgoing edges */
+  unsigned long _successor_allocations;                           /*!< Number of allocated successor states */
+  bool _successor_allocations_set;                                /*!< Whether _successor_allocations has been set */
+  unsigned long _avoided_zone_copies;                             /*!< Number of avoided copies of source zones */
+  bool _avoided_zone_copies_set;                                  /*!< Whether _avoided_zone_copies has been set */
 };
 
 } // end of namespace algorithms
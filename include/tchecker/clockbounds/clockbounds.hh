@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "tchecker/basictypes.hh"
@@ -643,6 +645,191 @@ private:
  */
 std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::global_m_map_t const & map);
 
+namespace details {
+
+/*!
+ \class vloc_index_t
+ \brief Index of tuples of locations
+ \note Tuples of locations are numbered from 0 in order of insertion
+ */
+class vloc_index_t {
+public:
+  /*!
+   \brief Constructor
+   \post this index is empty
+   */
+  vloc_index_t();
+
+  /*!
+   \brief Find or add a tuple of locations
+   \param vloc : tuple of locations
+   \post vloc has been added to this index if not already in
+   \return a pair (n, added) where n is the number of vloc in this index, and
+   added is true if vloc has been added, false if it was already in
+   */
+  std::tuple<std::size_t, bool> find_else_add(tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Accessor
+   \return Number of tuples of locations in this index
+   */
+  inline std::size_t size() const { return _offsets.size() - 1; }
+
+  /*!
+   \brief Clear
+   \post this index is empty
+   */
+  void clear();
+
+private:
+  std::unordered_multimap<std::size_t, std::size_t> _index; /*!< Map : hash of tuple -> number of tuple */
+  std::vector<tchecker::loc_id_t> _locs;                    /*!< Concatenated tuples of locations */
+  std::vector<std::size_t> _offsets;                        /*!< Offsets of tuples in _locs (+ end of last tuple) */
+};
+
+} // end of namespace details
+
+/*!
+ \class local_lu_cache_t
+ \brief Memoization of local LU clock bounds for tuples of locations
+ \note The clock bounds of a tuple of locations are computed from a local LU
+ map when first accessed, and stored for later accesses. A cache is not
+ thread-safe: each thread should have its own cache
+ */
+class local_lu_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param map : local LU map
+   \post this cache is empty, and keeps a shared pointer on map
+   */
+  local_lu_cache_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & map);
+
+  /*!
+   \brief Copy constructor
+   */
+  local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t const & c);
+
+  /*!
+   \brief Move constructor
+   */
+  local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t && c);
+
+  /*!
+   \brief Destructor
+   */
+  ~local_lu_cache_t();
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::clockbounds::local_lu_cache_t & operator=(tchecker::clockbounds::local_lu_cache_t const & c);
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::clockbounds::local_lu_cache_t & operator=(tchecker::clockbounds::local_lu_cache_t && c);
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of location identifiers
+   \param L : clock lower-bound map
+   \param U : clock upper-bound map
+   \pre see tchecker::clockbounds::local_lu_map_t::bounds
+   \post L and U point to the lower-bound and upper-bound maps for vloc
+   \note the maps pointed by L and U are owned by this cache, and remain valid
+   until this cache is cleared or destructed
+   */
+  void bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t const *& L, tchecker::clockbounds::map_t const *& U);
+
+  /*!
+   \brief Accessor
+   \return Number of tuples of locations in this cache
+   */
+  inline std::size_t size() const { return _index.size(); }
+
+  /*!
+   \brief Clear
+   \post this cache is empty
+   */
+  void clear();
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _map; /*!< Local LU map */
+  tchecker::clockbounds::details::vloc_index_t _index;               /*!< Index of cached tuples of locations */
+  std::vector<tchecker::clockbounds::map_t *> _L;                    /*!< Clock lower-bound maps of cached tuples */
+  std::vector<tchecker::clockbounds::map_t *> _U;                    /*!< Clock upper-bound maps of cached tuples */
+};
+
+/*!
+ \class local_m_cache_t
+ \brief Memoization of local M clock bounds for tuples of locations
+ \note The clock bounds of a tuple of locations are computed from a local M
+ map when first accessed, and stored for later accesses. A cache is not
+ thread-safe: each thread should have its own cache
+ */
+class local_m_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param map : local M map
+   \post this cache is empty, and keeps a shared pointer on map
+   */
+  local_m_cache_t(std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & map);
+
+  /*!
+   \brief Copy constructor
+   */
+  local_m_cache_t(tchecker::clockbounds::local_m_cache_t const & c);
+
+  /*!
+   \brief Move constructor
+   */
+  local_m_cache_t(tchecker::clockbounds::local_m_cache_t && c);
+
+  /*!
+   \brief Destructor
+   */
+  ~local_m_cache_t();
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::clockbounds::local_m_cache_t & operator=(tchecker::clockbounds::local_m_cache_t const & c);
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::clockbounds::local_m_cache_t & operator=(tchecker::clockbounds::local_m_cache_t && c);
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of location identifiers
+   \pre see tchecker::clockbounds::local_m_map_t::bounds
+   \return the clock bound map for vloc
+   \note the returned map is owned by this cache, and remains valid until this
+   cache is cleared or destructed
+   */
+  tchecker::clockbounds::map_t const & bounds(tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Accessor
+   \return Number of tuples of locations in this cache
+   */
+  inline std::size_t size() const { return _index.size(); }
+
+  /*!
+   \brief Clear
+   \post this cache is empty
+   */
+  void clear();
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_m_map_t const> _map; /*!< Local M map */
+  tchecker::clockbounds::details::vloc_index_t _index;              /*!< Index of cached tuples of locations */
+  std::vector<tchecker::clockbounds::map_t *> _M;                   /*!< Clock bound maps of cached tuples */
+};
+
 /*!
 \class clockbounds_t
 \brief Clock bounds for timed automata
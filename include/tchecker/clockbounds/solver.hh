@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <vector>
 
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/dbm.hh"
@@ -50,6 +51,11 @@ We take the conjunction of all the constraints for every transition in the autom
 Diophantine inequations is solved by computing the minimal path from L_{x,l} and U_{x,l} to 0 for every clock x
 and every location l, in the graph of the system of inequations.
 
+The graph is sparse: guards are stored as the maximal bound on each variable, and assignments are stored as
+adjacency lists shared by lower and upper bounds. Constraints across processes go through one auxiliary
+variable per process and clock. Hence, memory is linear in the number of variables, guards and assignments.
+Minimal paths are computed by a worklist algorithm (Bellman-Ford with a queue).
+
 This class provides methods to specify the constraints from the transitions of an automaton, and a method to
 solve the system of inequations, and compute the resulting bounds.
 */
@@ -69,19 +75,19 @@ public:
   \param solver : a solver
   \post this is a copy of solver
   */
-  df_solver_t(tchecker::clockbounds::df_solver_t const & solver);
+  df_solver_t(tchecker::clockbounds::df_solver_t const & solver) = default;
 
   /*!
   \brief Move constructor
   \param solver : a solver
   \post solver has been moved to this
   */
-  df_solver_t(tchecker::clockbounds::df_solver_t && solver);
+  df_solver_t(tchecker::clockbounds::df_solver_t && solver) = default;
 
   /*!
   \brief Destructor
   */
-  ~df_solver_t();
+  ~df_solver_t() = default;
 
   /*!
   \brief Assignment operator
@@ -89,7 +95,7 @@ public:
   \post this is a copy of solver
   \return this
   */
-  tchecker::clockbounds::df_solver_t & operator=(tchecker::clockbounds::df_solver_t const & solver);
+  tchecker::clockbounds::df_solver_t & operator=(tchecker::clockbounds::df_solver_t const & solver) = default;
 
   /*!
   \brief Move assignment operator
@@ -97,7 +103,7 @@ public:
   \post solver has been moved to this
   \return this
   */
-  tchecker::clockbounds::df_solver_t & operator=(tchecker::clockbounds::df_solver_t && solver);
+  tchecker::clockbounds::df_solver_t & operator=(tchecker::clockbounds::df_solver_t && solver) = default;
 
   /*!
   \brief Accessor
@@ -115,9 +121,10 @@ public:
   \brief Accessor
   \param l : location ID
   \param x : clock ID
-  \pre 0 <= l < _loc_number (checked by assertion) and 0 <= x < _clock_number (checked by assertion)
+  \pre 0 <= l < _loc_number (checked by assertion) and 0 <= x < _clock_number (checked by assertion), and this
+  has been solved (checked by assertion)
   \return Minimum feasible value for L_{l,x} according to the system of constraints
-  \note this value is only meaningful when the system has been solved and it has a solution
+  \note this value is only meaningful when the system has a solution
   */
   tchecker::clockbounds::bound_t L(tchecker::loc_id_t l, tchecker::clock_id_t x) const;
 
@@ -125,14 +132,16 @@ public:
   \brief Accessor
   \param l : location ID
   \param x : clock ID
-  \pre 0 <= l < _loc_number (checked by assertion) and 0 <= x < _clock_number (checked by assertion)
+  \pre 0 <= l < _loc_number (checked by assertion) and 0 <= x < _clock_number (checked by assertion), and this
+  has been solved (checked by assertion)
   \return Minimum feasible value for U_{l,x} according to the system of constraints
-  \note this value is only meaningful when the system has been solved and it has a solution
+  \note this value is only meaningful when the system has a solution
   */
   tchecker::clockbounds::bound_t U(tchecker::loc_id_t l, tchecker::clock_id_t x) const;
 
   /*!
   \brief Accessor
+  \pre this has been solved (checked by assertion)
   \return true is the system of inequations has a solution, false otherwise
   */
   bool has_solution() const;
@@ -143,6 +152,15 @@ public:
   */
   void clear();
 
+  /*!
+  \brief Solve the system of inequations
+  \post this has been solved: has_solution() tells if the system of inequations has a solution, and if so, L() and
+  U() give the minimal solution
+  \throw std::invalid_argument : if a bound is not representable
+  \note adding constraints after solving requires to solve again
+  */
+  void solve();
+
   /*!
   \brief Add a constraint for guard x > c or x >= c
   \param l : location ID
@@ -172,7 +190,8 @@ public:
   \param c : constant
   \pre 0 <= l1, l2 < _loc_number (checked by assertion) and 0 <= y, x < _clock_number (checked by assertion)
   \post The constraints L_{x,l1} >= L_{y,l2} - c   and   U_{x,l1} >= U_{y,l2} - c have been added to the
-  system of inequations
+  system of inequations, as well as L_{x,l1} >= L_{y,m} - c   and   U_{x,l1} >= U_{y,m} - c for every location m
+  in another process than l1
   */
   void add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t y, tchecker::clock_id_t x,
                       tchecker::integer_t c);
@@ -189,6 +208,16 @@ public:
   void add_no_assignement(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t x);
 
 protected:
+  /*!
+  \brief Type of weighted edges in the graph of inequations
+  \note an edge from u to v with weight w stands for inequation u - v >= -w, where 0 stands for the constant 0
+  */
+  struct edge_t {
+    std::size_t _src;            /*!< Source variable */
+    std::size_t _tgt;            /*!< Target variable */
+    tchecker::integer_t _weight; /*!< Weight */
+  };
+
   /*!
   \brief Accessor
   \param l : location ID
@@ -198,13 +227,45 @@ protected:
   */
   std::size_t index(tchecker::loc_id_t l, tchecker::clock_id_t x) const;
 
-  tchecker::loc_id_t _loc_number;               /*!< Number of locations */
-  tchecker::clock_id_t _clock_number;           /*!< Number of clocks */
-  std::vector<tchecker::process_id_t> _loc_pid; /*!< Map: location ID -> process ID */
-  std::size_t _dim;                             /*!< Dimension of the equations */
-  tchecker::dbm::db_t * _L;                     /*!< Inequations on lower bounds L_{x,l} */
-  tchecker::dbm::db_t * _U;                     /*!< Inequations on upper bounds U_{x,l} */
-  bool _has_solution;                           /*!< Flags existence of a solution */
+  /*!
+  \brief Accessor
+  \param pid : process ID
+  \param x : clock ID
+  \pre 0 <= pid < _process_number (checked by assertion) and 0 <= x < _clock_number (checked by assertion)
+  \return The index of the auxiliary variable for clock x in process pid
+  \post the auxiliary variable has been constrained to be greater than or equal to the bound variables for clock
+  x in every location of process pid
+  */
+  std::size_t process_index(tchecker::process_id_t pid, tchecker::clock_id_t x);
+
+  /*!
+  \brief Minimal paths from 0
+  \param guards : weights of edges from 0 (maximal bound for each variable, or tchecker::clockbounds::NO_BOUND)
+  \param first : map from variables to their first edge in succ and weight
+  \param succ : targets of edges sorted by source
+  \param weight : weights of edges sorted by source
+  \param bounds : bound for each location and clock
+  \pre the graph has no negative cycle
+  \post bounds has been filled with the minimal bound for each location and clock, NO_BOUND if unconstrained
+  \throw std::invalid_argument : if a bound is not representable
+  */
+  void minimal_paths(std::vector<tchecker::clockbounds::bound_t> const & guards, std::vector<std::size_t> const & first,
+                     std::vector<std::size_t> const & succ, std::vector<tchecker::integer_t> const & weight,
+                     std::vector<tchecker::clockbounds::bound_t> & bounds) const;
+
+  tchecker::loc_id_t _loc_number;                   /*!< Number of locations */
+  tchecker::clock_id_t _clock_number;               /*!< Number of clocks */
+  tchecker::process_id_t _process_number;           /*!< Number of processes */
+  std::vector<tchecker::process_id_t> _loc_pid;     /*!< Map: location ID -> process ID */
+  std::size_t _dim;                                 /*!< Number of variables (including 0) */
+  std::vector<tchecker::clockbounds::bound_t> _L0;  /*!< Maximal lower bound guard on each variable */
+  std::vector<tchecker::clockbounds::bound_t> _U0;  /*!< Maximal upper bound guard on each variable */
+  std::vector<edge_t> _edges;                       /*!< Inequations between variables (shared by L and U) */
+  std::vector<bool> _process_clocks;                /*!< Flags auxiliary variables that have been constrained */
+  std::vector<tchecker::clockbounds::bound_t> _L;   /*!< Solution: L_{l,x} */
+  std::vector<tchecker::clockbounds::bound_t> _U;   /*!< Solution: U_{l,x} */
+  bool _has_solution;                               /*!< Flags existence of a solution */
+  bool _solved;                                     /*!< Flags solved system */
 };
 
 /*!
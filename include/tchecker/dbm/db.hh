@@ -10,6 +10,8 @@
 
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/variables/clocks.hh"
@@ -182,6 +184,59 @@ inline tchecker::integer_t value(tchecker::dbm::db_t db) { return (db >> 1); }
  */
 inline std::size_t hash(tchecker::dbm::db_t db) { return db; }
 
+/* Narrow difference bounds:
+ Difference bounds are stored in 16-bits integers with the same encoding as in tchecker::dbm::db_t. The
+ greatest narrow difference bound encodes <inf. Conversions between narrow and wide difference bounds
+ preserve the order of difference bounds, hence the standard comparison operators also carry on narrow
+ difference bounds. Narrow difference bounds are meant to store DBMs with small constants.
+ */
+
+/*!
+ \brief Type of narrow difference bounds
+ */
+using narrow_db_t = std::int16_t;
+
+/*! \brief Narrow <inf */
+tchecker::dbm::narrow_db_t const NARROW_LT_INFINITY =
+    ((std::numeric_limits<tchecker::dbm::narrow_db_t>::max() >> 1) << 1) | tchecker::dbm::LT;
+
+/*!
+ \brief Narrowing predicate
+ \param db : a difference bound
+ \return true if db can be represented as a narrow difference bound, false otherwise
+ */
+inline bool is_narrow(tchecker::dbm::db_t db)
+{
+  return (db == tchecker::dbm::LT_INFINITY) ||
+         ((db >= std::numeric_limits<tchecker::dbm::narrow_db_t>::min()) && (db < tchecker::dbm::NARROW_LT_INFINITY));
+}
+
+/*!
+ \brief Narrowing of a difference bound
+ \param db : a difference bound
+ \pre tchecker::dbm::is_narrow(db)
+ \return the narrow difference bound that represents db
+ \throw std::invalid_argument : if db cannot be represented as a narrow difference bound
+ */
+inline tchecker::dbm::narrow_db_t narrow(tchecker::dbm::db_t db)
+{
+  if (db == tchecker::dbm::LT_INFINITY)
+    return tchecker::dbm::NARROW_LT_INFINITY;
+  if (!tchecker::dbm::is_narrow(db))
+    throw std::invalid_argument("difference bound out of narrow bounds");
+  return static_cast<tchecker::dbm::narrow_db_t>(db);
+}
+
+/*!
+ \brief Widening of a narrow difference bound
+ \param db : a narrow difference bound
+ \return the difference bound represented by db
+ */
+inline tchecker::dbm::db_t widen(tchecker::dbm::narrow_db_t db)
+{
+  return (db == tchecker::dbm::NARROW_LT_INFINITY ? tchecker::dbm::LT_INFINITY : static_cast<tchecker::dbm::db_t>(db));
+}
+
 /*!
  \brief Output a difference bound
  \param os : output stream
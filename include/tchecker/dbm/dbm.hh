@@ -602,6 +602,106 @@ std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * dbm, tcheck
 int lexical_cmp(tchecker::dbm::db_t const * dbm1, tchecker::clock_id_t dim1, tchecker::dbm::db_t const * dbm2,
                 tchecker::clock_id_t dim2);
 
+/*!
+ \brief Narrowing predicate
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dim >= 1 (checked by assertion)
+ \return true if all the difference bounds in dbm can be represented as narrow difference bounds, false otherwise
+ */
+bool is_narrow(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
+/*!
+ \brief Narrowing of a DBM
+ \param ndbm : a narrow dbm
+ \param dbm : a dbm
+ \param dim : dimension of ndbm and dbm
+ \pre ndbm and dbm are not nullptr (checked by assertion)
+ ndbm and dbm are dim*dim arrays of difference bounds
+ dim >= 1 (checked by assertion)
+ \post ndbm represents the same difference bounds as dbm
+ \throw std::invalid_argument : if some difference bound in dbm cannot be represented as a narrow difference bound, then
+ ndbm is partially updated
+ */
+void narrow(tchecker::dbm::narrow_db_t * ndbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
+/*!
+ \brief Widening of a narrow DBM
+ \param dbm : a dbm
+ \param ndbm : a narrow dbm
+ \param dim : dimension of dbm and ndbm
+ \pre dbm and ndbm are not nullptr (checked by assertion)
+ dbm and ndbm are dim*dim arrays of difference bounds
+ dim >= 1 (checked by assertion)
+ \post dbm represents the same difference bounds as ndbm
+ */
+void widen(tchecker::dbm::db_t * dbm, tchecker::dbm::narrow_db_t const * ndbm, tchecker::clock_id_t dim);
+
+/* Reduced DBMs:
+ A reduced DBM is a minimal set of difference bounds that has the same tightening as a given tight DBM (see "Efficient
+ verification of real-time systems: compact data structure and state-space reduction", Larsen et al., RTSS 1997). Clocks
+ that are related by zero-weight cycles are grouped in classes. Each class is represented by a cycle through its clocks, and
+ the classes are related by the difference bounds between their smallest clocks that are not implied by a third class.
+ The reduction is deterministic: equal DBMs have equal reduced DBMs.
+ */
+
+/*!
+ \brief Difference bound in a reduced DBM
+ */
+struct reduced_db_t {
+  tchecker::clock_id_t i;  /*!< First clock */
+  tchecker::clock_id_t j;  /*!< Second clock */
+  tchecker::dbm::db_t db; /*!< Bound on xi - xj */
+};
+
+/*!
+ \brief Reduction of a DBM
+ \param rdbm : a reduced DBM
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is tight and not empty (checked by assertion)
+ dim >= 1 (checked by assertion)
+ rdbm is nullptr, or it has capacity for the number of difference bounds returned by this function (at most dim*(dim-1))
+ \post if rdbm is not nullptr, it contains the minimal set of difference bounds of dbm
+ \return the number of difference bounds in the reduced DBM of dbm
+ */
+std::size_t reduce(tchecker::dbm::reduced_db_t * rdbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
+/*!
+ \brief Expansion of a reduced DBM
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param rdbm : a reduced DBM
+ \param size : number of difference bounds in rdbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dim >= 1 (checked by assertion)
+ rdbm has been computed by tchecker::dbm::reduce from a DBM of dimension dim, and has size difference bounds
+ \post dbm is the tight DBM that rdbm has been computed from
+ */
+void expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_db_t const * rdbm, std::size_t size);
+
+/*!
+ \brief Inclusion check w.r.t. a reduced DBM
+ \param dbm1 : a dbm
+ \param dim : dimension of dbm1
+ \param rdbm2 : a reduced DBM
+ \param size2 : number of difference bounds in rdbm2
+ \pre dbm1 is not nullptr (checked by assertion)
+ dbm1 is a dim*dim array of difference bounds
+ dbm1 is tight and not empty
+ dim >= 1 (checked by assertion)
+ rdbm2 has been computed by tchecker::dbm::reduce from a DBM of dimension dim, and has size2 difference bounds
+ \return true if the zone represented by dbm1 is included in the zone represented by rdbm2, false otherwise
+ \note the check does not expand rdbm2
+ */
+bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::clock_id_t dim, tchecker::dbm::reduced_db_t const * rdbm2,
+           std::size_t size2);
+
 } // end of namespace dbm
 
 } // end of namespace tchecker
@@ -0,0 +1,510 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_OPERATIONS_HH
+#define TCHECKER_DBM_OPERATIONS_HH
+
+#include <cassert>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/variables/clocks.hh"
+
+/*!
+ \file operations.hh
+ \brief DBM operations specialized for a fixed dimension
+ \note The functions in namespace tchecker::dbm::fixed implement the same
+ operations as the functions with the same names in tchecker/dbm/dbm.hh, and
+ compute the same DBMs. The dimension is a template parameter, which allows the
+ compiler to unroll and vectorize loops on small DBMs.
+ Sets of operations are selected by dimension using tchecker::dbm::operations
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace fixed {
+
+/*!
+ \brief Tightening
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \pre see tchecker::dbm::tighten
+ \post see tchecker::dbm::tighten
+ \return see tchecker::dbm::tighten
+ */
+template <tchecker::clock_id_t DIM> enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm)
+{
+  static_assert(DIM >= 1, "");
+  assert(dbm != nullptr);
+
+  for (tchecker::clock_id_t k = 0; k < DIM; ++k) {
+    tchecker::dbm::db_t const * dbm_k = dbm + k * DIM;
+    for (tchecker::clock_id_t i = 0; i < DIM; ++i) {
+      tchecker::dbm::db_t * dbm_i = dbm + i * DIM;
+      if ((i == k) || (dbm_i[k] == tchecker::dbm::LT_INFINITY)) // optimization
+        continue;
+      // dbm_i[k] is updated in the middle of the row, as in the textbook loop over j
+      tchecker::dbm::db_t const dik = dbm_i[k];
+      for (tchecker::clock_id_t j = 0; j < k; ++j)
+        dbm_i[j] = tchecker::dbm::min(tchecker::dbm::sum(dik, dbm_k[j]), dbm_i[j]);
+      dbm_i[k] = tchecker::dbm::min(tchecker::dbm::sum(dik, dbm_k[k]), dik);
+      tchecker::dbm::db_t const dik_updated = dbm_i[k];
+      for (tchecker::clock_id_t j = k + 1; j < DIM; ++j)
+        dbm_i[j] = tchecker::dbm::min(tchecker::dbm::sum(dik_updated, dbm_k[j]), dbm_i[j]);
+      if (dbm_i[i] < tchecker::dbm::LE_ZERO) {
+        dbm[0] = tchecker::dbm::LT_ZERO;
+        return tchecker::dbm::EMPTY;
+      }
+    }
+  }
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Tightening w.r.t. a constraint
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param x : first clock
+ \param y : second clock
+ \pre see tchecker::dbm::tighten
+ \post see tchecker::dbm::tighten
+ \return see tchecker::dbm::tighten
+ */
+template <tchecker::clock_id_t DIM>
+enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t x, tchecker::clock_id_t y)
+{
+  static_assert(DIM >= 1, "");
+  assert(dbm != nullptr);
+
+  if (dbm[x * DIM + y] == tchecker::dbm::LT_INFINITY)
+    return tchecker::dbm::MAY_BE_EMPTY;
+
+  tchecker::dbm::db_t const * dbm_y = dbm + y * DIM;
+  for (tchecker::clock_id_t i = 0; i < DIM; ++i) {
+    tchecker::dbm::db_t * dbm_i = dbm + i * DIM;
+
+    // tighten i->y w.r.t. i->x->y
+    if (i != x) {
+      tchecker::dbm::db_t db_ixy = tchecker::dbm::sum(dbm_i[x], dbm[x * DIM + y]);
+      if (db_ixy < dbm_i[y])
+        dbm_i[y] = db_ixy;
+    }
+
+    // tighten i->j w.r.t. i->y->j
+    tchecker::dbm::db_t const diy = dbm_i[y];
+    if (diy != tchecker::dbm::LT_INFINITY) {
+      for (tchecker::clock_id_t j = 0; j < y; ++j)
+        dbm_i[j] = tchecker::dbm::min(dbm_i[j], tchecker::dbm::sum(diy, dbm_y[j]));
+      dbm_i[y] = tchecker::dbm::min(diy, tchecker::dbm::sum(diy, dbm_y[y]));
+      tchecker::dbm::db_t const diy_updated = dbm_i[y];
+      for (tchecker::clock_id_t j = y + 1; j < DIM; ++j)
+        dbm_i[j] = tchecker::dbm::min(dbm_i[j], tchecker::dbm::sum(diy_updated, dbm_y[j]));
+    }
+
+    if (dbm_i[i] < tchecker::dbm::LE_ZERO) {
+      dbm[0] = tchecker::dbm::LT_ZERO;
+      return tchecker::dbm::EMPTY;
+    }
+  }
+
+  return tchecker::dbm::MAY_BE_EMPTY;
+}
+
+/*!
+ \brief Constrain a DBM
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param x : first clock
+ \param y : second clock
+ \param cmp : constraint comparator
+ \param value : constraint value
+ \pre see tchecker::dbm::constrain
+ \post see tchecker::dbm::constrain
+ \return see tchecker::dbm::constrain
+ \throw std::invalid_argument : see tchecker::dbm::constrain
+ */
+template <tchecker::clock_id_t DIM>
+enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t x, tchecker::clock_id_t y,
+                                       tchecker::dbm::comparator_t cmp, tchecker::integer_t value)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+  assert(x < DIM);
+  assert(y < DIM);
+
+  tchecker::dbm::db_t db = tchecker::dbm::db(cmp, value);
+  if (db >= dbm[x * DIM + y])
+    return tchecker::dbm::NON_EMPTY;
+
+  dbm[x * DIM + y] = db;
+
+  auto res = tchecker::dbm::fixed::tighten<DIM>(dbm, x, y);
+
+  if (res == tchecker::dbm::MAY_BE_EMPTY)
+    res = tchecker::dbm::NON_EMPTY; // since dbm was tight before
+
+  assert((res == tchecker::dbm::EMPTY) || tchecker::dbm::is_consistent(dbm, DIM));
+  assert((res == tchecker::dbm::EMPTY) || tchecker::dbm::is_tight(dbm, DIM));
+
+  return res;
+}
+
+/*!
+ \brief Constrain a DBM
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param constraints : clock constraints
+ \pre see tchecker::dbm::constrain
+ \post see tchecker::dbm::constrain
+ \return see tchecker::dbm::constrain
+ \throw std::invalid_argument : see tchecker::dbm::constrain
+ */
+template <tchecker::clock_id_t DIM>
+enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_constraint_container_t const & constraints)
+{
+  for (tchecker::clock_constraint_t const & c : constraints) {
+    tchecker::clock_id_t id1 = (c.id1() == tchecker::REFCLOCK_ID ? 0 : c.id1() + 1);
+    tchecker::clock_id_t id2 = (c.id2() == tchecker::REFCLOCK_ID ? 0 : c.id2() + 1);
+    auto cmp = (c.comparator() == tchecker::clock_constraint_t::LT ? tchecker::dbm::LT : tchecker::dbm::LE);
+    if (tchecker::dbm::fixed::constrain<DIM>(dbm, id1, id2, cmp, c.value()) == tchecker::dbm::EMPTY)
+      return tchecker::dbm::EMPTY;
+  }
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Inclusion check
+ \tparam DIM : dimension of DBMs
+ \param dbm1 : a DBM
+ \param dbm2 : a DBM
+ \pre see tchecker::dbm::is_le
+ \return see tchecker::dbm::is_le
+ */
+template <tchecker::clock_id_t DIM> bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_tight(dbm1, DIM));
+  assert(tchecker::dbm::is_tight(dbm2, DIM));
+
+  // no early exit: the loop is fully unrolled and vectorized for small DIM
+  bool le = true;
+  for (tchecker::clock_id_t k = 0; k < DIM * DIM; ++k)
+    le &= (dbm1[k] <= dbm2[k]);
+  return le;
+}
+
+/*!
+ \brief Reset a clock to a value
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param x : clock
+ \param value : value
+ \pre see tchecker::dbm::reset_to_value
+ \post see tchecker::dbm::reset_to_value
+ */
+template <tchecker::clock_id_t DIM>
+void reset_to_value(tchecker::dbm::db_t * dbm, tchecker::clock_id_t x, tchecker::integer_t value)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+  assert(x < DIM);
+  assert(0 <= value);
+
+  // set x == value
+  dbm[x * DIM] = tchecker::dbm::db(tchecker::dbm::LE, value);
+  dbm[x] = tchecker::dbm::db(tchecker::dbm::LE, -value);
+
+  // tighten: x->y is set to x->0->y and y->x to y->0->x for all y!=0
+  for (tchecker::clock_id_t y = 1; y < DIM; ++y) {
+    dbm[x * DIM + y] = tchecker::dbm::sum(dbm[x * DIM], dbm[y]);
+    dbm[y * DIM + x] = tchecker::dbm::sum(dbm[y * DIM], dbm[x]);
+  }
+
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+}
+
+/*!
+ \brief Reset a clock to another clock
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param x : clock
+ \param y : clock
+ \pre see tchecker::dbm::reset_to_clock
+ \post see tchecker::dbm::reset_to_clock
+ */
+template <tchecker::clock_id_t DIM>
+void reset_to_clock(tchecker::dbm::db_t * dbm, tchecker::clock_id_t x, tchecker::clock_id_t y)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+  assert(x < DIM);
+  assert(0 < y);
+  assert(y < DIM);
+
+  // x is identified to y w.r.t. all clocks z
+  for (tchecker::clock_id_t z = 0; z < DIM; ++z) {
+    dbm[x * DIM + z] = dbm[y * DIM + z];
+    dbm[z * DIM + x] = dbm[z * DIM + y];
+  }
+  dbm[x * DIM + x] = tchecker::dbm::LE_ZERO; // cheaper than testing in loop
+
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+}
+
+/*!
+ \brief Reset a clock to the sum of a clock and a value
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param x : clock
+ \param y : clock
+ \param value : value
+ \pre see tchecker::dbm::reset_to_sum
+ \post see tchecker::dbm::reset_to_sum
+ */
+template <tchecker::clock_id_t DIM>
+void reset_to_sum(tchecker::dbm::db_t * dbm, tchecker::clock_id_t x, tchecker::clock_id_t y, tchecker::integer_t value)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+  assert(x < DIM);
+  assert(y < DIM);
+  assert(0 <= value);
+
+  // see tchecker::dbm::reset_to_sum
+  for (tchecker::clock_id_t z = 0; z < DIM; ++z) {
+    dbm[x * DIM + z] = tchecker::dbm::add(dbm[y * DIM + z], value);
+    dbm[z * DIM + x] = tchecker::dbm::add(dbm[z * DIM + y], -value);
+  }
+  dbm[x * DIM + x] = tchecker::dbm::LE_ZERO; // cheaper than testing in loop
+
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+}
+
+/*!
+ \brief Reset clocks
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param resets : clock resets
+ \pre see tchecker::dbm::reset
+ \post see tchecker::dbm::reset
+ */
+template <tchecker::clock_id_t DIM> void reset(tchecker::dbm::db_t * dbm, tchecker::clock_reset_container_t const & resets)
+{
+  for (tchecker::clock_reset_t const & r : resets) {
+    tchecker::clock_id_t lid = (r.left_id() == tchecker::REFCLOCK_ID ? 0 : r.left_id() + 1);
+    tchecker::clock_id_t rid = (r.right_id() == tchecker::REFCLOCK_ID ? 0 : r.right_id() + 1);
+    if (rid == 0)
+      tchecker::dbm::fixed::reset_to_value<DIM>(dbm, lid, r.value());
+    else if (r.value() == 0)
+      tchecker::dbm::fixed::reset_to_clock<DIM>(dbm, lid, rid);
+    else
+      tchecker::dbm::fixed::reset_to_sum<DIM>(dbm, lid, rid, r.value());
+  }
+}
+
+/*!
+ \brief Open up (delay)
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \pre see tchecker::dbm::open_up
+ \post see tchecker::dbm::open_up
+ */
+template <tchecker::clock_id_t DIM> void open_up(tchecker::dbm::db_t * dbm)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+
+  for (tchecker::clock_id_t i = 1; i < DIM; ++i)
+    dbm[i * DIM] = tchecker::dbm::LT_INFINITY;
+
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+}
+
+/*!
+ \brief Checks inclusion w.r.t. abstraction aLU
+ \tparam DIM : dimension of DBMs
+ \param dbm1 : a DBM
+ \param dbm2 : a DBM
+ \param l : clock lower bounds for clocks 1 to DIM-1
+ \param u : clock upper bounds for clocks 1 to DIM-1
+ \pre see tchecker::dbm::is_alu_le
+ \return see tchecker::dbm::is_alu_le
+ */
+template <tchecker::clock_id_t DIM>
+bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::integer_t const * l,
+               tchecker::integer_t const * u)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm1, DIM));
+  assert(tchecker::dbm::is_consistent(dbm2, DIM));
+  assert(tchecker::dbm::is_positive(dbm1, DIM));
+  assert(tchecker::dbm::is_positive(dbm2, DIM));
+  assert(tchecker::dbm::is_tight(dbm1, DIM));
+  assert(tchecker::dbm::is_tight(dbm2, DIM));
+
+  // see tchecker::dbm::is_alu_le, U(0) = L(0) = 0
+  for (tchecker::clock_id_t x = 0; x < DIM; ++x) {
+    tchecker::integer_t Ux = (x == 0 ? 0 : u[x - 1]);
+    assert(Ux < tchecker::dbm::INF_VALUE);
+
+    if (Ux == -tchecker::dbm::INF_VALUE)
+      continue;
+
+    if (dbm1[x] < tchecker::dbm::db(tchecker::dbm::LE, -Ux))
+      continue;
+
+    for (tchecker::clock_id_t y = 0; y < DIM; ++y) {
+      tchecker::integer_t Ly = (y == 0 ? 0 : l[y - 1]);
+      assert(Ly < tchecker::dbm::INF_VALUE);
+
+      if (x == y)
+        continue;
+
+      if (Ly == -tchecker::dbm::INF_VALUE)
+        continue;
+
+      tchecker::dbm::db_t const dbm1_yx = dbm1[y * DIM + x];
+      tchecker::dbm::db_t const dbm2_yx = dbm2[y * DIM + x];
+      if (dbm2_yx < dbm1_yx && tchecker::dbm::sum(dbm2_yx, tchecker::dbm::db(tchecker::dbm::LT, -Ly)) < dbm1[x])
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/*!
+ \brief ExtraLU+ extrapolation
+ \tparam DIM : dimension of DBMs
+ \param dbm : a DBM
+ \param l : clock lower bounds for clocks 1 to DIM-1
+ \param u : clock upper bounds for clocks 1 to DIM-1
+ \pre see tchecker::dbm::extra_lu_plus
+ \post see tchecker::dbm::extra_lu_plus
+ */
+template <tchecker::clock_id_t DIM>
+void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::integer_t const * l, tchecker::integer_t const * u)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_positive(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+
+  bool modified = false;
+
+  // see tchecker::dbm::extra_lu_plus, the first row is modified last
+  for (tchecker::clock_id_t i = 1; i < DIM; ++i) {
+    tchecker::dbm::db_t * dbm_i = dbm + i * DIM;
+    tchecker::integer_t const Li = l[i - 1];
+    assert(Li < tchecker::dbm::INF_VALUE);
+    assert(u[i - 1] < tchecker::dbm::INF_VALUE);
+
+    if (-tchecker::dbm::value(dbm[i]) > Li) {
+      for (tchecker::clock_id_t j = 0; j < DIM; ++j) {
+        if (i == j || dbm_i[j] == tchecker::dbm::LT_INFINITY)
+          continue;
+        dbm_i[j] = tchecker::dbm::LT_INFINITY;
+        modified = true;
+      }
+    }
+    else {
+      for (tchecker::clock_id_t j = 0; j < DIM; ++j) {
+        tchecker::integer_t const Uj = (j == 0 ? 0 : u[j - 1]);
+        if (i == j || dbm_i[j] == tchecker::dbm::LT_INFINITY)
+          continue;
+        if (tchecker::dbm::value(dbm_i[j]) > Li || -tchecker::dbm::value(dbm[j]) > Uj) {
+          dbm_i[j] = tchecker::dbm::LT_INFINITY;
+          modified = true;
+        }
+      }
+    }
+  }
+
+  for (tchecker::clock_id_t j = 1; j < DIM; ++j) {
+    tchecker::integer_t const Uj = u[j - 1];
+    if (-tchecker::dbm::value(dbm[j]) > Uj) {
+      dbm[j] = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LE_ZERO : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
+      modified = true;
+    }
+  }
+
+  if (modified)
+    tchecker::dbm::fixed::tighten<DIM>(dbm);
+
+  assert(tchecker::dbm::is_consistent(dbm, DIM));
+  assert(tchecker::dbm::is_positive(dbm, DIM));
+  assert(tchecker::dbm::is_tight(dbm, DIM));
+}
+
+} // end of namespace fixed
+
+/*!
+ \brief Largest dimension with specialized operations (i.e. 8 clocks, plus
+ the zero clock)
+ */
+tchecker::clock_id_t const FIXED_DIM_MAX = 9;
+
+/*!
+ \class operations_t
+ \brief Set of DBM operations for a given dimension
+ \note The operations have the same signatures as the corresponding functions
+ in tchecker/dbm/dbm.hh. Operations specialized for a dimension require that
+ they are called with that dimension (checked by assertion)
+ */
+struct operations_t {
+  tchecker::clock_id_t dim; /*!< Dimension of specialized operations, 0 for generic operations */
+  enum tchecker::dbm::status_t (*tighten)(tchecker::dbm::db_t *, tchecker::clock_id_t); /*!< See tchecker::dbm::tighten */
+  enum tchecker::dbm::status_t (*constrain)(
+      tchecker::dbm::db_t *, tchecker::clock_id_t,
+      tchecker::clock_constraint_container_t const &); /*!< See tchecker::dbm::constrain */
+  void (*reset)(tchecker::dbm::db_t *, tchecker::clock_id_t,
+                tchecker::clock_reset_container_t const &); /*!< See tchecker::dbm::reset */
+  void (*open_up)(tchecker::dbm::db_t *, tchecker::clock_id_t); /*!< See tchecker::dbm::open_up */
+  bool (*is_le)(tchecker::dbm::db_t const *, tchecker::dbm::db_t const *,
+                tchecker::clock_id_t); /*!< See tchecker::dbm::is_le */
+  bool (*is_alu_le)(tchecker::dbm::db_t const *, tchecker::dbm::db_t const *, tchecker::clock_id_t,
+                    tchecker::integer_t const *, tchecker::integer_t const *); /*!< See tchecker::dbm::is_alu_le */
+  void (*extra_lu_plus)(tchecker::dbm::db_t *, tchecker::clock_id_t, tchecker::integer_t const *,
+                        tchecker::integer_t const *); /*!< See tchecker::dbm::extra_lu_plus */
+};
+
+/*!
+ \brief Accessor
+ \param dim : dimension of DBMs
+ \return the operations specialized for dimension dim if 1 <= dim <=
+ tchecker::dbm::FIXED_DIM_MAX, the generic operations from tchecker/dbm/dbm.hh
+ otherwise
+ */
+tchecker::dbm::operations_t const & operations(tchecker::clock_id_t dim);
+
+/*!
+ \brief Accessor
+ \return the generic operations from tchecker/dbm/dbm.hh
+ */
+tchecker::dbm::operations_t const & generic_operations();
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_OPERATIONS_HH
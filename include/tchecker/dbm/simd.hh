@@ -0,0 +1,205 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_SIMD_HH
+#define TCHECKER_DBM_SIMD_HH
+
+#include <cstddef>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/variables/clocks.hh"
+
+/*!
+ \file simd.hh
+ \brief Vectorized kernels for DBM operations
+ \note Kernels are implemented for several instruction sets. The best
+ instruction set supported by the CPU is selected when the program starts, the
+ scalar kernels are used as a fallback and as a reference implementation.
+ Vectorized kernels are only available on x86 CPUs, and when
+ tchecker::dbm::db_t is a 32-bits integer
+ \note Kernels do not check their preconditions: they are called by the
+ operations in tchecker/dbm/dbm.hh which do
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+/*!
+ \brief Type of instruction sets
+ */
+enum instruction_set_t {
+  SCALAR, /*!< No vectorization */
+  SSE42,  /*!< SSE up to version 4.2 (128-bits vectors) */
+  AVX2,   /*!< AVX2 (256-bits vectors) */
+};
+
+/*!
+ \brief Check if an instruction set is supported
+ \param is : an instruction set
+ \return true if kernels for is have been compiled and is is supported by the
+ CPU, false otherwise
+ */
+bool is_supported(enum tchecker::dbm::simd::instruction_set_t is);
+
+/*!
+ \brief Accessor
+ \return the best instruction set supported by the CPU
+ */
+enum tchecker::dbm::simd::instruction_set_t best_instruction_set();
+
+/*!
+ \brief Accessor
+ \return the instruction set of the selected kernels
+ */
+enum tchecker::dbm::simd::instruction_set_t instruction_set();
+
+/*!
+ \brief Select kernels
+ \param is : an instruction set
+ \post the kernels for instruction set is have been selected
+ \throw std::invalid_argument : if is is not supported
+ \note this function is not thread-safe: it should not be called while DBMs are
+ being computed by other threads
+ */
+void select(enum tchecker::dbm::simd::instruction_set_t is);
+
+/*!
+ \brief Instruction set name
+ \param is : an instruction set
+ \return name of is
+ */
+char const * name(enum tchecker::dbm::simd::instruction_set_t is);
+
+namespace details {
+
+/*!
+ \class kernels_t
+ \brief Table of kernels for an instruction set
+ */
+struct kernels_t {
+  enum tchecker::dbm::simd::instruction_set_t instruction_set; /*!< Instruction set */
+  bool (*is_equal)(tchecker::dbm::db_t const *, tchecker::dbm::db_t const *, std::size_t); /*!< See simd::is_equal */
+  bool (*is_le)(tchecker::dbm::db_t const *, tchecker::dbm::db_t const *, std::size_t);    /*!< See simd::is_le */
+  void (*min)(tchecker::dbm::db_t *, tchecker::dbm::db_t const *, tchecker::dbm::db_t const *,
+              std::size_t); /*!< See simd::min */
+  void (*tighten_row)(tchecker::dbm::db_t *, tchecker::dbm::db_t const *, tchecker::dbm::db_t, tchecker::clock_id_t,
+                      tchecker::clock_id_t); /*!< See simd::tighten_row */
+  bool (*extra_lu)(tchecker::dbm::db_t *, tchecker::clock_id_t, tchecker::integer_t const *,
+                   tchecker::integer_t const *); /*!< See simd::extra_lu */
+  bool (*extra_lu_plus)(tchecker::dbm::db_t *, tchecker::clock_id_t, tchecker::integer_t const *,
+                        tchecker::integer_t const *); /*!< See simd::extra_lu_plus */
+};
+
+/*!
+ \brief Selected kernels
+ */
+extern tchecker::dbm::simd::details::kernels_t const * kernels;
+
+} // end of namespace details
+
+/*!
+ \brief Equality of arrays of difference bounds
+ \param dbm1 : an array of difference bounds
+ \param dbm2 : an array of difference bounds
+ \param size : size of dbm1 and dbm2
+ \return true if dbm1[k] == dbm2[k] for all 0 <= k < size, false otherwise
+ */
+inline bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, std::size_t size)
+{
+  return tchecker::dbm::simd::details::kernels->is_equal(dbm1, dbm2, size);
+}
+
+/*!
+ \brief Less-than-or-equal-to predicate on arrays of difference bounds
+ \param dbm1 : an array of difference bounds
+ \param dbm2 : an array of difference bounds
+ \param size : size of dbm1 and dbm2
+ \return true if dbm1[k] <= dbm2[k] for all 0 <= k < size, false otherwise
+ */
+inline bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, std::size_t size)
+{
+  return tchecker::dbm::simd::details::kernels->is_le(dbm1, dbm2, size);
+}
+
+/*!
+ \brief Minimum of arrays of difference bounds
+ \param dbm : an array of difference bounds
+ \param dbm1 : an array of difference bounds
+ \param dbm2 : an array of difference bounds
+ \param size : size of dbm, dbm1 and dbm2
+ \post dbm[k] = min(dbm1[k], dbm2[k]) for all 0 <= k < size
+ \note dbm may be equal to dbm1 or dbm2
+ */
+inline void min(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                std::size_t size)
+{
+  tchecker::dbm::simd::details::kernels->min(dbm, dbm1, dbm2, size);
+}
+
+/*!
+ \brief Tightening of a row of a DBM w.r.t. a pivot clock
+ \param row : row i of a DBM
+ \param rowk : row k of the same DBM
+ \param dik : difference bound (i,k)
+ \param jbegin : first column
+ \param jend : past-the-end column
+ \pre row and rowk are either equal or disjoint, and dik is not stored in
+ row[jbegin..jend)
+ \post row[j] = min(row[j], dik + rowk[j]) for all jbegin <= j < jend
+ \throw std::invalid_argument : if a sum cannot be represented as a
+ tchecker::dbm::db_t (only if compilation flag DBM_UNSAFE is not set). Then,
+ row has been updated in the same way as by a scalar loop over j
+ */
+inline void tighten_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * rowk, tchecker::dbm::db_t dik,
+                        tchecker::clock_id_t jbegin, tchecker::clock_id_t jend)
+{
+  tchecker::dbm::simd::details::kernels->tighten_row(row, rowk, dik, jbegin, jend);
+}
+
+/*!
+ \brief ExtraLU extrapolation, without tightening
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param l : clock lower bounds for clocks 1 to dim-1
+ \param u : clock upper bounds for clocks 1 to dim-1
+ \pre see tchecker::dbm::extra_lu
+ \post the difference bounds in dbm have been extrapolated w.r.t. l and u
+ \return true if dbm has been modified, false otherwise
+ */
+inline bool extra_lu(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                     tchecker::integer_t const * u)
+{
+  return tchecker::dbm::simd::details::kernels->extra_lu(dbm, dim, l, u);
+}
+
+/*!
+ \brief ExtraLU+ extrapolation, without tightening
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param l : clock lower bounds for clocks 1 to dim-1
+ \param u : clock upper bounds for clocks 1 to dim-1
+ \pre see tchecker::dbm::extra_lu_plus
+ \post the difference bounds in dbm have been extrapolated w.r.t. l and u
+ \return true if dbm has been modified, false otherwise
+ */
+inline bool extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                          tchecker::integer_t const * u)
+{
+  return tchecker::dbm::simd::details::kernels->extra_lu_plus(dbm, dim, l, u);
+}
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_SIMD_HH
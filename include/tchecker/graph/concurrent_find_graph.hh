@@ -0,0 +1,361 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_CONCURRENT_FIND_GRAPH_HH
+#define TCHECKER_CONCURRENT_FIND_GRAPH_HH
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+
+/*!
+ \file concurrent_find_graph.hh
+ \brief Graph with concurrent node finding
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+namespace concurrent_find {
+
+/*!
+ \class graph_t
+ \brief Graph with node finding that can be accessed concurrently
+ \tparam NODE : type of node
+ \tparam HASH : hash function on NODE (see std::hash)
+ \tparam EQUAL : equality function on NODE (see std::equal_to)
+ \note this graph implementation stores pointers to nodes and answers
+ find-or-insert queries. It does not store edges, and it does not own nodes:
+ nodes should outlive the graph
+ \note each node has a unique instance in this graph w.r.t. EQUAL
+ \note the graph is an open-addressing hash table with linear probing. Slots
+ are updated with compare-and-swap, hence add_node() is lock-free, except while
+ the table is being resized. Resizing is cooperative: the thread that detects
+ that the table is too full allocates a bigger table, then all the threads that
+ access the graph migrate chunks of slots until the old table has been entirely
+ moved to the new one. Old tables are released when the graph is destroyed
+ */
+template <class NODE, class HASH, class EQUAL> class graph_t {
+public:
+  /*!
+   \brief Type of nodes
+   */
+  using node_t = NODE;
+
+  /*!
+   \brief Type of hash function
+   */
+  using hash_t = HASH;
+
+  /*!
+   \brief Type of equality predicate
+   */
+  using equal_t = EQUAL;
+
+  /*!
+   \brief Constructor
+   \param table_size : initial size of hash table
+   \param hash : hash function
+   \param equal : equality predicate
+   \note table_size is rounded up to the next power of 2
+   */
+  graph_t(std::size_t table_size = 65536, HASH const & hash = HASH(), EQUAL const & equal = EQUAL())
+      : _table(new table_t(round_capacity(table_size), nullptr)), _hash(hash), _equal(equal)
+  {
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  graph_t(tchecker::graph::concurrent_find::graph_t<NODE, HASH, EQUAL> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  graph_t(tchecker::graph::concurrent_find::graph_t<NODE, HASH, EQUAL> &&) = delete;
+
+  /*!
+   \brief Destructor
+   \note No destructor call on nodes
+   */
+  ~graph_t()
+  {
+    table_t * table = _table.load();
+    while (table != nullptr) {
+      table_t * previous = table->previous;
+      delete table;
+      table = previous;
+    }
+  }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::concurrent_find::graph_t<NODE, HASH, EQUAL> &
+  operator=(tchecker::graph::concurrent_find::graph_t<NODE, HASH, EQUAL> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::concurrent_find::graph_t<NODE, HASH, EQUAL> &
+  operator=(tchecker::graph::concurrent_find::graph_t<NODE, HASH, EQUAL> &&) = delete;
+
+  /*!
+   \brief Add node
+   \param n : a node
+   \pre n is not nullptr
+   \post n has been added to the graph unless it already contains an equivalent
+   node w.r.t. HASH and EQUAL
+   \return (true, n) if n has been added to the graph, (false, m) otherwise
+   where m is the node in the graph that is equivalent to n
+   \note thread-safe
+   */
+  std::tuple<bool, NODE const *> add_node(NODE const * n)
+  {
+    std::size_t const h = _hash(*n);
+    while (true) {
+      table_t * table = current_table();
+      std::size_t const mask = table->capacity - 1;
+      std::size_t probes = 0;
+      for (std::size_t i = h & mask; probes < table->capacity; i = (i + 1) & mask, ++probes) {
+        NODE const * m = table->slots[i].load(std::memory_order_acquire);
+        if (m == nullptr) {
+          if (!table->slots[i].compare_exchange_strong(m, n, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            if (m == moved())
+              break;
+            if (_equal(*m, *n))
+              return std::make_tuple(false, m);
+            continue;
+          }
+          if (++table->size * 4 > table->capacity * 3)
+            grow(table);
+          return std::make_tuple(true, n);
+        }
+        if (m == moved())
+          break;
+        if (_equal(*m, *n))
+          return std::make_tuple(false, m);
+      }
+      // the table is full or being migrated
+      grow(table);
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return the node in the graph equivalent to n w.r.t. HASH and EQUAL if any,
+   nullptr otherwise
+   \note thread-safe
+   */
+  NODE const * find(NODE const & n)
+  {
+    std::size_t const h = _hash(n);
+    while (true) {
+      table_t * table = current_table();
+      std::size_t const mask = table->capacity - 1;
+      std::size_t probes = 0;
+      bool retry = false;
+      for (std::size_t i = h & mask; probes < table->capacity; i = (i + 1) & mask, ++probes) {
+        NODE const * m = table->slots[i].load(std::memory_order_acquire);
+        if (m == nullptr)
+          return nullptr;
+        if (m == moved()) {
+          retry = true;
+          break;
+        }
+        if (_equal(*m, n))
+          return m;
+      }
+      if (!retry)
+        return nullptr;
+      grow(table);
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \return number of nodes in the graph
+   \note the value may be outdated if nodes are concurrently added
+   */
+  std::size_t size() const { return current_table_const()->size.load(); }
+
+  /*!
+   \brief Accessor
+   \return capacity of the current hash table
+   */
+  std::size_t capacity() const { return current_table_const()->capacity; }
+
+private:
+  /*!
+   \brief Number of slots migrated at once by a thread
+   */
+  static constexpr std::size_t MIGRATION_CHUNK = 1024;
+
+  /*!
+   \class table_t
+   \brief Hash table of node pointers
+   */
+  class table_t {
+  public:
+    /*!
+     \brief Constructor
+     \param capacity : number of slots
+     \param previous : table being migrated to this table
+     \pre capacity is a power of 2
+     */
+    table_t(std::size_t capacity, table_t * previous)
+        : capacity(capacity), slots(new std::atomic<NODE const *>[capacity]), size(0), next(nullptr), previous(previous),
+          migration_index(0), migrated(0)
+    {
+      for (std::size_t i = 0; i < capacity; ++i)
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    /*!
+     \brief Destructor
+     */
+    ~table_t() { delete[] slots; }
+
+    std::size_t const capacity;               /*!< Number of slots */
+    std::atomic<NODE const *> * const slots;  /*!< Slots */
+    std::atomic<std::size_t> size;            /*!< Number of nodes */
+    std::atomic<table_t *> next;              /*!< Bigger table (when migrating) */
+    table_t * const previous;                 /*!< Smaller table (migrated) */
+    std::atomic<std::size_t> migration_index; /*!< First slot not claimed for migration */
+    std::atomic<std::size_t> migrated;        /*!< Number of migrated slots */
+  };
+
+  /*!
+   \brief Marker of migrated slots
+   \return a pointer that is distinct from all nodes
+   */
+  static NODE const * moved()
+  {
+    static char marker;
+    return reinterpret_cast<NODE const *>(&marker);
+  }
+
+  /*!
+   \brief Round a capacity
+   \param capacity : a capacity
+   \return smallest power of 2 greater than or equal to capacity (and to 2)
+   */
+  static std::size_t round_capacity(std::size_t capacity)
+  {
+    std::size_t c = 2;
+    while (c < capacity)
+      c <<= 1;
+    return c;
+  }
+
+  /*!
+   \brief Accessor
+   \return current table, after completion of any pending migration
+   */
+  table_t * current_table()
+  {
+    table_t * table = _table.load(std::memory_order_acquire);
+    table_t * next = table->next.load(std::memory_order_acquire);
+    while (next != nullptr) {
+      migrate(table, next);
+      table = _table.load(std::memory_order_acquire);
+      next = table->next.load(std::memory_order_acquire);
+    }
+    return table;
+  }
+
+  /*!
+   \brief Accessor
+   \return current table
+   */
+  table_t const * current_table_const() const { return _table.load(std::memory_order_acquire); }
+
+  /*!
+   \brief Grow a table
+   \param table : a table
+   \post table has been migrated to a bigger table
+   */
+  void grow(table_t * table)
+  {
+    table_t * next = table->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      table_t * bigger = new table_t(2 * table->capacity, table);
+      if (table->next.compare_exchange_strong(next, bigger, std::memory_order_acq_rel, std::memory_order_acquire))
+        next = bigger;
+      else
+        delete bigger;
+    }
+    migrate(table, next);
+  }
+
+  /*!
+   \brief Migrate a table
+   \param table : a table
+   \param next : bigger table
+   \pre next is table->next
+   \post all the slots in table have been migrated to next, and next is the
+   current table
+   \note this thread migrates chunks of slots until all slots have been claimed,
+   then it waits for the other threads to complete their chunks
+   */
+  void migrate(table_t * table, table_t * next)
+  {
+    while (true) {
+      std::size_t first = table->migration_index.fetch_add(MIGRATION_CHUNK);
+      if (first >= table->capacity)
+        break;
+      std::size_t last = std::min(first + MIGRATION_CHUNK, table->capacity);
+      for (std::size_t i = first; i < last; ++i) {
+        NODE const * m = table->slots[i].exchange(moved(), std::memory_order_acq_rel);
+        if (m != nullptr)
+          insert_migrated(next, m);
+      }
+      table->migrated.fetch_add(last - first, std::memory_order_acq_rel);
+    }
+
+    while (table->migrated.load(std::memory_order_acquire) < table->capacity)
+      std::this_thread::yield();
+
+    table_t * expected = table;
+    _table.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+
+  /*!
+   \brief Insert a migrated node
+   \param table : a table
+   \param n : a node
+   \pre no node equivalent to n is stored in table, and table is not full
+   \post n has been stored in table
+   */
+  void insert_migrated(table_t * table, NODE const * n)
+  {
+    std::size_t const mask = table->capacity - 1;
+    for (std::size_t i = _hash(*n) & mask;; i = (i + 1) & mask) {
+      NODE const * m = nullptr;
+      if (table->slots[i].compare_exchange_strong(m, n, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        ++table->size;
+        return;
+      }
+    }
+  }
+
+  std::atomic<table_t *> _table; /*!< Current table */
+  HASH _hash;                    /*!< Hash function */
+  EQUAL _equal;                  /*!< Equality predicate */
+};
+
+} // end of namespace concurrent_find
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_CONCURRENT_FIND_GRAPH_HH
@@ -8,7 +8,10 @@
 #ifndef TCHECKER_COVER_GRAPH_HH
 #define TCHECKER_COVER_GRAPH_HH
 
+#include <cassert>
 #include <functional>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include "tchecker/utils/iterator.hh"
@@ -25,7 +28,7 @@ namespace graph {
 namespace cover {
 
 // Forward declarations
-template <class NODE_PTR, class NODE_HASH, class NODE_LE> class graph_t;
+template <class NODE_PTR, class NODE_HASH, class NODE_LE, class NODE_SUMMARY> class graph_t;
 
 /*!
  \brief Type of node position in the node container
@@ -41,9 +44,9 @@ extern tchecker::graph::cover::node_position_t const NOT_STORED;
  \class node_t
  \brief Node in a cover graph
  \note Stores the position of the node in the implementation of the graph for
- fast removal. The graph is implemented as a table of containers of nodes. The
- node stores two positions: its position in the table, and its position in the
- container of nodes
+ fast removal. The graph is implemented as a table of containers (groups) of
+ nodes. The node stores two positions: its position in the table, and its
+ position in the container of nodes
  */
 class node_t {
 public:
@@ -81,7 +84,7 @@ public:
   tchecker::graph::cover::node_t & operator=(tchecker::graph::cover::node_t &) = default;
 
 private:
-  template <class NODE_PTR, class NODE_HASH, class NODE_LE> friend class tchecker::graph::cover::graph_t;
+  template <class NODE_PTR, class NODE_HASH, class NODE_LE, class NODE_SUMMARY> friend class tchecker::graph::cover::graph_t;
 
   /*!
    \brief Accessor
@@ -124,6 +127,32 @@ private:
   node_position_t _position_in_container; /*!< Position in the node container */
 };
 
+/*!
+ \class no_summary_t
+ \brief Trivial node summary: every node is a candidate for covering
+ \note Models the NODE_SUMMARY parameter of tchecker::graph::cover::graph_t
+ */
+class no_summary_t {
+public:
+  /*!
+   \brief Type of summaries
+   */
+  struct summary_t {
+  };
+
+  /*!
+   \brief Summary of a node
+   \return the trivial summary
+   */
+  template <class NODE_PTR> inline summary_t operator()(NODE_PTR const &) const { return summary_t{}; }
+
+  /*!
+   \brief Less-than-or-equal-to predicate on summaries
+   \return true
+   */
+  inline bool le(summary_t const &, summary_t const &) const { return true; }
+};
+
 /*!
  \class graph_t
  \brief Graph with node covering
@@ -134,17 +163,37 @@ private:
  \tparam NODE_LE : less-than-or-equal predicate on nodes. Should be callable
  with two NODE_PTR argument and return true if the first one is smaller than the
  second one, and false otherwise
+ \tparam NODE_SUMMARY : summary of nodes. Should define a type summary_t, be
+ callable with a NODE_PTR argument and return the summary of the pointed node,
+ and have a method le(s1, s2) on summaries such that NODE_LE(n1, n2) implies
+ le(summary(n1), summary(n2))
  \note This graph allows to check if there is a node in the graph that covers
  some given node. Nodes are compared using NODE_LE. Only the nodes with the same
- hash value w.r.t. NODE_HASH are compared
+ hash value w.r.t. NODE_HASH are compared.
+ Nodes are grouped by hash value, hence NODE_HASH should only depend on the
+ part of the nodes that must be equal for covering (e.g. the discrete part of
+ states). A group is removed when its last node is removed. Each group stores the summaries of its nodes in a separate container,
+ which is scanned first: NODE_LE is only called on nodes with comparable
+ summaries
  */
-template <class NODE_PTR, class NODE_HASH, class NODE_LE> class graph_t {
+template <class NODE_PTR, class NODE_HASH, class NODE_LE, class NODE_SUMMARY = tchecker::graph::cover::no_summary_t>
+class graph_t {
 private:
   /*!
    \brief Type of node container
    */
   using nodes_container_t = std::vector<NODE_PTR>;
 
+  /*!
+   \brief Type of node summaries
+   */
+  using summary_t = typename NODE_SUMMARY::summary_t;
+
+  /*!
+   \brief Type of summaries container
+   */
+  using summaries_container_t = std::vector<summary_t>;
+
 public:
   /*!
    \brief Type of node pointer
@@ -153,28 +202,31 @@ public:
 
   /*!
    \brief Constructor
-   \param table_size : size of the hash table of node containers
+   \param table_size : expected number of groups of nodes (i.e. of distinct
+   hash values)
    \param node_hash : hash function
    \param node_le : covering predicate on nodes
+   \param node_summary : summary of nodes
    \pre table_size should be less than tchecker::graph::cover::NOT_STORED
    \throw std::invalid_argument : if the precondition is violated
    */
-  graph_t(std::size_t table_size, NODE_HASH node_hash, NODE_LE node_le)
-      : _nodes(table_size), _node_hash(node_hash), _node_le(node_le), _size(0)
+  graph_t(std::size_t table_size, NODE_HASH node_hash, NODE_LE node_le, NODE_SUMMARY node_summary = NODE_SUMMARY())
+      : _node_hash(node_hash), _node_le(node_le), _node_summary(node_summary), _size(0)
   {
     if (table_size >= tchecker::graph::cover::NOT_STORED)
       throw std::invalid_argument("Table size is too big");
+    _groups.reserve(table_size);
   }
 
   /*!
    \brief Copy constructor (deleted)
    */
-  graph_t(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE> const &) = delete;
+  graph_t(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE, NODE_SUMMARY> const &) = delete;
 
   /*!
    \brief Move constructor
    */
-  graph_t(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE> &&) = default;
+  graph_t(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE, NODE_SUMMARY> &&) = default;
 
   /*!
    \brief Destructor
@@ -184,14 +236,14 @@ public:
   /*!
    \brief Assignment operator (deleted)
    */
-  tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE> const &) = default;
+  tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE, NODE_SUMMARY> &
+  operator=(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE, NODE_SUMMARY> const &) = delete;
 
   /*!
    \brief Move-assignment operator
    */
-  tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE> &&) = default;
+  tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE, NODE_SUMMARY> &
+  operator=(tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE, NODE_SUMMARY> &&) = default;
 
   /*!
    \brief Clear
@@ -204,6 +256,8 @@ public:
     for (auto & container : _nodes)
       clear(container);
     _nodes.clear();
+    _summaries.clear();
+    _groups.clear();
     _size = 0;
   }
 
@@ -213,15 +267,18 @@ public:
    \pre n is not stored in a graph
    \post n has been added to the graph
    \throw std::invalid_argument : if n is already stored in a graph
-   \note Complexity : computation of the hash value of node n
+   \throw std::overflow_error : if the maximal number of groups of nodes has
+   been reached
+   \note Complexity : computation of the hash value and of the summary of node n
    \note Invalidates iterators
    */
   void add_node(NODE_PTR const & n)
   {
     if (n->is_stored())
       throw std::invalid_argument("Adding a node that is already stored is not allowed");
-    tchecker::graph::cover::node_position_t position_in_table = compute_position_in_table(n);
-    tchecker::graph::cover::node_position_t position_in_container = add_node(n, _nodes[position_in_table]);
+    tchecker::graph::cover::node_position_t position_in_table = find_else_add_group(n);
+    tchecker::graph::cover::node_position_t position_in_container =
+        add_node(n, _nodes[position_in_table], _summaries[position_in_table]);
     n->set_position(position_in_table, position_in_container);
     ++_size;
   }
@@ -230,9 +287,11 @@ public:
    \brief Remove node from the graph
    \param n : a node
    \pre n is stored in this graph
-   \post n has been removed from this graph
+   \post n has been removed from this graph. The group of n has been removed if
+   it has become empty
    \throw std::invalid_argument : if n is not stored in this graph
-   \note Contant-time complexity
+   \note Constant-time complexity, plus the size of the last group in the table
+   when the group of n is removed
    \note Invalidates iterators
    */
   void remove_node(NODE_PTR const & n)
@@ -242,9 +301,11 @@ public:
     tchecker::graph::cover::node_position_t position_in_table = n->position_in_table();
     if (position_in_table >= _nodes.size())
       throw std::invalid_argument("Removing a node which is not stored in this graph");
-    remove_node(n, _nodes[position_in_table]);
+    remove_node(n, _nodes[position_in_table], _summaries[position_in_table]);
     n->clear_position();
     --_size;
+    if (_nodes[position_in_table].empty())
+      remove_group(position_in_table, _node_hash(n));
   }
 
   /*!
@@ -260,8 +321,41 @@ public:
    */
   bool is_covered(NODE_PTR const & n, NODE_PTR & covering_node) const
   {
-    tchecker::graph::cover::node_position_t position_in_table = compute_position_in_table(n);
-    return is_covered(n, _nodes[position_in_table], covering_node);
+    tchecker::graph::cover::node_position_t position_in_table = find_group(n);
+    if (position_in_table == tchecker::graph::cover::NOT_STORED) {
+      covering_node = nullptr;
+      return false;
+    }
+    return is_covered(n, _nodes[position_in_table], _summaries[position_in_table], covering_node);
+  }
+
+  /*!
+   \brief Check if a candidate node is covered in the graph
+   \tparam NODE : type of candidate node, should be accepted as first argument
+   by NODE_HASH, NODE_LE and NODE_SUMMARY
+   \param n : a candidate node, not stored in the graph
+   \param covering_node : a node
+   \post covering_node is such that NODE_LE(n, covering_node) is true if such
+   node exists in the graph, nullptr otherwise
+   \return true if if a covering node has been found for n, false otherwise
+   \note this allows to check covering before a node is allocated for n
+   */
+  template <class NODE> bool is_covered_candidate(NODE const & n, NODE_PTR & covering_node) const
+  {
+    auto it = _groups.find(_node_hash(n));
+    if (it != _groups.end()) {
+      nodes_container_t const & c = _nodes[it->second];
+      summaries_container_t const & s = _summaries[it->second];
+      auto const n_summary = _node_summary(n);
+      for (std::size_t i = 0; i < c.size(); ++i) {
+        if (_node_summary.le(n_summary, s[i]) && _node_le(n, c[i])) {
+          covering_node = c[i];
+          return true;
+        }
+      }
+    }
+    covering_node = nullptr;
+    return false;
   }
 
   /*!
@@ -274,8 +368,10 @@ public:
    */
   template <class INSERTER> void covered_nodes(NODE_PTR const & n, INSERTER & ins) const
   {
-    tchecker::graph::cover::node_position_t position_in_table = compute_position_in_table(n);
-    covered_nodes(n, _nodes[position_in_table], ins);
+    tchecker::graph::cover::node_position_t position_in_table = find_group(n);
+    if (position_in_table == tchecker::graph::cover::NOT_STORED)
+      return;
+    covered_nodes(n, _nodes[position_in_table], _summaries[position_in_table], ins);
   }
 
   /*!
@@ -284,6 +380,13 @@ public:
    */
   inline std::size_t size() const { return _size; }
 
+  /*!
+   \brief Accessor
+   \return Number of groups of nodes in this graph (i.e. of distinct hash
+   values of nodes)
+   */
+  inline std::size_t groups_count() const { return _nodes.size(); }
+
   /*!
    \brief Type of iterator over the nodes in the graph
    */
@@ -294,40 +397,79 @@ public:
    \brief Accessor
    \return Iterator pointing to the first node in the graph, or past-the-end if the graph is empty
    */
-  tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::const_iterator_t begin() const
-  {
-    return tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::const_iterator_t(
-        _nodes.begin(), _nodes.end(), tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::nodes_container_range);
-  }
+  const_iterator_t begin() const { return const_iterator_t(_nodes.begin(), _nodes.end(), nodes_container_range); }
 
   /*!
    \brief Accessor
    \return Past-the-end iterator
    */
-  tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::const_iterator_t end() const
-  {
-    return tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::const_iterator_t(
-        _nodes.end(), _nodes.end(), tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::nodes_container_range);
-  }
+  const_iterator_t end() const { return const_iterator_t(_nodes.end(), _nodes.end(), nodes_container_range); }
 
   /*!
    \brief Accessor
    \return Range of nodes
   */
-  tchecker::range_t<tchecker::graph::cover::graph_t<NODE_PTR, NODE_HASH, NODE_LE>::const_iterator_t> nodes() const
+  tchecker::range_t<const_iterator_t> nodes() const { return tchecker::make_range(begin(), end()); }
+
+private:
+  /*!
+   \brief Find the group of a node
+   \param n : a node
+   \return The position in the table of the group of nodes with the same hash
+   value as n if any, tchecker::graph::cover::NOT_STORED otherwise
+  */
+  tchecker::graph::cover::node_position_t find_group(NODE_PTR const & n) const
   {
-    return tchecker::make_range(begin(), end());
+    auto it = _groups.find(_node_hash(n));
+    return (it == _groups.end() ? tchecker::graph::cover::NOT_STORED : it->second);
   }
 
-private:
   /*!
-   \brief Computes node position in table
+   \brief Find the group of a node, add it if needed
    \param n : a node
-   \return The position than n should have in the table of nodes
+   \return The position in the table of the group of nodes with the same hash
+   value as n
+   \post A new (empty) group has been added if no group of nodes had the same
+   hash value as n
+   \throw std::overflow_error : if the group cannot be added
+  */
+  tchecker::graph::cover::node_position_t find_else_add_group(NODE_PTR const & n)
+  {
+    auto && [it, is_new_group] = _groups.emplace(_node_hash(n), _nodes.size());
+    if (is_new_group) {
+      if (_nodes.size() >= tchecker::graph::cover::NOT_STORED) {
+        _groups.erase(it);
+        throw std::overflow_error("Too many groups of nodes");
+      }
+      _nodes.emplace_back();
+      _summaries.emplace_back();
+    }
+    return it->second;
+  }
+
+  /*!
+   \brief Remove an empty group
+   \param position_in_table : position of a group in the table
+   \param hash : hash value of the nodes in the group
+   \pre the group at position_in_table is empty
+   \post the group has been removed. The last group in the table has been moved
+   to position_in_table, and the positions of its nodes have been updated
+   \note Invalidates iterators
   */
-  inline tchecker::graph::cover::node_position_t compute_position_in_table(NODE_PTR const & n) const
+  void remove_group(tchecker::graph::cover::node_position_t position_in_table, std::size_t hash)
   {
-    return _node_hash(n) % _nodes.size();
+    assert(_nodes[position_in_table].empty());
+    _groups.erase(hash);
+    tchecker::graph::cover::node_position_t const last = _nodes.size() - 1;
+    if (position_in_table != last) {
+      _nodes[position_in_table].swap(_nodes[last]);
+      _summaries[position_in_table].swap(_summaries[last]);
+      for (NODE_PTR const & n : _nodes[position_in_table])
+        n->set_position(position_in_table, n->position_in_container());
+      _groups[_node_hash(_nodes[position_in_table].front())] = position_in_table;
+    }
+    _nodes.pop_back();
+    _summaries.pop_back();
   }
 
   /*!
@@ -348,12 +490,14 @@ private:
    \brief Add a node to a container
    \param n : a node
    \param c : a container
-   \post n has been added to c
+   \param s : summaries of the nodes in c
+   \post n has been added to c, and its summary has been added to s
    \return The position of node n in container c
   */
-  tchecker::graph::cover::node_position_t add_node(NODE_PTR const & n, nodes_container_t & c)
+  tchecker::graph::cover::node_position_t add_node(NODE_PTR const & n, nodes_container_t & c, summaries_container_t & s)
   {
     c.push_back(n);
+    s.push_back(_node_summary(n));
     return c.size() - 1;
   }
 
@@ -361,10 +505,11 @@ private:
    \brief Remove a node from a container
    \param n : a node
    \param c : a container
-   \post n has been removed from c
+   \param s : summaries of the nodes in c
+   \post n has been removed from c, and its summary has been removed from s
    \throw std::invalid_argument : if n is not stored in c
   */
-  void remove_node(NODE_PTR const & n, nodes_container_t & c)
+  void remove_node(NODE_PTR const & n, nodes_container_t & c, summaries_container_t & s)
   {
     tchecker::graph::cover::node_position_t position_in_container = n->position_in_container();
     if (position_in_container >= c.size() || c[position_in_container] != n)
@@ -373,12 +518,15 @@ private:
     back_node->set_position(back_node->position_in_table(), position_in_container);
     c[position_in_container] = back_node;
     c.pop_back();
+    s[position_in_container] = s.back();
+    s.pop_back();
   }
 
   /*!
    \brief Check if a node is covered in a node container
    \param n : a node
    \param c : a node container
+   \param s : summaries of the nodes in c
    \param covering_node : a node
    \post covering_node is such that NODE_LE(n, covering_node) is true if such
    node exists in the graph, nullptr otherwise
@@ -386,11 +534,13 @@ private:
    \note Only the nodes which have the same hash value than n w.r.t. HASH will
    be considered as potential covering nodes
    */
-  bool is_covered(NODE_PTR const & n, nodes_container_t const & c, NODE_PTR & covering_node) const
+  bool is_covered(NODE_PTR const & n, nodes_container_t const & c, summaries_container_t const & s,
+                  NODE_PTR & covering_node) const
   {
-    for (NODE_PTR const & node : c) {
-      if ((n != node) && _node_le(n, node)) {
-        covering_node = node;
+    summary_t const n_summary = _node_summary(n);
+    for (std::size_t i = 0; i < c.size(); ++i) {
+      if (_node_summary.le(n_summary, s[i]) && (n != c[i]) && _node_le(n, c[i])) {
+        covering_node = c[i];
         return true;
       }
     }
@@ -402,15 +552,18 @@ private:
    \brief Accessor to the nodes in a container that are covered by a given node
    \param n : a node
    \param c : a node container
+   \param s : summaries of the nodes in c
    \param ins : an inserter iterator that accepts NODE_PTR
    \post All the nodes in c that are smaller-than-or-equal-to n w.r.t. NODE_LE
    have been inserted using ins
    */
-  template <class INSERTER> void covered_nodes(NODE_PTR const & n, nodes_container_t const & c, INSERTER & ins) const
+  template <class INSERTER>
+  void covered_nodes(NODE_PTR const & n, nodes_container_t const & c, summaries_container_t const & s, INSERTER & ins) const
   {
-    for (NODE_PTR const & node : c)
-      if ((node != n) && _node_le(node, n))
-        ins = node;
+    summary_t const n_summary = _node_summary(n);
+    for (std::size_t i = 0; i < c.size(); ++i)
+      if (_node_summary.le(s[i], n_summary) && (c[i] != n) && _node_le(c[i], n))
+        ins = c[i];
   }
 
   /*!
@@ -425,10 +578,13 @@ private:
     return tchecker::make_range(it->begin(), it->end());
   }
 
-  std::vector<nodes_container_t> _nodes; /*!< Nodes */
-  NODE_HASH _node_hash;                  /*!< Hash function on nodes */
-  NODE_LE _node_le;                      /*!< Covering predicate on nodes */
-  std::size_t _size;                     /*!< Number of nodes */
+  std::vector<nodes_container_t> _nodes;                                            /*!< Groups of nodes */
+  std::vector<summaries_container_t> _summaries;                                    /*!< Summaries of nodes, by group */
+  std::unordered_map<std::size_t, tchecker::graph::cover::node_position_t> _groups; /*!< Map: hash value -> group */
+  NODE_HASH _node_hash;                                                             /*!< Hash function on nodes */
+  NODE_LE _node_le;                                                                 /*!< Covering predicate on nodes */
+  NODE_SUMMARY _node_summary;                                                       /*!< Summary of nodes */
+  std::size_t _size;                                                                /*!< Number of nodes */
 };
 
 } // end of namespace cover
@@ -34,7 +34,9 @@ namespace subsumption {
 // Forward declarations
 template <class NODE, class EDGE> class node_t;
 template <class NODE, class EDGE> class edge_t;
-template <class NODE, class EDGE, class NODE_HASH, class NODE_LE> class graph_t;
+template <class NODE, class EDGE, class NODE_HASH, class NODE_LE,
+          class NODE_SUMMARY = tchecker::graph::cover::no_summary_t>
+class graph_t;
 
 /*!
  \brief Type of shared node
@@ -126,7 +128,8 @@ public:
   }
 
 private:
-  template <class N, class E, class NODE_HASH, class NODE_LE> friend class tchecker::graph::subsumption::graph_t;
+  template <class N, class E, class NODE_HASH, class NODE_LE, class NODE_SUMMARY>
+  friend class tchecker::graph::subsumption::graph_t;
 
   /*!
    \brief Accessor
@@ -198,15 +201,21 @@ namespace subsumption {
  \tparam NODE_LE : covering predicate on nodes, should be callable with two
  parameters of type NODE const &, and return true is the first node is covered
  by the second one, false otherwise
+ \tparam NODE_SUMMARY : summary of nodes, should define a type summary_t, be
+ callable with a parameter of type NODE const & and return the summary of the
+ node, and have a method le(s1, s2) on summaries such that NODE_LE(n1, n2)
+ implies le(summary(n1), summary(n2)). Summaries are used to discard candidate
+ covering nodes without calling NODE_LE
  \note this graph allocates nodes of type
  tchecker::graph::subsumption::node_t<NODE, EDGE> and edges of type
  tchecker::graph::subsumption::edge_t<NODE, EDGE>
 */
-template <class NODE, class EDGE, class NODE_HASH, class NODE_LE> class graph_t {
+template <class NODE, class EDGE, class NODE_HASH, class NODE_LE, class NODE_SUMMARY> class graph_t {
 private:
   // Forward declarations
   class node_sptr_hash_t;
   class node_sptr_le_t;
+  class node_sptr_summary_t;
 
 public:
   /*!
@@ -255,22 +264,25 @@ public:
   \param table_size : size of hash table
   \param node_hash : hash function on nodes
   \param node_le : covering predicate on nodes
+  \param node_summary : summary of nodes
   */
-  graph_t(std::size_t block_size, std::size_t table_size, NODE_HASH const & node_hash, NODE_LE const & node_le)
-      : _node_sptr_hash(node_hash), _node_sptr_le(node_le), _cover_graph(table_size, _node_sptr_hash, _node_sptr_le),
-        _node_pool(block_size), _edge_pool(block_size)
+  graph_t(std::size_t block_size, std::size_t table_size, NODE_HASH const & node_hash, NODE_LE const & node_le,
+          NODE_SUMMARY const & node_summary = NODE_SUMMARY())
+      : _node_sptr_hash(node_hash), _node_sptr_le(node_le), _node_sptr_summary(node_summary),
+        _cover_graph(table_size, _node_sptr_hash, _node_sptr_le, _node_sptr_summary), _node_pool(block_size),
+        _edge_pool(block_size)
   {
   }
 
   /*!
   \brief Copy constructor (deleted)
   */
-  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> const &) = delete;
+  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> const &) = delete;
 
   /*!
   \brief Move constructor (deleted)
   */
-  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &&) = delete;
+  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &&) = delete;
 
   /*!
   \brief Destructor
@@ -280,14 +292,14 @@ public:
   /*!
   \brief Assignment operator (deleted)
   */
-  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> const &) = delete;
+  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &
+  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> const &) = delete;
 
   /*!
   \brief Move-assignment operator (deleted)
   */
-  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &&) = delete;
+  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &
+  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, NODE_SUMMARY> &&) = delete;
 
   /*!
   \brief Clear the graph
@@ -388,6 +400,21 @@ public:
     return _cover_graph.is_covered(n, covering_node);
   }
 
+  /*!
+   \brief Check if a candidate node is covered in this graph
+   \param n : a node, not stored in this graph
+   \param covering_node : a node
+   \post covering_node points to a node bigger-than-or-equal-to n w.r.t. NODE_LE
+   if any, nullptr otherwise
+   \return true if n is NODE_LE to some node in this graph with same hash value
+   than n w.r.t. NODE_HASH, false otherwise
+   \note this allows to check covering before a node is allocated for n
+   */
+  bool is_covered(NODE const & n, node_sptr_t & covering_node) const
+  {
+    return _cover_graph.is_covered_candidate(n, covering_node);
+  }
+
   /*!
    \brief Compute the nodes in the graph that are covered by a given node
    \param n : a node
@@ -401,6 +428,14 @@ public:
     _cover_graph.covered_nodes(n, ins);
   }
 
+  /*!
+   \brief Hash value of a node
+   \param n : a node
+   \return hash value of n w.r.t. NODE_HASH
+   \note a node can only be covered by nodes with the same hash value
+   */
+  std::size_t node_hash(NODE const & n) const { return _node_sptr_hash(n); }
+
   /*!
    \brief Type of incoming edges iterator
   */
@@ -460,11 +495,20 @@ public:
    */
   std::size_t nodes_count() const { return _cover_graph.size(); }
 
+  /*!
+   \brief Accessor
+   \return memory allocated for nodes and edges (in bytes)
+   \note allocated memory is reused once nodes and edges are removed, hence it
+   does not decrease
+   */
+  std::size_t memsize() const { return _node_pool.memsize() + _edge_pool.memsize(); }
+
   /*!
    \brief Type of iterator on nodes
   */
   using nodes_const_iterator_t =
-      typename tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t>::const_iterator_t;
+      typename tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t,
+                                               node_sptr_summary_t>::const_iterator_t;
 
   /*!
    \brief Accessor
@@ -536,6 +580,13 @@ private:
      */
     inline std::size_t operator()(node_sptr_t const & n) const { return _node_hash(*n); }
 
+    /*!
+     \brief Hash function on nodes
+     \param n : a node
+     \return hash value for n w.r.t. NODE_HASH
+     */
+    inline std::size_t operator()(NODE const & n) const { return _node_hash(n); }
+
   private:
     NODE_HASH _node_hash; /*!< Hash function on nodes */
   };
@@ -561,10 +612,62 @@ private:
      */
     inline bool operator()(node_sptr_t const & n1, node_sptr_t const & n2) const { return _node_le(*n1, *n2); }
 
+    /*!
+     \brief Covering predicate on a node and a shared pointer to node
+     \param n1 : a node
+     \param n2 : a node
+     \return true if n1 is less-than-or-equal-to *n2 w.r.t. NODE_LE, false otherwise
+     */
+    inline bool operator()(NODE const & n1, node_sptr_t const & n2) const { return _node_le(n1, *n2); }
+
   private:
     NODE_LE _node_le; /*!< Covering predicate on nodes */
   };
 
+  /*!
+   \class node_sptr_summary_t
+   \brief Summary functor for node pointers
+   */
+  class node_sptr_summary_t {
+  public:
+    /*!
+     \brief Type of summaries
+     */
+    using summary_t = typename NODE_SUMMARY::summary_t;
+
+    /*!
+     \brief Constructor
+     \param node_summary : summary of nodes
+     \post this keeps a copy of node_summary
+     */
+    node_sptr_summary_t(NODE_SUMMARY const & node_summary) : _node_summary(node_summary) {}
+
+    /*!
+     \brief Summary of shared pointers to nodes
+     \param n : a node
+     \return summary of *n w.r.t. NODE_SUMMARY
+     */
+    inline summary_t operator()(node_sptr_t const & n) const { return _node_summary(*n); }
+
+    /*!
+     \brief Summary of nodes
+     \param n : a node
+     \return summary of n w.r.t. NODE_SUMMARY
+     */
+    inline summary_t operator()(NODE const & n) const { return _node_summary(n); }
+
+    /*!
+     \brief Less-than-or-equal-to predicate on summaries
+     \param s1 : a summary
+     \param s2 : a summary
+     \return s1 is less-than-or-equal-to s2 w.r.t. NODE_SUMMARY
+     */
+    inline bool le(summary_t const & s1, summary_t const & s2) const { return _node_summary.le(s1, s2); }
+
+  private:
+    NODE_SUMMARY _node_summary; /*!< Summary of nodes */
+  };
+
   /*!
    \brief Check is a node is connected
    \param n : a node
@@ -577,9 +680,11 @@ private:
     return (in_edges.begin() != in_edges.end() || out_edges.begin() != out_edges.end());
   }
 
-  node_sptr_hash_t _node_sptr_hash; /*!< Hash functor on shared pointers to nodes */
-  node_sptr_le_t _node_sptr_le;     /*!< Covering functor on shared pointers to nodes */
-  tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t> _cover_graph; /*!< Node store with covering */
+  node_sptr_hash_t _node_sptr_hash;       /*!< Hash functor on shared pointers to nodes */
+  node_sptr_le_t _node_sptr_le;           /*!< Covering functor on shared pointers to nodes */
+  node_sptr_summary_t _node_sptr_summary; /*!< Summary functor on shared pointers to nodes */
+  tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t, node_sptr_summary_t>
+      _cover_graph; /*!< Node store with covering */
   tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph;                /*!< Edge store */
   tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;                            /*!< Node pool allocator */
   tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;                            /*!< Edge pool allocator */
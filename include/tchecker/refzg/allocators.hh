@@ -8,10 +8,13 @@
 #ifndef TCHECKER_REFZG_ALLOCATORS_HH
 #define TCHECKER_REFZG_ALLOCATORS_HH
 
+#include <functional>
+#include <memory>
 #include <type_traits>
 
 #include "tchecker/refzg/state.hh"
 #include "tchecker/refzg/transition.hh"
+#include "tchecker/utils/cache.hh"
 #include "tchecker/ta/allocators.hh"
 
 /*!
@@ -120,6 +123,23 @@ public:
     return tchecker::refzg::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Share components of a state
+   \param s : a state
+   \post the tuple of locations, the valuation of bounded integer variables and
+   the zone in s have been replaced by equal ones stored by this allocator if
+   any, otherwise they have been stored by this allocator
+   \note s and its components should not be modified afterwards, since they may
+   be shared with other states
+   */
+  void share(STATE & s)
+  {
+    tchecker::ta::details::state_pool_allocator_t<STATE>::share(s);
+    if (_zone_cache.get() == nullptr)
+      _zone_cache.reset(new zone_cache_t);
+    s.zone_ptr() = _zone_cache->find_else_insert(s.zone_ptr());
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -153,6 +173,8 @@ public:
   void collect()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::collect();
+    if (_zone_cache.get() != nullptr)
+      _zone_cache->collect();
     _zone_pool.collect();
   }
 
@@ -166,6 +188,8 @@ public:
   void destruct_all()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::destruct_all();
+    if (_zone_cache.get() != nullptr)
+      _zone_cache->clear();
     _zone_pool.destruct_all();
   }
 
@@ -188,8 +212,15 @@ protected:
                                                                                       args...);
   }
 
+  /*!
+   \brief Type of cache of zones
+   */
+  using zone_cache_t = tchecker::cache_t<tchecker::refzg::shared_zone_t, tchecker::shared_object_hash_t,
+                                         std::equal_to<tchecker::refzg::shared_zone_t>>;
+
   std::shared_ptr<tchecker::reference_clock_variables_t const> _ref_clocks; /*!< Reference clocks */
   tchecker::pool_t<tchecker::refzg::shared_zone_t> _zone_pool;              /*!< Pool of zones */
+  std::unique_ptr<zone_cache_t> _zone_cache;                                /*!< Shared zones (allocated on first use) */
 };
 
 /*!
@@ -0,0 +1,131 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_REFZG_POR_HH
+#define TCHECKER_REFZG_POR_HH
+
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/refzg/refzg.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file por.hh
+ \brief Partial-order reduction for zone graphs with reference clocks
+ */
+
+namespace tchecker {
+
+namespace refzg {
+
+/*!
+ \class persistent_sets_t
+ \brief Persistent sets of transitions in zone graphs with reference clocks
+ \note Persistent sets are computed from dependencies between edges. Two edges
+ of distinct processes are dependent if they may synchronize, or if one of them
+ writes a variable (clock or integer variable) that the other one reads or
+ writes. Reads of a shared variable do not conflict with each other.
+ In a state, a set of processes is closed if every edge from the location of
+ one of its processes is independent of all the edges that the other processes
+ can reach in their automaton from their current location. The enabled
+ transitions of a closed set of processes then form a persistent set in a zone
+ graph with process reference clocks (local-time semantics): transitions of the
+ other processes neither enable, disable nor are affected by them.
+ When accepting labels are given, edges from the locations of a closed set of
+ processes should also be invisible: they do not change the accepting labels of
+ their process, and they do not make the zone unsynchronizable (see
+ tchecker::refzg::satisfies). The latter is guaranteed by requiring that
+ neither their guard nor the invariant of their target location involve clocks.
+ No reduction is achieved when all the transitions synchronize with a same
+ process (e.g. a process that holds a shared variable): in local-time
+ semantics, synchronizations order the reference clocks of the processes
+ involved, hence transitions that share a process never commute
+ */
+class persistent_sets_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param labels : accepting labels
+   \post dependencies between the edges of system, and visibility of edges
+   w.r.t. labels have been computed
+   */
+  persistent_sets_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Closed set of processes
+   \param vloc : tuple of locations
+   \param pid : a process identifier
+   \param processes : a set of processes
+   \pre vloc is a tuple of locations of the system and pid is a process in
+   vloc (checked by assertion)
+   \post processes is the smallest closed set of processes in vloc that
+   contains pid
+   \return true if all the edges from the locations of processes in vloc are
+   invisible, false otherwise
+   */
+  bool closed_processes(tchecker::vloc_t const & vloc, tchecker::process_id_t pid, boost::dynamic_bitset<> & processes) const;
+
+  /*!
+   \brief Next states and transitions along a persistent set
+   \param refzg : a zone graph with process reference clocks
+   \param s : a state of refzg
+   \param v : container
+   \post if some closed set of processes in s is invisible, does not contain all
+   the processes, and has an enabled transition, then all the tuples (status,
+   s', t) such that s -t-> s' is a transition of the smallest such set of
+   processes and s' has status tchecker::STATE_OK have been pushed to v.
+   Otherwise, v is unchanged
+   \return the set of processes whose transitions have been pushed to v, the
+   empty set if there is no such set of processes
+   */
+  boost::dynamic_bitset<> next(tchecker::refzg::refzg_t & refzg, tchecker::refzg::const_state_sptr_t const & s,
+                               std::vector<tchecker::refzg::refzg_t::sst_t> & v) const;
+
+  /*!
+   \brief Next states and transitions of other processes
+   \param refzg : a zone graph with process reference clocks
+   \param s : a state of refzg
+   \param processes : a set of processes
+   \param v : container
+   \post all the tuples (status, s', t) such that s -t-> s' is a transition
+   that involves a process outside processes and s' has status
+   tchecker::STATE_OK have been pushed to v
+   */
+  void next_except(tchecker::refzg::refzg_t & refzg, tchecker::refzg::const_state_sptr_t const & s,
+                   boost::dynamic_bitset<> const & processes, std::vector<tchecker::refzg::refzg_t::sst_t> & v) const;
+
+private:
+  /*!
+   \brief Next states and transitions of a set of processes
+   \param refzg : a zone graph with process reference clocks
+   \param s : a state of refzg
+   \param processes : a set of processes
+   \param involved : selects transitions that only involve processes if true,
+   and the other transitions otherwise
+   \param v : container
+   \post all the tuples (status, s', t) such that s -t-> s' is a selected
+   transition and s' has status tchecker::STATE_OK have been pushed to v
+   */
+  void next(tchecker::refzg::refzg_t & refzg, tchecker::refzg::const_state_sptr_t const & s,
+            boost::dynamic_bitset<> const & processes, bool involved,
+            std::vector<tchecker::refzg::refzg_t::sst_t> & v) const;
+
+  std::vector<boost::dynamic_bitset<>> _dependent_edges; /*!< Map : loc id -> edges dependent on its outgoing edges */
+  std::vector<boost::dynamic_bitset<>> _reachable_edges; /*!< Map : loc id -> edges reachable in its process */
+  boost::dynamic_bitset<> _committing;                   /*!< Locations that can reach a committed location */
+  boost::dynamic_bitset<> _visible;                      /*!< Locations with an outgoing edge visible w.r.t. labels */
+};
+
+} // end of namespace refzg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_REFZG_POR_HH
@@ -9,6 +9,7 @@
 #define TCHECKER_REFZG_HH
 
 #include <cstdlib>
+#include <memory>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
@@ -21,6 +22,7 @@
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/ta/ta.hh"
+#include "tchecker/ts/sharing.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/variables/intvars.hh"
@@ -294,13 +296,20 @@ public:
    \param semantics : a semantics over zones with reference clocks
    \param spread : spread bound over reference clocks
    \param block_size : number of objects allocated in a block
+   \param sharing_type : type of sharing of state components
    \note all states and transitions are pool allocated and deallocated
    automatically
    \note set spread to tchecker::refdbm::UNBOUNDED_SPREAD for unbounded spread
+   \note if sharing_type is tchecker::ts::SHARING, the tuple of locations, the
+   valuation of bounded integer variables and the zone of computed states are
+   shared among equal states, hence components of states should not be modified
+   \note tchecker::ts::SHARING_NARROW_ZONES and tchecker::ts::SHARING_REDUCED_ZONES
+   are handled as tchecker::ts::SHARING
    */
   refzg_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
           std::shared_ptr<tchecker::reference_clock_variables_t const> const & r,
-          std::unique_ptr<tchecker::refzg::semantics_t> && semantics, tchecker::integer_t spread, std::size_t block_size);
+          std::unique_ptr<tchecker::refzg::semantics_t> && semantics, tchecker::integer_t spread, std::size_t block_size,
+          enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
   /*!
    \brief Copy constructor (deleted)
@@ -375,6 +384,16 @@ public:
   virtual void next(tchecker::refzg::const_state_sptr_t const & s, tchecker::refzg::outgoing_edges_value_t const & out_edge,
                     std::vector<sst_t> & v);
 
+  /*!
+   \brief Clone a state
+   \param s : a state
+   \return a copy of s allocated by this zone graph with reference clocks
+   \note s may have been allocated by another zone graph with reference clocks over the same system.
+   s is only accessed through const references, hence it can be cloned while
+   another thread holds shared pointers to s, as long as s is not modified
+   */
+  tchecker::refzg::state_sptr_t clone_state(tchecker::refzg::shared_state_t const & s);
+
   using tchecker::ts::full_ts_t<tchecker::refzg::state_sptr_t, tchecker::refzg::const_state_sptr_t,
                                 tchecker::refzg::transition_sptr_t, tchecker::refzg::const_transition_sptr_t,
                                 tchecker::refzg::initial_range_t, tchecker::refzg::outgoing_edges_range_t,
@@ -416,13 +435,33 @@ public:
    */
   tchecker::ta::system_t const & system() const;
 
+  /*!
+   \brief Accessor
+   \return memory allocated for states and transitions (in bytes)
+   \note allocated memory is reused once states and transitions are released,
+   hence it does not decrease
+   */
+  std::size_t memsize() const;
+
+  /*!
+   \brief Set memoization of outgoing edges
+   \param cache : cache of outgoing edges from tuples of locations (nullptr: no
+   memoization)
+   \post outgoing edges are obtained from cache if set (see
+   tchecker::syncprod::outgoing_edges_cache_t)
+   \note cache should not be shared with another thread
+   */
+  void set_outgoing_edges_cache(std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> const & cache);
+
 private:
-  std::shared_ptr<tchecker::ta::system_t const> _system;              /*!< System of timed processes */
-  std::shared_ptr<tchecker::reference_clock_variables_t const> _r;    /*!< Reference clock variables */
-  std::unique_ptr<tchecker::refzg::semantics_t> _semantics;           /*!< Zone semantics */
-  tchecker::integer_t _spread;                                        /*!< Spread bound over reference clocks */
-  tchecker::refzg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
-  tchecker::refzg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  std::shared_ptr<tchecker::ta::system_t const> _system;                    /*!< System of timed processes */
+  std::shared_ptr<tchecker::reference_clock_variables_t const> _r;          /*!< Reference clock variables */
+  std::unique_ptr<tchecker::refzg::semantics_t> _semantics;                 /*!< Zone semantics */
+  tchecker::integer_t _spread;                                              /*!< Spread bound over reference clocks */
+  tchecker::refzg::state_pool_allocator_t _state_allocator;                 /*!< Pool allocator of states */
+  tchecker::refzg::transition_pool_allocator_t _transition_allocator;       /*! Pool allocator of transitions */
+  enum tchecker::ts::sharing_type_t _sharing_type;                          /*!< Sharing of state components */
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> _edges_cache; /*!< Cache of outgoing edges (nullptr: none) */
 };
 
 /* Factory */
@@ -442,6 +481,7 @@ enum reference_clock_variables_type_t {
  \param semantics_type : type of semantics over zones with reference clocks
  \param spread : spread bound over reference clocks
  \param block_size : number of objects allocated in a block
+ \param sharing_type : type of sharing of state components
  \return a zone graph over system with zone semantics and spread bound
  defined from semantics_type and spread, reference clocks defined from
  refclocks_type, and allocation of block_size objects at a time
@@ -450,7 +490,8 @@ enum reference_clock_variables_type_t {
 tchecker::refzg::refzg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                                    enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                                    enum tchecker::refzg::semantics_type_t semantics_type, tchecker::integer_t spread,
-                                   std::size_t block_size);
+                                   std::size_t block_size,
+                                   enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
 } // end of namespace refzg
 
@@ -8,6 +8,8 @@
 #ifndef TCHECKER_SYNCPROD_ALLOCATORS_HH
 #define TCHECKER_SYNCPROD_ALLOCATORS_HH
 
+#include <functional>
+#include <memory>
 #include <type_traits>
 
 #include "tchecker/syncprod/state.hh"
@@ -15,6 +17,7 @@
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/ts/allocators.hh"
+#include "tchecker/utils/cache.hh"
 
 /*!
  \file allocators.hh
@@ -111,6 +114,22 @@ public:
     return tchecker::syncprod::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Share components of a state
+   \param s : a state
+   \post the tuple of locations in s has been replaced by an equal tuple of
+   locations stored by this allocator if any, otherwise it has been stored by
+   this allocator
+   \note s and its components should not be modified afterwards, since they may
+   be shared with other states
+   */
+  void share(STATE & s)
+  {
+    if (_vloc_cache.get() == nullptr)
+      _vloc_cache.reset(new vloc_cache_t);
+    s.vloc_ptr() = _vloc_cache->find_else_insert(s.vloc_ptr());
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -143,6 +162,8 @@ public:
   void collect()
   {
     tchecker::ts::state_pool_allocator_t<STATE>::collect();
+    if (_vloc_cache.get() != nullptr)
+      _vloc_cache->collect();
     _vloc_pool.collect();
   }
 
@@ -154,6 +175,8 @@ public:
   void destruct_all()
   {
     tchecker::ts::state_pool_allocator_t<STATE>::destruct_all();
+    if (_vloc_cache.get() != nullptr)
+      _vloc_cache->clear();
     _vloc_pool.destruct_all();
   }
 
@@ -175,8 +198,15 @@ protected:
     return tchecker::ts::state_pool_allocator_t<STATE>::construct_from_state(s, _vloc_pool.construct(s.vloc()), args...);
   }
 
+  /*!
+   \brief Type of cache of tuples of locations
+   */
+  using vloc_cache_t =
+      tchecker::cache_t<tchecker::shared_vloc_t, tchecker::shared_object_hash_t, std::equal_to<tchecker::shared_vloc_t>>;
+
   std::size_t _vloc_capacity;                           /*!< Capacity of tuples of locations */
   tchecker::pool_t<tchecker::shared_vloc_t> _vloc_pool; /*!< Pool of tuples of locations */
+  std::unique_ptr<vloc_cache_t> _vloc_cache;            /*!< Shared tuples of locations (allocated on first use) */
 };
 
 /*!
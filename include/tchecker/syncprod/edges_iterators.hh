@@ -76,12 +76,28 @@ public:
    \param loc_edges_maps : maps loc id -> edges/events
    \param sync_begin : iterator on first synchronization
    \param sync_end : past-the-end iterator on synchronizations
+   \post this iterates over all synchronizations in [sync_begin, sync_end)
    */
   vloc_synchronized_edges_iterator_t(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
                                      std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
                                      tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
                                      tchecker::system::synchronizations_t::const_iterator_t const & sync_end);
 
+  /*!
+   \brief Constructor
+   \param vloc : tuple of locations
+   \param loc_edges_maps : maps loc id -> edges/events
+   \param sync_begin : iterator on first synchronization
+   \param candidates : identifiers of candidate synchronizations (i.e. offsets w.r.t. sync_begin)
+   \pre candidates is sorted in increasing order and contains all synchronizations that are enabled from vloc
+   (see tchecker::syncprod::system_t::candidate_synchronizations)
+   \post this only iterates over the synchronizations in candidates
+   */
+  vloc_synchronized_edges_iterator_t(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
+                                     std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
+                                     tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
+                                     std::vector<tchecker::sync_id_t> candidates);
+
   /*!
    \brief Copy constructor
    */
@@ -170,20 +186,21 @@ protected:
   \brief Fast end-of-range check
   \return true if this is past-the-end, false otherwise
   */
-  inline bool at_end() const { return (_sync_it == _sync_end); }
+  inline bool at_end() const { return (_candidate == _candidates.size()); }
 
   /*!
    \brief Fills cartesian product
    \post either this range is at_end(), or _cartesian_it has been filled with ranges of edges corresponding to
-   synchronzation pointed by _sync_it
+   synchronzation identified by _candidates[_candidate]
    */
   void advance_while_empty_cartesian_product();
 
   tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> _vloc; /*!< Vector of locations */
   /*!< Maps loc id -> edges/events */
   std::shared_ptr<tchecker::system::loc_edges_maps_t const> _loc_edges_maps;
-  tchecker::system::synchronizations_t::const_iterator_t _sync_it;  /*!< Iterator on synchronizations */
-  tchecker::system::synchronizations_t::const_iterator_t _sync_end; /*!< Past-the-end iterator on synchronizations */
+  tchecker::system::synchronizations_t::const_iterator_t _sync_begin; /*!< Iterator on first synchronization */
+  std::vector<tchecker::sync_id_t> _candidates;                       /*!< Candidate synchronizations */
+  std::size_t _candidate;                                             /*!< Current candidate synchronization */
   /*!< Cartesian iterator */
   tchecker::cartesian_iterator_t<tchecker::range_t<tchecker::system::edges_collection_const_iterator_t>> _cartesian_it;
 };
@@ -193,6 +210,8 @@ protected:
  \param system : a system
  \param vloc : a tuple of locations
  \return range of outgoing synchronized edges from vloc in system
+ \note only the candidate synchronizations from vloc are considered (see
+ tchecker::syncprod::system_t::candidate_synchronizations)
  */
 tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t>
 outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
@@ -224,6 +243,15 @@ public:
    */
   edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t::edges_iterator_t const & it);
 
+  /*!
+   \brief Constructor
+   \param edge : pointer in an array of edges
+   \pre edge != nullptr (checked by assertion)
+   \post this is an iterator on the array of edges, starting from edge
+   \note the array of edges must outlive this iterator
+   */
+  explicit edges_iterator_t(tchecker::system::edge_const_shared_ptr_t const * edge);
+
   /*!
    \brief Copy constructor
    */
@@ -283,6 +311,8 @@ private:
   bool _async_at_end;
   /*!< Iterator over synchronized edges */
   tchecker::syncprod::vloc_synchronized_edges_iterator_t::edges_iterator_t _sync_it;
+  /*!< Pointer in an array of edges (nullptr if not iterating over an array) */
+  tchecker::system::edge_const_shared_ptr_t const * _array_edge;
 };
 
 /*!
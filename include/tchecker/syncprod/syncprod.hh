@@ -9,6 +9,10 @@
 #define TCHECKER_SYNCPROD_SYNCPROD_HH
 
 #include <cstdlib>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 
@@ -90,6 +94,17 @@ inline tchecker::state_status_t initial(tchecker::syncprod::system_t const & sys
   return tchecker::syncprod::initial(system, s.vloc_ptr(), t.vedge_ptr(), v);
 }
 
+/*!
+ \class outgoing_edges_array_t
+ \brief Outgoing tuples of edges from a tuple of locations, stored in a flat
+ array
+ */
+class outgoing_edges_array_t {
+public:
+  std::vector<tchecker::system::edge_const_shared_ptr_t> _edges; /*!< Concatenated tuples of edges */
+  std::vector<std::size_t> _offsets;                             /*!< Offsets of tuples in _edges (+ end of last tuple) */
+};
+
 /*!
 \class outgoing_edges_iterator_t
 \brief Outgoing edges iterator taking committed processes into account. Iterates
@@ -115,6 +130,15 @@ public:
   */
   outgoing_edges_iterator_t(tchecker::syncprod::vloc_edges_iterator_t const & it, boost::dynamic_bitset<> committed_processes);
 
+  /*!
+  \brief Constructor
+  \param array : array of outgoing tuples of edges
+  \pre array != nullptr (checked by assertion)
+  \post this iterates over all the tuples of edges in array, that are assumed to
+  take committed processes into account
+  */
+  explicit outgoing_edges_iterator_t(std::shared_ptr<tchecker::syncprod::outgoing_edges_array_t const> const & array);
+
   /*!
   \brief Copy constructor
   */
@@ -143,8 +167,8 @@ public:
   /*!
   \brief Equality predicate
   \param it : iterator
-  \return true if underlying vloc edges iterators are equal, and committed
-  processes are equal, false otherwise
+  \return true if underlying vloc edges iterators (or arrays and positions) are
+  equal, and committed processes are equal, false otherwise
   */
   bool operator==(tchecker::syncprod::outgoing_edges_iterator_t const & it) const;
 
@@ -205,9 +229,11 @@ private:
   */
   bool at_end() const;
 
-  tchecker::syncprod::vloc_edges_iterator_t _it; /*!< Underlying vloc edges iterator */
-  boost::dynamic_bitset<> _committed_processes;  /*!< Map : PID -> committed flag */
-  bool _committed;                               /*!< Flag : whether _committed_procs has a committed process or not */
+  std::optional<tchecker::syncprod::vloc_edges_iterator_t> _it;             /*!< Underlying vloc edges iterator (if any) */
+  boost::dynamic_bitset<> _committed_processes;                             /*!< Map : PID -> committed flag */
+  bool _committed;                                                          /*!< Flag : whether some process is committed */
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_array_t const> _array; /*!< Array of tuples of edges (if no _it) */
+  std::size_t _position;                                                    /*!< Position of current tuple in _array */
 };
 
 /*!
@@ -225,6 +251,109 @@ tchecker::syncprod::outgoing_edges_range_t
 outgoing_edges(tchecker::syncprod::system_t const & system,
                tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
 
+/*!
+ \class outgoing_edges_cache_t
+ \brief Memoization of outgoing edges from tuples of locations
+ \note The outgoing tuples of edges from a tuple of locations only depend on the
+ tuple of locations. They are computed when first accessed, and stored as a
+ flat array shared by all the states with the same tuple of locations. Tuples of
+ locations are indexed by content. The cache is flushed when its memory bound
+ is reached. A cache is tied to a single system, and is not thread-safe: each
+ thread should have its own cache
+ */
+class outgoing_edges_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param max_memsize : memory bound (in bytes)
+   \post this cache is empty, and stores arrays of outgoing edges within
+   max_memsize bytes (approximately)
+   */
+  explicit outgoing_edges_cache_t(std::size_t max_memsize);
+
+  /*!
+   \brief Copy constructor
+   */
+  outgoing_edges_cache_t(tchecker::syncprod::outgoing_edges_cache_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  outgoing_edges_cache_t(tchecker::syncprod::outgoing_edges_cache_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~outgoing_edges_cache_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::syncprod::outgoing_edges_cache_t & operator=(tchecker::syncprod::outgoing_edges_cache_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::syncprod::outgoing_edges_cache_t & operator=(tchecker::syncprod::outgoing_edges_cache_t &&) = default;
+
+  /*!
+   \brief Accessor to outgoing edges
+   \param system : a system
+   \param vloc : tuple of locations
+   \return range of outgoing synchronized and asynchronous edges from vloc in
+   system (see tchecker::syncprod::outgoing_edges)
+   \post the outgoing edges from vloc have been computed and stored in this cache
+   if they were not cached yet. The cache has been flushed before if storing them
+   would exceed the memory bound. Outgoing edges that do not fit in the memory
+   bound are not stored
+   \note returned ranges remain valid after this cache has been flushed
+   */
+  tchecker::syncprod::outgoing_edges_range_t
+  outgoing_edges(tchecker::syncprod::system_t const & system,
+                 tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
+
+  /*!
+   \brief Clear
+   \post this cache is empty
+   \note hits and misses counters are not reset
+   */
+  void clear();
+
+  /*!
+   \brief Accessor
+   \return Number of accesses to tuples of locations found in this cache
+   */
+  inline unsigned long hits() const { return _hits; }
+
+  /*!
+   \brief Accessor
+   \return Number of accesses to tuples of locations not found in this cache
+   */
+  inline unsigned long misses() const { return _misses; }
+
+  /*!
+   \brief Accessor
+   \return Number of tuples of locations in this cache
+   */
+  inline std::size_t size() const { return _arrays.size(); }
+
+  /*!
+   \brief Accessor
+   \return Memory used by this cache (in bytes, approximately)
+   */
+  inline std::size_t memsize() const { return _memsize; }
+
+private:
+  std::size_t _max_memsize;                                                               /*!< Memory bound (in bytes) */
+  std::size_t _memsize;                                                                   /*!< Memory used (in bytes) */
+  std::unordered_multimap<std::size_t, std::size_t> _index;                               /*!< Map : hash -> tuple number */
+  std::vector<tchecker::loc_id_t> _locs;                                                  /*!< Concatenated tuples */
+  std::vector<std::size_t> _offsets;                                                      /*!< Offsets in _locs (+ end) */
+  std::vector<std::shared_ptr<tchecker::syncprod::outgoing_edges_array_t const>> _arrays; /*!< Map : tuple -> edges */
+  unsigned long _hits;                                                                    /*!< Number of cache hits */
+  unsigned long _misses;                                                                  /*!< Number of cache misses */
+};
+
 /*!
  \brief Type of outgoing vedge
  \note type dereferenced by outgoing_edges_iterator_t, corresponds to tchecker::vedge_iterator_t
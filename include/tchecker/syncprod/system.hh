@@ -15,6 +15,7 @@
 
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/label.hh"
+#include "tchecker/syncprod/vloc.hh"
 #include "tchecker/system/edge.hh"
 #include "tchecker/system/system.hh"
 #include "tchecker/utils/iterator.hh"
@@ -210,6 +211,19 @@ public:
   using tchecker::system::system_t::synchronizations;
   using tchecker::system::system_t::synchronizations_count;
 
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \param syncs : synchronization identifiers
+   \pre vloc has one location for each process (checked by assertion)
+   \post syncs has been filled with the identifiers of the synchronizations that may be enabled from vloc, in
+   increasing order. Every synchronization that is enabled from vloc is in syncs
+   \note synchronizations are indexed by one of their strong constraints: a synchronization may be enabled from
+   vloc only if the location of the constrained process in vloc has an outgoing edge labelled by the constrained
+   event. Synchronizations without strong constraints are always in syncs
+   */
+  void candidate_synchronizations(tchecker::vloc_t const & vloc, std::vector<tchecker::sync_id_t> & syncs) const;
+
   // Cast
 
   /*!
@@ -246,6 +260,15 @@ private:
    */
   void compute_labels();
 
+  /*!
+   \brief Compute index of synchronizations
+   \post every synchronization with a strong constraint has been added to _loc_synchronizations for all the
+   locations that have an outgoing edge for its most selective strong constraint (i.e. the one with the fewest
+   such locations), and the synchronizations without a strong constraint have been added to
+   _unconstrained_synchronizations
+   */
+  void compute_synchronizations_index();
+
   /*!
    \brief Add asynchronous edge
    \param edge : an edge
@@ -268,6 +291,9 @@ private:
   static asynchronous_edges_collection_t const _empty_async_edges;    /*!< Empty collection of asynchronous edges */
   boost::dynamic_bitset<> _committed;                                 /*!< Committed locations */
   std::vector<boost::dynamic_bitset<>> _labels;                       /*!< Map: location identifier -> labels */
+  /*!< Map: location identifier -> synchronizations indexed by location (increasing order) */
+  std::vector<std::vector<tchecker::sync_id_t>> _loc_synchronizations;
+  std::vector<tchecker::sync_id_t> _unconstrained_synchronizations; /*!< Synchronizations without strong constraints */
 };
 
 /*!
@@ -8,11 +8,14 @@
 #ifndef TCHECKER_TA_ALLOCATORS_HH
 #define TCHECKER_TA_ALLOCATORS_HH
 
+#include <functional>
+#include <memory>
 #include <type_traits>
 
 #include "tchecker/syncprod/allocators.hh"
 #include "tchecker/ta/state.hh"
 #include "tchecker/ta/transition.hh"
+#include "tchecker/utils/cache.hh"
 
 /*!
  \file allocators.hh
@@ -114,6 +117,23 @@ public:
     return tchecker::ta::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Share components of a state
+   \param s : a state
+   \post the tuple of locations and the valuation of bounded integer variables in
+   s have been replaced by equal ones stored by this allocator if any, otherwise
+   they have been stored by this allocator
+   \note s and its components should not be modified afterwards, since they may
+   be shared with other states
+   */
+  void share(STATE & s)
+  {
+    tchecker::syncprod::details::state_pool_allocator_t<STATE>::share(s);
+    if (_intval_cache.get() == nullptr)
+      _intval_cache.reset(new intval_cache_t);
+    s.intval_ptr() = _intval_cache->find_else_insert(s.intval_ptr());
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -146,6 +166,8 @@ public:
   void collect()
   {
     tchecker::syncprod::details::state_pool_allocator_t<STATE>::collect();
+    if (_intval_cache.get() != nullptr)
+      _intval_cache->collect();
     _intval_pool.collect();
   }
 
@@ -158,6 +180,8 @@ public:
   void destruct_all()
   {
     tchecker::syncprod::details::state_pool_allocator_t<STATE>::destruct_all();
+    if (_intval_cache.get() != nullptr)
+      _intval_cache->clear();
     _intval_pool.destruct_all();
   }
 
@@ -184,8 +208,15 @@ protected:
         s, _intval_pool.construct(s.intval()), args...);
   }
 
+  /*!
+   \brief Type of cache of valuations of bounded integer variables
+   */
+  using intval_cache_t =
+      tchecker::cache_t<tchecker::shared_intval_t, tchecker::shared_object_hash_t, std::equal_to<tchecker::shared_intval_t>>;
+
   std::size_t _intval_capacity;                             /*!< Capacity of valuations of bounded integer variables */
   tchecker::pool_t<tchecker::shared_intval_t> _intval_pool; /*!< Pool of valuations of bounded integer variables */
+  std::unique_ptr<intval_cache_t> _intval_cache;            /*!< Shared valuations (allocated on first use) */
 };
 
 /*!
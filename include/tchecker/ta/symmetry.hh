@@ -0,0 +1,119 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_SYMMETRY_HH
+#define TCHECKER_TA_SYMMETRY_HH
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/intvars.hh"
+
+/*!
+ \file symmetry.hh
+ \brief Symmetry reduction for systems of timed processes
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \class symmetry_t
+ \brief Symmetries among the processes of a system of timed processes
+ \note Two processes are interchangeable if they are the same automaton up to
+ the renaming of their private variables (i.e. the clocks and bounded integer
+ variables that are accessed by no other process), and if swapping them leaves
+ the synchronizations unchanged. Locations are matched by order of declaration
+ in their process, and matching locations must have the same accepting labels.
+ Processes that refer to their own identity (e.g. a process that writes its
+ index to a shared variable, or that has a label of its own) are thus not
+ interchangeable.
+ Interchangeable processes form symmetry classes. Permuting processes within a
+ class (along with their locations and private variables) maps reachable
+ states to reachable states, and preserves accepting labels. Hence, it is
+ enough to explore one state per orbit. States are mapped to a representative
+ of their orbit by sorting the processes of each class w.r.t. their location,
+ the valuation of their private integer variables and the bounds on their
+ private clocks. This representative is not canonical when two processes only
+ differ by the constraints between their clocks: the reduction is then sound
+ but not maximal
+ */
+class symmetry_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param labels : accepting labels
+   \post symmetry classes of system w.r.t. labels have been computed
+   */
+  symmetry_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Accessor
+   \return number of symmetry classes with at least 2 processes
+   */
+  std::size_t classes_count() const;
+
+  /*!
+   \brief Accessor
+   \param k : index of a symmetry class
+   \pre k < classes_count() (checked by assertion)
+   \return identifiers of the processes in the k-th symmetry class, in
+   increasing order
+   */
+  std::vector<tchecker::process_id_t> const & symmetry_class(std::size_t k) const;
+
+  /*!
+   \brief Map a state to the representative of its orbit
+   \param vloc : tuple of locations
+   \param intval : valuation of bounded integer variables
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \pre vloc, intval and dbm are a state of the system this has been built
+   from, and dim is the number of flattened clocks in this system plus 1
+   \post the processes in each symmetry class have been sorted in vloc,
+   intval and dbm (see class description)
+   */
+  void canonicalize(tchecker::vloc_t & vloc, tchecker::intvars_valuation_t & intval, tchecker::dbm::db_t * dbm,
+                    tchecker::clock_id_t dim) const;
+
+private:
+  /*!
+   \brief Comparison of processes
+   \param vloc : tuple of locations
+   \param intval : valuation of bounded integer variables
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \param pid1 : process identifier
+   \param pid2 : process identifier
+   \pre pid1 and pid2 are in the same symmetry class
+   \return true if the location, the valuation of private integer variables and
+   the bounds on private clocks of pid1 are lexicographically smaller than those
+   of pid2, false otherwise
+   */
+  bool less(tchecker::vloc_t const & vloc, tchecker::intvars_valuation_t const & intval, tchecker::dbm::db_t const * dbm,
+            tchecker::clock_id_t dim, tchecker::process_id_t pid1, tchecker::process_id_t pid2) const;
+
+  std::vector<std::vector<tchecker::process_id_t>> _classes;   /*!< Symmetry classes with at least 2 processes */
+  std::vector<std::vector<tchecker::loc_id_t>> _locations;     /*!< Locations of each process, in declaration order */
+  std::vector<tchecker::loc_id_t> _local_index;                /*!< Index of each location in its process */
+  std::vector<std::vector<tchecker::clock_id_t>> _clocks;      /*!< Private flattened clocks of each process */
+  std::vector<std::vector<tchecker::intvar_id_t>> _intvars;    /*!< Private flattened integer variables of each process */
+};
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_SYMMETRY_HH
@@ -8,7 +8,9 @@
 #ifndef TCHECKER_TA_SYSTEM_HH
 #define TCHECKER_TA_SYSTEM_HH
 
+#include <cassert>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -22,6 +24,7 @@
 #include "tchecker/system/attribute.hh"
 #include "tchecker/system/system.hh"
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/vm/native.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -36,6 +39,14 @@ namespace ta {
 /*!
  \class system_t
  \brief System of processes for timed automata
+ \note Invariants, guards and statements are compiled to bytecode. They can
+ also be translated to native code (see compile_native), which is done when
+ the system is built if environment variable TCHECKER_NATIVE is set (see
+ tchecker::native_code_requested). Invariants, guards and statements that
+ neither read nor write integer variables are evaluated once when the system
+ is built. Evaluation (see run_invariant, run_guard and run_statement) outputs
+ their precomputed clock constraints and clock resets, calls native code when
+ available, and interprets bytecode otherwise
  */
 class system_t : private tchecker::syncprod::system_t {
 public:
@@ -145,6 +156,24 @@ public:
    */
   tchecker::bytecode_t const * statement_bytecode(tchecker::edge_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return true if the guard of edge id has been evaluated when this system
+   was built, false otherwise
+   */
+  bool is_constant_guard(tchecker::edge_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return true if the statement of edge id has been evaluated when this system
+   was built, false otherwise
+   */
+  bool is_constant_statement(tchecker::edge_id_t id) const;
+
   // Events
   using tchecker::syncprod::system_t::event_attributes;
   using tchecker::syncprod::system_t::event_id;
@@ -200,6 +229,15 @@ public:
    */
   tchecker::bytecode_t const * invariant_bytecode(tchecker::loc_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return true if the invariant of location id has been evaluated when this
+   system was built, false otherwise
+   */
+  bool is_constant_invariant(tchecker::loc_id_t id) const;
+
   // Processes
   using tchecker::syncprod::system_t::is_process;
   using tchecker::syncprod::system_t::process_attributes;
@@ -215,6 +253,86 @@ public:
   // Virtual machine
   inline tchecker::vm_t & vm() const { return _vm; }
 
+  /*!
+   \brief Evaluate an invariant
+   \param id : location identifier
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \pre id is a location identifier (checked by assertion)
+   \return see tchecker::vm_t::run
+   \post the invariant of location id has been evaluated (see
+   tchecker::vm_t::run)
+   \throw see tchecker::vm_t::run
+   */
+  inline tchecker::integer_t run_invariant(tchecker::loc_id_t id, tchecker::intvars_valuation_t & intval,
+                                           tchecker::clock_constraint_container_t & clkconstr,
+                                           tchecker::clock_reset_container_t & clkreset) const
+  {
+    assert(is_location(id));
+    compiled_expression_t const & invariant = _invariants[id];
+    return run(invariant._constant.get(), invariant._native, invariant._compiled_expr.get(), intval, clkconstr, clkreset);
+  }
+
+  /*!
+   \brief Evaluate a guard
+   \param id : edge identifier
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \pre id is an edge identifier (checked by assertion)
+   \return see tchecker::vm_t::run
+   \post the guard of edge id has been evaluated (see tchecker::vm_t::run)
+   \throw see tchecker::vm_t::run
+   */
+  inline tchecker::integer_t run_guard(tchecker::edge_id_t id, tchecker::intvars_valuation_t & intval,
+                                       tchecker::clock_constraint_container_t & clkconstr,
+                                       tchecker::clock_reset_container_t & clkreset) const
+  {
+    assert(is_edge(id));
+    compiled_expression_t const & guard = _guards[id];
+    return run(guard._constant.get(), guard._native, guard._compiled_expr.get(), intval, clkconstr, clkreset);
+  }
+
+  /*!
+   \brief Apply a statement
+   \param id : edge identifier
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \pre id is an edge identifier (checked by assertion)
+   \return see tchecker::vm_t::run
+   \post the statement of edge id has been applied (see tchecker::vm_t::run)
+   \throw see tchecker::vm_t::run
+   */
+  inline tchecker::integer_t run_statement(tchecker::edge_id_t id, tchecker::intvars_valuation_t & intval,
+                                           tchecker::clock_constraint_container_t & clkconstr,
+                                           tchecker::clock_reset_container_t & clkreset) const
+  {
+    assert(is_edge(id));
+    compiled_statement_t const & statement = _statements[id];
+    return run(statement._constant.get(), statement._native, statement._compiled_stmt.get(), intval, clkconstr, clkreset);
+  }
+
+  // Native code
+
+  /*!
+   \brief Translate invariants, guards and statements to native code
+   \param cache_dir : directory of cached shared objects
+   \param compiler : C++ compiler command
+   \post invariants, guards and statements have been translated to native code
+   and loaded (see tchecker::native_library_t). Those that cannot be translated
+   are interpreted
+   \throw std::runtime_error : if native code cannot be built or loaded
+   */
+  void compile_native(std::string const & cache_dir, std::string const & compiler);
+
+  /*!
+   \brief Accessor
+   \return native code of this system, nullptr if none
+   */
+  inline std::shared_ptr<tchecker::native_library_t const> const & native_library() const { return _native; }
+
   // Cast
   using tchecker::syncprod::system_t::as_system_system;
 
@@ -225,22 +343,91 @@ public:
   constexpr inline tchecker::syncprod::system_t const & as_syncprod_system() const { return *this; }
 
 private:
+  /*!
+   \brief Result of the evaluation of a bytecode that neither reads nor writes
+   integer variables
+   */
+  struct constant_evaluation_t {
+    tchecker::integer_t _value;                        /*!< Returned value */
+    tchecker::clock_constraint_container_t _clkconstr; /*!< Output clock constraints */
+    tchecker::clock_reset_container_t _clkreset;       /*!< Output clock resets */
+  };
+
   /*!
    \brief Typed and compiled expression
    */
   struct compiled_expression_t {
-    std::shared_ptr<tchecker::typed_expression_t> _typed_expr; /*!< Typed expression */
-    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;      /*!< Compiled expression */
+    std::shared_ptr<tchecker::typed_expression_t> _typed_expr;       /*!< Typed expression */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;            /*!< Compiled expression */
+    tchecker::native_function_t _native{nullptr};                    /*!< Native code (nullptr if none) */
+    std::shared_ptr<constant_evaluation_t const> _constant{nullptr}; /*!< Precomputed evaluation (nullptr if none) */
   };
 
   /*!
    \brief Typed and compiled statement
    */
   struct compiled_statement_t {
-    std::shared_ptr<tchecker::typed_statement_t> _typed_stmt; /*!< Typed statement */
-    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
+    std::shared_ptr<tchecker::typed_statement_t> _typed_stmt;        /*!< Typed statement */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;            /*!< Compiled statement */
+    tchecker::native_function_t _native{nullptr};                    /*!< Native code (nullptr if none) */
+    std::shared_ptr<constant_evaluation_t const> _constant{nullptr}; /*!< Precomputed evaluation (nullptr if none) */
   };
 
+  /*!
+   \brief Evaluation of precomputed results, native code or bytecode
+   \param constant : precomputed evaluation
+   \param native : native code
+   \param bytecode : bytecode
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \return see tchecker::vm_t::run
+   \post the clock constraints and clock resets in constant have been appended
+   to clkconstr and clkreset if constant is not nullptr. Otherwise, native has
+   been called if not nullptr, and bytecode has been interpreted otherwise (see
+   tchecker::vm_t::run)
+   \throw see tchecker::vm_t::run
+   */
+  inline tchecker::integer_t run(constant_evaluation_t const * constant, tchecker::native_function_t native,
+                                 tchecker::bytecode_t const * bytecode, tchecker::intvars_valuation_t & intval,
+                                 tchecker::clock_constraint_container_t & clkconstr,
+                                 tchecker::clock_reset_container_t & clkreset) const
+  {
+    if (constant != nullptr) {
+      clkconstr.insert(clkconstr.end(), constant->_clkconstr.begin(), constant->_clkconstr.end());
+      clkreset.insert(clkreset.end(), constant->_clkreset.begin(), constant->_clkreset.end());
+      return constant->_value;
+    }
+    if (native != nullptr)
+      return tchecker::run_native(native, intval, clkconstr, clkreset);
+    return _vm.run(bytecode, intval, clkconstr, clkreset);
+  }
+
+  /*!
+   \brief Precompute evaluations
+   \post invariants, guards and statements that neither read nor write integer
+   variables, and that have no loop, have been evaluated, unless their
+   evaluation throws
+   */
+  void precompute_constant_evaluations();
+
+  /*!
+   \brief Set native code
+   \param native : native code of invariants, guards and statements, in this
+   order
+   \post native functions of invariants, guards and statements have been set
+   from native
+   */
+  void set_native(std::shared_ptr<tchecker::native_library_t const> const & native);
+
+  /*!
+   \brief Translate to native code if requested
+   \post invariants, guards and statements have been translated to native code
+   if tchecker::native_code_requested(). A warning has been reported to
+   std::cerr if translation failed
+   */
+  void compile_native_if_requested();
+
   /*!
    \brief Compute data from syncprod::system_t
    \throw std::invalid_argument : if system has a transition over a weakly synchronized event
@@ -290,11 +477,12 @@ private:
   void set_statements(tchecker::edge_id_t id,
                       tchecker::range_t<tchecker::system::attributes_t::const_iterator_t> const & statements);
 
-  mutable tchecker::vm_t _vm;                     /*!< Bytecode interpreter */
-  std::vector<compiled_expression_t> _invariants; /*!< Map : location identifier -> invariant */
-  std::vector<compiled_expression_t> _guards;     /*!< Map : edge identifier -> guard */
-  std::vector<compiled_statement_t> _statements;  /*!< Map : edge identifier -> statement */
-  boost::dynamic_bitset<> _urgent;                /*!< Urgent locations */
+  mutable tchecker::vm_t _vm;                                /*!< Bytecode interpreter */
+  std::vector<compiled_expression_t> _invariants;            /*!< Map : location identifier -> invariant */
+  std::vector<compiled_expression_t> _guards;                /*!< Map : edge identifier -> guard */
+  std::vector<compiled_statement_t> _statements;             /*!< Map : edge identifier -> statement */
+  boost::dynamic_bitset<> _urgent;                           /*!< Urgent locations */
+  std::shared_ptr<tchecker::native_library_t const> _native; /*!< Native code (nullptr if none) */
 };
 
 } // end of namespace ta
@@ -379,10 +379,21 @@ public:
    */
   tchecker::ta::system_t const & system() const;
 
+  /*!
+   \brief Set memoization of outgoing edges
+   \param cache : cache of outgoing edges from tuples of locations (nullptr: no
+   memoization)
+   \post outgoing edges are obtained from cache if set (see
+   tchecker::syncprod::outgoing_edges_cache_t)
+   \note cache should not be shared with another thread
+   */
+  void set_outgoing_edges_cache(std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> const & cache);
+
 private:
-  std::shared_ptr<tchecker::ta::system_t const> _system;           /*!< System of timed processes */
-  tchecker::ta::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
-  tchecker::ta::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  std::shared_ptr<tchecker::ta::system_t const> _system;                    /*!< System of timed processes */
+  tchecker::ta::state_pool_allocator_t _state_allocator;                    /*!< Pool allocator of states */
+  tchecker::ta::transition_pool_allocator_t _transition_allocator;          /*! Pool allocator of transitions */
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> _edges_cache; /*!< Cache of outgoing edges (nullptr: none) */
 };
 
 } // end of namespace ta
@@ -31,6 +31,16 @@ class transition_t : public tchecker::syncprod::transition_t {
 public:
   using tchecker::syncprod::transition_t::transition_t;
 
+  /*!
+   \brief Partial copy constructor
+   \param t : a transition
+   \param vedge : tuple of edges
+   \pre vedge must not point to nullptr (checked by assertion)
+   \post this is a copy of t, including clock constraints and clock resets, with
+   tuple of edges vedge
+   */
+  transition_t(tchecker::ta::transition_t const & t, tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge);
+
   // Container accessors
 
   /*!
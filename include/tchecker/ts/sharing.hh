@@ -0,0 +1,36 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TS_SHARING_HH
+#define TCHECKER_TS_SHARING_HH
+
+/*!
+ \file sharing.hh
+ \brief Sharing of state components in transition systems
+ */
+
+namespace tchecker {
+
+namespace ts {
+
+/*!
+ \brief Type of sharing of state components
+ */
+enum sharing_type_t {
+  NO_SHARING,           /*!< Each state has its own components */
+  SHARING,              /*!< Equal components are shared among states (hash-consing) */
+  SHARING_NARROW_ZONES, /*!< As SHARING, and shared zones are stored with 16-bit difference
+                           bounds when possible (zone graphs only) */
+  SHARING_REDUCED_ZONES, /*!< As SHARING, and shared zones are stored as minimal sets of
+                            difference bounds (zone graphs only) */
+};
+
+} // end of namespace ts
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TS_SHARING_HH
@@ -8,6 +8,7 @@
 #ifndef TCHECKER_TS_HH
 #define TCHECKER_TS_HH
 
+#include <functional>
 #include <map>
 #include <tuple>
 #include <type_traits>
@@ -234,6 +235,65 @@ public:
    */
   virtual void next(CONST_STATE const & s, OUTGOING_EDGES_VALUE const & out_edge, std::vector<sst_t> & v) = 0;
 
+  /*!
+   \brief Next states and transitions with selected status
+   \param s : state
+   \param out_edge : outgoing edge value
+   \param v : container
+   \param mask : mask on next states
+   \post triples (status, s', t') have been added to v, for each successor state
+   s' and transition t from s to s' along outgoing edge out_edge such that status
+   matches mask (i.e. status & mask != 0)
+   \note the default implementation filters the successors computed by
+   next(s, out_edge, v) through a buffer owned by this transition system.
+   Transition systems may override it to avoid allocating successors that do
+   not match mask
+   */
+  virtual void next(CONST_STATE const & s, OUTGOING_EDGES_VALUE const & out_edge, std::vector<sst_t> & v,
+                    tchecker::state_status_t mask)
+  {
+    next(s, out_edge, _sst);
+    for (auto && [status, next_s, next_t] : _sst) {
+      if (status & mask)
+        v.push_back(std::make_tuple(status, next_s, next_t));
+    }
+    _sst.clear();
+  }
+
+  /*!
+   \brief Type of filters on next states
+   \note a filter returns true for the states that should be kept
+   */
+  using state_filter_t = std::function<bool(CONST_STATE const &)>;
+
+  /*!
+   \brief Next states and transitions with selected status, filtered
+   \param s : state
+   \param out_edge : outgoing edge value
+   \param v : container
+   \param mask : mask on next states
+   \param filter : filter on next states with status tchecker::STATE_OK
+   \post triples (status, s', t') have been added to v, for each successor state
+   s' and transition t from s to s' along outgoing edge out_edge such that status
+   matches mask (i.e. status & mask != 0). If status is tchecker::STATE_OK and s'
+   is not kept by filter, the triple has been added with a null pointer instead
+   of s'
+   \note the default implementation filters the successors computed by
+   next(s, out_edge, v, mask). Transition systems may override it to avoid
+   allocating the successor states that are not kept by filter
+   */
+  virtual void next(CONST_STATE const & s, OUTGOING_EDGES_VALUE const & out_edge, std::vector<sst_t> & v,
+                    tchecker::state_status_t mask, state_filter_t const & filter)
+  {
+    std::size_t const size = v.size();
+    next(s, out_edge, v, mask);
+    for (std::size_t i = size; i < v.size(); ++i) {
+      auto & [status, next_s, next_t] = v[i];
+      if (status == tchecker::STATE_OK && !filter(CONST_STATE{next_s}))
+        next_s = STATE{};
+    }
+  }
+
   /*!
   \brief Initial states and transitions with selected status
   \param v : container
@@ -265,16 +325,27 @@ public:
   */
   void next(CONST_STATE const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
   {
-    std::vector<sst_t> sst;
     OUTGOING_EDGES_RANGE out_edges = outgoing_edges(s);
-    for (OUTGOING_EDGES_VALUE && out_edge : out_edges) {
-      next(s, out_edge, sst);
-      for (auto && [status, next_s, next_t] : sst) {
-        if (status & mask)
-          v.push_back(std::make_tuple(status, next_s, next_t));
-      }
-      sst.clear();
-    }
+    for (OUTGOING_EDGES_VALUE && out_edge : out_edges)
+      next(s, out_edge, v, mask);
+  }
+
+  /*!
+  \brief Next states and transitions with selected status, filtered
+  \param s : state
+  \param v : container
+  \param mask : mask on next states
+  \param filter : filter on next states with status tchecker::STATE_OK
+  \post all tuples (status, s', t) such that s -t-> s' is a transition and the
+  status of s' matches mask (i.e. status & mask != 0) have been pushed to v,
+  with a null pointer instead of s' if status is tchecker::STATE_OK and s' is
+  not kept by filter
+  */
+  void next(CONST_STATE const & s, std::vector<sst_t> & v, tchecker::state_status_t mask, state_filter_t const & filter)
+  {
+    OUTGOING_EDGES_RANGE out_edges = outgoing_edges(s);
+    for (OUTGOING_EDGES_VALUE && out_edge : out_edges)
+      next(s, out_edge, v, mask, filter);
   }
 
   /*!
@@ -299,6 +370,9 @@ public:
   using tchecker::ts::ts_t<STATE, CONST_STATE, TRANSITION, CONST_TRANSITION>::transition;
   using tchecker::ts::ts_t<STATE, CONST_STATE, TRANSITION, CONST_TRANSITION>::satisfies;
   using tchecker::ts::ts_t<STATE, CONST_STATE, TRANSITION, CONST_TRANSITION>::attributes;
+
+private:
+  std::vector<sst_t> _sst; /*!< Buffer of successors, reused across calls to next */
 };
 
 } // end of namespace ts
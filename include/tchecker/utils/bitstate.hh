@@ -0,0 +1,123 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_BITSTATE_HH
+#define TCHECKER_BITSTATE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ \file bitstate.hh
+ \brief Bitstate hashing (supertrace)
+ */
+
+namespace tchecker {
+
+/*!
+ \class bitstate_t
+ \brief Probabilistic set of hash values
+ \note Each hash value is represented by k bits in a fixed-size bit array
+ (Holzmann's bitstate hashing). Membership is exact for inserted values, but
+ a value that has not been inserted may be considered as a member if its k
+ bits have been set by other values. The bit positions of a hash value are
+ obtained by double hashing
+ */
+class bitstate_t {
+public:
+  /*!
+   \brief Constructor
+   \param size : number of bits
+   \param hash_count : number of bits per hash value
+   \pre size > 0 and hash_count > 0
+   \post this is an empty set of size bits
+   \throw std::invalid_argument : if the precondition is violated
+   */
+  bitstate_t(std::size_t size, unsigned int hash_count = 3);
+
+  /*!
+   \brief Insertion
+   \param hash : a hash value
+   \post the bits of hash have been set
+   \return true if some bit of hash was not set (i.e. hash was not a member of
+   this set), false otherwise
+   */
+  bool insert(std::size_t hash);
+
+  /*!
+   \brief Membership predicate
+   \param hash : a hash value
+   \return true if all the bits of hash are set, false otherwise
+   */
+  bool contains(std::size_t hash) const;
+
+  /*!
+   \brief Accessor
+   \return number of bits
+   */
+  inline std::size_t size() const { return _size; }
+
+  /*!
+   \brief Accessor
+   \return number of bits per hash value
+   */
+  inline unsigned int hash_count() const { return _hash_count; }
+
+  /*!
+   \brief Accessor
+   \return number of set bits
+   */
+  inline std::size_t set_bits() const { return _set_bits; }
+
+  /*!
+   \brief Accessor
+   \return number of successful insertions
+   */
+  inline std::size_t inserted() const { return _inserted; }
+
+  /*!
+   \brief Accessor
+   \return probability that a value that has not been inserted is considered
+   as a member of this set
+   */
+  double omission_probability() const;
+
+  /*!
+   \brief Accessor
+   \return estimated number of values that were considered as members of this
+   set when inserted for the first time
+   \note every successful insertion contributes p/(1-p) where p is the
+   omission probability right after the insertion (infinity if p is 1)
+   */
+  inline double expected_omissions() const { return _expected_omissions; }
+
+  /*!
+   \brief Accessor
+   \return estimated ratio of distinct inserted values that have been
+   successfully inserted (0 if the bit array has been filled)
+   */
+  double estimated_coverage() const;
+
+  /*!
+   \brief Accessor
+   \return memory used by the bit array (in bytes)
+   */
+  inline std::size_t memsize() const { return _words.size() * sizeof(std::uint64_t); }
+
+private:
+  std::vector<std::uint64_t> _words; /*!< Bit array */
+  std::size_t _size;                 /*!< Number of bits */
+  unsigned int _hash_count;          /*!< Number of bits per hash value */
+  std::size_t _set_bits;             /*!< Number of set bits */
+  std::size_t _inserted;             /*!< Number of successful insertions */
+  double _expected_omissions;        /*!< Estimated number of omitted insertions */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_BITSTATE_HH
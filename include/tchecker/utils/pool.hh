@@ -9,6 +9,7 @@
 #define TCHECKER_POOL_HH
 
 #include "tchecker/utils/shared_objects.hh"
+#include "tchecker/utils/spill.hh"
 
 /*!
  \file pool.hh
@@ -27,6 +28,8 @@ namespace tchecker {
  size alloc_size. A block contains a fixed alloc_nb chunks. The size of a
  block is alloc_nb * alloc_size + sizeof(void *). The extra size for a pointer
  is used to maintain a simple linked list of blocks.
+ \note Blocks are allocated as spilled memory blocks if spilling is enabled
+ when the pool is constructed (see tchecker::spill)
  \note The pool is *NOT* thread-safe
  */
 template <class T> class pool_t {
@@ -82,8 +85,8 @@ public:
    */
   pool_t(std::size_t alloc_nb, std::size_t alloc_size)
       : _alloc_nb(alloc_nb), _alloc_size(std::max(alloc_size, MIN_ALLOC_SIZE)),
-        _block_size(_alloc_nb * _alloc_size + sizeof(void *)), _blocks_count(0), _free_head(nullptr), _block_head(nullptr),
-        _raw_head(nullptr), _raw_end(nullptr)
+        _block_size(_alloc_nb * _alloc_size + sizeof(void *)), _spill(tchecker::spill::enabled()), _blocks_count(0),
+        _free_head(nullptr), _block_head(nullptr), _raw_head(nullptr), _raw_end(nullptr)
   {
     if (_alloc_nb < 1)
       throw std::invalid_argument("allocation number should be >= 1");
@@ -158,13 +161,13 @@ public:
       return false;
 
     T * t = p.ptr();
+    p = nullptr; // release the last reference before the chunk is marked free
+
     T::destruct(t);
 
     typename T::refcount_t * chunk = reinterpret_cast<typename T::refcount_t *>(t) - 1;
     release(chunk);
 
-    p = nullptr;
-
     return true;
   }
 
@@ -266,7 +269,10 @@ public:
     while (p != nullptr) {
       tmp = p;
       p = nextblock(p);
-      delete[] static_cast<char *>(tmp);
+      if (_spill)
+        tchecker::spill::deallocate(tmp, _block_size);
+      else
+        delete[] static_cast<char *>(tmp);
     }
     _blocks_count = 0;
     _free_head = nullptr; // _free_head_lock access protection useless
@@ -355,7 +361,7 @@ protected:
   {
     assert(_raw_head == _raw_end);
     // allocate
-    _raw_head = new char[_block_size];
+    _raw_head = (_spill ? static_cast<char *>(tchecker::spill::allocate(_block_size)) : new char[_block_size]);
     _raw_end = _raw_head + _block_size;
     // link to allocated blocks
     nextblock(_raw_head) = _block_head;
@@ -427,6 +433,7 @@ protected:
   std::size_t const _alloc_nb;   /*!< number of chunks per block */
   std::size_t const _alloc_size; /*!< size of a chunk (bytes) */
   std::size_t const _block_size; /*!< size of a block (bytes) */
+  bool const _spill;             /*!< blocks are spilled memory blocks */
   std::size_t _blocks_count;     /*!< number of allocated blocks */
   char * _free_head;             /*!< head pointer to list of free chunks */
   char * _block_head;            /*!< head pointer to list of blocks */
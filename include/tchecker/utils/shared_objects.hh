@@ -285,6 +285,24 @@ std::size_t hash_value(tchecker::make_shared_t<T, REFCOUNT, RESERVED> const & sh
   return hash_value(static_cast<T const &>(shared));
 }
 
+/*!
+ \class shared_object_hash_t
+ \brief Hash functor for shared objects
+ */
+class shared_object_hash_t {
+public:
+  /*!
+   \brief Hash
+   \param shared : shared object
+   \return hash value for shared
+   */
+  template <class T, class REFCOUNT, std::size_t RESERVED>
+  inline std::size_t operator()(tchecker::make_shared_t<T, REFCOUNT, RESERVED> const & shared) const
+  {
+    return hash_value(shared);
+  }
+};
+
 // pointers to shared objects
 
 /*!
@@ -0,0 +1,95 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_SPILL_HH
+#define TCHECKER_SPILL_HH
+
+#include <cstddef>
+#include <string>
+
+/*!
+ \file spill.hh
+ \brief Spilling of allocated memory to disk
+ \note When spilling is enabled, pools (see tchecker::pool_t) allocate their
+ blocks as memory-mapped files in the spill directory instead of the heap. The
+ operating system can then write cold blocks (states, zones, nodes and edges
+ of graphs) back to disk and reclaim their memory, instead of running out of
+ memory. Hash tables and other indices remain in memory
+ */
+
+namespace tchecker {
+
+namespace spill {
+
+/*!
+ \brief Enable spilling
+ \param directory : a directory
+ \post memory blocks allocated by pools constructed from now on are mapped to
+ files in directory
+ \throw std::invalid_argument : if directory is not a writable directory
+ \note spilling should not be enabled or disabled while pools are constructed
+ concurrently
+ */
+void enable(std::string const & directory);
+
+/*!
+ \brief Disable spilling
+ \post memory blocks allocated by pools constructed from now on are allocated
+ from the heap
+ */
+void disable();
+
+/*!
+ \brief Accessor
+ \return true if spilling is enabled, false otherwise
+ */
+bool enabled();
+
+/*!
+ \brief Accessor
+ \return the spill directory if spilling is enabled, the empty string otherwise
+ */
+std::string const & directory();
+
+/*!
+ \brief Allocation of a spilled memory block
+ \param size : size of the block
+ \pre spilling is enabled
+ \return a block of size bytes mapped to an anonymous file in the spill
+ directory, or a deallocated block of the same size
+ \throw std::bad_alloc : if the file cannot be created, if disk space cannot be
+ reserved for the block, or if the file cannot be mapped
+ \note blocks are carved out of large regions of a single file per spill
+ directory. Disk space is reserved for each region before it is mapped, hence
+ writing to a block cannot fail when the disk is full. The file is removed from
+ the spill directory upon creation, hence it is deleted by the operating system
+ when the process terminates
+ \note thread-safe
+ */
+void * allocate(std::size_t size);
+
+/*!
+ \brief Deallocation of a spilled memory block
+ \param block : a memory block
+ \param size : size of block
+ \pre block has been allocated by tchecker::spill::allocate(size)
+ \post block will be reused by later allocations of size bytes
+ \note thread-safe
+ */
+void deallocate(void * block, std::size_t size);
+
+/*!
+ \brief Accessor
+ \return number of bytes currently allocated as spilled memory blocks
+ */
+std::size_t spilled_size();
+
+} // end of namespace spill
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SPILL_HH
@@ -10,6 +10,7 @@
 
 #include "tchecker/expression/typed_expression.hh"
 #include "tchecker/statement/typed_statement.hh"
+#include "tchecker/variables/intvars.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -40,6 +41,24 @@ tchecker::bytecode_t * compile(tchecker::typed_expression_t const & expr);
  */
 tchecker::bytecode_t * compile(tchecker::typed_statement_t const & stmt);
 
+/*!
+ \brief Bytecode optimizer
+ \param bytecode : bytecode
+ \param intvars : bounded integer variables
+ \pre bytecode is null-terminated (i.e. RET terminated) and well-formed.
+ Integer variable identifiers in bytecode are flattened identifiers of
+ variables in intvars
+ \return null-terminated bytecode equivalent to bytecode, where arithmetic
+ and logical instructions on constants have been folded, range checks that
+ always succeed w.r.t. the domains of the variables in intvars have been
+ removed, jumps to jumps have been threaded, and unreachable instructions,
+ no-operations and jumps to the next instruction have been removed
+ \throw std::invalid_argument : if bytecode contains a jump that does not land
+ on an instruction
+ \note the caller is responsible for deleting[] the returned value
+ */
+tchecker::bytecode_t * optimize(tchecker::bytecode_t const * bytecode, tchecker::integer_variables_t const & intvars);
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_VM_COMPILERS_HH
@@ -0,0 +1,196 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_VM_NATIVE_HH
+#define TCHECKER_VM_NATIVE_HH
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/vm.hh"
+
+/*!
+ \file native.hh
+ \brief Translation of bytecode to native code
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Environment of native functions
+ \note Native functions are loaded from a shared object that does not link
+ against TChecker. They output clock constraints and clock resets, and report
+ errors, through the callbacks in their environment. Layout shared with the
+ generated code (see tchecker::emit_native_function)
+ */
+struct native_environment_t {
+  void * clkconstr; /*!< Container of clock constraints */
+  void * clkreset;  /*!< Container of clock resets */
+  /*! Output a clock constraint (id1, id2, cmp, bound) to clkconstr, where cmp is 0 for < and 1 for <= */
+  void (*push_clkconstr)(void * clkconstr, std::uint32_t id1, std::uint32_t id2, int cmp, std::int64_t bound);
+  /*! Output a clock reset (id1, id2, value) to clkreset */
+  void (*push_clkreset)(void * clkreset, std::uint32_t id1, std::uint32_t id2, std::int64_t value);
+  /*! Throw the exception that the VM would throw on error (does not return) */
+  void (*fail)(int error, std::int64_t value, std::int64_t min, std::int64_t max);
+};
+
+/*!
+ \brief Type of native functions
+ \note a native function takes the valuation of the bounded integer variables
+ and an environment. It has the same semantics as the bytecode it has been
+ translated from (see tchecker::vm_t::run)
+ */
+using native_function_t = tchecker::integer_t (*)(tchecker::integer_t * intval, tchecker::native_environment_t * env);
+
+/*!
+ \brief Translation of bytecode to C++
+ \param os : output stream
+ \param name : name of the function
+ \param bytecode : sequence of bytecode instructions
+ \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+ \post if bytecode can be translated, the definition of an extern "C" function
+ named name of type tchecker::native_function_t, with the same semantics as
+ bytecode, has been output to os. Nothing has been output otherwise
+ \return true if bytecode has been translated, false otherwise
+ \note bytecode that accesses local variables is not translated. The generated
+ code needs the declarations output by tchecker::emit_native_prelude
+ */
+bool emit_native_function(std::ostream & os, std::string const & name, tchecker::bytecode_t const * bytecode);
+
+/*!
+ \brief Output of the declarations needed by generated functions
+ \param os : output stream
+ \post the declarations needed by functions output by
+ tchecker::emit_native_function have been output to os
+ */
+void emit_native_prelude(std::ostream & os);
+
+/*!
+ \brief Call to a native function
+ \param f : a native function
+ \param intval : valuation of bounded integer variables
+ \param clkconstr : container of clock constraints
+ \param clkreset : container of clock resets
+ \return see tchecker::vm_t::run
+ \post see tchecker::vm_t::run
+ \throw see tchecker::vm_t::run
+ */
+tchecker::integer_t run_native(tchecker::native_function_t f, tchecker::intvars_valuation_t & intval,
+                               tchecker::clock_constraint_container_t & clkconstr,
+                               tchecker::clock_reset_container_t & clkreset);
+
+/*!
+ \class native_library_t
+ \brief Native functions translated from bytecode and loaded from a shared
+ object
+ \note The shared object is built by the system compiler, and cached on disk
+ by hash of the generated source code: building a library for the same
+ bytecode with the same compiler loads the cached shared object
+ */
+class native_library_t {
+public:
+  /*!
+   \brief Constructor
+   \param programs : null-terminated bytecode programs
+   \param cache_dir : directory of cached shared objects, created with
+   permissions for the current user only if missing
+   \param compiler : C++ compiler command, split into words on white spaces and
+   run without a shell
+   \post programs have been translated to C++ and the resulting shared object
+   has been loaded, either from cache_dir, or after being built with compiler
+   and stored to cache_dir
+   \throw std::runtime_error : if native code is not supported on this
+   platform, if cache_dir cannot be created, if cache_dir or the shared object
+   is not owned by the current user or is writable by group or others, or if
+   compilation or loading of the shared object fails
+   */
+  native_library_t(std::vector<tchecker::bytecode_t const *> const & programs, std::string const & cache_dir,
+                   std::string const & compiler);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  native_library_t(tchecker::native_library_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  native_library_t(tchecker::native_library_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post the shared object has been unloaded
+   */
+  ~native_library_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::native_library_t & operator=(tchecker::native_library_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::native_library_t & operator=(tchecker::native_library_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \param k : index of a program
+   \pre k is less than the number of programs passed to the constructor
+   (checked by assertion)
+   \return native function for the k-th program, nullptr if it has not been
+   translated
+   */
+  tchecker::native_function_t function(std::size_t k) const;
+
+  /*!
+   \brief Accessor
+   \return path to the loaded shared object
+   */
+  std::string const & path() const;
+
+private:
+  void * _handle;                                      /*!< Handle of the loaded shared object */
+  std::string _path;                                   /*!< Path to the loaded shared object */
+  std::vector<tchecker::native_function_t> _functions; /*!< Native functions */
+};
+
+/*!
+ \brief Accessor
+ \return true if native code has been requested by setting environment
+ variable TCHECKER_NATIVE to a value other than 0, false otherwise
+ */
+bool native_code_requested();
+
+/*!
+ \brief Accessor
+ \return directory of cached shared objects: the value of environment variable
+ TCHECKER_NATIVE_CACHE if set, tchecker in the user cache directory
+ (XDG_CACHE_HOME if set to an absolute path, HOME/.cache otherwise)
+ \throw std::runtime_error : if none of TCHECKER_NATIVE_CACHE, XDG_CACHE_HOME
+ and HOME is set
+ \note the directory must not be shared with other users: the constructor of
+ tchecker::native_library_t refuses to load code from it otherwise
+ */
+std::string native_cache_directory();
+
+/*!
+ \brief Accessor
+ \return C++ compiler command: the value of environment variable
+ TCHECKER_NATIVE_CXX if set, c++ otherwise. The command is split into words on
+ white spaces, and run without a shell
+ */
+std::string native_compiler();
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_NATIVE_HH
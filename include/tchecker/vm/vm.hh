@@ -8,6 +8,7 @@
 #ifndef TCHECKER_VM_HH
 #define TCHECKER_VM_HH
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <exception>
@@ -65,13 +66,23 @@ enum instruction_t {
   //
   VM_PUSH_FRAME,    // push a new frame for local variables
   VM_POP_FRAME,     // pop the top-level frame
+  //                   local variables are identified by dense slot indices in the stack of frames (see tchecker::vm_t)
   VM_VALUEAT_FRAME, // stack = v1 ... vK-1 [vK]
                     // vK is replaced by the value of the local variable identified by vK.
   VM_ASSIGN_FRAME,  // stack = v1 ... vK-2
                     // [vK-1] is assigned vK where vK-1 identifies a local variables.
   VM_INIT_FRAME,    // stack = v1 ... vK-2
                     // [vK-1] is initialized with vK where vK-1 identifies a local variables.
-  VM_NOP,           // SHOULD BE LAST INSTRUCTION
+  //
+  // superinstructions (see tchecker::fuse_superinstructions)
+  VM_PUSH_VALUEAT,     // stack = v1 ... vK [id]               where id is a parameter of VM_PUSH_VALUEAT
+  VM_PUSH_VALUEAT_CMP, // stack = v1 ... vK ([id] cmp v)       where id, v and cmp (one of VM_EQ, VM_GE, VM_GT,
+  //                                                         VM_LT, VM_LE, VM_NE) are parameters of VM_PUSH_VALUEAT_CMP
+  VM_CLKCONSTR_CONST, // stack = v1 ... vK                    output (id1 id2 s b) where id1, id2, b and s
+  //                                                         (strictness) are parameters of VM_CLKCONSTR_CONST
+  VM_CLKRESET_CONST, // stack = v1 ... vK                    output (id1 id2 v) where id1, id2 and v are
+  //                                                         parameters of VM_CLKRESET_CONST
+  VM_NOP,            // SHOULD BE LAST INSTRUCTION
 };
 
 /*!
@@ -122,6 +133,31 @@ std::ostream & output(std::ostream & os, tchecker::bytecode_t const * bytecode);
  */
 std::size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * bytecode);
 
+/*!
+ \brief Size of an instruction
+ \param bytecode : sequence of bytecode instructions
+ \pre bytecode points to a well-formed instruction
+ \return the number of bytes of the instruction pointed by bytecode (i.e. 1
+ plus the number of its parameters)
+ \throw std::invalid_argument : if bytecode does not point to an instruction
+ */
+std::size_t instruction_size(tchecker::bytecode_t const * bytecode);
+
+/*!
+ \brief Superinstructions
+ \param bytecode : sequence of bytecode instructions
+ \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+ \return null-terminated bytecode equivalent to bytecode, where the sequences
+ of instructions emitted by tchecker::compile for reading an integer variable,
+ comparing an integer variable to a constant, and for clock constraints and
+ clock resets with constant operands, have been replaced by a single
+ superinstruction (VM_PUSH_VALUEAT, VM_PUSH_VALUEAT_CMP, VM_CLKCONSTR_CONST
+ and VM_CLKRESET_CONST). Jump offsets have been updated accordingly
+ \note sequences that contain the target of a jump are left unchanged
+ \note the caller is responsible for deleting[] the returned value
+ */
+tchecker::bytecode_t * fuse_superinstructions(tchecker::bytecode_t const * bytecode);
+
 // Virtual machine (VM)
 
 /*!
@@ -132,8 +168,9 @@ class vm_t {
 public:
   /*!
    \brief Constructor
+   \post the stack of frames has been preallocated
    */
-  vm_t() = default;
+  vm_t() : _return(false), _slots(SLOTS_CAPACITY), _slots_top(0) { _frames.reserve(FRAMES_CAPACITY); }
 
   /*!
    \brief Copy constructor
@@ -177,20 +214,42 @@ public:
    intval has been updated,
    clock constraints have been pushed into clkconstr,
    and clock resets have been pushed into clkreset
-   \throw std::runtime_error : if bytecode interpretation fails
+   \throw std::runtime_error : if bytecode interpretation fails, or if the
+   interpretation stack overflows
    \throw std::out_of_range : if out-of-bound array access
    \note Evaluating a bytecode from an expression returns 0 for false and any
    other value for true
    \note Evaluating a bytecode from a statement always returns 1. It throws an
    exception if evaluation failed.
+   \note Instructions are dispatched by direct threading (computed goto) on
+   compilers that support it, and the interpretation stack is preallocated.
+   Falls back to run_switch otherwise
    */
   tchecker::integer_t run(tchecker::bytecode_t const * bytecode, tchecker::intvars_valuation_t & intval,
-                          tchecker::clock_constraint_container_t & clkconstr, tchecker::clock_reset_container_t & clkreset)
+                          tchecker::clock_constraint_container_t & clkconstr, tchecker::clock_reset_container_t & clkreset);
+
+  /*!
+   \brief Reference bytecode interpreter
+   \param bytecode : tchecker bytecode
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \pre see run
+   \return see run
+   \post see run
+   \throw see run
+   \note Instructions are interpreted one at a time by a switch statement.
+   Same semantics as run
+   */
+  tchecker::integer_t run_switch(tchecker::bytecode_t const * bytecode, tchecker::intvars_valuation_t & intval,
+                                 tchecker::clock_constraint_container_t & clkconstr,
+                                 tchecker::clock_reset_container_t & clkreset)
   {
     assert(size() == 0); // stack should be empty
 
     tchecker::integer_t eval = 0;
     _return = false;
+    clear_frames();
 
     do {
       try {
@@ -453,14 +512,54 @@ protected:
       return 1;
     }
 
+      // stack = v1 ... vK [id]   where id is a parameter of VM_PUSH_VALUEAT
+    case VM_PUSH_VALUEAT: {
+      auto const id = static_cast<tchecker::intvar_id_t>(*++bytecode);
+      assert(id < intval.size());
+      push<tchecker::integer_t>(intval[id]);
+      return top<tchecker::integer_t>();
+    }
+
+      // stack = v1 ... vK ([id] cmp v)   where id, v and cmp are parameters
+      // of VM_PUSH_VALUEAT_CMP
+    case VM_PUSH_VALUEAT_CMP: {
+      auto const id = static_cast<tchecker::intvar_id_t>(*++bytecode);
+      auto const v = static_cast<tchecker::integer_t>(*++bytecode);
+      tchecker::bytecode_t const cmp = *++bytecode;
+      assert(id < intval.size());
+      push<tchecker::integer_t>(compare(cmp, intval[id], v));
+      return top<tchecker::integer_t>();
+    }
+
+      // stack = v1 ... vK   output (id1 id2 s b)   where id1, id2, b and s
+      // are parameters of VM_CLKCONSTR_CONST
+    case VM_CLKCONSTR_CONST: {
+      auto const id1 = static_cast<tchecker::clock_id_t>(*++bytecode);
+      auto const id2 = static_cast<tchecker::clock_id_t>(*++bytecode);
+      auto const bound = static_cast<tchecker::integer_t>(*++bytecode);
+      tchecker::bytecode_t const cmp = *++bytecode;
+      clkconstr.emplace_back(id1, id2, (cmp == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE), bound);
+      return 1;
+    }
+
+      // stack = v1 ... vK   output (id1 id2 v)   where id1, id2 and v are
+      // parameters of VM_CLKRESET_CONST
+    case VM_CLKRESET_CONST: {
+      auto const left_id = static_cast<tchecker::clock_id_t>(*++bytecode);
+      auto const right_id = static_cast<tchecker::clock_id_t>(*++bytecode);
+      auto const value = static_cast<tchecker::integer_t>(*++bytecode);
+      clkreset.emplace_back(left_id, right_id, value);
+      return 1;
+    }
+
       // push a new frame for local variables
     case VM_PUSH_FRAME: {
-      _frames.emplace_back();
+      push_frame();
       return 1;
     }
       // pop the top-level frame
     case VM_POP_FRAME: {
-      _frames.pop_back();
+      pop_frame();
       return 1;
     }
 
@@ -484,9 +583,9 @@ protected:
       // stack = v1 ... vK-2
       // [vK-1] is initialized with vK where vK-1 identifies a local variables.
     case VM_INIT_FRAME: {
-      auto const value = top_and_pop<tchecker::intvar_id_t>();
+      auto const value = top_and_pop<tchecker::integer_t>();
       auto const id = top_and_pop<tchecker::intvar_id_t>();
-      _frames.back()[id] = value;
+      init_slot(id, value);
 
       return 0;
     }
@@ -496,22 +595,97 @@ protected:
     throw std::runtime_error("incomplete switch statement");
   }
 
-  using frame_t = std::map<tchecker::bytecode_t, tchecker::integer_t>;
+  // frames of local variables
+
+  /*!
+   \brief Clear the stack of frames
+   \post the stack of frames is empty
+   */
+  inline void clear_frames()
+  {
+    _frames.clear();
+    _slots_top = 0;
+  }
+
+  /*!
+   \brief Push a frame
+   \post a new frame has been pushed on top of the stack of frames
+   */
+  inline void push_frame() { _frames.push_back(_slots_top); }
+
+  /*!
+   \brief Pop a frame
+   \pre the stack of frames is not empty (checked by assertion)
+   \post the top-level frame has been popped, its local variables are not
+   accessible anymore
+   */
+  inline void pop_frame()
+  {
+    assert(!_frames.empty());
+    _slots_top = _frames.back();
+    _frames.pop_back();
+  }
+
+  /*!
+   \brief Initialize a local variable in the top-level frame
+   \param id : identifier of the local variable
+   \param value : initial value
+   \post the slot of id has been set to value, and the stack of slots has been
+   grown if needed
+   \throw std::out_of_range : if id is negative
+   */
+  inline void init_slot(tchecker::bytecode_t id, tchecker::integer_t value)
+  {
+    if (id < 0)
+      throw std::out_of_range("unknown local variable ID");
+    auto const slot = static_cast<std::size_t>(id);
+    if (slot >= _slots.size())
+      _slots.resize(slot + 1);
+    _slots[slot] = value;
+    if (slot >= _slots_top)
+      _slots_top = slot + 1;
+  }
 
   /*!
    \brief Look for a local variable in the stack of frames
    \param id the identifier of the local variable
    \return the lvalue of this variable
-   \throw std::out_of_range is the variable is not found.s
+   \throw std::out_of_range : if the variable is not in a live frame
+   */
+  inline tchecker::integer_t & slot_of(tchecker::bytecode_t id)
+  {
+    if (id < 0 || static_cast<std::size_t>(id) >= _slots_top)
+      throw std::out_of_range("unknown local variable ID");
+    return _slots[static_cast<std::size_t>(id)];
+  }
+
+  /*!
+   \brief Comparison
+   \param cmp : comparison instruction (one of VM_EQ, VM_GE, VM_GT, VM_LT, VM_LE,
+   VM_NE)
+   \param left : left operand
+   \param right : right operand
+   \return result of (left cmp right)
+   \throw std::runtime_error : if cmp is not a comparison instruction
    */
-  tchecker::integer_t & slot_of(tchecker::bytecode_t id)
+  inline static tchecker::integer_t compare(tchecker::bytecode_t cmp, tchecker::integer_t left, tchecker::integer_t right)
   {
-    for (auto it = _frames.rbegin(); it != _frames.rend(); ++it) {
-      auto kv = it->find(id);
-      if (kv != it->end())
-        return kv->second;
+    switch (cmp) {
+    case VM_EQ:
+      return left == right;
+    case VM_GE:
+      return left >= right;
+    case VM_GT:
+      return left > right;
+    case VM_LT:
+      return left < right;
+    case VM_LE:
+      return left <= right;
+    case VM_NE:
+      return left != right;
+    default:
+      throw std::runtime_error("vm_t::compare, not a comparison instruction");
     }
-    throw std::out_of_range("unknown local variable ID");
   }
 
   // integer domain checking
@@ -531,6 +705,20 @@ protected:
     return ((val >= std::numeric_limits<EXPECTED>::min()) && (val <= std::numeric_limits<EXPECTED>::max()));
   }
 
+  /*!
+   \brief Checked conversion
+   \tparam T : expected integer type
+   \param val : value
+   \return val casted to T
+   \throw std::runtime_error : if val cannot be represented by type T
+   */
+  template <class T> inline static T value_as(tchecker::bytecode_t val)
+  {
+    if (!contains_value<T>(val))
+      throw std::runtime_error("vm_t::run, value out-of-bounds");
+    return static_cast<T>(val);
+  }
+
   // stack operations
 
   /*!
@@ -591,11 +779,35 @@ protected:
    */
   inline std::size_t size() const { return _stack.size(); }
 
+  /*!
+   \brief Capacity of the preallocated interpretation stack of run
+   */
+  static constexpr std::size_t STACK_CAPACITY = 1024;
+
   bool _return;                             /*!< Return flag */
-  std::vector<tchecker::bytecode_t> _stack; /*!< Interpretation stack */
+  std::vector<tchecker::bytecode_t> _stack; /*!< Interpretation stack of run_switch */
   // NB: implemented as an std::vector for methods clear() and size()
+  std::array<tchecker::bytecode_t, STACK_CAPACITY> _fixed_stack; /*!< Interpretation stack of run */
 
-  std::vector<frame_t> _frames;
+  /*!
+   \brief Number of preallocated slots for local variables
+   */
+  static constexpr std::size_t SLOTS_CAPACITY = 64;
+
+  /*!
+   \brief Number of preallocated frames
+   */
+  static constexpr std::size_t FRAMES_CAPACITY = 16;
+
+  // NB: the identifiers of the local variables in a statement are allocated in
+  // a stack discipline by the typechecker: the variables in a frame have
+  // identifiers that are greater than those in the enclosing frames, and
+  // identifiers are only reused once the frame that declared them has been
+  // popped. Hence, identifiers are used as slot indices, and a frame is the
+  // range of slots above the top of the enclosing frame
+  std::vector<tchecker::integer_t> _slots; /*!< Slots of local variables, indexed by identifiers */
+  std::size_t _slots_top;                  /*!< Number of slots in live frames */
+  std::vector<std::size_t> _frames;        /*!< Number of slots in live frames below each frame */
 };
 
 } // end of namespace tchecker
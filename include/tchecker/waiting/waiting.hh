@@ -109,6 +109,13 @@ public:
   */
   element_t();
 
+  /*!
+   \brief Accessor
+   \return true if this element is waiting in a fast remove waiting container,
+   false otherwise
+   */
+  inline bool is_waiting() const { return _status == tchecker::waiting::WAITING; }
+
 protected:
   template <class W> friend class fast_remove_waiting_t;
 
@@ -8,11 +8,17 @@
 #ifndef TCHECKER_ZG_ALLOCATORS_HH
 #define TCHECKER_ZG_ALLOCATORS_HH
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "tchecker/ta/allocators.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
+#include "tchecker/utils/cache.hh"
 
 /*!
  \file allocators.hh
@@ -60,14 +66,22 @@ public:
    variables
    \param zone_alloc_nb : number of zones allocated in one block
    \param zone_dimension : dimension of allocated zones
+   \param shared_zone_storage : storage of shared zones
+   \note shared zones that cannot be stored w.r.t. shared_zone_storage are
+   stored as wide zones
    */
   state_pool_allocator_t(std::size_t state_alloc_nb, std::size_t vloc_alloc_nb, std::size_t vloc_capacity,
                          std::size_t intval_alloc_nb, std::size_t intval_capacity, std::size_t zone_alloc_nb,
-                         std::size_t zone_dimension)
+                         std::size_t zone_dimension,
+                         enum tchecker::zg::zone_storage_t shared_zone_storage = tchecker::zg::WIDE_STORAGE)
       : tchecker::ta::details::state_pool_allocator_t<STATE>(state_alloc_nb, vloc_alloc_nb, vloc_capacity, intval_alloc_nb,
                                                              intval_capacity),
-        _zone_dimension(zone_dimension),
-        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension))
+        _zone_alloc_nb(zone_alloc_nb), _zone_dimension(zone_dimension), _shared_zone_storage(shared_zone_storage),
+        _zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension)),
+        _narrow_zone_pool(zone_alloc_nb, tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(
+                                             _zone_dimension, tchecker::zg::NARROW_STORAGE)),
+        _reduced_zone_pools(_zone_dimension * (_zone_dimension - 1) + 1),
+        _reduced_dbm(_shared_zone_storage == tchecker::zg::REDUCED_STORAGE ? _zone_dimension * (_zone_dimension - 1) : 0)
   {
   }
 
@@ -118,6 +132,37 @@ public:
     return tchecker::zg::details::state_pool_allocator_t<STATE>::construct_from_state(s);
   }
 
+  /*!
+   \brief Share components of a state
+   \param s : a state
+   \post the tuple of locations, the valuation of bounded integer variables and
+   the zone in s have been replaced by equal ones stored by this allocator if
+   any, otherwise they have been stored by this allocator. The zone is stored
+   w.r.t. the storage of shared zones if possible, and as a wide zone otherwise
+   \note s and its components should not be modified afterwards, since they may
+   be shared with other states
+   */
+  void share(STATE & s)
+  {
+    tchecker::ta::details::state_pool_allocator_t<STATE>::share(s);
+    if (_zone_cache.get() == nullptr)
+      _zone_cache.reset(new zone_cache_t);
+
+    tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> zone_ptr = s.zone_ptr();
+    tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> stored_zone_ptr = construct_shared_zone(*zone_ptr);
+    if (stored_zone_ptr.ptr() != nullptr) {
+      s.zone_ptr() = _zone_cache->find_else_insert(stored_zone_ptr);
+      if (s.zone_ptr() != stored_zone_ptr) // an equal zone was already stored
+        zone_pool(*stored_zone_ptr).destruct(stored_zone_ptr);
+    }
+    else
+      s.zone_ptr() = _zone_cache->find_else_insert(zone_ptr);
+
+    // the zone of s before sharing is no longer used if it has been replaced
+    if (s.zone_ptr() != zone_ptr)
+      zone_pool(*zone_ptr).destruct(zone_ptr);
+  }
+
   /*!
    \brief Destruct state
    \param p : pointer to state
@@ -138,7 +183,7 @@ public:
     if (!tchecker::ta::details::state_pool_allocator_t<STATE>::destruct(p))
       return false;
 
-    _zone_pool.destruct(zone_ptr);
+    zone_pool(*zone_ptr).destruct(zone_ptr);
 
     return true;
   }
@@ -150,7 +195,13 @@ public:
   void collect()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::collect();
+    if (_zone_cache.get() != nullptr)
+      _zone_cache->collect();
     _zone_pool.collect();
+    _narrow_zone_pool.collect();
+    for (auto & pool : _reduced_zone_pools)
+      if (pool.get() != nullptr)
+        pool->collect();
   }
 
   /*!
@@ -163,14 +214,28 @@ public:
   void destruct_all()
   {
     tchecker::ta::details::state_pool_allocator_t<STATE>::destruct_all();
+    if (_zone_cache.get() != nullptr)
+      _zone_cache->clear();
     _zone_pool.destruct_all();
+    _narrow_zone_pool.destruct_all();
+    for (auto & pool : _reduced_zone_pools)
+      if (pool.get() != nullptr)
+        pool->destruct_all();
   }
 
   /*!
    \brief Accessor
    \return Memory used by this state allocator
    */
-  std::size_t memsize() const { return tchecker::ta::details::state_pool_allocator_t<STATE>::memsize() + _zone_pool.memsize(); }
+  std::size_t memsize() const
+  {
+    std::size_t size = tchecker::ta::details::state_pool_allocator_t<STATE>::memsize() + _zone_pool.memsize() +
+                       _narrow_zone_pool.memsize();
+    for (auto const & pool : _reduced_zone_pools)
+      if (pool.get() != nullptr)
+        size += pool->memsize();
+    return size;
+  }
 
 protected:
   /*!
@@ -185,8 +250,87 @@ protected:
                                                                                       args...);
   }
 
-  std::size_t _zone_dimension;                              /*!< Dimension of allocated zones */
-  tchecker::pool_t<tchecker::zg::shared_zone_t> _zone_pool; /*!< Pool of zones */
+  /*!
+   \brief Type of cache of zones
+   */
+  using zone_cache_t = tchecker::cache_t<tchecker::zg::shared_zone_t, tchecker::shared_object_hash_t,
+                                         std::equal_to<tchecker::zg::shared_zone_t>>;
+
+  /*!
+   \brief Accessor
+   \param zone : a zone
+   \pre zone has been allocated by this allocator
+   \return the pool that zone has been allocated from
+   */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> & zone_pool(tchecker::zg::shared_zone_t const & zone)
+  {
+    switch (zone.storage()) {
+    case tchecker::zg::NARROW_STORAGE:
+      return _narrow_zone_pool;
+    case tchecker::zg::REDUCED_STORAGE:
+      return reduced_zone_pool(zone.reduced_size());
+    default:
+      return _zone_pool;
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \param size : number of difference bounds
+   \return the pool of reduced zones with size difference bounds (allocated on first use)
+   \note reduced zones are spread over many pools, which hence allocate smaller blocks
+   */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> & reduced_zone_pool(std::size_t size)
+  {
+    assert(size < _reduced_zone_pools.size());
+    std::unique_ptr<tchecker::pool_t<tchecker::zg::shared_zone_t>> & pool = _reduced_zone_pools[size];
+    if (pool.get() == nullptr)
+      pool.reset(new tchecker::pool_t<tchecker::zg::shared_zone_t>(
+          std::max<std::size_t>(_zone_alloc_nb / _zone_dimension, 1),
+          tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(_zone_dimension, tchecker::zg::REDUCED_STORAGE,
+                                                                               size)));
+    return *pool;
+  }
+
+  /*!
+   \brief Construct a zone for sharing
+   \param zone : a zone
+   \return a copy of zone stored w.r.t. the storage of shared zones, nullptr if
+   shared zones are wide, or if zone cannot be stored w.r.t. the storage of
+   shared zones
+   */
+  tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> construct_shared_zone(tchecker::zg::zone_t const & zone)
+  {
+    if (zone.storage() != tchecker::zg::WIDE_STORAGE)
+      return tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t>{nullptr};
+    switch (_shared_zone_storage) {
+    case tchecker::zg::NARROW_STORAGE:
+      if (zone.is_narrowable())
+        return _narrow_zone_pool.construct(zone, tchecker::zg::NARROW_STORAGE);
+      break;
+    case tchecker::zg::REDUCED_STORAGE:
+      if (!zone.is_empty()) {
+        // zones are reduced once, and kept wide if their reduced DBM is not smaller
+        std::size_t size = tchecker::dbm::reduce(_reduced_dbm.data(), zone.dbm(), _zone_dimension);
+        if (size * sizeof(tchecker::dbm::reduced_db_t) < _zone_dimension * _zone_dimension * sizeof(tchecker::dbm::db_t))
+          return reduced_zone_pool(size).construct(_zone_dimension, _reduced_dbm.data(), size);
+      }
+      break;
+    default:
+      break;
+    }
+    return tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t>{nullptr};
+  }
+
+  std::size_t _zone_alloc_nb;                                      /*!< Number of zones allocated in one block */
+  std::size_t _zone_dimension;                                     /*!< Dimension of allocated zones */
+  enum tchecker::zg::zone_storage_t _shared_zone_storage;          /*!< Storage of shared zones */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> _zone_pool;        /*!< Pool of (wide) zones */
+  tchecker::pool_t<tchecker::zg::shared_zone_t> _narrow_zone_pool; /*!< Pool of narrow zones */
+  std::vector<std::unique_ptr<tchecker::pool_t<tchecker::zg::shared_zone_t>>>
+      _reduced_zone_pools;                   /*!< Pools of reduced zones, indexed by their number of difference bounds */
+  std::unique_ptr<zone_cache_t> _zone_cache; /*!< Shared zones (allocated on first use) */
+  std::vector<tchecker::dbm::reduced_db_t> _reduced_dbm; /*!< Reduced DBM of the zone being shared */
 };
 
 /*!
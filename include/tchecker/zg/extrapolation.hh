@@ -14,6 +14,7 @@
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/operations.hh"
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/ta/system.hh"
 
@@ -41,10 +42,12 @@ public:
    \brief Zone extrapolation
    \param dbm : a dbm
    \param dim : dimension of dbm
+   \param dbm_operations : operations on DBMs of dimension dim
    \param vloc : a tuple of locations
    \post dbm has been extrapolated using clocks bounds in vloc
    */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc) = 0;
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc) = 0;
 };
 
 /*!
@@ -62,10 +65,12 @@ public:
    \brief Zone extrapolation
    \param dbm : a dbm
    \param dim : dimension of dbm
+   \param dbm_operations : operations on DBMs of dimension dim
    \param vloc : a tuple of locations
    \post dbm has not been modified
    */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 namespace details {
@@ -131,11 +136,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraLU has been applied to dbm with global LU clock bounds
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 /*!
@@ -155,11 +162,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraLU+ has been applied to dbm with global LU clock bounds
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 namespace details {
@@ -179,32 +188,32 @@ public:
   /*!
   \brief Copy constructor
   */
-  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e);
+  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e) = default;
 
   /*!
   \brief Move constructor
   */
-  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e);
+  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e) = default;
 
   /*!
    \brief Destructor
   */
-  virtual ~local_lu_extrapolation_t();
+  virtual ~local_lu_extrapolation_t() = default;
 
   /*!
   \brief Assignment operator
   */
-  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t const & e);
+  tchecker::zg::details::local_lu_extrapolation_t &
+  operator=(tchecker::zg::details::local_lu_extrapolation_t const & e) = default;
 
   /*!
   \brief Move-assignment operator
   */
-  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t && e);
+  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t && e) = default;
 
 protected:
-  tchecker::clockbounds::map_t * _l;                                          /*!< clock bounds L map */
-  tchecker::clockbounds::map_t * _u;                                          /*!< clock bounds U map */
   std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< local LU clock bounds map */
+  tchecker::clockbounds::local_lu_cache_t _cache;                             /*!< LU clock bounds of tuples of locations */
 };
 
 } // end of namespace details
@@ -226,11 +235,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraLU has been applied to dbm with local LU clock bounds in vloc
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 /*!
@@ -250,11 +261,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraLU+ has been applied to dbm with local LU clock bounds in vloc
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 namespace details {
@@ -320,11 +333,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraM has been applied to dbm with global M clock bounds
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 /*!
@@ -344,11 +359,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraM+ has been applied to dbm with global M clock bounds
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 namespace details {
@@ -368,31 +385,32 @@ public:
   /*!
   \brief Copy constructor
   */
-  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e);
+  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e) = default;
 
   /*!
   \brief Move constructor
   */
-  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e);
+  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e) = default;
 
   /*!
    \brief Destructor
   */
-  virtual ~local_m_extrapolation_t();
+  virtual ~local_m_extrapolation_t() = default;
 
   /*!
   \brief Assignment operator
   */
-  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t const & e);
+  tchecker::zg::details::local_m_extrapolation_t &
+  operator=(tchecker::zg::details::local_m_extrapolation_t const & e) = default;
 
   /*!
   \brief Move-assignment operator
   */
-  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t && e);
+  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t && e) = default;
 
 protected:
-  tchecker::clockbounds::map_t * _m;                                         /*!< clock bounds M map */
   std::shared_ptr<tchecker::clockbounds::local_m_map_t const> _clock_bounds; /*!< local M clock bounds map */
+  tchecker::clockbounds::local_m_cache_t _cache;                             /*!< M clock bounds of tuples of locations */
 };
 
 } // end of namespace details
@@ -414,11 +432,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraM has been applied to dbm with local M clock bounds in vloc
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 /*!
@@ -438,11 +458,13 @@ public:
   \brief Zone extrapolation
   \param dbm : a dbm
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param vloc : a tuple of locations
   \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
   \post ExtraM+ has been applied to dbm with local M clock bounds in vloc
  */
-  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                           tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc);
 };
 
 /*!
@@ -10,7 +10,9 @@
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/operations.hh"
 #include "tchecker/variables/clocks.hh"
+#include "tchecker/zg/zone.hh"
 
 /*!
  \file semantics.hh
@@ -36,19 +38,22 @@ public:
   \brief Compute initial zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param delay_allowed : true if delay is allowed in initial state
   \param invariant : invariant
   \post dbm is the initial zone w.r.t. delay_allowed and invariant
   \return STATE_OK if the resulting dbm is not empty, other values if the
   resulting dbm is empty (see details in implementations)
    */
-  virtual tchecker::state_status_t initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool delay_allowed,
+  virtual tchecker::state_status_t initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                           tchecker::dbm::operations_t const & dbm_operations, bool delay_allowed,
                                            tchecker::clock_constraint_container_t const & invariant) = 0;
 
   /*!
   \brief Compute next zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param src_delay_allowed : true if delay allowed in source state
   \param src_invariant : invariant in source state
   \param guard : transition guard
@@ -60,11 +65,26 @@ public:
   \return STATE_OK if the resulting dbm is not empty, other values if the resulting
   dbm is empty (see details in implementations)
    */
-  virtual tchecker::state_status_t next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+  virtual tchecker::state_status_t next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                        tchecker::dbm::operations_t const & dbm_operations, bool src_delay_allowed,
                                         tchecker::clock_constraint_container_t const & src_invariant,
                                         tchecker::clock_constraint_container_t const & guard,
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant) = 0;
+
+  /*!
+  \brief Check if a transition is disabled from a zone
+  \param zone : a zone
+  \param src_delay_allowed : true if delay allowed in source state
+  \param guard : transition guard
+  \return true if some constraint in guard is not satisfied by any valuation
+  that next intersects with guard when computing from zone, false otherwise
+  \note true implies that next yields an empty zone from zone, whereas false does
+  not tell anything. The constraints in guard are checked against the bounds in
+  zone, which is neither copied nor modified
+   */
+  virtual bool disabled(tchecker::zg::zone_t const & zone, bool src_delay_allowed,
+                        tchecker::clock_constraint_container_t const & guard) const = 0;
 };
 
 /*!
@@ -83,6 +103,7 @@ public:
   \brief Compute initial zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param delay_allowed : true if delay is allowed in initial state
   \param invariant : invariant
   \post dbm is the zone that only containts the zero valuation
@@ -90,13 +111,15 @@ public:
   tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED if the zero valuation does not
   satisfy invariant.
    */
-  virtual tchecker::state_status_t initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool delay_allowed,
+  virtual tchecker::state_status_t initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                           tchecker::dbm::operations_t const & dbm_operations, bool delay_allowed,
                                            tchecker::clock_constraint_container_t const & invariant);
 
   /*!
   \brief Compute next zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param src_delay_allowed : true if delay allowed in source state
   \param src_invariant : invariant in source state
   \param guard : transition guard
@@ -113,11 +136,25 @@ public:
   tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED if intersection with
   tgt_invariant result in an empty zone
   */
-  virtual tchecker::state_status_t next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+  virtual tchecker::state_status_t next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                        tchecker::dbm::operations_t const & dbm_operations, bool src_delay_allowed,
                                         tchecker::clock_constraint_container_t const & src_invariant,
                                         tchecker::clock_constraint_container_t const & guard,
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant);
+
+  /*!
+  \brief Check if a transition is disabled from a zone
+  \param zone : a zone
+  \param src_delay_allowed : true if delay allowed in source state
+  \param guard : transition guard
+  \return true if some constraint in guard is not satisfied by any valuation in
+  zone, false otherwise
+  \note if src_delay_allowed, only the constraints that are not weakened by
+  delay (i.e. all but lower bounds x>=c, x>c) are checked
+  */
+  virtual bool disabled(tchecker::zg::zone_t const & zone, bool src_delay_allowed,
+                        tchecker::clock_constraint_container_t const & guard) const;
 };
 
 /*!
@@ -136,6 +173,7 @@ public:
   \brief Compute initial zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param delay_allowed : true if delay is allowed in initial state
   \param invariant : invariant
   \post dbm is the zone that contains all the time successors of the zero
@@ -145,13 +183,15 @@ public:
   tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED if the (time successors of the)
   zero valuation does not satisfy invariant.
    */
-  virtual tchecker::state_status_t initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool delay_allowed,
+  virtual tchecker::state_status_t initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                           tchecker::dbm::operations_t const & dbm_operations, bool delay_allowed,
                                            tchecker::clock_constraint_container_t const & invariant);
 
   /*!
   \brief Compute next zone
   \param dbm : a DBM
   \param dim : dimension of dbm
+  \param dbm_operations : operations on DBMs of dimension dim
   \param src_delay_allowed : true if delay allowed in source state
   \param src_invariant : invariant in source state
   \param guard : transition guard
@@ -168,11 +208,23 @@ public:
   tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED if intersection with
   tgt_invariant result in an empty zone
   */
-  virtual tchecker::state_status_t next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+  virtual tchecker::state_status_t next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                        tchecker::dbm::operations_t const & dbm_operations, bool src_delay_allowed,
                                         tchecker::clock_constraint_container_t const & src_invariant,
                                         tchecker::clock_constraint_container_t const & guard,
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant);
+
+  /*!
+  \brief Check if a transition is disabled from a zone
+  \param zone : a zone
+  \param src_delay_allowed : true if delay allowed in source state
+  \param guard : transition guard
+  \return true if some constraint in guard is not satisfied by any valuation in
+  zone, false otherwise
+  */
+  virtual bool disabled(tchecker::zg::zone_t const & zone, bool src_delay_allowed,
+                        tchecker::clock_constraint_container_t const & guard) const;
 };
 
 /*!
@@ -9,13 +9,17 @@
 #define TCHECKER_ZG_HH
 
 #include <cstdlib>
+#include <memory>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/dbm/operations.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/symmetry.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/ta/ta.hh"
+#include "tchecker/ts/sharing.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/variables/intvars.hh"
@@ -69,6 +73,7 @@ using initial_value_t = tchecker::ta::initial_value_t;
  \param vedge : tuple of edges
  \param invariant : clock constraint container for initial state invariant
  \param semantics : a zone semantics
+ \param dbm_operations : operations on DBMs of the dimension of zone
  \param extrapolation : an extrapolation
  \param initial_range : range of initial state valuations
  \pre the size of vloc and vedge is equal to the size of initial_range.
@@ -92,6 +97,7 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
                                  tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> const & zone,
                                  tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                                  tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
+                                 tchecker::dbm::operations_t const & dbm_operations,
                                  tchecker::zg::extrapolation_t & extrapolation,
                                  tchecker::zg::initial_value_t const & initial_range);
 
@@ -101,6 +107,7 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
  \param s : state
  \param t : transition
  \param semantics : a zone semantics
+ \param dbm_operations : operations on DBMs of the dimension of the zone in s
  \param extrapolation : an extrapolation
  \param v : initial iterator value
  \post s has been initialized from v, and t is an empty transition
@@ -110,10 +117,11 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
 */
 inline tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
                                         tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
+                                        tchecker::dbm::operations_t const & dbm_operations,
                                         tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::initial_value_t const & v)
 {
   return tchecker::zg::initial(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                               semantics, extrapolation, v);
+                               semantics, dbm_operations, extrapolation, v);
 }
 
 /*!
@@ -158,6 +166,7 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
  \param tgt_invariant : clock constaint container for invariant of vloc after it
  is updated
  \param semantics : a zone semantics
+ \param dbm_operations : operations on DBMs of the dimension of zone
  \param extrapolation : an extrapolation
  \param edges : tuple of edge from vloc (range of synchronized/asynchronous edges)
  \pre the source location in edges match the locations in vloc.
@@ -209,15 +218,45 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
+                              tchecker::dbm::operations_t const & dbm_operations,
                               tchecker::zg::extrapolation_t & extrapolation,
                               tchecker::zg::outgoing_edges_value_t const & edges);
 
+/*!
+ \brief Compute next zone
+ \param system : a system
+ \param vloc : tuple of target locations
+ \param zone : a DBM zone
+ \param src_delay_allowed : true if delay is allowed in source state
+ \param src_invariant : invariant in source state
+ \param guard : transition guard
+ \param reset : transition reset
+ \param tgt_invariant : invariant in target state
+ \param semantics : a zone semantics
+ \param dbm_operations : operations on DBMs of the dimension of zone
+ \param extrapolation : an extrapolation
+ \pre zone is a wide zone
+ \post zone has been updated according to semantics and extrapolation from
+ src_invariant, guard, reset, tgt_invariant (and delay)
+ \return tchecker::STATE_OK if the updated zone is not empty, the status returned
+ by semantics otherwise (see tchecker::zg::next)
+ */
+tchecker::state_status_t next_zone(tchecker::ta::system_t const & system, tchecker::vloc_t const & vloc,
+                                   tchecker::zg::zone_t & zone, bool src_delay_allowed,
+                                   tchecker::clock_constraint_container_t const & src_invariant,
+                                   tchecker::clock_constraint_container_t const & guard,
+                                   tchecker::clock_reset_container_t const & reset,
+                                   tchecker::clock_constraint_container_t const & tgt_invariant,
+                                   tchecker::zg::semantics_t & semantics, tchecker::dbm::operations_t const & dbm_operations,
+                                   tchecker::zg::extrapolation_t & extrapolation);
+
 /*!
  \brief Compute next state and transition
  \param system : a system
  \param s : state
  \param t : transition
  \param semantics : a zone semantics
+ \param dbm_operations : operations on DBMs of the dimension of the zone in s
  \param extrapolation : an extrapolation
  \param v : outgoing edge value
  \post s have been updated from v according to semantics and extrapolation, and
@@ -227,11 +266,13 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 */
 inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
                                      tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
+                                     tchecker::dbm::operations_t const & dbm_operations,
                                      tchecker::zg::extrapolation_t & extrapolation,
                                      tchecker::zg::outgoing_edges_value_t const & v)
 {
   return tchecker::zg::next(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, extrapolation, v);
+                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, dbm_operations,
+                            extrapolation, v);
 }
 
 /*!
@@ -264,6 +305,13 @@ void attributes(tchecker::ta::system_t const & system, tchecker::zg::state_t con
 void attributes(tchecker::ta::system_t const & system, tchecker::zg::transition_t const & t,
                 std::map<std::string, std::string> & m);
 
+/*!
+ \brief Storage of shared zones
+ \param sharing_type : type of sharing of state components
+ \return the storage of the zones of shared states w.r.t. sharing_type
+ */
+enum tchecker::zg::zone_storage_t shared_zone_storage(enum tchecker::ts::sharing_type_t sharing_type);
+
 /*!
  \class zg_t
  \brief Zone graph of a timed automaton
@@ -279,10 +327,23 @@ public:
    \param semantics : a zone semantics
    \param extrapolation : a zone extrapolation
    \param block_size : number of objects allocated in a block
+   \param sharing_type : type of sharing of state components
    \note all states and transitions are pool allocated and deallocated automatically
+   \note if sharing_type is tchecker::ts::SHARING, the tuple of locations, the
+   valuation of bounded integer variables and the zone of computed states are
+   shared among equal states, hence components of states should not be modified
+   \note if sharing_type is tchecker::ts::SHARING_NARROW_ZONES, components are
+   shared as above and shared zones are moreover stored with 16-bit difference
+   bounds whenever all their bounds fit (see tchecker::zg::zone_t)
+   \note if sharing_type is tchecker::ts::SHARING_REDUCED_ZONES, components are
+   shared as above and shared zones are moreover stored as reduced DBMs (see
+   tchecker::dbm::reduce)
+   \note DBM operations specialized for the number of clocks in system are
+   selected once and for all (see tchecker::dbm::operations)
    */
   zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::unique_ptr<tchecker::zg::semantics_t> && semantics,
-       std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size);
+       std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size,
+       enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
   /*!
    \brief Copy constructor (deleted)
@@ -357,6 +418,52 @@ public:
   virtual void next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
                     std::vector<sst_t> & v);
 
+  /*!
+   \brief Next states and transitions with selected status
+   \param s : state
+   \param out_edge : outgoing edge value
+   \param v : container
+   \param mask : mask on next states
+   \post triples (status, s', t') have been added to v, for each successor state
+   s' and transition t from s to s' along outgoing edge out_edge such that status
+   matches mask (i.e. status & mask != 0)
+   \note successors are computed in a state and a transition owned by this zone
+   graph, and only copied to newly allocated ones if their status matches mask.
+   The zone of s is not copied if the status of the successor is known not to
+   match mask before its zone is computed (see
+   tchecker::zg::semantics_t::disabled)
+   */
+  virtual void next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
+                    std::vector<sst_t> & v, tchecker::state_status_t mask);
+
+  /*!
+   \brief Next states and transitions with selected status, filtered
+   \param s : state
+   \param out_edge : outgoing edge value
+   \param v : container
+   \param mask : mask on next states
+   \param filter : filter on next states with status tchecker::STATE_OK (empty:
+   all states are kept)
+   \post same as next(s, out_edge, v, mask), except that successor states with
+   status tchecker::STATE_OK that are not kept by filter have been replaced by a
+   null pointer
+   \note filter is called on the state owned by this zone graph where successors
+   are computed, hence states that are not kept by filter are never allocated
+   (only their transition is)
+   */
+  virtual void next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
+                    std::vector<sst_t> & v, tchecker::state_status_t mask, state_filter_t const & filter);
+
+  /*!
+   \brief Clone a state
+   \param s : a state
+   \return a copy of s allocated by this zone graph
+   \note s may have been allocated by another zone graph over the same system.
+   s is only accessed through const references, hence it can be cloned while
+   another thread holds shared pointers to s, as long as s is not modified
+   */
+  tchecker::zg::state_sptr_t clone_state(tchecker::zg::shared_state_t const & s);
+
   using tchecker::ts::full_ts_t<tchecker::zg::state_sptr_t, tchecker::zg::const_state_sptr_t, tchecker::zg::transition_sptr_t,
                                 tchecker::zg::const_transition_sptr_t, tchecker::zg::initial_range_t,
                                 tchecker::zg::outgoing_edges_range_t, tchecker::zg::initial_value_t,
@@ -398,12 +505,73 @@ public:
    */
   tchecker::ta::system_t const & system() const;
 
+  /*!
+   \brief Accessor
+   \return memory allocated for states and transitions (in bytes)
+   \note allocated memory is reused once states and transitions are released,
+   hence it does not decrease
+   */
+  std::size_t memsize() const;
+
+  /*!
+   \brief Accessor
+   \return number of successor states (along with their transitions) that have
+   been allocated by next
+   \note successor states that are not kept by a filter are not allocated, hence
+   they are not counted
+   */
+  inline unsigned long successor_allocations() const { return _successor_allocations; }
+
+  /*!
+   \brief Accessor
+   \return number of successors computed by next with a mask, that have been
+   discarded without copying the zone of their source state
+   */
+  inline unsigned long avoided_zone_copies() const { return _avoided_zone_copies; }
+
+  /*!
+   \brief Set symmetry reduction
+   \param symmetry : symmetries of the underlying system (nullptr: no reduction)
+   \post initial and next states with status tchecker::STATE_OK are mapped to
+   the representative of their orbit w.r.t. symmetry (see
+   tchecker::ta::symmetry_t::canonicalize) before being returned
+   \note transitions are not permuted: the vedge of a transition refers to the
+   processes of its source state before canonicalization
+   */
+  void set_symmetry(std::shared_ptr<tchecker::ta::symmetry_t const> const & symmetry);
+
+  /*!
+   \brief Set memoization of outgoing edges
+   \param cache : cache of outgoing edges from tuples of locations (nullptr: no
+   memoization)
+   \post outgoing edges are obtained from cache if set (see
+   tchecker::syncprod::outgoing_edges_cache_t)
+   \note cache should not be shared with another thread
+   */
+  void set_outgoing_edges_cache(std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> const & cache);
+
 private:
-  std::shared_ptr<tchecker::ta::system_t const> _system;           /*!< System of timed processes */
-  std::unique_ptr<tchecker::zg::semantics_t> _semantics;           /*!< Zone semantics */
-  std::unique_ptr<tchecker::zg::extrapolation_t> _extrapolation;   /*!< Zone extrapolation */
-  tchecker::zg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
-  tchecker::zg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
+  /*!
+   \brief Map a state to the representative of its orbit
+   \param s : a state
+   \pre the components of s are not shared
+   \post s has been canonicalized w.r.t. symmetry reduction if set
+   */
+  void canonicalize(tchecker::zg::state_t & s) const;
+
+  std::shared_ptr<tchecker::ta::system_t const> _system;                    /*!< System of timed processes */
+  std::unique_ptr<tchecker::zg::semantics_t> _semantics;                    /*!< Zone semantics */
+  tchecker::dbm::operations_t const * _dbm_operations;                      /*!< Operations on DBMs of the zones */
+  std::unique_ptr<tchecker::zg::extrapolation_t> _extrapolation;            /*!< Zone extrapolation */
+  tchecker::zg::state_pool_allocator_t _state_allocator;                    /*!< Pool allocator of states */
+  tchecker::zg::transition_pool_allocator_t _transition_allocator;          /*! Pool allocator of transitions */
+  enum tchecker::ts::sharing_type_t _sharing_type;                          /*!< Sharing of state components */
+  std::shared_ptr<tchecker::ta::symmetry_t const> _symmetry;                /*!< Symmetry reduction (nullptr: none) */
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> _edges_cache; /*!< Cache of outgoing edges (nullptr: none) */
+  tchecker::zg::state_sptr_t _next_state;                                   /*!< State where successors are computed */
+  tchecker::zg::transition_sptr_t _next_transition;                         /*!< Transition where successors are computed */
+  unsigned long _successor_allocations;                                     /*!< Number of allocated successors */
+  unsigned long _avoided_zone_copies;                                       /*!< Successors discarded before zone copy */
 };
 
 /*!
@@ -412,6 +580,7 @@ private:
  \param semantics_type : type of zone semantics
  \param extrapolation_type : type of zone extrapolation
  \param block_size : number of objects allocated in a block
+ \param sharing_type : type of sharing of state components
  \return a zone graph over system with zone semantics and zone extrapolation
  defined from semantics_type and extrapolation_type, and allocation of
  block_size objects at a time, nullptr if clock bounds cannot be inferred from
@@ -419,7 +588,8 @@ private:
  */
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                              enum tchecker::zg::semantics_type_t semantics_type,
-                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size);
+                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size,
+                             enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
 /*!
  \brief Factory of zone graphs
@@ -428,6 +598,7 @@ tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const
  \param extrapolation_type : type of zone extrapolation
  \param clock_bounds : clock bounds
  \param block_size : number of objects allocated in a block
+ \param sharing_type : type of sharing of state components
  \return a zone graph over system with zone semantics and zone extrapolation
  defined from semantics_type, extrapolation_type and clock_bounds, and
  allocation of block_size objects at a time
@@ -435,7 +606,8 @@ tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                              enum tchecker::zg::semantics_type_t semantics_type,
                              enum tchecker::zg::extrapolation_type_t extrapolation_type,
-                             tchecker::clockbounds::clockbounds_t const & clock_bounds, std::size_t block_size);
+                             tchecker::clockbounds::clockbounds_t const & clock_bounds, std::size_t block_size,
+                             enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
 } // end of namespace zg
 
@@ -8,6 +8,7 @@
 #ifndef TCHECKER_ZG_ZONE_HH
 #define TCHECKER_ZG_ZONE_HH
 
+#include <cstdint>
 #include <string>
 
 #include "tchecker/basictypes.hh"
@@ -25,16 +26,33 @@ namespace tchecker {
 
 namespace zg {
 
+class zone_summary_t;
+
+/*!
+ \brief Type of storage of zones
+ */
+enum zone_storage_t {
+  WIDE_STORAGE,    /*!< Difference bounds are stored as tchecker::dbm::db_t */
+  NARROW_STORAGE,  /*!< Difference bounds are stored as tchecker::dbm::narrow_db_t */
+  REDUCED_STORAGE, /*!< Minimal set of difference bounds (see tchecker::dbm::reduce) */
+};
+
 /*!
  \class zone_t
  \brief DBM implementation of zones
+ \note Zones are stored with wide difference bounds, unless they have been
+ built as narrow or reduced copies of other zones. Narrow zones use half the
+ memory of wide zones. Reduced zones only store a minimal set of difference
+ bounds, and inclusion in a reduced zone is checked on this set. Narrow and
+ reduced zones cannot be modified, and their DBM cannot be accessed directly
  */
 class zone_t {
 public:
   /*!
    \brief Assignment operator
    \param zone : a DBM zone
-   \pre this and zone have the same dimension
+   \pre this and zone have the same dimension, and this is a wide zone (checked
+   by assertion)
    \post this is a copy of zone
    \return this after assignment
    \throw std::invalid_argument : if this and zone do not have the same dimension
@@ -120,6 +138,40 @@ public:
    */
   inline std::size_t dim() const { return _dim; }
 
+  /*!
+   \brief Accessor
+   \return true if the difference bounds of this zone are stored as narrow
+   difference bounds, false otherwise
+   */
+  inline bool is_narrow() const { return _storage == tchecker::zg::NARROW_STORAGE; }
+
+  /*!
+   \brief Accessor
+   \return true if this zone is stored as a reduced DBM, false otherwise
+   */
+  inline bool is_reduced() const { return _storage == tchecker::zg::REDUCED_STORAGE; }
+
+  /*!
+   \brief Accessor
+   \return storage of this zone
+   */
+  inline enum tchecker::zg::zone_storage_t storage() const { return _storage; }
+
+  /*!
+   \brief Narrowing predicate
+   \return true if all the difference bounds of this zone can be stored as
+   narrow difference bounds, false otherwise
+   */
+  bool is_narrowable() const;
+
+  /*!
+   \brief Accessor
+   \pre this zone is not empty
+   \return number of difference bounds in the reduced DBM of this zone
+   \note computes the reduced DBM of this zone unless it is stored reduced
+   */
+  std::size_t reduced_size() const;
+
   /*!
    \brief Output
    \param os : output stream
@@ -132,6 +184,7 @@ public:
 
   /*!
    \brief Accessor
+   \pre this is a wide zone (checked by assertion)
    \return internal DBM of size dim()*dim()
    \note Modifications to the returned DBM should ensure tightness or emptiness of the zone, following the convention defined
    in file tchecker/dbm/dbm.hh. It is thus strongly suggested to use the function defined in that file to modify the returned
@@ -141,10 +194,31 @@ public:
 
   /*!
    \brief Accessor
+   \pre this is a wide zone (checked by assertion)
    \return internal DBM of size dim()*dim()
    */
   tchecker::dbm::db_t const * dbm() const;
 
+  /*!
+   \brief Accessor
+   \param i : clock ID
+   \param j : clock ID
+   \pre i and j are less than dim()
+   \return constraint on xi-xj in this zone
+   \note expands the DBM of reduced zones
+   */
+  inline tchecker::dbm::db_t dbm(tchecker::clock_id_t i, tchecker::clock_id_t j) const
+  {
+    switch (_storage) {
+    case tchecker::zg::WIDE_STORAGE:
+      return dbm_ptr()[i * _dim + j];
+    case tchecker::zg::NARROW_STORAGE:
+      return tchecker::dbm::widen(narrow_dbm_ptr()[i * _dim + j]);
+    default:
+      return wide_dbm_ptr(0)[i * _dim + j];
+    }
+  }
+
   /*!
   \brief Conversion to DBM
   \param dbm : a DBM
@@ -159,7 +233,12 @@ public:
    \tparam ARGS : type of arguments to a constructor of tchecker::zg::zone_t
    \tparam ptr : pointer to an allocated zone
    \pre ptr points to an allocated zone of sufficient capacity, i.e. at least
-   allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim)
+   allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim) for wide zones,
+   allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim,
+   tchecker::zg::NARROW_STORAGE) for narrow zones, and
+   allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim,
+   tchecker::zg::REDUCED_STORAGE, size) for reduced zones with size
+   difference bounds
    \post an instance of tchecker::zg::zone_t has been built in ptr with
    parameters args
    */
@@ -187,10 +266,36 @@ protected:
    \brief Copy constructor
    \param zone : a zone
    \pre this has been allocated with the same dimension as zone
-   \post this is a copy of zone
+   \post this is a wide copy of zone
    */
   zone_t(tchecker::zg::zone_t const & zone);
 
+  /*!
+   \brief Copy constructor
+   \param zone : a zone
+   \param storage : storage of this zone
+   \pre this has been allocated with the same dimension as zone and with
+   storage (and zone.reduced_size() difference bounds if storage is
+   tchecker::zg::REDUCED_STORAGE)
+   \post this is a copy of zone stored w.r.t. storage
+   \throw std::invalid_argument : if storage is tchecker::zg::NARROW_STORAGE and
+   zone is not narrowable, or if storage is tchecker::zg::REDUCED_STORAGE and
+   zone is empty
+   */
+  zone_t(tchecker::zg::zone_t const & zone, enum tchecker::zg::zone_storage_t storage);
+
+  /*!
+   \brief Constructor
+   \param dim : dimension
+   \param rdbm : a reduced DBM
+   \param size : number of difference bounds in rdbm
+   \pre this has been allocated with dimension dim, tchecker::zg::REDUCED_STORAGE
+   and size difference bounds. rdbm has been computed by tchecker::dbm::reduce
+   from a non-empty DBM of dimension dim, and has size difference bounds
+   \post this is the reduced zone with reduced DBM rdbm
+   */
+  zone_t(tchecker::clock_id_t dim, tchecker::dbm::reduced_db_t const * rdbm, std::size_t size);
+
   /*!
    \brief Move constructor
    \note deleted (move construction is the same as copy construction)
@@ -213,13 +318,37 @@ protected:
 
   /*!
    \brief Accessor
-   \param i : clock ID
-   \param j : clock ID
-   \return constraint on xi-xj in this DBM
+   \return pointer to narrow DBM
+   */
+  constexpr tchecker::dbm::narrow_db_t * narrow_dbm_ptr() const
+  {
+    return static_cast<tchecker::dbm::narrow_db_t *>(static_cast<void *>(const_cast<tchecker::zg::zone_t *>(this) + 1));
+  }
+
+  /*!
+   \brief Accessor
+   \return pointer to reduced DBM
+   */
+  constexpr tchecker::dbm::reduced_db_t * reduced_dbm_ptr() const
+  {
+    return static_cast<tchecker::dbm::reduced_db_t *>(static_cast<void *>(const_cast<tchecker::zg::zone_t *>(this) + 1));
+  }
+
+  /*!
+   \brief Accessor
+   \param k : index of a DBM buffer (0 or 1)
+   \return pointer to DBM if this zone is wide, pointer to a copy of the DBM
+   in the k-th buffer of the calling thread otherwise
+   \note the returned pointer is invalidated by the next call with the same k
+   on a narrow or reduced zone by the same thread
    */
-  constexpr tchecker::dbm::db_t dbm(tchecker::clock_id_t i, tchecker::clock_id_t j) const { return dbm_ptr()[i * _dim + j]; }
+  tchecker::dbm::db_t const * wide_dbm_ptr(unsigned k) const;
+
+  friend class tchecker::zg::zone_summary_t;
 
-  tchecker::clock_id_t _dim; /*!< Dimension of DBM */
+  tchecker::clock_id_t _dim;                       /*!< Dimension of DBM */
+  enum tchecker::zg::zone_storage_t _storage : 2; /*!< Storage of difference bounds */
+  std::uint32_t _reduced_size : 30;               /*!< Number of difference bounds of reduced zones */
 };
 
 /*!
@@ -237,6 +366,39 @@ inline std::size_t hash_value(tchecker::zg::zone_t const & zone) { return zone.h
  */
 inline int lexical_cmp(tchecker::zg::zone_t const & z1, tchecker::zg::zone_t const & z2) { return z1.lexical_cmp(z2); }
 
+/*!
+ \class zone_summary_t
+ \brief Summary of a zone by its clock bounds
+ \note The summary is monotone w.r.t. zone inclusion: if z1 <= z2 then
+ zone_summary_t(z1) <= zone_summary_t(z2). Hence zones with incomparable
+ summaries can be discarded without comparing their DBMs
+ */
+class zone_summary_t {
+public:
+  /*!
+   \brief Constructor
+   \param zone : a zone
+   \post this is the summary of zone
+   */
+  explicit zone_summary_t(tchecker::zg::zone_t const & zone);
+
+  /*!
+   \brief Less-than-or-equal-to predicate
+   \param summary : a zone summary
+   \return false if no zone summarized by this is included in a zone summarized
+   by summary, true otherwise (zones may be included)
+   */
+  inline bool operator<=(tchecker::zg::zone_summary_t const & summary) const
+  {
+    return (_upper <= summary._upper) && (_lower <= summary._lower) && ((_unbounded & ~summary._unbounded) == 0);
+  }
+
+private:
+  std::int64_t _upper;      /*!< Sum of upper bounds x-0 over all clocks */
+  std::int64_t _lower;      /*!< Sum of bounds 0-x over all clocks */
+  std::uint64_t _unbounded; /*!< Bit (x % 64) is set if some clock x has no upper bound */
+};
+
 } // end of namespace zg
 
 /*!
@@ -257,6 +419,42 @@ public:
     return (sizeof(tchecker::zg::zone_t) + dim * dim * sizeof(tchecker::dbm::db_t));
   }
 
+  /*!
+   \brief Allocation size
+   \param dim : dimension
+   \param storage : storage of zones
+   \return Allocation size for objects of type tchecker::zg::zone_t
+   with dimension dim stored w.r.t. storage
+   */
+  static constexpr std::size_t alloc_size(tchecker::clock_id_t dim, enum tchecker::zg::zone_storage_t storage)
+  {
+    switch (storage) {
+    case tchecker::zg::NARROW_STORAGE:
+      return sizeof(tchecker::zg::zone_t) + dim * dim * sizeof(tchecker::dbm::narrow_db_t);
+    case tchecker::zg::REDUCED_STORAGE:
+      return sizeof(tchecker::zg::zone_t) + dim * (dim - 1) * sizeof(tchecker::dbm::reduced_db_t); // at most dim*(dim-1) bounds
+    default:
+      return tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim);
+    }
+  }
+
+  /*!
+   \brief Allocation size
+   \param dim : dimension
+   \param storage : storage of zones
+   \param reduced_size : number of difference bounds of reduced zones
+   \return Allocation size for objects of type tchecker::zg::zone_t
+   with dimension dim stored w.r.t. storage, with reduced_size difference
+   bounds if storage is tchecker::zg::REDUCED_STORAGE
+   */
+  static constexpr std::size_t alloc_size(tchecker::clock_id_t dim, enum tchecker::zg::zone_storage_t storage,
+                                          std::size_t reduced_size)
+  {
+    return (storage == tchecker::zg::REDUCED_STORAGE
+                ? sizeof(tchecker::zg::zone_t) + reduced_size * sizeof(tchecker::dbm::reduced_db_t)
+                : tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(dim, storage));
+  }
+
   /*!
    \brief Accessor
    \param dim : dimension
@@ -14,7 +14,7 @@ namespace tchecker {
 namespace algorithms {
 namespace covreach {
 
-stats_t::stats_t() : _visited_states(0), _covered_states(0), _reachable(false) {}
+stats_t::stats_t() : _visited_states(0), _covered_states(0), _stored_states(0), _evicted_states(0), _reachable(false) {}
 
 unsigned long & stats_t::visited_states() { return _visited_states; }
 
@@ -28,6 +28,10 @@ unsigned long & stats_t::stored_states() { return _stored_states; }
 
 unsigned long stats_t::stored_states() const { return _stored_states; }
 
+unsigned long & stats_t::evicted_states() { return _evicted_states; }
+
+unsigned long stats_t::evicted_states() const { return _evicted_states; }
+
 bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
@@ -49,11 +53,45 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream << _stored_states;
   m["STORED_STATES"] = sstream.str();
 
+  // only reported when a memory budget has been enforced, to keep outputs of
+  // unconstrained runs unchanged
+  if (_evicted_states > 0) {
+    sstream.str("");
+    sstream << _evicted_states;
+    m["EVICTED_STATES"] = sstream.str();
+  }
+
   sstream.str("");
   sstream << std::boolalpha << _reachable;
   m["REACHABLE"] = sstream.str();
 }
 
+/* por_stats_t */
+
+por_stats_t::por_stats_t() : _reduced_expansions(0), _full_expansions(0) {}
+
+unsigned long & por_stats_t::reduced_expansions() { return _reduced_expansions; }
+
+unsigned long por_stats_t::reduced_expansions() const { return _reduced_expansions; }
+
+unsigned long & por_stats_t::full_expansions() { return _full_expansions; }
+
+unsigned long por_stats_t::full_expansions() const { return _full_expansions; }
+
+void por_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::covreach::stats_t::attributes(m);
+
+  std::stringstream sstream;
+
+  sstream << _reduced_expansions;
+  m["REDUCED_EXPANSIONS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _full_expansions;
+  m["FULL_EXPANSIONS"] = sstream.str();
+}
+
 } // end of namespace covreach
 
 } // namespace algorithms
@@ -39,6 +39,56 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   m["REACHABLE"] = sstream.str();
 }
 
+/* bitstate_stats_t */
+
+bitstate_stats_t::bitstate_stats_t()
+    : _stored_states(0), _bitstate_size(0), _hash_count(0), _set_bits(0), _omission_probability(0.0),
+      _estimated_coverage(1.0)
+{
+}
+
+void bitstate_stats_t::set_bitstate(tchecker::bitstate_t const & bitstate)
+{
+  _stored_states = bitstate.inserted();
+  _bitstate_size = bitstate.size();
+  _hash_count = bitstate.hash_count();
+  _set_bits = bitstate.set_bits();
+  _omission_probability = bitstate.omission_probability();
+  _estimated_coverage = bitstate.estimated_coverage();
+}
+
+double bitstate_stats_t::estimated_coverage() const { return _estimated_coverage; }
+
+void bitstate_stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::reach::stats_t::attributes(m);
+
+  std::stringstream sstream;
+
+  sstream << _stored_states;
+  m["STORED_STATES"] = sstream.str();
+
+  sstream.str("");
+  sstream << _bitstate_size;
+  m["BITSTATE_SIZE"] = sstream.str();
+
+  sstream.str("");
+  sstream << _hash_count;
+  m["BITSTATE_HASHES"] = sstream.str();
+
+  sstream.str("");
+  sstream << (_bitstate_size == 0 ? 0.0 : static_cast<double>(_set_bits) / static_cast<double>(_bitstate_size));
+  m["BITSTATE_FILL_RATIO"] = sstream.str();
+
+  sstream.str("");
+  sstream << _omission_probability;
+  m["OMISSION_PROBABILITY"] = sstream.str();
+
+  sstream.str("");
+  sstream << _estimated_coverage;
+  m["ESTIMATED_COVERAGE"] = sstream.str();
+}
+
 } // end of namespace reach
 
 } // end of namespace algorithms
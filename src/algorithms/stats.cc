@@ -13,6 +13,12 @@ namespace tchecker {
 
 namespace algorithms {
 
+stats_t::stats_t()
+    : _edges_cache_hits(0), _edges_cache_misses(0), _successor_allocations(0), _successor_allocations_set(false),
+      _avoided_zone_copies(0), _avoided_zone_copies_set(false)
+{
+}
+
 void stats_t::set_start_time() { _start_time = std::chrono::steady_clock::now(); }
 
 std::chrono::time_point<std::chrono::steady_clock> stats_t::start_time() const { return _start_time; }
@@ -27,12 +33,61 @@ double stats_t::running_time() const
   return duration.count();
 }
 
+unsigned long & stats_t::edges_cache_hits() { return _edges_cache_hits; }
+
+unsigned long stats_t::edges_cache_hits() const { return _edges_cache_hits; }
+
+unsigned long & stats_t::edges_cache_misses() { return _edges_cache_misses; }
+
+unsigned long stats_t::edges_cache_misses() const { return _edges_cache_misses; }
+
+void stats_t::set_successor_allocations(unsigned long n)
+{
+  _successor_allocations = n;
+  _successor_allocations_set = true;
+}
+
+unsigned long stats_t::successor_allocations() const { return _successor_allocations; }
+
+void stats_t::set_avoided_zone_copies(unsigned long n)
+{
+  _avoided_zone_copies = n;
+  _avoided_zone_copies_set = true;
+}
+
+unsigned long stats_t::avoided_zone_copies() const { return _avoided_zone_copies; }
+
 void stats_t::attributes(std::map<std::string, std::string> & m) const
 {
   std::stringstream sstream;
 
   sstream << running_time();
   m["RUNNING_TIME_SECONDS"] = sstream.str();
+
+  // only reported when outgoing edges have been memoized, to keep outputs of
+  // other runs unchanged
+  if (_edges_cache_hits + _edges_cache_misses > 0) {
+    sstream.str("");
+    sstream << _edges_cache_hits;
+    m["EDGES_CACHE_HITS"] = sstream.str();
+
+    sstream.str("");
+    sstream << _edges_cache_misses;
+    m["EDGES_CACHE_MISSES"] = sstream.str();
+  }
+
+  // only reported by transition systems that count them
+  if (_successor_allocations_set) {
+    sstream.str("");
+    sstream << _successor_allocations;
+    m["SUCCESSOR_ALLOCATIONS"] = sstream.str();
+  }
+
+  if (_avoided_zone_copies_set) {
+    sstream.str("");
+    sstream << _avoided_zone_copies;
+    m["AVOIDED_ZONE_COPIES"] = sstream.str();
+  }
 }
 
 } // end of namespace algorithms
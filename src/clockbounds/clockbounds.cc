@@ -5,9 +5,12 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
 #include <tuple>
 
+#include <boost/container_hash/hash.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/utils/iterator.hh"
@@ -532,6 +535,175 @@ std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::global_m_map
   return os << "M=" << map.M() << std::endl;
 }
 
+/* vloc_index_t */
+
+namespace details {
+
+vloc_index_t::vloc_index_t() : _offsets(1, 0) {}
+
+std::tuple<std::size_t, bool> vloc_index_t::find_else_add(tchecker::vloc_t const & vloc)
+{
+  std::size_t const h = boost::hash_range(vloc.begin(), vloc.end());
+  auto && [begin, end] = _index.equal_range(h);
+  for (auto it = begin; it != end; ++it) {
+    std::size_t const n = it->second;
+    if ((_offsets[n + 1] - _offsets[n] == vloc.size()) && std::equal(vloc.begin(), vloc.end(), _locs.begin() + _offsets[n]))
+      return std::make_tuple(n, false);
+  }
+
+  std::size_t const n = size();
+  _locs.insert(_locs.end(), vloc.begin(), vloc.end());
+  _offsets.push_back(_locs.size());
+  _index.emplace(h, n);
+  return std::make_tuple(n, true);
+}
+
+void vloc_index_t::clear()
+{
+  _index.clear();
+  _locs.clear();
+  _offsets.resize(1);
+}
+
+} // end of namespace details
+
+/* local_lu_cache_t */
+
+local_lu_cache_t::local_lu_cache_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & map) : _map(map) {}
+
+local_lu_cache_t::local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t const & c) : _map(c._map), _index(c._index)
+{
+  for (tchecker::clockbounds::map_t const * L : c._L)
+    _L.push_back(tchecker::clockbounds::clone_map(*L));
+  for (tchecker::clockbounds::map_t const * U : c._U)
+    _U.push_back(tchecker::clockbounds::clone_map(*U));
+}
+
+local_lu_cache_t::local_lu_cache_t(tchecker::clockbounds::local_lu_cache_t && c)
+    : _map(std::move(c._map)), _index(std::move(c._index)), _L(std::move(c._L)), _U(std::move(c._U))
+{
+  c._index.clear();
+  c._L.clear();
+  c._U.clear();
+}
+
+local_lu_cache_t::~local_lu_cache_t() { clear(); }
+
+tchecker::clockbounds::local_lu_cache_t & local_lu_cache_t::operator=(tchecker::clockbounds::local_lu_cache_t const & c)
+{
+  if (this != &c) {
+    clear();
+    _map = c._map;
+    _index = c._index;
+    for (tchecker::clockbounds::map_t const * L : c._L)
+      _L.push_back(tchecker::clockbounds::clone_map(*L));
+    for (tchecker::clockbounds::map_t const * U : c._U)
+      _U.push_back(tchecker::clockbounds::clone_map(*U));
+  }
+  return *this;
+}
+
+tchecker::clockbounds::local_lu_cache_t & local_lu_cache_t::operator=(tchecker::clockbounds::local_lu_cache_t && c)
+{
+  if (this != &c) {
+    clear();
+    _map = std::move(c._map);
+    _index = std::move(c._index);
+    _L = std::move(c._L);
+    _U = std::move(c._U);
+    c._index.clear();
+    c._L.clear();
+    c._U.clear();
+  }
+  return *this;
+}
+
+void local_lu_cache_t::bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t const *& L,
+                              tchecker::clockbounds::map_t const *& U)
+{
+  auto && [n, added] = _index.find_else_add(vloc);
+  if (added) {
+    _L.push_back(tchecker::clockbounds::allocate_map(_map->clock_number()));
+    _U.push_back(tchecker::clockbounds::allocate_map(_map->clock_number()));
+    _map->bounds(vloc, *_L[n], *_U[n]);
+  }
+  L = _L[n];
+  U = _U[n];
+}
+
+void local_lu_cache_t::clear()
+{
+  for (tchecker::clockbounds::map_t * L : _L)
+    tchecker::clockbounds::deallocate_map(L);
+  _L.clear();
+  for (tchecker::clockbounds::map_t * U : _U)
+    tchecker::clockbounds::deallocate_map(U);
+  _U.clear();
+  _index.clear();
+}
+
+/* local_m_cache_t */
+
+local_m_cache_t::local_m_cache_t(std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & map) : _map(map) {}
+
+local_m_cache_t::local_m_cache_t(tchecker::clockbounds::local_m_cache_t const & c) : _map(c._map), _index(c._index)
+{
+  for (tchecker::clockbounds::map_t const * M : c._M)
+    _M.push_back(tchecker::clockbounds::clone_map(*M));
+}
+
+local_m_cache_t::local_m_cache_t(tchecker::clockbounds::local_m_cache_t && c)
+    : _map(std::move(c._map)), _index(std::move(c._index)), _M(std::move(c._M))
+{
+  c._index.clear();
+  c._M.clear();
+}
+
+local_m_cache_t::~local_m_cache_t() { clear(); }
+
+tchecker::clockbounds::local_m_cache_t & local_m_cache_t::operator=(tchecker::clockbounds::local_m_cache_t const & c)
+{
+  if (this != &c) {
+    clear();
+    _map = c._map;
+    _index = c._index;
+    for (tchecker::clockbounds::map_t const * M : c._M)
+      _M.push_back(tchecker::clockbounds::clone_map(*M));
+  }
+  return *this;
+}
+
+tchecker::clockbounds::local_m_cache_t & local_m_cache_t::operator=(tchecker::clockbounds::local_m_cache_t && c)
+{
+  if (this != &c) {
+    clear();
+    _map = std::move(c._map);
+    _index = std::move(c._index);
+    _M = std::move(c._M);
+    c._index.clear();
+    c._M.clear();
+  }
+  return *this;
+}
+
+tchecker::clockbounds::map_t const & local_m_cache_t::bounds(tchecker::vloc_t const & vloc)
+{
+  auto && [n, added] = _index.find_else_add(vloc);
+  if (added) {
+    _M.push_back(tchecker::clockbounds::allocate_map(_map->clock_number()));
+    _map->bounds(vloc, *_M[n]);
+  }
+  return *_M[n];
+}
+
+void local_m_cache_t::clear()
+{
+  for (tchecker::clockbounds::map_t * M : _M)
+    tchecker::clockbounds::deallocate_map(M);
+  _M.clear();
+  _index.clear();
+}
+
 /* clockbounds_t */
 
 clockbounds_t::clockbounds_t(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock_nb)
@@ -6,7 +6,10 @@
  */
 
 #include <cassert>
-#include <cstring>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <numeric>
 #include <unordered_set>
 
 #include "tchecker/clockbounds/solver.hh"
@@ -16,131 +19,165 @@ namespace tchecker {
 
 namespace clockbounds {
 
+/*!
+ \brief Check that a weight in the graph of inequations is representable
+ \param w : a weight
+ \throw std::invalid_argument : if w is not within the range of DBM values
+*/
+static void check_weight(std::int64_t w)
+{
+  if ((w < tchecker::dbm::MIN_VALUE) || (w > tchecker::dbm::MAX_VALUE))
+    throw std::invalid_argument("clock bound out of range");
+}
+
 df_solver_t::df_solver_t(tchecker::ta::system_t const & system)
     : _loc_number(system.locations_count()), _clock_number(system.clock_variables().size(tchecker::VK_FLATTENED)),
-      _loc_pid(_loc_number, 0),
-      _dim(1 + _loc_number * _clock_number), // 1 variable for each clock in each location, plus 1 for dummy clock 0
-      _L(nullptr), _U(nullptr), _has_solution(true)
+      _process_number(system.processes_count()), _loc_pid(_loc_number, 0),
+      // 1 variable for each clock in each location, 1 for each clock in each process, plus 1 for dummy clock 0
+      _dim(1 + (_loc_number + _process_number) * _clock_number), _has_solution(true), _solved(false)
 {
-  if ((_loc_number > 0) && (_clock_number > 0) && ((_dim < _loc_number) || (_dim < _clock_number)))
+  if ((_loc_number > 0) && (_clock_number > 0) &&
+      ((_dim < _loc_number) || (_dim < _clock_number) || ((_dim - 1) / _clock_number != _loc_number + _process_number)))
     throw std::invalid_argument("invalid number of clocks or locations (overflow)");
 
   for (tchecker::loc_id_t id = 0; id < _loc_number; ++id)
     _loc_pid[id] = system.location(id)->pid();
 
-  _L = new tchecker::dbm::db_t[_dim * _dim];
-  _U = new tchecker::dbm::db_t[_dim * _dim];
   clear();
 }
 
-df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t const & solver)
-    : _loc_number(solver._loc_number), _clock_number(solver._clock_number), _loc_pid(solver._loc_pid), _dim(solver._dim),
-      _L(nullptr), _U(nullptr), _has_solution(true)
+tchecker::clock_id_t df_solver_t::clock_number() const { return _clock_number; }
+
+tchecker::clock_id_t df_solver_t::loc_number() const { return _loc_number; }
+
+tchecker::clockbounds::bound_t df_solver_t::L(tchecker::loc_id_t l, tchecker::clock_id_t x) const
 {
-  _L = new tchecker::dbm::db_t[_dim * _dim];
-  _U = new tchecker::dbm::db_t[_dim * _dim];
-  memcpy(_L, solver._L, _dim * _dim * sizeof(*_L));
-  memcpy(_U, solver._U, _dim * _dim * sizeof(*_U));
+  assert(l < _loc_number);
+  assert(x < _clock_number);
+  assert(_solved);
+  return _L[l * _clock_number + x];
 }
 
-df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t && solver)
-    : _loc_number(std::move(solver._loc_number)), _clock_number(std::move(solver._clock_number)),
-      _loc_pid(std::move(solver._loc_pid)), _dim(std::move(solver._dim)), _L(std::move(solver._L)), _U(std::move(solver._U)),
-      _has_solution(std::move(solver._has_solution))
+tchecker::clockbounds::bound_t df_solver_t::U(tchecker::loc_id_t l, tchecker::clock_id_t x) const
 {
-  solver._loc_number = 0;
-  solver._clock_number = 0;
-  solver._dim = 1;
-  solver._L = nullptr;
-  solver._U = nullptr;
-  solver._has_solution = false;
+  assert(l < _loc_number);
+  assert(x < _clock_number);
+  assert(_solved);
+  return _U[l * _clock_number + x];
 }
 
-df_solver_t::~df_solver_t()
+bool df_solver_t::has_solution() const
 {
-  delete[] _L;
-  delete[] _U;
+  assert(_solved);
+  return _has_solution;
 }
 
-tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbounds::df_solver_t const & solver)
+void df_solver_t::clear()
 {
-  if (this != &solver) {
-    _loc_number = solver._loc_number;
-    _clock_number = solver._clock_number;
-    _loc_pid = solver._loc_pid;
-    _dim = solver._dim;
-
-    delete[] _L;
-    _L = new tchecker::dbm::db_t[_dim * _dim];
-    memcpy(_L, solver._L, _dim * _dim * sizeof(*_L));
-
-    delete[] _U;
-    _U = new tchecker::dbm::db_t[_dim * _dim];
-    memcpy(_U, solver._U, _dim * _dim * sizeof(*_U));
-
-    _has_solution = solver._has_solution;
-  }
-
-  return *this;
+  _L0.assign(_dim, tchecker::clockbounds::NO_BOUND);
+  _U0.assign(_dim, tchecker::clockbounds::NO_BOUND);
+  _edges.clear();
+  _process_clocks.assign(_process_number * _clock_number, false);
+  _L.clear();
+  _U.clear();
+  _has_solution = true;
+  _solved = false;
 }
 
-tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbounds::df_solver_t && solver)
+void df_solver_t::solve()
 {
-  if (this != &solver) {
-    _loc_number = std::move(solver._loc_number);
-    _clock_number = std::move(solver._clock_number);
-    _loc_pid = std::move(solver._loc_pid);
-    _dim = std::move(solver._dim);
-    _L = std::move(solver._L);
-    _U = std::move(solver._U);
-    _has_solution = std::move(solver._has_solution);
-
-    solver._loc_number = 0;
-    solver._clock_number = 0;
-    solver._dim = 1;
-    solver._L = nullptr;
-    solver._U = nullptr;
-    solver._has_solution = false;
+  // Adjacency lists, sorted by source variable
+  std::vector<std::size_t> first(_dim + 1, 0);
+  for (edge_t const & e : _edges)
+    ++first[e._src + 1];
+  std::partial_sum(first.begin(), first.end(), first.begin());
+
+  std::vector<std::size_t> succ(_edges.size());
+  std::vector<tchecker::integer_t> weight(_edges.size());
+  std::vector<std::size_t> next(first.begin(), first.end() - 1);
+  for (edge_t const & e : _edges) {
+    succ[next[e._src]] = e._tgt;
+    weight[next[e._src]] = e._weight;
+    ++next[e._src];
   }
 
-  return *this;
-}
+  // Negative cycles: minimal paths from a virtual source to every variable, a path with _dim edges has a cycle
+  std::vector<std::int64_t> dist(_dim, 0);
+  std::vector<std::size_t> length(_dim, 0);
+  std::vector<bool> queued(_dim, true);
+  std::deque<std::size_t> waiting(_dim);
+  std::iota(waiting.begin(), waiting.end(), 0);
 
-tchecker::clock_id_t df_solver_t::clock_number() const { return _clock_number; }
+  _has_solution = true;
+  while (!waiting.empty() && _has_solution) {
+    std::size_t u = waiting.front();
+    waiting.pop_front();
+    queued[u] = false;
+    for (std::size_t k = first[u]; k < first[u + 1] && _has_solution; ++k) {
+      std::size_t v = succ[k];
+      if (dist[u] + weight[k] >= dist[v])
+        continue;
+      dist[v] = dist[u] + weight[k];
+      length[v] = length[u] + 1;
+      _has_solution = (length[v] < _dim);
+      if (!queued[v]) {
+        queued[v] = true;
+        waiting.push_back(v);
+      }
+    }
+  }
 
-tchecker::clock_id_t df_solver_t::loc_number() const { return _loc_number; }
+  _L.assign(_loc_number * _clock_number, tchecker::clockbounds::NO_BOUND);
+  _U.assign(_loc_number * _clock_number, tchecker::clockbounds::NO_BOUND);
+  if (_has_solution) {
+    minimal_paths(_L0, first, succ, weight, _L);
+    minimal_paths(_U0, first, succ, weight, _U);
+  }
 
-tchecker::clockbounds::bound_t df_solver_t::L(tchecker::loc_id_t l, tchecker::clock_id_t x) const
-{
-  assert(l < _loc_number);
-  assert(x < _clock_number);
-  tchecker::dbm::db_t db = _L[0 * _dim + index(l, x)];
-  return (db == tchecker::dbm::LT_INFINITY ? tchecker::clockbounds::NO_BOUND : -tchecker::dbm::value(db));
+  _solved = true;
 }
 
-tchecker::clockbounds::bound_t df_solver_t::U(tchecker::loc_id_t l, tchecker::clock_id_t x) const
+void df_solver_t::minimal_paths(std::vector<tchecker::clockbounds::bound_t> const & guards,
+                                std::vector<std::size_t> const & first, std::vector<std::size_t> const & succ,
+                                std::vector<tchecker::integer_t> const & weight,
+                                std::vector<tchecker::clockbounds::bound_t> & bounds) const
 {
-  assert(l < _loc_number);
-  assert(x < _clock_number);
-  tchecker::dbm::db_t db = _U[0 * _dim + index(l, x)];
-  return (db == tchecker::dbm::LT_INFINITY ? tchecker::clockbounds::NO_BOUND : -tchecker::dbm::value(db));
-}
-
-bool df_solver_t::has_solution() const { return _has_solution; }
+  std::int64_t const unreachable = std::numeric_limits<std::int64_t>::max();
+  std::vector<std::int64_t> dist(_dim, unreachable);
+  std::vector<bool> queued(_dim, false);
+  std::deque<std::size_t> waiting;
+
+  // Edges from 0 (i.e. guards)
+  for (std::size_t v = 1; v < _dim; ++v)
+    if (guards[v] != tchecker::clockbounds::NO_BOUND) {
+      dist[v] = -static_cast<std::int64_t>(guards[v]);
+      queued[v] = true;
+      waiting.push_back(v);
+    }
 
-void df_solver_t::clear()
-{
-  // <inf everywhere except <=0 on diagonal
-  for (tchecker::clock_id_t x = 0; x < _dim; ++x) {
-    for (tchecker::clock_id_t y = 0; y < _dim; ++y) {
-      _L[x * _dim + y] = tchecker::dbm::LT_INFINITY;
-      _U[x * _dim + y] = tchecker::dbm::LT_INFINITY;
+  while (!waiting.empty()) {
+    std::size_t u = waiting.front();
+    waiting.pop_front();
+    queued[u] = false;
+    for (std::size_t k = first[u]; k < first[u + 1]; ++k) {
+      std::size_t v = succ[k];
+      if (dist[u] + weight[k] >= dist[v])
+        continue;
+      dist[v] = dist[u] + weight[k];
+      tchecker::clockbounds::check_weight(dist[v]);
+      if (!queued[v]) {
+        queued[v] = true;
+        waiting.push_back(v);
+      }
     }
-    _L[x * _dim + x] = tchecker::dbm::LE_ZERO;
-    _U[x * _dim + x] = tchecker::dbm::LE_ZERO;
   }
 
-  _has_solution = true;
+  for (tchecker::loc_id_t l = 0; l < _loc_number; ++l)
+    for (tchecker::clock_id_t x = 0; x < _clock_number; ++x) {
+      std::int64_t d = dist[index(l, x)];
+      bounds[l * _clock_number + x] =
+          (d == unreachable ? tchecker::clockbounds::NO_BOUND : static_cast<tchecker::clockbounds::bound_t>(-d));
+    }
 }
 
 void df_solver_t::add_lower_bound_guard(tchecker::loc_id_t l, tchecker::clock_id_t x, tchecker::integer_t c)
@@ -148,7 +185,10 @@ void df_solver_t::add_lower_bound_guard(tchecker::loc_id_t l, tchecker::clock_id
   assert(l < _loc_number);
   assert(x < _clock_number);
   // L_{l, x} >= c  (i.e. 0 - L_{l, x} <= -c)
-  _has_solution &= (tchecker::dbm::constrain(_L, _dim, 0, index(l, x), tchecker::dbm::LE, -c) != tchecker::dbm::EMPTY);
+  tchecker::clockbounds::check_weight(-static_cast<std::int64_t>(c));
+  std::size_t i = index(l, x);
+  _L0[i] = std::max(_L0[i], c);
+  _solved = false;
 }
 
 void df_solver_t::add_upper_bound_guard(tchecker::loc_id_t l, tchecker::clock_id_t x, tchecker::integer_t c)
@@ -156,7 +196,10 @@ void df_solver_t::add_upper_bound_guard(tchecker::loc_id_t l, tchecker::clock_id
   assert(l < _loc_number);
   assert(x < _clock_number);
   // U_{l, x} >= c  (i.e. 0 - U_{l ,x} <= -c)
-  _has_solution &= (tchecker::dbm::constrain(_U, _dim, 0, index(l, x), tchecker::dbm::LE, -c) != tchecker::dbm::EMPTY);
+  tchecker::clockbounds::check_weight(-static_cast<std::int64_t>(c));
+  std::size_t i = index(l, x);
+  _U0[i] = std::max(_U0[i], c);
+  _solved = false;
 }
 
 void df_solver_t::add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t x, tchecker::clock_id_t y,
@@ -166,21 +209,17 @@ void df_solver_t::add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, t
   assert(l2 < _loc_number);
   assert(x < _clock_number);
   assert(y < _clock_number);
-  // Propagation over the edge: L_{l2,x} - L_{l1,y} <= c / U_{l2,x} - U_{l1,xy} <= c
-  _has_solution &=
-      (tchecker::dbm::constrain(_L, _dim, index(l2, x), index(l1, y), tchecker::dbm::LE, c) != tchecker::dbm::EMPTY);
-  _has_solution &=
-      (tchecker::dbm::constrain(_U, _dim, index(l2, x), index(l1, y), tchecker::dbm::LE, c) != tchecker::dbm::EMPTY);
+  tchecker::clockbounds::check_weight(c);
+  // Propagation over the edge: L_{l2,x} - L_{l1,y} <= c / U_{l2,x} - U_{l1,y} <= c
+  _edges.push_back(edge_t{index(l2, x), index(l1, y), c});
 
   // Propagation across processes: L_{m,x} - L_{l1,y} <= c / U_{m,x} - U_{l1,y} <= c
-  // for every location m in another process
-  for (tchecker::loc_id_t m = 0; m < _loc_number; ++m)
-    if (_loc_pid[m] != _loc_pid[l1]) {
-      _has_solution &=
-          (tchecker::dbm::constrain(_L, _dim, index(m, x), index(l1, y), tchecker::dbm::LE, c) != tchecker::dbm::EMPTY);
-      _has_solution &=
-          (tchecker::dbm::constrain(_U, _dim, index(m, x), index(l1, y), tchecker::dbm::LE, c) != tchecker::dbm::EMPTY);
-    }
+  // for every location m in another process, through the variable of clock x in the process of m
+  for (tchecker::process_id_t pid = 0; pid < _process_number; ++pid)
+    if (pid != _loc_pid[l1])
+      _edges.push_back(edge_t{process_index(pid, x), index(l1, y), c});
+
+  _solved = false;
 }
 
 void df_solver_t::add_no_assignement(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t x)
@@ -188,12 +227,9 @@ void df_solver_t::add_no_assignement(tchecker::loc_id_t l1, tchecker::loc_id_t l
   assert(l1 < _loc_number);
   assert(l2 < _loc_number);
   assert(x < _clock_number);
-  // L_{l2,x} - L_{l1,x} <= 0
-  _has_solution &=
-      (tchecker::dbm::constrain(_L, _dim, index(l2, x), index(l1, x), tchecker::dbm::LE, 0) != tchecker::dbm::EMPTY);
-  // U_{l2,x} - U_{l1,x} <= 0
-  _has_solution &=
-      (tchecker::dbm::constrain(_U, _dim, index(l2, x), index(l1, x), tchecker::dbm::LE, 0) != tchecker::dbm::EMPTY);
+  // L_{l2,x} - L_{l1,x} <= 0 / U_{l2,x} - U_{l1,x} <= 0
+  _edges.push_back(edge_t{index(l2, x), index(l1, x), 0});
+  _solved = false;
 }
 
 std::size_t df_solver_t::index(tchecker::loc_id_t l, tchecker::clock_id_t x) const
@@ -203,6 +239,21 @@ std::size_t df_solver_t::index(tchecker::loc_id_t l, tchecker::clock_id_t x) con
   return 1 + l * _clock_number + x;
 }
 
+std::size_t df_solver_t::process_index(tchecker::process_id_t pid, tchecker::clock_id_t x)
+{
+  assert(pid < _process_number);
+  assert(x < _clock_number);
+  std::size_t i = 1 + (_loc_number + pid) * _clock_number + x;
+  if (!_process_clocks[pid * _clock_number + x]) {
+    // L_{m,x} - L_{pid,x} <= 0 / U_{m,x} - U_{pid,x} <= 0 for every location m in process pid
+    for (tchecker::loc_id_t m = 0; m < _loc_number; ++m)
+      if (_loc_pid[m] == pid)
+        _edges.push_back(edge_t{index(m, x), i, 0});
+    _process_clocks[pid * _clock_number + x] = true;
+  }
+  return i;
+}
+
 /*!
 \class df_solver_updater_t
 \brief Update solver constraints from expressions and statements
@@ -389,7 +440,7 @@ public:
 
     for (tchecker::clock_id_t lclock = lclocks.begin(); lclock != lclocks.end(); ++lclock)
       for (tchecker::clock_id_t rclock = rclocks.begin(); rclock != rclocks.end(); ++rclock)
-        _solver->add_assignment(_src, lclock, _tgt, rclock, 0);
+        _solver->add_assignment(_src, _tgt, lclock, rclock, 0);
   }
 
   /*!
@@ -573,6 +624,8 @@ std::shared_ptr<tchecker::clockbounds::df_solver_t> solve(tchecker::ta::system_t
   for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
     tchecker::clockbounds::add_edge_constraints(system.guard(edge->id()), system.statement(edge->id()), edge->src(),
                                                 edge->tgt(), solver);
+
+  solver->solve();
   return solver;
 }
 
@@ -6,6 +6,7 @@
  */
 
 #include <cassert>
+#include <vector>
 
 #if BOOST_VERSION <= 106600
 #include <boost/functional/hash.hpp>
@@ -14,6 +15,7 @@
 #endif
 
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/simd.hh"
 #include "tchecker/utils/ordering.hh"
 
 namespace tchecker {
@@ -151,11 +153,14 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
   assert(dim >= 1);
 
   for (tchecker::clock_id_t k = 0; k < dim; ++k) {
+    tchecker::dbm::db_t const * dbm_k = dbm + k * dim;
     for (tchecker::clock_id_t i = 0; i < dim; ++i) {
       if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
         continue;
-      for (tchecker::clock_id_t j = 0; j < dim; ++j)
-        DBM(i, j) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i, k), DBM(k, j)), DBM(i, j));
+      // DBM(i, k) is updated in the middle of the row, as in the textbook loop over j
+      tchecker::dbm::simd::tighten_row(dbm + i * dim, dbm_k, DBM(i, k), 0, k);
+      DBM(i, k) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i, k), DBM(k, k)), DBM(i, k));
+      tchecker::dbm::simd::tighten_row(dbm + i * dim, dbm_k, DBM(i, k), k + 1, dim);
       if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
         DBM(0, 0) = tchecker::dbm::LT_ZERO;
         return tchecker::dbm::EMPTY;
@@ -185,8 +190,11 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
     }
 
     // tighten i->j w.r.t. i->y->j
-    for (tchecker::clock_id_t j = 0; j < dim; ++j)
-      DBM(i, j) = tchecker::dbm::min(DBM(i, j), tchecker::dbm::sum(DBM(i, y), DBM(y, j)));
+    if (DBM(i, y) != tchecker::dbm::LT_INFINITY) {
+      tchecker::dbm::simd::tighten_row(dbm + i * dim, dbm + y * dim, DBM(i, y), 0, y);
+      DBM(i, y) = tchecker::dbm::min(DBM(i, y), tchecker::dbm::sum(DBM(i, y), DBM(y, y)));
+      tchecker::dbm::simd::tighten_row(dbm + i * dim, dbm + y * dim, DBM(i, y), y + 1, dim);
+    }
 
     if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
       DBM(0, 0) = tchecker::dbm::LT_ZERO;
@@ -250,11 +258,7 @@ bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
-  for (tchecker::clock_id_t i = 0; i < dim; ++i)
-    for (tchecker::clock_id_t j = 0; j < dim; ++j)
-      if (DBM1(i, j) != DBM2(i, j))
-        return false;
-  return true;
+  return tchecker::dbm::simd::is_equal(dbm1, dbm2, dim * dim);
 }
 
 bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
@@ -265,11 +269,7 @@ bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, t
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
-  for (tchecker::clock_id_t i = 0; i < dim; ++i)
-    for (tchecker::clock_id_t j = 0; j < dim; ++j)
-      if (DBM1(i, j) > DBM2(i, j))
-        return false;
-  return true;
+  return tchecker::dbm::simd::is_le(dbm1, dbm2, dim * dim);
 }
 
 void reset(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x, tchecker::clock_id_t y,
@@ -396,9 +396,7 @@ enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::d
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
-  for (tchecker::clock_id_t i = 0; i < dim; ++i)
-    for (tchecker::clock_id_t j = 0; j < dim; ++j)
-      DBM(i, j) = tchecker::dbm::min(DBM1(i, j), DBM2(i, j));
+  tchecker::dbm::simd::min(dbm, dbm1, dbm2, dim * dim);
 
   return tchecker::dbm::tighten(dbm, dim);
 }
@@ -553,53 +551,18 @@ void extra_lu(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::int
   assert(tchecker::dbm::is_positive(dbm, dim));
   assert(tchecker::dbm::is_tight(dbm, dim));
 
-  bool modified = false;
+#ifndef NDEBUG
+  for (tchecker::clock_id_t x = 1; x < dim; ++x) {
+    assert(L(x) < tchecker::dbm::INF_VALUE);
+    assert(U(x) < tchecker::dbm::INF_VALUE);
+  }
+#endif
 
   // let DBM(i,j) be (#,cij)
   // DBM(i,j) becomes  <inf    if  cij > L(i)
   //                   <-U(j)  if -cij > U(j)
   //          unchanged otherwise
-
-  // i=0 (first row), only second case applies
-  for (tchecker::clock_id_t j = 1; j < dim; ++j) {
-    tchecker::integer_t Uj = U(j);
-    assert(Uj < tchecker::dbm::INF_VALUE);
-    if (DBM(0, j) == tchecker::dbm::LE_ZERO)
-      continue;
-    tchecker::integer_t c0j = tchecker::dbm::value(DBM(0, j));
-    if (-c0j > Uj) {
-      DBM(0, j) = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LE_ZERO : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
-      modified = true;
-    }
-  }
-
-  // i>0, both cases apply
-  for (tchecker::clock_id_t i = 1; i < dim; ++i) {
-    tchecker::integer_t Li = L(i);
-    assert(Li < tchecker::dbm::INF_VALUE);
-    assert(U(i) < tchecker::dbm::INF_VALUE);
-
-    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
-      assert(L(j) < tchecker::dbm::INF_VALUE);
-      tchecker::integer_t Uj = U(j);
-      assert(Uj < tchecker::dbm::INF_VALUE);
-
-      if (i == j)
-        continue;
-      if (DBM(i, j) == tchecker::dbm::LT_INFINITY)
-        continue;
-
-      tchecker::integer_t cij = tchecker::dbm::value(DBM(i, j));
-      if (cij > Li) {
-        DBM(i, j) = tchecker::dbm::LT_INFINITY;
-        modified = true;
-      }
-      else if (-cij > Uj) {
-        DBM(i, j) = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LT_INFINITY : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
-        modified = true;
-      }
-    }
-  }
+  bool modified = tchecker::dbm::simd::extra_lu(dbm, dim, l, u);
 
   if (modified)
     tchecker::dbm::tighten(dbm, dim);
@@ -618,7 +581,12 @@ void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker
   assert(tchecker::dbm::is_positive(dbm, dim));
   assert(tchecker::dbm::is_tight(dbm, dim));
 
-  bool modified = false;
+#ifndef NDEBUG
+  for (tchecker::clock_id_t x = 1; x < dim; ++x) {
+    assert(L(x) < tchecker::dbm::INF_VALUE);
+    assert(U(x) < tchecker::dbm::INF_VALUE);
+  }
+#endif
 
   // let DBM(i,j) be (#,cij)
   // DBM(i,j) becomes  <inf    if  cij > L(i)
@@ -626,66 +594,7 @@ void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker
   //                   <inf    if -c0j > U(j), i != 0
   //                   <-U(j)  if -c0j > U(j), i  = 0
   //          unchanged otherwise
-
-  // NB: the first line (i.e. 0-line) must be modified last to keep
-  // c0i and c0j intact for 2nd, 3rd and 4th cases
-
-  // i > 0, all cases except the 4th apply
-  for (tchecker::clock_id_t i = 1; i < dim; ++i) {
-    tchecker::integer_t Li = L(i);
-    assert(Li < tchecker::dbm::INF_VALUE);
-    assert(U(i) < tchecker::dbm::INF_VALUE);
-
-    tchecker::integer_t c0i = tchecker::dbm::value(DBM(0, i));
-
-    if (-c0i > Li) { // 2nd case
-      for (tchecker::clock_id_t j = 0; j < dim; ++j) {
-        if (i == j)
-          continue;
-        if (DBM(i, j) == tchecker::dbm::LT_INFINITY)
-          continue;
-
-        DBM(i, j) = tchecker::dbm::LT_INFINITY;
-        modified = true;
-      }
-    }
-    else { // 1st and 3rd cases apply
-      for (tchecker::clock_id_t j = 0; j < dim; ++j) {
-        assert(L(j) < tchecker::dbm::INF_VALUE);
-        tchecker::integer_t Uj = U(j);
-        assert(Uj < tchecker::dbm::INF_VALUE);
-
-        if (i == j)
-          continue;
-        if (DBM(i, j) == tchecker::dbm::LT_INFINITY)
-          continue;
-
-        tchecker::integer_t c0j = tchecker::dbm::value(DBM(0, j));
-        tchecker::integer_t cij = tchecker::dbm::value(DBM(i, j));
-
-        if (cij > Li || -c0j > Uj) {
-          DBM(i, j) = tchecker::dbm::LT_INFINITY;
-          modified = true;
-        }
-      }
-    }
-  }
-
-  // i = 0, only the 4th case apply
-  assert(L(0) < tchecker::dbm::INF_VALUE);
-  assert(U(0) < tchecker::dbm::INF_VALUE);
-
-  for (tchecker::clock_id_t j = 1; j < dim; ++j) {
-    assert(L(j) < tchecker::dbm::INF_VALUE);
-    tchecker::integer_t Uj = U(j);
-    assert(Uj < tchecker::dbm::INF_VALUE);
-
-    tchecker::integer_t c0j = tchecker::dbm::value(DBM(0, j));
-    if (-c0j > Uj) {
-      DBM(0, j) = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LE_ZERO : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
-      modified = true;
-    }
-  }
+  bool modified = tchecker::dbm::simd::extra_lu_plus(dbm, dim, l, u);
 
   if (modified)
     tchecker::dbm::tighten(dbm, dim);
@@ -840,6 +749,123 @@ int lexical_cmp(tchecker::dbm::db_t const * dbm1, tchecker::clock_id_t dim1, tch
   return tchecker::lexical_cmp(dbm1, dbm1 + dim1 * dim1, dbm2, dbm2 + dim2 * dim2, tchecker::dbm::db_cmp);
 }
 
+bool is_narrow(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  for (tchecker::clock_id_t k = 0; k < dim * dim; ++k)
+    if (!tchecker::dbm::is_narrow(dbm[k]))
+      return false;
+  return true;
+}
+
+void narrow(tchecker::dbm::narrow_db_t * ndbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  assert(ndbm != nullptr);
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  for (tchecker::clock_id_t k = 0; k < dim * dim; ++k)
+    ndbm[k] = tchecker::dbm::narrow(dbm[k]);
+}
+
+void widen(tchecker::dbm::db_t * dbm, tchecker::dbm::narrow_db_t const * ndbm, tchecker::clock_id_t dim)
+{
+  assert(dbm != nullptr);
+  assert(ndbm != nullptr);
+  assert(dim >= 1);
+
+  for (tchecker::clock_id_t k = 0; k < dim * dim; ++k)
+    dbm[k] = tchecker::dbm::widen(ndbm[k]);
+}
+
+std::size_t reduce(tchecker::dbm::reduced_db_t * rdbm, tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  assert(!tchecker::dbm::is_empty_0(dbm, dim));
+
+  std::size_t size = 0;
+  auto keep = [&](tchecker::clock_id_t i, tchecker::clock_id_t j) {
+    if (rdbm != nullptr)
+      rdbm[size] = tchecker::dbm::reduced_db_t{i, j, DBM(i, j)};
+    ++size;
+  };
+
+  // Classes of clocks w.r.t. zero-weight cycles, represented by their smallest clock
+  std::vector<tchecker::clock_id_t> rep(dim);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    rep[i] = i;
+    for (tchecker::clock_id_t j = 0; j < i; ++j)
+      if (rep[j] == j && tchecker::dbm::sum(DBM(i, j), DBM(j, i)) == tchecker::dbm::LE_ZERO) {
+        rep[i] = j;
+        break;
+      }
+  }
+
+  // Each class with several clocks is represented by a cycle through its clocks
+  for (tchecker::clock_id_t r = 0; r < dim; ++r) {
+    if (rep[r] != r)
+      continue;
+    tchecker::clock_id_t last = r;
+    for (tchecker::clock_id_t i = r + 1; i < dim; ++i)
+      if (rep[i] == r) {
+        keep(last, i);
+        last = i;
+      }
+    if (last != r)
+      keep(last, r);
+  }
+
+  // Bounds between classes that are not implied by a third class
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if (rep[i] != i)
+      continue;
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if (rep[j] != j || j == i || DBM(i, j) == tchecker::dbm::LT_INFINITY)
+        continue;
+      bool redundant = false;
+      for (tchecker::clock_id_t k = 0; k < dim && !redundant; ++k)
+        redundant = (rep[k] == k && k != i && k != j && tchecker::dbm::sum(DBM(i, k), DBM(k, j)) <= DBM(i, j));
+      if (!redundant)
+        keep(i, j);
+    }
+  }
+
+  return size;
+}
+
+void expand(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::dbm::reduced_db_t const * rdbm, std::size_t size)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      DBM(i, j) = (i == j ? tchecker::dbm::LE_ZERO : tchecker::dbm::LT_INFINITY);
+  for (std::size_t k = 0; k < size; ++k)
+    DBM(rdbm[k].i, rdbm[k].j) = rdbm[k].db;
+
+  if (size > 0)
+    tchecker::dbm::tighten(dbm, dim);
+
+  assert(tchecker::dbm::is_tight(dbm, dim));
+}
+
+bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::clock_id_t dim, tchecker::dbm::reduced_db_t const * rdbm2,
+           std::size_t size2)
+{
+  assert(dbm1 != nullptr);
+  assert(dim >= 1);
+
+  for (std::size_t k = 0; k < size2; ++k)
+    if (DBM1(rdbm2[k].i, rdbm2[k].j) > rdbm2[k].db)
+      return false;
+  return true;
+}
+
 } // end of namespace dbm
 
 } // end of namespace tchecker
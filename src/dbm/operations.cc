@@ -0,0 +1,110 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+
+#include "tchecker/dbm/operations.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace {
+
+/* Adapters from specialized operations to the signatures of generic operations */
+
+template <tchecker::clock_id_t DIM>
+enum tchecker::dbm::status_t fixed_tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
+{
+  assert(dim == DIM);
+  return tchecker::dbm::fixed::tighten<DIM>(dbm);
+}
+
+template <tchecker::clock_id_t DIM>
+enum tchecker::dbm::status_t fixed_constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                             tchecker::clock_constraint_container_t const & constraints)
+{
+  assert(dim == DIM);
+  return tchecker::dbm::fixed::constrain<DIM>(dbm, constraints);
+}
+
+template <tchecker::clock_id_t DIM>
+void fixed_reset(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_reset_container_t const & resets)
+{
+  assert(dim == DIM);
+  tchecker::dbm::fixed::reset<DIM>(dbm, resets);
+}
+
+template <tchecker::clock_id_t DIM> void fixed_open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
+{
+  assert(dim == DIM);
+  tchecker::dbm::fixed::open_up<DIM>(dbm);
+}
+
+template <tchecker::clock_id_t DIM>
+bool fixed_is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
+{
+  assert(dim == DIM);
+  return tchecker::dbm::fixed::is_le<DIM>(dbm1, dbm2);
+}
+
+template <tchecker::clock_id_t DIM>
+bool fixed_is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                     tchecker::integer_t const * l, tchecker::integer_t const * u)
+{
+  assert(dim == DIM);
+  return tchecker::dbm::fixed::is_alu_le<DIM>(dbm1, dbm2, l, u);
+}
+
+template <tchecker::clock_id_t DIM>
+void fixed_extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                         tchecker::integer_t const * u)
+{
+  assert(dim == DIM);
+  tchecker::dbm::fixed::extra_lu_plus<DIM>(dbm, l, u);
+}
+
+template <tchecker::clock_id_t DIM> constexpr tchecker::dbm::operations_t make_operations()
+{
+  return {DIM,
+          &fixed_tighten<DIM>,
+          &fixed_constrain<DIM>,
+          &fixed_reset<DIM>,
+          &fixed_open_up<DIM>,
+          &fixed_is_le<DIM>,
+          &fixed_is_alu_le<DIM>,
+          &fixed_extra_lu_plus<DIM>};
+}
+
+tchecker::dbm::operations_t const generic = {0,
+                                             &tchecker::dbm::tighten,
+                                             &tchecker::dbm::constrain,
+                                             &tchecker::dbm::reset,
+                                             &tchecker::dbm::open_up,
+                                             &tchecker::dbm::is_le,
+                                             &tchecker::dbm::is_alu_le,
+                                             &tchecker::dbm::extra_lu_plus};
+
+/* Specialized operations, indexed by dimension - 1 */
+tchecker::dbm::operations_t const specialized[tchecker::dbm::FIXED_DIM_MAX] = {
+    make_operations<1>(), make_operations<2>(), make_operations<3>(), make_operations<4>(), make_operations<5>(),
+    make_operations<6>(), make_operations<7>(), make_operations<8>(), make_operations<9>()};
+
+} // end of anonymous namespace
+
+tchecker::dbm::operations_t const & operations(tchecker::clock_id_t dim)
+{
+  if (dim < 1 || dim > tchecker::dbm::FIXED_DIM_MAX)
+    return generic;
+  return specialized[dim - 1];
+}
+
+tchecker::dbm::operations_t const & generic_operations() { return generic; }
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
@@ -11,6 +11,7 @@
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/dbm/refdbm.hh"
+#include "tchecker/dbm/simd.hh"
 #include "tchecker/utils/ordering.hh"
 
 #define DBM(i, j)       dbm[(i)*dim + (j)]
@@ -557,12 +558,8 @@ enum tchecker::dbm::status_t bound_spread(tchecker::dbm::db_t * rdbm, tchecker::
       if (x == t || RDBM(x, t) == tchecker::dbm::LT_INFINITY)
         continue; // optimization
 
-      for (tchecker::clock_id_t y = 0; y < rdim; ++y) {
-        if (y == t || RDBM(t, y) == tchecker::dbm::LT_INFINITY)
-          continue; // optimization
-
-        RDBM(x, y) = tchecker::dbm::min(tchecker::dbm::sum(RDBM(x, t), RDBM(t, y)), RDBM(x, y));
-      }
+      tchecker::dbm::simd::tighten_row(rdbm + x * rdim, rdbm + t * rdim, RDBM(x, t), 0, t);
+      tchecker::dbm::simd::tighten_row(rdbm + x * rdim, rdbm + t * rdim, RDBM(x, t), t + 1, rdim);
 
       if (RDBM(x, x) < tchecker::dbm::LE_ZERO) {
         RDBM(0, 0) = tchecker::dbm::LT_ZERO;
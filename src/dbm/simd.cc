@@ -0,0 +1,694 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "tchecker/dbm/simd.hh"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && (INTEGER_T_SIZE == 32)
+#define TCHECKER_DBM_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+namespace details {
+
+namespace {
+
+/* Scalar kernels */
+
+/*!
+ \brief ExtraLU on one difference bound in a row i > 0
+ \param db : a difference bound DBM(i,j) with i != j
+ \param Li : L(i)
+ \param Uj : U(j)
+ \return true if db has been modified, false otherwise
+ */
+inline bool extra_lu_db(tchecker::dbm::db_t & db, tchecker::integer_t Li, tchecker::integer_t Uj)
+{
+  if (db == tchecker::dbm::LT_INFINITY)
+    return false;
+  tchecker::integer_t cij = tchecker::dbm::value(db);
+  if (cij > Li) {
+    db = tchecker::dbm::LT_INFINITY;
+    return true;
+  }
+  if (-cij > Uj) {
+    db = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LT_INFINITY : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
+    return true;
+  }
+  return false;
+}
+
+/*!
+ \brief ExtraLU+ on one difference bound in a row i > 0, when -c0i <= L(i)
+ \param db : a difference bound DBM(i,j) with i != j
+ \param db0 : DBM(0,j)
+ \param Li : L(i)
+ \param Uj : U(j)
+ \return true if db has been modified, false otherwise
+ */
+inline bool extra_lu_plus_db(tchecker::dbm::db_t & db, tchecker::dbm::db_t db0, tchecker::integer_t Li, tchecker::integer_t Uj)
+{
+  if (db == tchecker::dbm::LT_INFINITY)
+    return false;
+  if (tchecker::dbm::value(db) > Li || -tchecker::dbm::value(db0) > Uj) {
+    db = tchecker::dbm::LT_INFINITY;
+    return true;
+  }
+  return false;
+}
+
+/*!
+ \brief ExtraLU and ExtraLU+ on one difference bound in row 0
+ \param db : a difference bound DBM(0,j) with j > 0
+ \param Uj : U(j)
+ \return true if db has been modified, false otherwise
+ */
+inline bool extra_lu_row0_db(tchecker::dbm::db_t & db, tchecker::integer_t Uj)
+{
+  if (-tchecker::dbm::value(db) > Uj) {
+    db = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LE_ZERO : tchecker::dbm::db(tchecker::dbm::LT, -Uj));
+    return true;
+  }
+  return false;
+}
+
+/*!
+ \class scalar_t
+ \brief Scalar kernels
+ \note Row kernels apply to the difference bounds row[j] for jbegin <= j < jend,
+ and read the upper bound of clock j as u[j-1], hence jbegin should be at least 1
+ */
+struct scalar_t {
+  static bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, std::size_t size)
+  {
+    for (std::size_t k = 0; k < size; ++k)
+      if (dbm1[k] != dbm2[k])
+        return false;
+    return true;
+  }
+
+  static bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, std::size_t size)
+  {
+    for (std::size_t k = 0; k < size; ++k)
+      if (dbm1[k] > dbm2[k])
+        return false;
+    return true;
+  }
+
+  static void min(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                  std::size_t size)
+  {
+    for (std::size_t k = 0; k < size; ++k)
+      dbm[k] = tchecker::dbm::min(dbm1[k], dbm2[k]);
+  }
+
+  static void tighten_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * rowk, tchecker::dbm::db_t dik,
+                          tchecker::clock_id_t jbegin, tchecker::clock_id_t jend)
+  {
+    for (tchecker::clock_id_t j = jbegin; j < jend; ++j)
+      row[j] = tchecker::dbm::min(tchecker::dbm::sum(dik, rowk[j]), row[j]);
+  }
+
+  static bool extra_lu_row(tchecker::dbm::db_t * row, tchecker::clock_id_t jbegin, tchecker::clock_id_t jend,
+                           tchecker::integer_t Li, tchecker::integer_t const * u)
+  {
+    bool modified = false;
+    for (tchecker::clock_id_t j = jbegin; j < jend; ++j)
+      modified |= extra_lu_db(row[j], Li, u[j - 1]);
+    return modified;
+  }
+
+  static bool extra_lu_row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim, tchecker::integer_t const * u)
+  {
+    bool modified = false;
+    for (tchecker::clock_id_t j = 1; j < dim; ++j)
+      if (row[j] != tchecker::dbm::LE_ZERO)
+        modified |= extra_lu_row0_db(row[j], u[j - 1]);
+    return modified;
+  }
+
+  static bool extra_lu_plus_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * row0, tchecker::clock_id_t jbegin,
+                                tchecker::clock_id_t jend, tchecker::integer_t Li, tchecker::integer_t const * u)
+  {
+    bool modified = false;
+    for (tchecker::clock_id_t j = jbegin; j < jend; ++j)
+      modified |= extra_lu_plus_db(row[j], row0[j], Li, u[j - 1]);
+    return modified;
+  }
+
+  static bool extra_lu_plus_row_inf(tchecker::dbm::db_t * row, tchecker::clock_id_t jbegin, tchecker::clock_id_t jend)
+  {
+    bool modified = false;
+    for (tchecker::clock_id_t j = jbegin; j < jend; ++j)
+      if (row[j] != tchecker::dbm::LT_INFINITY) {
+        row[j] = tchecker::dbm::LT_INFINITY;
+        modified = true;
+      }
+    return modified;
+  }
+
+  static bool extra_lu_plus_row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim, tchecker::integer_t const * u)
+  {
+    bool modified = false;
+    for (tchecker::clock_id_t j = 1; j < dim; ++j)
+      modified |= extra_lu_row0_db(row[j], u[j - 1]);
+    return modified;
+  }
+};
+
+/* Extrapolations, vectorized along rows by OPS */
+
+template <class OPS>
+bool extra_lu(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+              tchecker::integer_t const * u)
+{
+  // i=0 (first row), only second case applies
+  bool modified = OPS::extra_lu_row0(dbm, dim, u);
+
+  // i>0, both cases apply (U(0) = 0 for j=0)
+  for (tchecker::clock_id_t i = 1; i < dim; ++i) {
+    tchecker::dbm::db_t * row = dbm + i * dim;
+    tchecker::integer_t Li = l[i - 1];
+    modified |= extra_lu_db(row[0], Li, 0);
+    modified |= OPS::extra_lu_row(row, 1, i, Li, u);
+    modified |= OPS::extra_lu_row(row, i + 1, dim, Li, u);
+  }
+
+  return modified;
+}
+
+template <class OPS>
+bool extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                   tchecker::integer_t const * u)
+{
+  bool modified = false;
+
+  // i > 0, the first row must be modified last to keep c0i and c0j intact
+  for (tchecker::clock_id_t i = 1; i < dim; ++i) {
+    tchecker::dbm::db_t * row = dbm + i * dim;
+    tchecker::integer_t Li = l[i - 1];
+
+    if (-tchecker::dbm::value(dbm[i]) > Li) {
+      modified |= OPS::extra_lu_plus_row_inf(row, 0, i);
+      modified |= OPS::extra_lu_plus_row_inf(row, i + 1, dim);
+    }
+    else {
+      modified |= extra_lu_plus_db(row[0], dbm[0], Li, 0);
+      modified |= OPS::extra_lu_plus_row(row, dbm, 1, i, Li, u);
+      modified |= OPS::extra_lu_plus_row(row, dbm, i + 1, dim, Li, u);
+    }
+  }
+
+  // i = 0
+  modified |= OPS::extra_lu_plus_row0(dbm, dim, u);
+
+  return modified;
+}
+
+#if defined(TCHECKER_DBM_SIMD_X86)
+
+/* SSE4.2 kernels (4 difference bounds per vector) */
+
+#define TCHECKER_TARGET_SSE42 __attribute__((target("sse4.2")))
+
+struct sse42_t {
+  TCHECKER_TARGET_SSE42 static bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                                             std::size_t size)
+  {
+    std::size_t k = 0;
+    for (; k + 4 <= size; k += 4) {
+      __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(dbm1 + k)),
+                                _mm_loadu_si128(reinterpret_cast<__m128i const *>(dbm2 + k)));
+      if (!_mm_testz_si128(x, x))
+        return false;
+    }
+    return scalar_t::is_equal(dbm1 + k, dbm2 + k, size - k);
+  }
+
+  TCHECKER_TARGET_SSE42 static bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, std::size_t size)
+  {
+    std::size_t k = 0;
+    for (; k + 4 <= size; k += 4) {
+      __m128i gt = _mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(dbm1 + k)),
+                                   _mm_loadu_si128(reinterpret_cast<__m128i const *>(dbm2 + k)));
+      if (!_mm_testz_si128(gt, gt))
+        return false;
+    }
+    return scalar_t::is_le(dbm1 + k, dbm2 + k, size - k);
+  }
+
+  TCHECKER_TARGET_SSE42 static void min(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
+                                        tchecker::dbm::db_t const * dbm2, std::size_t size)
+  {
+    std::size_t k = 0;
+    for (; k + 4 <= size; k += 4)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dbm + k),
+                       _mm_min_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(dbm1 + k)),
+                                     _mm_loadu_si128(reinterpret_cast<__m128i const *>(dbm2 + k))));
+    scalar_t::min(dbm + k, dbm1 + k, dbm2 + k, size - k);
+  }
+
+  TCHECKER_TARGET_SSE42 static void tighten_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * rowk,
+                                               tchecker::dbm::db_t dik, tchecker::clock_id_t jbegin, tchecker::clock_id_t jend)
+  {
+    if (dik == tchecker::dbm::LT_INFINITY)
+      return;
+    __m128i const lt_inf = _mm_set1_epi32(tchecker::dbm::LT_INFINITY);
+#if defined(DBM_UNSAFE)
+    __m128i const one = _mm_set1_epi32(1);
+    __m128i const db_ik = _mm_set1_epi32(dik);
+#else
+    __m128i const value_ik = _mm_set1_epi32(dik >> 1);
+    __m128i const cmp_ik = _mm_set1_epi32(dik & tchecker::dbm::LE);
+    __m128i const min_value = _mm_set1_epi32(tchecker::dbm::MIN_VALUE);
+    __m128i const max_value = _mm_set1_epi32(tchecker::dbm::MAX_VALUE);
+#endif
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 4 <= jend; j += 4) {
+      __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + j));
+      __m128i dk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(rowk + j));
+      __m128i inf = _mm_cmpeq_epi32(dk, lt_inf);
+#if defined(DBM_UNSAFE)
+      __m128i s = _mm_sub_epi32(_mm_add_epi32(db_ik, dk), _mm_and_si128(_mm_or_si128(db_ik, dk), one));
+#else
+      __m128i v = _mm_add_epi32(value_ik, _mm_srai_epi32(dk, 1));
+      __m128i out = _mm_andnot_si128(inf, _mm_or_si128(_mm_cmpgt_epi32(min_value, v), _mm_cmpgt_epi32(v, max_value)));
+      if (!_mm_testz_si128(out, out))
+        break; // the scalar loop below throws
+      __m128i s = _mm_or_si128(_mm_slli_epi32(v, 1), _mm_and_si128(dk, cmp_ik));
+#endif
+      s = _mm_blendv_epi8(s, lt_inf, inf);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(row + j), _mm_min_epi32(s, d));
+    }
+    scalar_t::tighten_row(row, rowk, dik, j, jend);
+  }
+
+  TCHECKER_TARGET_SSE42 static bool extra_lu_row(tchecker::dbm::db_t * row, tchecker::clock_id_t jbegin,
+                                                 tchecker::clock_id_t jend, tchecker::integer_t Li,
+                                                 tchecker::integer_t const * u)
+  {
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const lt_inf = _mm_set1_epi32(tchecker::dbm::LT_INFINITY);
+    __m128i const minus_inf = _mm_set1_epi32(-tchecker::dbm::INF_VALUE);
+    __m128i const li = _mm_set1_epi32(Li);
+    bool modified = false;
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 4 <= jend; j += 4) {
+      __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + j));
+      __m128i uj = _mm_loadu_si128(reinterpret_cast<__m128i const *>(u + j - 1));
+      __m128i c = _mm_srai_epi32(d, 1);
+      __m128i case1 = _mm_cmpgt_epi32(c, li);
+      __m128i case2 = _mm_cmpgt_epi32(_mm_sub_epi32(zero, c), uj);
+      __m128i changed = _mm_andnot_si128(_mm_cmpeq_epi32(d, lt_inf), _mm_or_si128(case1, case2));
+      if (_mm_testz_si128(changed, changed))
+        continue;
+      __m128i v2 = _mm_blendv_epi8(_mm_slli_epi32(_mm_sub_epi32(zero, uj), 1), lt_inf, _mm_cmpeq_epi32(uj, minus_inf));
+      __m128i v = _mm_blendv_epi8(v2, lt_inf, case1);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(row + j), _mm_blendv_epi8(d, v, changed));
+      modified = true;
+    }
+    return scalar_t::extra_lu_row(row, j, jend, Li, u) || modified;
+  }
+
+  TCHECKER_TARGET_SSE42 static bool extra_lu_row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim,
+                                                  tchecker::integer_t const * u)
+  {
+    return row0(row, dim, u, true);
+  }
+
+  TCHECKER_TARGET_SSE42 static bool extra_lu_plus_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * row0,
+                                                      tchecker::clock_id_t jbegin, tchecker::clock_id_t jend,
+                                                      tchecker::integer_t Li, tchecker::integer_t const * u)
+  {
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const lt_inf = _mm_set1_epi32(tchecker::dbm::LT_INFINITY);
+    __m128i const li = _mm_set1_epi32(Li);
+    bool modified = false;
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 4 <= jend; j += 4) {
+      __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + j));
+      __m128i d0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row0 + j));
+      __m128i uj = _mm_loadu_si128(reinterpret_cast<__m128i const *>(u + j - 1));
+      __m128i case1 = _mm_cmpgt_epi32(_mm_srai_epi32(d, 1), li);
+      __m128i case3 = _mm_cmpgt_epi32(_mm_sub_epi32(zero, _mm_srai_epi32(d0, 1)), uj);
+      __m128i changed = _mm_andnot_si128(_mm_cmpeq_epi32(d, lt_inf), _mm_or_si128(case1, case3));
+      if (_mm_testz_si128(changed, changed))
+        continue;
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(row + j), _mm_blendv_epi8(d, lt_inf, changed));
+      modified = true;
+    }
+    return scalar_t::extra_lu_plus_row(row, row0, j, jend, Li, u) || modified;
+  }
+
+  TCHECKER_TARGET_SSE42 static bool extra_lu_plus_row_inf(tchecker::dbm::db_t * row, tchecker::clock_id_t jbegin,
+                                                          tchecker::clock_id_t jend)
+  {
+    __m128i const lt_inf = _mm_set1_epi32(tchecker::dbm::LT_INFINITY);
+    __m128i const all = _mm_set1_epi32(-1);
+    bool modified = false;
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 4 <= jend; j += 4) {
+      __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + j));
+      if (_mm_testc_si128(_mm_cmpeq_epi32(d, lt_inf), all))
+        continue;
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(row + j), lt_inf);
+      modified = true;
+    }
+    return scalar_t::extra_lu_plus_row_inf(row, j, jend) || modified;
+  }
+
+  TCHECKER_TARGET_SSE42 static bool extra_lu_plus_row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim,
+                                                       tchecker::integer_t const * u)
+  {
+    return row0(row, dim, u, false);
+  }
+
+private:
+  TCHECKER_TARGET_SSE42 static bool row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim, tchecker::integer_t const * u,
+                                         bool skip_le_zero)
+  {
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const le_zero = _mm_set1_epi32(tchecker::dbm::LE_ZERO);
+    __m128i const minus_inf = _mm_set1_epi32(-tchecker::dbm::INF_VALUE);
+    bool modified = false;
+    tchecker::clock_id_t j = 1;
+    for (; j + 4 <= dim; j += 4) {
+      __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(row + j));
+      __m128i uj = _mm_loadu_si128(reinterpret_cast<__m128i const *>(u + j - 1));
+      __m128i changed = _mm_cmpgt_epi32(_mm_sub_epi32(zero, _mm_srai_epi32(d, 1)), uj);
+      if (skip_le_zero)
+        changed = _mm_andnot_si128(_mm_cmpeq_epi32(d, le_zero), changed);
+      if (_mm_testz_si128(changed, changed))
+        continue;
+      __m128i v = _mm_blendv_epi8(_mm_slli_epi32(_mm_sub_epi32(zero, uj), 1), le_zero, _mm_cmpeq_epi32(uj, minus_inf));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(row + j), _mm_blendv_epi8(d, v, changed));
+      modified = true;
+    }
+    for (; j < dim; ++j)
+      if (!skip_le_zero || row[j] != tchecker::dbm::LE_ZERO)
+        modified |= extra_lu_row0_db(row[j], u[j - 1]);
+    return modified;
+  }
+};
+
+/* AVX2 kernels (8 difference bounds per vector) */
+
+#define TCHECKER_TARGET_AVX2 __attribute__((target("avx2")))
+
+struct avx2_t {
+  TCHECKER_TARGET_AVX2 static bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                                            std::size_t size)
+  {
+    std::size_t k = 0;
+    for (; k + 8 <= size; k += 8) {
+      __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm1 + k)),
+                                   _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm2 + k)));
+      if (!_mm256_testz_si256(x, x))
+        return false;
+    }
+    return scalar_t::is_equal(dbm1 + k, dbm2 + k, size - k);
+  }
+
+  TCHECKER_TARGET_AVX2 static bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, std::size_t size)
+  {
+    std::size_t k = 0;
+    for (; k + 8 <= size; k += 8) {
+      __m256i gt = _mm256_cmpgt_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm1 + k)),
+                                      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm2 + k)));
+      if (!_mm256_testz_si256(gt, gt))
+        return false;
+    }
+    return scalar_t::is_le(dbm1 + k, dbm2 + k, size - k);
+  }
+
+  TCHECKER_TARGET_AVX2 static void min(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
+                                       tchecker::dbm::db_t const * dbm2, std::size_t size)
+  {
+    std::size_t k = 0;
+    for (; k + 8 <= size; k += 8)
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dbm + k),
+                          _mm256_min_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm1 + k)),
+                                           _mm256_loadu_si256(reinterpret_cast<__m256i const *>(dbm2 + k))));
+    scalar_t::min(dbm + k, dbm1 + k, dbm2 + k, size - k);
+  }
+
+  TCHECKER_TARGET_AVX2 static void tighten_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * rowk,
+                                              tchecker::dbm::db_t dik, tchecker::clock_id_t jbegin, tchecker::clock_id_t jend)
+  {
+    if (dik == tchecker::dbm::LT_INFINITY)
+      return;
+    __m256i const lt_inf = _mm256_set1_epi32(tchecker::dbm::LT_INFINITY);
+#if defined(DBM_UNSAFE)
+    __m256i const one = _mm256_set1_epi32(1);
+    __m256i const db_ik = _mm256_set1_epi32(dik);
+#else
+    __m256i const value_ik = _mm256_set1_epi32(dik >> 1);
+    __m256i const cmp_ik = _mm256_set1_epi32(dik & tchecker::dbm::LE);
+    __m256i const min_value = _mm256_set1_epi32(tchecker::dbm::MIN_VALUE);
+    __m256i const max_value = _mm256_set1_epi32(tchecker::dbm::MAX_VALUE);
+#endif
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 8 <= jend; j += 8) {
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + j));
+      __m256i dk = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rowk + j));
+      __m256i inf = _mm256_cmpeq_epi32(dk, lt_inf);
+#if defined(DBM_UNSAFE)
+      __m256i s = _mm256_sub_epi32(_mm256_add_epi32(db_ik, dk), _mm256_and_si256(_mm256_or_si256(db_ik, dk), one));
+#else
+      __m256i v = _mm256_add_epi32(value_ik, _mm256_srai_epi32(dk, 1));
+      __m256i out =
+          _mm256_andnot_si256(inf, _mm256_or_si256(_mm256_cmpgt_epi32(min_value, v), _mm256_cmpgt_epi32(v, max_value)));
+      if (!_mm256_testz_si256(out, out))
+        break; // the scalar loop below throws
+      __m256i s = _mm256_or_si256(_mm256_slli_epi32(v, 1), _mm256_and_si256(dk, cmp_ik));
+#endif
+      s = _mm256_blendv_epi8(s, lt_inf, inf);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + j), _mm256_min_epi32(s, d));
+    }
+    sse42_t::tighten_row(row, rowk, dik, j, jend);
+  }
+
+  TCHECKER_TARGET_AVX2 static bool extra_lu_row(tchecker::dbm::db_t * row, tchecker::clock_id_t jbegin,
+                                                tchecker::clock_id_t jend, tchecker::integer_t Li,
+                                                tchecker::integer_t const * u)
+  {
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const lt_inf = _mm256_set1_epi32(tchecker::dbm::LT_INFINITY);
+    __m256i const minus_inf = _mm256_set1_epi32(-tchecker::dbm::INF_VALUE);
+    __m256i const li = _mm256_set1_epi32(Li);
+    bool modified = false;
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 8 <= jend; j += 8) {
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + j));
+      __m256i uj = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(u + j - 1));
+      __m256i c = _mm256_srai_epi32(d, 1);
+      __m256i case1 = _mm256_cmpgt_epi32(c, li);
+      __m256i case2 = _mm256_cmpgt_epi32(_mm256_sub_epi32(zero, c), uj);
+      __m256i changed = _mm256_andnot_si256(_mm256_cmpeq_epi32(d, lt_inf), _mm256_or_si256(case1, case2));
+      if (_mm256_testz_si256(changed, changed))
+        continue;
+      __m256i v2 = _mm256_blendv_epi8(_mm256_slli_epi32(_mm256_sub_epi32(zero, uj), 1), lt_inf,
+                                      _mm256_cmpeq_epi32(uj, minus_inf));
+      __m256i v = _mm256_blendv_epi8(v2, lt_inf, case1);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + j), _mm256_blendv_epi8(d, v, changed));
+      modified = true;
+    }
+    return sse42_t::extra_lu_row(row, j, jend, Li, u) || modified;
+  }
+
+  TCHECKER_TARGET_AVX2 static bool extra_lu_row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim,
+                                                 tchecker::integer_t const * u)
+  {
+    return row0(row, dim, u, true);
+  }
+
+  TCHECKER_TARGET_AVX2 static bool extra_lu_plus_row(tchecker::dbm::db_t * row, tchecker::dbm::db_t const * row0,
+                                                     tchecker::clock_id_t jbegin, tchecker::clock_id_t jend,
+                                                     tchecker::integer_t Li, tchecker::integer_t const * u)
+  {
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const lt_inf = _mm256_set1_epi32(tchecker::dbm::LT_INFINITY);
+    __m256i const li = _mm256_set1_epi32(Li);
+    bool modified = false;
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 8 <= jend; j += 8) {
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + j));
+      __m256i d0 = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row0 + j));
+      __m256i uj = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(u + j - 1));
+      __m256i case1 = _mm256_cmpgt_epi32(_mm256_srai_epi32(d, 1), li);
+      __m256i case3 = _mm256_cmpgt_epi32(_mm256_sub_epi32(zero, _mm256_srai_epi32(d0, 1)), uj);
+      __m256i changed = _mm256_andnot_si256(_mm256_cmpeq_epi32(d, lt_inf), _mm256_or_si256(case1, case3));
+      if (_mm256_testz_si256(changed, changed))
+        continue;
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + j), _mm256_blendv_epi8(d, lt_inf, changed));
+      modified = true;
+    }
+    return sse42_t::extra_lu_plus_row(row, row0, j, jend, Li, u) || modified;
+  }
+
+  TCHECKER_TARGET_AVX2 static bool extra_lu_plus_row_inf(tchecker::dbm::db_t * row, tchecker::clock_id_t jbegin,
+                                                         tchecker::clock_id_t jend)
+  {
+    __m256i const lt_inf = _mm256_set1_epi32(tchecker::dbm::LT_INFINITY);
+    __m256i const all = _mm256_set1_epi32(-1);
+    bool modified = false;
+    tchecker::clock_id_t j = jbegin;
+    for (; j + 8 <= jend; j += 8) {
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + j));
+      if (_mm256_testc_si256(_mm256_cmpeq_epi32(d, lt_inf), all))
+        continue;
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + j), lt_inf);
+      modified = true;
+    }
+    return sse42_t::extra_lu_plus_row_inf(row, j, jend) || modified;
+  }
+
+  TCHECKER_TARGET_AVX2 static bool extra_lu_plus_row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim,
+                                                      tchecker::integer_t const * u)
+  {
+    return row0(row, dim, u, false);
+  }
+
+private:
+  TCHECKER_TARGET_AVX2 static bool row0(tchecker::dbm::db_t * row, tchecker::clock_id_t dim, tchecker::integer_t const * u,
+                                        bool skip_le_zero)
+  {
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const le_zero = _mm256_set1_epi32(tchecker::dbm::LE_ZERO);
+    __m256i const minus_inf = _mm256_set1_epi32(-tchecker::dbm::INF_VALUE);
+    bool modified = false;
+    tchecker::clock_id_t j = 1;
+    for (; j + 8 <= dim; j += 8) {
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(row + j));
+      __m256i uj = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(u + j - 1));
+      __m256i changed = _mm256_cmpgt_epi32(_mm256_sub_epi32(zero, _mm256_srai_epi32(d, 1)), uj);
+      if (skip_le_zero)
+        changed = _mm256_andnot_si256(_mm256_cmpeq_epi32(d, le_zero), changed);
+      if (_mm256_testz_si256(changed, changed))
+        continue;
+      __m256i v = _mm256_blendv_epi8(_mm256_slli_epi32(_mm256_sub_epi32(zero, uj), 1), le_zero,
+                                     _mm256_cmpeq_epi32(uj, minus_inf));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + j), _mm256_blendv_epi8(d, v, changed));
+      modified = true;
+    }
+    for (; j < dim; ++j)
+      if (!skip_le_zero || row[j] != tchecker::dbm::LE_ZERO)
+        modified |= extra_lu_row0_db(row[j], u[j - 1]);
+    return modified;
+  }
+};
+
+#endif // TCHECKER_DBM_SIMD_X86
+
+/*!
+ \brief Table of kernels for OPS
+ */
+template <class OPS> tchecker::dbm::simd::details::kernels_t make_kernels(enum tchecker::dbm::simd::instruction_set_t is)
+{
+  return tchecker::dbm::simd::details::kernels_t{is,
+                                                 &OPS::is_equal,
+                                                 &OPS::is_le,
+                                                 &OPS::min,
+                                                 &OPS::tighten_row,
+                                                 &tchecker::dbm::simd::details::extra_lu<OPS>,
+                                                 &tchecker::dbm::simd::details::extra_lu_plus<OPS>};
+}
+
+tchecker::dbm::simd::details::kernels_t const scalar_kernels = make_kernels<scalar_t>(tchecker::dbm::simd::SCALAR);
+
+#if defined(TCHECKER_DBM_SIMD_X86)
+tchecker::dbm::simd::details::kernels_t const sse42_kernels = make_kernels<sse42_t>(tchecker::dbm::simd::SSE42);
+tchecker::dbm::simd::details::kernels_t const avx2_kernels = make_kernels<avx2_t>(tchecker::dbm::simd::AVX2);
+#endif
+
+/*!
+ \brief Kernels for an instruction set
+ \param is : an instruction set
+ \pre is is supported
+ \return the kernels for is
+ */
+tchecker::dbm::simd::details::kernels_t const * kernels_for(enum tchecker::dbm::simd::instruction_set_t is)
+{
+#if defined(TCHECKER_DBM_SIMD_X86)
+  if (is == tchecker::dbm::simd::AVX2)
+    return &avx2_kernels;
+  if (is == tchecker::dbm::simd::SSE42)
+    return &sse42_kernels;
+#endif
+  return &scalar_kernels;
+}
+
+} // end of anonymous namespace
+
+tchecker::dbm::simd::details::kernels_t const * kernels =
+    tchecker::dbm::simd::details::kernels_for(tchecker::dbm::simd::best_instruction_set());
+
+} // end of namespace details
+
+bool is_supported(enum tchecker::dbm::simd::instruction_set_t is)
+{
+  switch (is) {
+  case tchecker::dbm::simd::SCALAR:
+    return true;
+#if defined(TCHECKER_DBM_SIMD_X86)
+  case tchecker::dbm::simd::SSE42:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+  case tchecker::dbm::simd::AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+enum tchecker::dbm::simd::instruction_set_t best_instruction_set()
+{
+  if (tchecker::dbm::simd::is_supported(tchecker::dbm::simd::AVX2))
+    return tchecker::dbm::simd::AVX2;
+  if (tchecker::dbm::simd::is_supported(tchecker::dbm::simd::SSE42))
+    return tchecker::dbm::simd::SSE42;
+  return tchecker::dbm::simd::SCALAR;
+}
+
+enum tchecker::dbm::simd::instruction_set_t instruction_set() { return tchecker::dbm::simd::details::kernels->instruction_set; }
+
+void select(enum tchecker::dbm::simd::instruction_set_t is)
+{
+  if (!tchecker::dbm::simd::is_supported(is))
+    throw std::invalid_argument(std::string("Unsupported instruction set: ") + tchecker::dbm::simd::name(is));
+  tchecker::dbm::simd::details::kernels = tchecker::dbm::simd::details::kernels_for(is);
+}
+
+char const * name(enum tchecker::dbm::simd::instruction_set_t is)
+{
+  switch (is) {
+  case tchecker::dbm::simd::SCALAR:
+    return "scalar";
+  case tchecker::dbm::simd::SSE42:
+    return "sse4.2";
+  case tchecker::dbm::simd::AVX2:
+    return "avx2";
+  default:
+    return "unknown";
+  }
+}
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
@@ -0,0 +1,299 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/refzg/por.hh"
+#include "tchecker/statement/static_analysis.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace refzg {
+
+/*!
+ \brief Variables accessed by an edge
+ \param system : a system of timed processes
+ \param edge : an edge of system
+ \param read_clocks : set of clock identifiers
+ \param read_intvars : set of integer variable identifiers
+ \param written_clocks : set of clock identifiers
+ \param written_intvars : set of integer variable identifiers
+ \post the clocks and integer variables read by edge (in its guard, its
+ statement, and the invariants of its source and target locations) have been
+ added to read_clocks and read_intvars, and the clocks and integer variables
+ written by its statement have been added to written_clocks and written_intvars
+ */
+static void accessed_variables(tchecker::ta::system_t const & system, tchecker::system::edge_t const & edge,
+                               std::unordered_set<tchecker::clock_id_t> & read_clocks,
+                               std::unordered_set<tchecker::intvar_id_t> & read_intvars,
+                               std::unordered_set<tchecker::clock_id_t> & written_clocks,
+                               std::unordered_set<tchecker::intvar_id_t> & written_intvars)
+{
+  tchecker::extract_variables(system.guard(edge.id()), read_clocks, read_intvars);
+  tchecker::extract_read_variables(system.statement(edge.id()), read_clocks, read_intvars);
+  tchecker::extract_variables(system.invariant(edge.src()), read_clocks, read_intvars);
+  tchecker::extract_variables(system.invariant(edge.tgt()), read_clocks, read_intvars);
+  tchecker::extract_written_variables(system.statement(edge.id()), written_clocks, written_intvars);
+}
+
+/*!
+ \brief Map : variable identifier -> edges
+ */
+using variable_edges_t = std::unordered_map<tchecker::variable_id_t, boost::dynamic_bitset<>>;
+
+/*!
+ \brief Add an edge to the edges of variables
+ \param ids : variable identifiers
+ \param edge_id : edge identifier
+ \param edges_count : number of edges
+ \param map : edges of variables
+ \post edge_id has been added to map[id] for every id in ids
+ */
+static void add_edge(std::unordered_set<tchecker::variable_id_t> const & ids, tchecker::edge_id_t edge_id,
+                     tchecker::edge_id_t edges_count, tchecker::refzg::variable_edges_t & map)
+{
+  for (tchecker::variable_id_t id : ids) {
+    boost::dynamic_bitset<> & edges = map.try_emplace(id, edges_count).first->second;
+    edges.set(edge_id);
+  }
+}
+
+/*!
+ \brief Add the edges of variables
+ \param ids : variable identifiers
+ \param map : edges of variables
+ \param edges : set of edges
+ \post map[id] has been added to edges for every id in ids
+ */
+static void add_edges(std::unordered_set<tchecker::variable_id_t> const & ids, tchecker::refzg::variable_edges_t const & map,
+                      boost::dynamic_bitset<> & edges)
+{
+  for (tchecker::variable_id_t id : ids) {
+    auto it = map.find(id);
+    if (it != map.end())
+      edges |= it->second;
+  }
+}
+
+/*!
+ \brief Check invisibility of an edge
+ \param system : a system of timed processes
+ \param labels : accepting labels
+ \param edge : an edge of system
+ \return true if edge does not change the accepting labels of its process, and
+ if neither its guard nor the invariant of its target location involve clocks,
+ false otherwise
+ \note constraints on clocks restrict the reference clock of the process, and
+ may thus make the zone unsynchronizable, whereas resets do not
+ */
+static bool is_invisible(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels,
+                         tchecker::system::edge_t const & edge)
+{
+  if ((system.labels(edge.src()) & labels) != (system.labels(edge.tgt()) & labels))
+    return false;
+
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  tchecker::extract_variables(system.guard(edge.id()), clocks, intvars);
+  tchecker::extract_variables(system.invariant(edge.tgt()), clocks, intvars);
+  return clocks.empty();
+}
+
+/* persistent_sets_t */
+
+persistent_sets_t::persistent_sets_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels)
+    : _dependent_edges(system.locations_count(), boost::dynamic_bitset<>(system.edges_count())),
+      _reachable_edges(system.locations_count(), boost::dynamic_bitset<>(system.edges_count())),
+      _committing(system.locations_count()), _visible(system.locations_count())
+{
+  tchecker::edge_id_t const edges_count = system.edges_count();
+
+  // Variables accessed by edges
+  std::vector<std::unordered_set<tchecker::clock_id_t>> read_clocks(edges_count), written_clocks(edges_count);
+  std::vector<std::unordered_set<tchecker::intvar_id_t>> read_intvars(edges_count), written_intvars(edges_count);
+  tchecker::refzg::variable_edges_t clock_readers, clock_writers, intvar_readers, intvar_writers;
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    tchecker::edge_id_t const id = edge->id();
+    tchecker::refzg::accessed_variables(system, *edge, read_clocks[id], read_intvars[id], written_clocks[id],
+                                        written_intvars[id]);
+    tchecker::refzg::add_edge(read_clocks[id], id, edges_count, clock_readers);
+    tchecker::refzg::add_edge(read_intvars[id], id, edges_count, intvar_readers);
+    tchecker::refzg::add_edge(written_clocks[id], id, edges_count, clock_writers);
+    tchecker::refzg::add_edge(written_intvars[id], id, edges_count, intvar_writers);
+  }
+
+  // Conflicting edges: an edge depends on the edges that write the variables
+  // it accesses, and on the edges that read the variables it writes
+  std::vector<boost::dynamic_bitset<>> dependent_edges(edges_count, boost::dynamic_bitset<>(edges_count));
+  for (tchecker::edge_id_t id = 0; id < edges_count; ++id) {
+    tchecker::refzg::add_edges(read_clocks[id], clock_writers, dependent_edges[id]);
+    tchecker::refzg::add_edges(read_intvars[id], intvar_writers, dependent_edges[id]);
+    tchecker::refzg::add_edges(written_clocks[id], clock_readers, dependent_edges[id]);
+    tchecker::refzg::add_edges(written_clocks[id], clock_writers, dependent_edges[id]);
+    tchecker::refzg::add_edges(written_intvars[id], intvar_readers, dependent_edges[id]);
+    tchecker::refzg::add_edges(written_intvars[id], intvar_writers, dependent_edges[id]);
+  }
+
+  // Synchronizing edges: an edge depends on the edges it may synchronize with
+  std::map<std::tuple<tchecker::process_id_t, tchecker::event_id_t>, boost::dynamic_bitset<>> event_edges;
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    boost::dynamic_bitset<> & edges = event_edges.try_emplace({edge->pid(), edge->event_id()}, edges_count).first->second;
+    edges.set(edge->id());
+  }
+
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints()) {
+      auto it = event_edges.find({constr.pid(), constr.event_id()});
+      if (it == event_edges.end())
+        continue;
+      for (tchecker::system::sync_constraint_t const & other_constr : sync.synchronization_constraints()) {
+        auto other_it = event_edges.find({other_constr.pid(), other_constr.event_id()});
+        if (other_constr.pid() == constr.pid() || other_it == event_edges.end())
+          continue;
+        for (std::size_t id = it->second.find_first(); id != boost::dynamic_bitset<>::npos; id = it->second.find_next(id))
+          dependent_edges[id] |= other_it->second;
+      }
+    }
+
+  // Locations: dependent edges and visibility of outgoing edges
+  boost::dynamic_bitset<> committing_edges(edges_count);
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    _dependent_edges[edge->src()] |= dependent_edges[edge->id()];
+    if (system.is_committed(edge->tgt()))
+      committing_edges.set(edge->id());
+    // no state satisfies empty labels (see tchecker::syncprod::satisfies)
+    if (labels.any() && !tchecker::refzg::is_invisible(system, labels, *edge))
+      _visible.set(edge->src());
+  }
+
+  // Locations: reachable edges in their process
+  std::vector<tchecker::loc_id_t> waiting;
+  boost::dynamic_bitset<> visited(system.locations_count());
+  for (tchecker::loc_id_t loc = 0; loc < system.locations_count(); ++loc) {
+    visited.reset();
+    visited.set(loc);
+    waiting.push_back(loc);
+    while (!waiting.empty()) {
+      tchecker::loc_id_t const src = waiting.back();
+      waiting.pop_back();
+      for (tchecker::system::edge_const_shared_ptr_t const & edge : system.outgoing_edges(src)) {
+        _reachable_edges[loc].set(edge->id());
+        if (!visited[edge->tgt()]) {
+          visited.set(edge->tgt());
+          waiting.push_back(edge->tgt());
+        }
+      }
+    }
+    if (system.is_committed(loc) || _reachable_edges[loc].intersects(committing_edges))
+      _committing.set(loc);
+  }
+}
+
+bool persistent_sets_t::closed_processes(tchecker::vloc_t const & vloc, tchecker::process_id_t pid,
+                                         boost::dynamic_bitset<> & processes) const
+{
+  assert(pid < vloc.size());
+
+  processes.resize(vloc.size());
+  processes.reset();
+  processes.set(pid);
+
+  std::vector<tchecker::process_id_t> waiting{pid};
+  bool invisible = true;
+
+  while (!waiting.empty()) {
+    tchecker::loc_id_t const loc = vloc[waiting.back()];
+    waiting.pop_back();
+
+    assert(loc < _dependent_edges.size());
+    if (_visible[loc])
+      invisible = false;
+
+    // NB: a process that may enter a committed location disables all the
+    // transitions that do not involve it
+    for (tchecker::process_id_t other_pid = 0; other_pid < vloc.size(); ++other_pid) {
+      if (processes[other_pid])
+        continue;
+      tchecker::loc_id_t const other_loc = vloc[other_pid];
+      if (_committing[other_loc] || _dependent_edges[loc].intersects(_reachable_edges[other_loc])) {
+        processes.set(other_pid);
+        waiting.push_back(other_pid);
+      }
+    }
+  }
+
+  return invisible;
+}
+
+boost::dynamic_bitset<> persistent_sets_t::next(tchecker::refzg::refzg_t & refzg, tchecker::refzg::const_state_sptr_t const & s,
+                                                std::vector<tchecker::refzg::refzg_t::sst_t> & v) const
+{
+  tchecker::vloc_t const & vloc = s->vloc();
+  boost::dynamic_bitset<> processes;
+  std::vector<boost::dynamic_bitset<>> candidates;
+  for (tchecker::process_id_t pid = 0; pid < vloc.size(); ++pid) {
+    if (!closed_processes(vloc, pid, processes) || processes.all())
+      continue;
+    if (std::find(candidates.begin(), candidates.end(), processes) == candidates.end())
+      candidates.push_back(processes);
+  }
+
+  // smaller sets of processes yield smaller persistent sets
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](boost::dynamic_bitset<> const & p1, boost::dynamic_bitset<> const & p2) { return p1.count() < p2.count(); });
+
+  for (boost::dynamic_bitset<> const & candidate : candidates) {
+    std::size_t const size = v.size();
+    next(refzg, s, candidate, true, v);
+    if (v.size() > size)
+      return candidate;
+  }
+  return boost::dynamic_bitset<>{};
+}
+
+void persistent_sets_t::next_except(tchecker::refzg::refzg_t & refzg, tchecker::refzg::const_state_sptr_t const & s,
+                                    boost::dynamic_bitset<> const & processes,
+                                    std::vector<tchecker::refzg::refzg_t::sst_t> & v) const
+{
+  next(refzg, s, processes, false, v);
+}
+
+void persistent_sets_t::next(tchecker::refzg::refzg_t & refzg, tchecker::refzg::const_state_sptr_t const & s,
+                             boost::dynamic_bitset<> const & processes, bool involved,
+                             std::vector<tchecker::refzg::refzg_t::sst_t> & v) const
+{
+  std::vector<tchecker::refzg::refzg_t::sst_t> sst;
+  tchecker::refzg::outgoing_edges_range_t out_edges = refzg.outgoing_edges(s);
+  for (tchecker::refzg::outgoing_edges_value_t && out_edge : out_edges) {
+    bool only_processes = true;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : out_edge)
+      if (!processes[edge->pid()]) {
+        only_processes = false;
+        break;
+      }
+    if (only_processes != involved)
+      continue;
+
+    refzg.next(s, out_edge, sst);
+    for (auto && [status, next_s, next_t] : sst)
+      if (status == tchecker::STATE_OK)
+        v.push_back(std::make_tuple(status, next_s, next_t));
+    sst.clear();
+  }
+}
+
+} // end of namespace refzg
+
+} // end of namespace tchecker
@@ -95,11 +95,13 @@ void attributes(tchecker::ta::system_t const & system, tchecker::refzg::transiti
 
 refzg_t::refzg_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
                  std::shared_ptr<tchecker::reference_clock_variables_t const> const & r,
-                 std::unique_ptr<tchecker::refzg::semantics_t> && semantics, tchecker::integer_t spread, std::size_t block_size)
+                 std::unique_ptr<tchecker::refzg::semantics_t> && semantics, tchecker::integer_t spread, std::size_t block_size,
+                 enum tchecker::ts::sharing_type_t sharing_type)
     : _system(system), _r(r), _semantics(std::move(semantics)), _spread(spread),
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
                        _system->intvars_count(tchecker::VK_FLATTENED), block_size, _r),
-      _transition_allocator(block_size, block_size, _system->processes_count())
+      _transition_allocator(block_size, block_size, _system->processes_count()), _sharing_type(sharing_type),
+      _edges_cache(nullptr)
 {
 }
 
@@ -110,11 +112,15 @@ void refzg_t::initial(tchecker::refzg::initial_value_t const & init_edge, std::v
   tchecker::refzg::state_sptr_t s = _state_allocator.construct();
   tchecker::refzg::transition_sptr_t t = _transition_allocator.construct();
   tchecker::state_status_t status = tchecker::refzg::initial(*_system, *s, *t, *_semantics, _spread, init_edge);
+  if (_sharing_type != tchecker::ts::NO_SHARING && status == tchecker::STATE_OK)
+    _state_allocator.share(*s);
   v.push_back(std::make_tuple(status, s, t));
 }
 
 tchecker::refzg::outgoing_edges_range_t refzg_t::outgoing_edges(tchecker::refzg::const_state_sptr_t const & s)
 {
+  if (_edges_cache.get() != nullptr)
+    return _edges_cache->outgoing_edges(_system->as_syncprod_system(), s->vloc_ptr());
   return tchecker::refzg::outgoing_edges(*_system, s->vloc_ptr());
 }
 
@@ -124,9 +130,19 @@ void refzg_t::next(tchecker::refzg::const_state_sptr_t const & s, tchecker::refz
   tchecker::refzg::state_sptr_t nexts = _state_allocator.clone(*s);
   tchecker::refzg::transition_sptr_t nextt = _transition_allocator.construct();
   tchecker::state_status_t status = tchecker::refzg::next(*_system, *nexts, *nextt, *_semantics, _spread, out_edge);
+  if (_sharing_type != tchecker::ts::NO_SHARING && status == tchecker::STATE_OK)
+    _state_allocator.share(*nexts);
   v.push_back(std::make_tuple(status, nexts, nextt));
 }
 
+tchecker::refzg::state_sptr_t refzg_t::clone_state(tchecker::refzg::shared_state_t const & s)
+{
+  tchecker::refzg::state_sptr_t clone = _state_allocator.clone(s);
+  if (_sharing_type != tchecker::ts::NO_SHARING)
+    _state_allocator.share(*clone);
+  return clone;
+}
+
 bool refzg_t::satisfies(tchecker::refzg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const
 {
   return tchecker::refzg::satisfies(*_system, *s, labels);
@@ -144,6 +160,13 @@ void refzg_t::attributes(tchecker::refzg::const_transition_sptr_t const & t, std
 
 tchecker::ta::system_t const & refzg_t::system() const { return *_system; }
 
+std::size_t refzg_t::memsize() const { return _state_allocator.memsize() + _transition_allocator.memsize(); }
+
+void refzg_t::set_outgoing_edges_cache(std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> const & cache)
+{
+  _edges_cache = cache;
+}
+
 /* factory */
 
 // Factory of reference clock variables
@@ -167,12 +190,12 @@ reference_clocks_factory(enum tchecker::refzg::reference_clock_variables_type_t
 tchecker::refzg::refzg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                                    enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                                    enum tchecker::refzg::semantics_type_t semantics_type, tchecker::integer_t spread,
-                                   std::size_t block_size)
+                                   std::size_t block_size, enum tchecker::ts::sharing_type_t sharing_type)
 {
   std::shared_ptr<tchecker::reference_clock_variables_t const> r(
       tchecker::refzg::reference_clocks_factory(refclocks_type, *system));
   std::unique_ptr<tchecker::refzg::semantics_t> semantics{tchecker::refzg::semantics_factory(semantics_type)};
-  return new tchecker::refzg::refzg_t(system, r, std::move(semantics), spread, block_size);
+  return new tchecker::refzg::refzg_t(system, r, std::move(semantics), spread, block_size, sharing_type);
 }
 
 } // end of namespace refzg
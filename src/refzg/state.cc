@@ -35,7 +35,7 @@ state_t::state_t(tchecker::ta::state_t const & s, tchecker::intrusive_shared_ptr
 
 bool operator==(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2)
 {
-  return tchecker::ta::operator==(s1, s2) && (s1.zone() == s2.zone());
+  return tchecker::ta::operator==(s1, s2) && (&s1.zone() == &s2.zone() || s1.zone() == s2.zone());
 }
 
 bool operator!=(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2) { return !(s1 == s2); }
@@ -49,7 +49,7 @@ std::size_t hash_value(tchecker::refzg::state_t const & s)
 
 bool operator<=(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2)
 {
-  return tchecker::ta::operator==(s1, s2) && (s1.zone() <= s2.zone());
+  return tchecker::ta::operator==(s1, s2) && (&s1.zone() == &s2.zone() || s1.zone() <= s2.zone());
 }
 
 bool is_alu_star_le(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2,
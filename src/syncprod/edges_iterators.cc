@@ -5,6 +5,9 @@
  *
  */
 
+#include <algorithm>
+#include <numeric>
+
 #include <boost/iterator/transform_iterator.hpp>
 
 #include "tchecker/syncprod/edges_iterators.hh"
@@ -58,15 +61,26 @@ vloc_synchronized_edges_iterator_t::vloc_synchronized_edges_iterator_t(
     std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
     tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
     tchecker::system::synchronizations_t::const_iterator_t const & sync_end)
-    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _sync_it(sync_begin), _sync_end(sync_end)
+    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _sync_begin(sync_begin), _candidates(sync_end - sync_begin), _candidate(0)
+{
+  std::iota(_candidates.begin(), _candidates.end(), 0);
+  advance_while_empty_cartesian_product();
+}
+
+vloc_synchronized_edges_iterator_t::vloc_synchronized_edges_iterator_t(
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
+    std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
+    tchecker::system::synchronizations_t::const_iterator_t const & sync_begin, std::vector<tchecker::sync_id_t> candidates)
+    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _sync_begin(sync_begin), _candidates(std::move(candidates)), _candidate(0)
 {
+  assert(std::is_sorted(_candidates.begin(), _candidates.end()));
   advance_while_empty_cartesian_product();
 }
 
 bool vloc_synchronized_edges_iterator_t::operator==(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const
 {
-  return ((*_vloc == *it._vloc) && (_loc_edges_maps.get() == it._loc_edges_maps.get()) && (_sync_it == it._sync_it) &&
-          (_sync_end == it._sync_end) && (_cartesian_it == it._cartesian_it));
+  return ((*_vloc == *it._vloc) && (_loc_edges_maps.get() == it._loc_edges_maps.get()) && (_sync_begin == it._sync_begin) &&
+          (_candidates == it._candidates) && (_candidate == it._candidate) && (_cartesian_it == it._cartesian_it));
 }
 
 bool vloc_synchronized_edges_iterator_t::operator!=(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const
@@ -83,7 +97,7 @@ tchecker::syncprod::vloc_synchronized_edges_iterator_t & tchecker::syncprod::vlo
   assert(!at_end());
   ++_cartesian_it;
   if (_cartesian_it == tchecker::past_the_end_iterator) {
-    ++_sync_it;
+    ++_candidate;
     advance_while_empty_cartesian_product();
   }
   return *this;
@@ -94,15 +108,15 @@ void tchecker::syncprod::vloc_synchronized_edges_iterator_t::advance_while_empty
   _cartesian_it.clear();
 
   while (!at_end()) {
-    if (tchecker::syncprod::enabled(*_sync_it, *_vloc, *_loc_edges_maps))
+    if (tchecker::syncprod::enabled(*(_sync_begin + _candidates[_candidate]), *_vloc, *_loc_edges_maps))
       break;
-    ++_sync_it;
+    ++_candidate;
   }
 
   if (at_end())
     return;
 
-  auto constraints = _sync_it->synchronization_constraints();
+  auto constraints = (_sync_begin + _candidates[_candidate])->synchronization_constraints();
   for (auto const & constr : constraints) {
     auto edges = _loc_edges_maps->edges((*_vloc)[constr.pid()], constr.event_id());
     if ((constr.strength() == tchecker::SYNC_WEAK) && (edges.begin() == edges.end()))
@@ -115,8 +129,10 @@ tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tcheck
 outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
 {
-  auto syncs = system.synchronizations();
-  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(), syncs.begin(), syncs.end());
+  std::vector<tchecker::sync_id_t> candidates;
+  system.candidate_synchronizations(*vloc, candidates);
+  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(),
+                                                               system.synchronizations().begin(), std::move(candidates));
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -124,25 +140,34 @@ outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
 /* edges_iterator_t */
 
 edges_iterator_t::edges_iterator_t(tchecker::system::edge_const_shared_ptr_t const & edge, bool at_end)
-    : _async_edge(edge), _async_at_end(at_end)
+    : _async_edge(edge), _async_at_end(at_end), _array_edge(nullptr)
 {
   assert(edge.get() != nullptr);
 }
 
 edges_iterator_t::edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t::edges_iterator_t const & it)
-    : _async_edge(nullptr), _async_at_end(false), _sync_it(it)
+    : _async_edge(nullptr), _async_at_end(false), _sync_it(it), _array_edge(nullptr)
 {
 }
 
+edges_iterator_t::edges_iterator_t(tchecker::system::edge_const_shared_ptr_t const * edge)
+    : _async_edge(nullptr), _async_at_end(false), _array_edge(edge)
+{
+  assert(edge != nullptr);
+}
+
 bool edges_iterator_t::operator==(tchecker::syncprod::edges_iterator_t const & it) const
 {
-  return ((_async_edge == it._async_edge) && (_async_at_end == it._async_at_end) && (_sync_it == it._sync_it));
+  return ((_async_edge == it._async_edge) && (_async_at_end == it._async_at_end) && (_sync_it == it._sync_it) &&
+          (_array_edge == it._array_edge));
 }
 
 bool edges_iterator_t::operator!=(tchecker::syncprod::edges_iterator_t const & it) const { return !(*this == it); }
 
 tchecker::system::edge_const_shared_ptr_t edges_iterator_t::operator*()
 {
+  if (_array_edge != nullptr)
+    return *_array_edge;
   if (_async_edge.get() == nullptr)
     return *_sync_it;
   return _async_edge;
@@ -150,7 +175,9 @@ tchecker::system::edge_const_shared_ptr_t edges_iterator_t::operator*()
 
 tchecker::syncprod::edges_iterator_t & edges_iterator_t::operator++()
 {
-  if (_async_edge.get() == nullptr)
+  if (_array_edge != nullptr)
+    ++_array_edge;
+  else if (_async_edge.get() == nullptr)
     ++_sync_it;
   else
     _async_at_end = true;
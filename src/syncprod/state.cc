@@ -34,8 +34,9 @@ state_t::state_t(tchecker::syncprod::state_t const & s, tchecker::intrusive_shar
 
 bool operator==(tchecker::syncprod::state_t const & s1, tchecker::syncprod::state_t const & s2)
 {
+  // tuples of locations are compared by address first since they may be shared
   return (static_cast<tchecker::ts::state_t const &>(s1) == static_cast<tchecker::ts::state_t const &>(s2) &&
-          s1.vloc() == s2.vloc());
+          (&s1.vloc() == &s2.vloc() || s1.vloc() == s2.vloc()));
 }
 
 bool operator!=(tchecker::syncprod::state_t const & s1, tchecker::syncprod::state_t const & s2) { return (!(s1 == s2)); }
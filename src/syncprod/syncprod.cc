@@ -5,6 +5,8 @@
  *
  */
 
+#include <boost/functional/hash.hpp>
+
 #include "tchecker/syncprod/syncprod.hh"
 
 namespace tchecker {
@@ -52,21 +54,30 @@ tchecker::state_status_t initial(tchecker::syncprod::system_t const & system,
 outgoing_edges_iterator_t::outgoing_edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & sync_it,
                                                      tchecker::syncprod::vloc_asynchronous_edges_iterator_t const & async_it,
                                                      boost::dynamic_bitset<> committed_processes)
-    : _it(sync_it, async_it), _committed_processes(committed_processes), _committed(_committed_processes.any())
+    : _it(std::in_place, sync_it, async_it), _committed_processes(committed_processes),
+      _committed(_committed_processes.any()), _position(0)
 {
   advance_while_not_enabled();
 }
 
 outgoing_edges_iterator_t::outgoing_edges_iterator_t(tchecker::syncprod::vloc_edges_iterator_t const & it,
                                                      boost::dynamic_bitset<> committed_processes)
-    : _it(it), _committed_processes(committed_processes), _committed(_committed_processes.any())
+    : _it(it), _committed_processes(committed_processes), _committed(_committed_processes.any()), _position(0)
 {
   advance_while_not_enabled();
 }
 
+outgoing_edges_iterator_t::outgoing_edges_iterator_t(
+    std::shared_ptr<tchecker::syncprod::outgoing_edges_array_t const> const & array)
+    : _committed(false), _array(array), _position(0)
+{
+  assert(_array != nullptr);
+}
+
 bool outgoing_edges_iterator_t::operator==(tchecker::syncprod::outgoing_edges_iterator_t const & it) const
 {
-  return (_it == it._it && _committed_processes == it._committed_processes && _committed == it._committed);
+  return (_it == it._it && _committed_processes == it._committed_processes && _committed == it._committed &&
+          _array == it._array && _position == it._position);
 }
 
 bool outgoing_edges_iterator_t::operator==(tchecker::end_iterator_t const & it) const { return at_end(); }
@@ -74,13 +85,22 @@ bool outgoing_edges_iterator_t::operator==(tchecker::end_iterator_t const & it)
 tchecker::range_t<tchecker::syncprod::edges_iterator_t> outgoing_edges_iterator_t::operator*()
 {
   assert(!at_end());
-  return *_it;
+  if (!_it.has_value()) {
+    tchecker::system::edge_const_shared_ptr_t const * edges = _array->_edges.data();
+    return tchecker::make_range(tchecker::syncprod::edges_iterator_t{edges + _array->_offsets[_position]},
+                                tchecker::syncprod::edges_iterator_t{edges + _array->_offsets[_position + 1]});
+  }
+  return **_it;
 }
 
 tchecker::syncprod::outgoing_edges_iterator_t & outgoing_edges_iterator_t::operator++()
 {
   assert(!at_end());
-  ++_it;
+  if (!_it.has_value()) {
+    ++_position;
+    return *this;
+  }
+  ++*_it;
   advance_while_not_enabled();
   return *this;
 }
@@ -90,9 +110,9 @@ void outgoing_edges_iterator_t::advance_while_not_enabled()
   if (!_committed)
     return;
   while (!at_end()) {
-    if (involves_committed_process(*_it))
+    if (involves_committed_process(**_it))
       return;
-    ++_it;
+    ++*_it;
   }
 }
 
@@ -105,7 +125,12 @@ bool outgoing_edges_iterator_t::involves_committed_process(
   return false;
 }
 
-bool outgoing_edges_iterator_t::at_end() const { return _it == tchecker::past_the_end_iterator; }
+bool outgoing_edges_iterator_t::at_end() const
+{
+  if (!_it.has_value())
+    return (_position + 1 >= _array->_offsets.size());
+  return *_it == tchecker::past_the_end_iterator;
+}
 
 /* outgoing edges */
 
@@ -125,6 +150,68 @@ outgoing_edges(tchecker::syncprod::system_t const & system,
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
 
+/* outgoing_edges_cache_t */
+
+outgoing_edges_cache_t::outgoing_edges_cache_t(std::size_t max_memsize)
+    : _max_memsize(max_memsize), _memsize(0), _offsets(1, 0), _hits(0), _misses(0)
+{
+}
+
+tchecker::syncprod::outgoing_edges_range_t
+outgoing_edges_cache_t::outgoing_edges(tchecker::syncprod::system_t const & system,
+                                       tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
+{
+  std::size_t const h = boost::hash_range(vloc->begin(), vloc->end());
+  auto && [begin, end] = _index.equal_range(h);
+  for (auto it = begin; it != end; ++it) {
+    std::size_t const n = it->second;
+    if ((_offsets[n + 1] - _offsets[n] == vloc->size()) &&
+        std::equal(vloc->begin(), vloc->end(), _locs.begin() + _offsets[n])) {
+      ++_hits;
+      return tchecker::make_range(tchecker::syncprod::outgoing_edges_iterator_t{_arrays[n]}, tchecker::past_the_end_iterator);
+    }
+  }
+
+  ++_misses;
+
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_array_t> array = std::make_shared<outgoing_edges_array_t>();
+  array->_offsets.push_back(0);
+  for (auto && edges : tchecker::syncprod::outgoing_edges(system, vloc)) {
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
+      array->_edges.push_back(edge);
+    array->_offsets.push_back(array->_edges.size());
+  }
+  array->_edges.shrink_to_fit();
+  array->_offsets.shrink_to_fit();
+
+  // Approximate memory footprint of the tuple of locations, its index entry and its array
+  std::size_t const memsize = vloc->size() * sizeof(tchecker::loc_id_t) + 2 * sizeof(std::size_t) +
+                              4 * sizeof(void *) + sizeof(tchecker::syncprod::outgoing_edges_array_t) +
+                              array->_edges.size() * sizeof(tchecker::system::edge_const_shared_ptr_t) +
+                              array->_offsets.size() * sizeof(std::size_t);
+
+  if (_memsize + memsize > _max_memsize)
+    clear();
+  if (memsize <= _max_memsize) {
+    _index.emplace(h, _arrays.size());
+    _locs.insert(_locs.end(), vloc->begin(), vloc->end());
+    _offsets.push_back(_locs.size());
+    _arrays.push_back(array);
+    _memsize += memsize;
+  }
+
+  return tchecker::make_range(tchecker::syncprod::outgoing_edges_iterator_t{array}, tchecker::past_the_end_iterator);
+}
+
+void outgoing_edges_cache_t::clear()
+{
+  _index.clear();
+  _locs.clear();
+  _offsets.resize(1);
+  _arrays.clear();
+  _memsize = 0;
+}
+
 tchecker::state_status_t next(tchecker::syncprod::system_t const & system,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
                               tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
 #include <stack>
 #include <tuple>
@@ -29,6 +30,7 @@ system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tc
   extract_asynchronous_edges();
   compute_committed_locations();
   compute_labels();
+  compute_synchronizations_index();
 }
 
 system_t::system_t(tchecker::system::system_t const & system) : tchecker::system::system_t(system)
@@ -36,6 +38,7 @@ system_t::system_t(tchecker::system::system_t const & system) : tchecker::system
   extract_asynchronous_edges();
   compute_committed_locations();
   compute_labels();
+  compute_synchronizations_index();
 }
 
 bool system_t::is_asynchronous(tchecker::system::edge_t const & edge) const
@@ -108,6 +111,16 @@ bool system_t::is_committed(tchecker::loc_id_t id) const
   return _committed[id] == 1;
 }
 
+void system_t::candidate_synchronizations(tchecker::vloc_t const & vloc, std::vector<tchecker::sync_id_t> & syncs) const
+{
+  assert(vloc.size() == processes_count());
+  syncs.assign(_unconstrained_synchronizations.begin(), _unconstrained_synchronizations.end());
+  for (tchecker::loc_id_t loc : vloc)
+    syncs.insert(syncs.end(), _loc_synchronizations[loc].begin(), _loc_synchronizations[loc].end());
+  // each synchronization is indexed by a single process, hence syncs has no duplicates
+  std::sort(syncs.begin(), syncs.end());
+}
+
 void system_t::extract_asynchronous_edges()
 {
   for (tchecker::system::edge_const_shared_ptr_t const & edge : edges())
@@ -169,6 +182,41 @@ void system_t::compute_labels()
   }
 }
 
+void system_t::compute_synchronizations_index()
+{
+  tchecker::event_id_t const events_count = this->events_count();
+
+  // Map: (process identifier, event identifier) -> locations with an outgoing edge labelled by event
+  std::vector<std::vector<tchecker::loc_id_t>> event_locations(processes_count() * events_count);
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : edges())
+    event_locations[edge->pid() * events_count + edge->event_id()].push_back(edge->src());
+  for (std::vector<tchecker::loc_id_t> & locations : event_locations) {
+    std::sort(locations.begin(), locations.end());
+    locations.erase(std::unique(locations.begin(), locations.end()), locations.end());
+  }
+
+  _loc_synchronizations.clear();
+  _loc_synchronizations.resize(locations_count());
+  _unconstrained_synchronizations.clear();
+
+  for (tchecker::system::synchronization_t const & sync : synchronizations()) {
+    std::vector<tchecker::loc_id_t> const * selective = nullptr;
+    for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints()) {
+      if (constr.strength() != tchecker::SYNC_STRONG)
+        continue;
+      std::vector<tchecker::loc_id_t> const & locations = event_locations[constr.pid() * events_count + constr.event_id()];
+      if (selective == nullptr || locations.size() < selective->size())
+        selective = &locations;
+    }
+
+    if (selective == nullptr)
+      _unconstrained_synchronizations.push_back(sync.id());
+    else
+      for (tchecker::loc_id_t loc : *selective)
+        _loc_synchronizations[loc].push_back(sync.id());
+  }
+}
+
 void system_t::add_asynchronous_edge(tchecker::system::edge_const_shared_ptr_t const & edge)
 {
   assert(is_asynchronous(*edge));
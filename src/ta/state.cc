@@ -33,7 +33,7 @@ state_t::state_t(tchecker::ta::state_t const & s, tchecker::intrusive_shared_ptr
 
 bool operator==(tchecker::ta::state_t const & s1, tchecker::ta::state_t const & s2)
 {
-  return tchecker::syncprod::operator==(s1, s2) && (s1.intval() == s2.intval());
+  return tchecker::syncprod::operator==(s1, s2) && (&s1.intval() == &s2.intval() || s1.intval() == s2.intval());
 }
 
 bool operator!=(tchecker::ta::state_t const & s1, tchecker::ta::state_t const & s2) { return !(s1 == s2); }
@@ -0,0 +1,287 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Type of map from variable names to new names
+ */
+using renaming_t = std::unordered_map<std::string, std::string>;
+
+/*!
+ \brief Rename variables in an expression or a statement
+ \param s : string representation of an expression or a statement
+ \param renaming : a renaming of variables
+ \return s where every identifier in the domain of renaming has been renamed
+ */
+static std::string rename(std::string const & s, tchecker::ta::renaming_t const & renaming)
+{
+  std::string renamed;
+  std::size_t i = 0;
+  while (i < s.size()) {
+    if (std::isalpha(static_cast<unsigned char>(s[i])) || s[i] == '_') {
+      std::size_t j = i + 1;
+      while (j < s.size() && (std::isalnum(static_cast<unsigned char>(s[j])) || s[j] == '_'))
+        ++j;
+      std::string const identifier = s.substr(i, j - i);
+      auto it = renaming.find(identifier);
+      renamed += (it == renaming.end() ? identifier : it->second);
+      i = j;
+    }
+    else
+      renamed += s[i++];
+  }
+  return renamed;
+}
+
+/*!
+ \brief Private variables of a process
+ \param variables : declared variables
+ \param map : variable access map
+ \param vtype : type of variables
+ \param pid : process identifier
+ \return identifiers of the variables in variables that are only accessed by
+ process pid, in increasing order
+ */
+template <class VARIABLES>
+static std::vector<tchecker::variable_id_t> private_variables(VARIABLES const & variables,
+                                                              tchecker::variable_access_map_t const & map,
+                                                              enum tchecker::variable_type_t vtype, tchecker::process_id_t pid)
+{
+  std::vector<tchecker::variable_id_t> ids;
+  for (auto && [id, name] : variables.index()) {
+    bool is_private = true;
+    for (tchecker::variable_id_t k = id; k < id + variables.info(id).size() && is_private; ++k) {
+      auto accessing = map.accessing_processes(k, vtype, tchecker::VACCESS_ANY);
+      is_private = (std::distance(accessing.begin(), accessing.end()) == 1 && *accessing.begin() == pid);
+    }
+    if (is_private)
+      ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/*!
+ \brief Type of synchronization vectors as sorted tuples (process, event, strength)
+ */
+using sync_key_t = std::vector<std::tuple<tchecker::process_id_t, tchecker::event_id_t, int>>;
+
+/*!
+ \brief Check invariance of synchronizations under a transposition
+ \param syncs : synchronization vectors
+ \param pid1 : process identifier
+ \param pid2 : process identifier
+ \return true if swapping pid1 and pid2 in syncs yields syncs, false otherwise
+ */
+static bool is_invariant(std::set<tchecker::ta::sync_key_t> const & syncs, tchecker::process_id_t pid1,
+                         tchecker::process_id_t pid2)
+{
+  for (tchecker::ta::sync_key_t key : syncs) {
+    for (auto & [pid, event, strength] : key)
+      pid = (pid == pid1 ? pid2 : (pid == pid2 ? pid1 : pid));
+    std::sort(key.begin(), key.end());
+    if (syncs.find(key) == syncs.end())
+      return false;
+  }
+  return true;
+}
+
+/* symmetry_t */
+
+symmetry_t::symmetry_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels)
+    : _locations(system.processes_count()), _local_index(system.locations_count()), _clocks(system.processes_count()),
+      _intvars(system.processes_count())
+{
+  tchecker::variable_access_map_t map = tchecker::variable_access(system);
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+    _local_index[loc->id()] = static_cast<tchecker::loc_id_t>(_locations[loc->pid()].size());
+    _locations[loc->pid()].push_back(loc->id());
+  }
+
+  std::set<tchecker::ta::sync_key_t> syncs;
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations()) {
+    tchecker::ta::sync_key_t key;
+    for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints())
+      key.push_back(std::make_tuple(constr.pid(), constr.event_id(), static_cast<int>(constr.strength())));
+    std::sort(key.begin(), key.end());
+    syncs.insert(key);
+  }
+
+  // Description of each process with private variables renamed by position
+  std::vector<std::string> descriptions(system.processes_count());
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid) {
+    std::stringstream description;
+    tchecker::ta::renaming_t renaming;
+
+    std::vector<tchecker::variable_id_t> clocks =
+        tchecker::ta::private_variables(system.clock_variables(), map, tchecker::VTYPE_CLOCK, pid);
+    for (tchecker::variable_id_t id : clocks) {
+      std::size_t const size = system.clock_variables().info(id).size();
+      renaming[system.clock_name(id)] = "$clock" + std::to_string(renaming.size());
+      description << "clock " << size << std::endl;
+      for (std::size_t k = 0; k < size; ++k)
+        _clocks[pid].push_back(static_cast<tchecker::clock_id_t>(id + k));
+    }
+
+    std::vector<tchecker::variable_id_t> intvars =
+        tchecker::ta::private_variables(system.integer_variables(), map, tchecker::VTYPE_INTVAR, pid);
+    for (tchecker::variable_id_t id : intvars) {
+      tchecker::intvar_info_t const & info = system.integer_variables().info(id);
+      renaming[system.intvar_name(id)] = "$int" + std::to_string(renaming.size());
+      description << "int " << info.size() << " " << info.min() << " " << info.max() << " " << info.initial_value()
+                  << std::endl;
+      for (std::size_t k = 0; k < info.size(); ++k)
+        _intvars[pid].push_back(static_cast<tchecker::intvar_id_t>(id + k));
+    }
+
+    for (tchecker::loc_id_t loc : _locations[pid]) {
+      boost::dynamic_bitset<> accepting = labels;
+      accepting.resize(system.labels(loc).size());
+      description << "location " << system.is_initial_location(loc) << system.is_committed(loc) << system.is_urgent(loc) << " "
+                  << (system.labels(loc) & accepting) << " "
+                  << tchecker::ta::rename(system.invariant(loc).to_string(), renaming) << std::endl;
+    }
+
+    std::vector<std::string> edges;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      if (edge->pid() != pid)
+        continue;
+      std::stringstream e;
+      e << "edge " << _local_index[edge->src()] << " " << _local_index[edge->tgt()] << " " << edge->event_id() << " "
+        << tchecker::ta::rename(system.guard(edge->id()).to_string(), renaming) << " "
+        << tchecker::ta::rename(system.statement(edge->id()).to_string(), renaming);
+      edges.push_back(e.str());
+    }
+    std::sort(edges.begin(), edges.end());
+    for (std::string const & e : edges)
+      description << e << std::endl;
+
+    descriptions[pid] = description.str();
+  }
+
+  // Symmetry classes: transpositions with the first process of a class generate all its permutations
+  std::vector<std::vector<tchecker::process_id_t>> classes;
+  for (tchecker::process_id_t pid = 0; pid < system.processes_count(); ++pid) {
+    auto it = std::find_if(classes.begin(), classes.end(), [&](std::vector<tchecker::process_id_t> const & c) {
+      return descriptions[c[0]] == descriptions[pid] && tchecker::ta::is_invariant(syncs, c[0], pid);
+    });
+    if (it == classes.end())
+      classes.push_back(std::vector<tchecker::process_id_t>{pid});
+    else
+      it->push_back(pid);
+  }
+
+  for (std::vector<tchecker::process_id_t> const & c : classes)
+    if (c.size() > 1)
+      _classes.push_back(c);
+}
+
+std::size_t symmetry_t::classes_count() const { return _classes.size(); }
+
+std::vector<tchecker::process_id_t> const & symmetry_t::symmetry_class(std::size_t k) const
+{
+  assert(k < _classes.size());
+  return _classes[k];
+}
+
+void symmetry_t::canonicalize(tchecker::vloc_t & vloc, tchecker::intvars_valuation_t & intval, tchecker::dbm::db_t * dbm,
+                              tchecker::clock_id_t dim) const
+{
+  std::vector<tchecker::clock_id_t> sigma(dim); // permutation of DBM indices
+  std::iota(sigma.begin(), sigma.end(), 0);
+  bool permuted_clocks = false;
+
+  std::vector<std::size_t> order;
+  std::vector<tchecker::loc_id_t> locs;
+  std::vector<std::vector<tchecker::integer_t>> values;
+
+  for (std::vector<tchecker::process_id_t> const & c : _classes) {
+    order.resize(c.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t i, std::size_t j) { return less(vloc, intval, dbm, dim, c[i], c[j]); });
+
+    bool identity = true;
+    for (std::size_t i = 0; i < order.size() && identity; ++i)
+      identity = (order[i] == i);
+    if (identity)
+      continue;
+
+    locs.clear();
+    values.clear();
+    for (tchecker::process_id_t pid : c) {
+      locs.push_back(vloc[pid]);
+      values.emplace_back();
+      for (tchecker::intvar_id_t id : _intvars[pid])
+        values.back().push_back(intval[id]);
+    }
+
+    // process c[i] takes the place of process c[order[i]]
+    for (std::size_t i = 0; i < c.size(); ++i) {
+      tchecker::process_id_t const src = c[order[i]], dst = c[i];
+      vloc[dst] = _locations[dst][_local_index[locs[order[i]]]];
+      for (std::size_t m = 0; m < _intvars[dst].size(); ++m)
+        intval[_intvars[dst][m]] = values[order[i]][m];
+      for (std::size_t m = 0; m < _clocks[dst].size(); ++m) {
+        sigma[_clocks[src][m] + 1] = _clocks[dst][m] + 1;
+        permuted_clocks |= (src != dst);
+      }
+    }
+  }
+
+  if (!permuted_clocks)
+    return;
+
+  std::vector<tchecker::dbm::db_t> old(dbm, dbm + dim * dim);
+  for (tchecker::clock_id_t x = 0; x < dim; ++x)
+    for (tchecker::clock_id_t y = 0; y < dim; ++y)
+      dbm[sigma[x] * dim + sigma[y]] = old[x * dim + y];
+}
+
+bool symmetry_t::less(tchecker::vloc_t const & vloc, tchecker::intvars_valuation_t const & intval,
+                      tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::process_id_t pid1,
+                      tchecker::process_id_t pid2) const
+{
+  if (_local_index[vloc[pid1]] != _local_index[vloc[pid2]])
+    return _local_index[vloc[pid1]] < _local_index[vloc[pid2]];
+
+  for (std::size_t m = 0; m < _intvars[pid1].size(); ++m)
+    if (intval[_intvars[pid1][m]] != intval[_intvars[pid2][m]])
+      return intval[_intvars[pid1][m]] < intval[_intvars[pid2][m]];
+
+  for (std::size_t m = 0; m < _clocks[pid1].size(); ++m) {
+    tchecker::clock_id_t const x1 = _clocks[pid1][m] + 1, x2 = _clocks[pid2][m] + 1;
+    if (dbm[x1 * dim] != dbm[x2 * dim])
+      return dbm[x1 * dim] < dbm[x2 * dim];
+    if (dbm[x1] != dbm[x2])
+      return dbm[x1] < dbm[x2];
+  }
+
+  return false;
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
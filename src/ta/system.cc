@@ -9,6 +9,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/expression/expression.hh"
@@ -29,22 +30,26 @@ namespace ta {
 system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tchecker::syncprod::system_t(sysdecl)
 {
   compute_from_syncprod_system();
+  compile_native_if_requested();
 }
 
 system_t::system_t(tchecker::system::system_t const & system) : tchecker::syncprod::system_t(system)
 {
   compute_from_syncprod_system();
+  compile_native_if_requested();
 }
 
 system_t::system_t(tchecker::syncprod::system_t const & system) : tchecker::syncprod::system_t(system)
 {
   compute_from_syncprod_system();
+  compile_native_if_requested();
 }
 
 system_t::system_t(tchecker::ta::system_t const & system)
     : tchecker::syncprod::system_t(system.as_syncprod_system()), _vm(system._vm)
 {
   compute_from_syncprod_system();
+  set_native(system._native);
 }
 
 tchecker::ta::system_t & system_t::operator=(tchecker::ta::system_t const & system)
@@ -53,6 +58,7 @@ tchecker::ta::system_t & system_t::operator=(tchecker::ta::system_t const & syst
     tchecker::syncprod::system_t::operator=(system);
     _vm = system._vm;
     compute_from_syncprod_system();
+    set_native(system._native);
   }
   return *this;
 }
@@ -81,6 +87,18 @@ tchecker::bytecode_t const * system_t::statement_bytecode(tchecker::edge_id_t id
   return _statements[id]._compiled_stmt.get();
 }
 
+bool system_t::is_constant_guard(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return _guards[id]._constant != nullptr;
+}
+
+bool system_t::is_constant_statement(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return _statements[id]._constant != nullptr;
+}
+
 bool system_t::is_urgent(tchecker::loc_id_t id) const
 {
   assert(is_location(id));
@@ -99,6 +117,115 @@ tchecker::bytecode_t const * system_t::invariant_bytecode(tchecker::loc_id_t id)
   return _invariants[id]._compiled_expr.get();
 }
 
+bool system_t::is_constant_invariant(tchecker::loc_id_t id) const
+{
+  assert(is_location(id));
+  return _invariants[id]._constant != nullptr;
+}
+
+/*!
+ \brief Check if a bytecode can be evaluated statically
+ \param bytecode : null-terminated bytecode
+ \return true if bytecode neither reads nor writes integer variables or local
+ variables, and has no backward jump, false otherwise
+ \note the evaluation of such a bytecode terminates, and does not depend on
+ the valuation of integer variables
+ */
+static bool is_constant(tchecker::bytecode_t const * bytecode)
+{
+  for (bool stop = false; !stop; bytecode += tchecker::instruction_size(bytecode)) {
+    switch (*bytecode) {
+    case tchecker::VM_RET:
+      stop = true;
+      break;
+    case tchecker::VM_JMP:
+    case tchecker::VM_JMPZ:
+      if (bytecode[1] < 0)
+        return false;
+      break;
+    case tchecker::VM_VALUEAT:
+    case tchecker::VM_ASSIGN:
+    case tchecker::VM_PUSH_FRAME:
+    case tchecker::VM_POP_FRAME:
+    case tchecker::VM_VALUEAT_FRAME:
+    case tchecker::VM_ASSIGN_FRAME:
+    case tchecker::VM_INIT_FRAME:
+    case tchecker::VM_PUSH_VALUEAT:
+    case tchecker::VM_PUSH_VALUEAT_CMP:
+      return false;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+void system_t::precompute_constant_evaluations()
+{
+  unsigned short const size = static_cast<unsigned short>(intvars_count(tchecker::VK_FLATTENED));
+  std::unique_ptr<tchecker::intvars_valuation_t, decltype(&tchecker::intvars_valuation_destruct_and_deallocate)> intval{
+      tchecker::intvars_valuation_allocate_and_construct(size, size, 0), &tchecker::intvars_valuation_destruct_and_deallocate};
+
+  auto evaluate = [&](tchecker::bytecode_t const * bytecode) -> std::shared_ptr<constant_evaluation_t const> {
+    if (!tchecker::ta::is_constant(bytecode))
+      return nullptr;
+    auto constant = std::make_shared<constant_evaluation_t>();
+    try {
+      constant->_value = _vm.run(bytecode, *intval, constant->_clkconstr, constant->_clkreset);
+    }
+    catch (std::exception const &) {
+      return nullptr; // reported when the bytecode is interpreted
+    }
+    return constant;
+  };
+
+  for (compiled_expression_t & invariant : _invariants)
+    invariant._constant = evaluate(invariant._compiled_expr.get());
+  for (compiled_expression_t & guard : _guards)
+    guard._constant = evaluate(guard._compiled_expr.get());
+  for (compiled_statement_t & statement : _statements)
+    statement._constant = evaluate(statement._compiled_stmt.get());
+}
+
+void system_t::compile_native(std::string const & cache_dir, std::string const & compiler)
+{
+  std::vector<tchecker::bytecode_t const *> programs;
+  for (compiled_expression_t const & invariant : _invariants)
+    programs.push_back(invariant._compiled_expr.get());
+  for (compiled_expression_t const & guard : _guards)
+    programs.push_back(guard._compiled_expr.get());
+  for (compiled_statement_t const & statement : _statements)
+    programs.push_back(statement._compiled_stmt.get());
+
+  set_native(std::make_shared<tchecker::native_library_t const>(programs, cache_dir, compiler));
+}
+
+void system_t::set_native(std::shared_ptr<tchecker::native_library_t const> const & native)
+{
+  _native = native;
+
+  std::size_t k = 0;
+  for (compiled_expression_t & invariant : _invariants)
+    invariant._native = (_native != nullptr ? _native->function(k++) : nullptr);
+  for (compiled_expression_t & guard : _guards)
+    guard._native = (_native != nullptr ? _native->function(k++) : nullptr);
+  for (compiled_statement_t & statement : _statements)
+    statement._native = (_native != nullptr ? _native->function(k++) : nullptr);
+}
+
+void system_t::compile_native_if_requested()
+{
+  if (!tchecker::native_code_requested())
+    return;
+
+  try {
+    compile_native(tchecker::native_cache_directory(), tchecker::native_compiler());
+  }
+  catch (std::exception const & e) {
+    std::cerr << tchecker::log_warning << e.what() << ", bytecode will be interpreted" << std::endl;
+  }
+}
+
 void system_t::compute_from_syncprod_system()
 {
   _invariants.clear();
@@ -126,6 +253,8 @@ void system_t::compute_from_syncprod_system()
     set_statements(id, attr.values("do"));
   }
 
+  precompute_constant_evaluations();
+
   if (tchecker::ta::has_guarded_weakly_synchronized_event(*this))
     throw std::invalid_argument("Transitions over weakly synchronized events should not have guards");
 }
@@ -179,7 +308,9 @@ void system_t::set_invariant(tchecker::loc_id_t id,
   }
 
   try {
-    std::shared_ptr<tchecker::bytecode_t> invariant_bytecode{tchecker::compile(*invariant_typed_expr),
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(*invariant_typed_expr)};
+    std::unique_ptr<tchecker::bytecode_t[]> optimized{tchecker::optimize(compiled.get(), integer_variables())};
+    std::shared_ptr<tchecker::bytecode_t> invariant_bytecode{tchecker::fuse_superinstructions(optimized.get()),
                                                              std::default_delete<tchecker::bytecode_t[]>()};
     _invariants[id] = {invariant_typed_expr, invariant_bytecode};
   }
@@ -221,7 +352,9 @@ void system_t::set_guards(tchecker::edge_id_t id,
   }
 
   try {
-    std::shared_ptr<tchecker::bytecode_t> guard_bytecode{tchecker::compile(*guard_typed_expr),
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(*guard_typed_expr)};
+    std::unique_ptr<tchecker::bytecode_t[]> optimized{tchecker::optimize(compiled.get(), integer_variables())};
+    std::shared_ptr<tchecker::bytecode_t> guard_bytecode{tchecker::fuse_superinstructions(optimized.get()),
                                                          std::default_delete<tchecker::bytecode_t[]>()};
     _guards[id] = {guard_typed_expr, guard_bytecode};
   }
@@ -281,7 +414,9 @@ void system_t::set_statements(tchecker::edge_id_t id,
                           })};
 
   try {
-    std::shared_ptr<tchecker::bytecode_t> bytecode{tchecker::compile(*typed_stmt),
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(*typed_stmt)};
+    std::unique_ptr<tchecker::bytecode_t[]> optimized{tchecker::optimize(compiled.get(), integer_variables())};
+    std::shared_ptr<tchecker::bytecode_t> bytecode{tchecker::fuse_superinstructions(optimized.get()),
                                                    std::default_delete<tchecker::bytecode_t[]>()};
     _statements[id] = {typed_stmt, bytecode};
   }
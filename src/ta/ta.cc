@@ -50,9 +50,8 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
     (*intval)[id] = intvars.info(id).initial_value();
 
   // check invariant
-  tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc)
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, throw_clkreset) == 0)
+    if (system.run_invariant(loc_id, *intval, invariant, throw_clkreset) == 0)
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
@@ -67,11 +66,9 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & tgt_invariant,
                               tchecker::ta::outgoing_edges_value_t const & edges)
 {
-  tchecker::vm_t & vm = system.vm();
-
   // check source invariant
   for (tchecker::loc_id_t loc_id : *vloc)
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, src_invariant, throw_clkreset) == 0)
+    if (system.run_invariant(loc_id, *intval, src_invariant, throw_clkreset) == 0)
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
 
   // compute next vloc
@@ -81,17 +78,17 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 
   // check guards
   for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
-    if (vm.run(system.guard_bytecode(edge->id()), *intval, guard, throw_clkreset) == 0)
+    if (system.run_guard(edge->id(), *intval, guard, throw_clkreset) == 0)
       return tchecker::STATE_INTVARS_GUARD_VIOLATED;
 
   // apply statements
   for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
-    if (vm.run(system.statement_bytecode(edge->id()), *intval, throw_clkconstr, reset) == 0)
+    if (system.run_statement(edge->id(), *intval, throw_clkconstr, reset) == 0)
       return tchecker::STATE_INTVARS_STATEMENT_FAILED;
 
   // check target invariant
   for (tchecker::loc_id_t loc_id : *vloc)
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, tgt_invariant, throw_clkreset) == 0)
+    if (system.run_invariant(loc_id, *intval, tgt_invariant, throw_clkreset) == 0)
       return tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
@@ -159,7 +156,7 @@ void attributes(tchecker::ta::system_t const & system, tchecker::ta::transition_
 ta_t::ta_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::size_t block_size)
     : _system(system), _state_allocator(block_size, block_size, _system->processes_count(), block_size,
                                         _system->intvars_count(tchecker::VK_FLATTENED)),
-      _transition_allocator(block_size, block_size, _system->processes_count())
+      _transition_allocator(block_size, block_size, _system->processes_count()), _edges_cache(nullptr)
 {
 }
 
@@ -175,6 +172,8 @@ void ta_t::initial(tchecker::ta::initial_value_t const & init_edge, std::vector<
 
 tchecker::ta::outgoing_edges_range_t ta_t::outgoing_edges(tchecker::ta::const_state_sptr_t const & s)
 {
+  if (_edges_cache.get() != nullptr)
+    return _edges_cache->outgoing_edges(_system->as_syncprod_system(), s->vloc_ptr());
   return tchecker::ta::outgoing_edges(*_system, s->vloc_ptr());
 }
 
@@ -204,6 +203,11 @@ void ta_t::attributes(tchecker::ta::const_transition_sptr_t const & t, std::map<
 
 tchecker::ta::system_t const & ta_t::system() const { return *_system; }
 
+void ta_t::set_outgoing_edges_cache(std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> const & cache)
+{
+  _edges_cache = cache;
+}
+
 } // end of namespace ta
 
 } // end of namespace tchecker
@@ -5,6 +5,10 @@
  *
  */
 
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "concur19.hh"
@@ -19,9 +23,9 @@ namespace concur19 {
 
 /* node_t */
 
-node_t::node_t(tchecker::refzg::state_sptr_t const & s) : _state(s) {}
+node_t::node_t(tchecker::refzg::state_sptr_t const & s) : _last_use(0), _state(s) {}
 
-node_t::node_t(tchecker::refzg::const_state_sptr_t const & s) : _state(s) {}
+node_t::node_t(tchecker::refzg::const_state_sptr_t const & s) : _last_use(0), _state(s) {}
 
 /* node_hash_t */
 
@@ -34,65 +38,23 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::concur19::node_t const
 
 /* node_le_t */
 
-node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds) : _clockbounds(clockbounds)
-{
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-}
-
-node_le_t::node_le_t(tchecker::ta::system_t const & system) : _clockbounds(tchecker::clockbounds::compute_clockbounds(system))
-{
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-}
-
-node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le) : _clockbounds(node_le._clockbounds)
-{
-  _l = tchecker::clockbounds::clone_map(*node_le._l);
-  _u = tchecker::clockbounds::clone_map(*node_le._u);
-}
-
-node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le) : _clockbounds(std::move(node_le._clockbounds))
-{
-  _l = node_le._l;
-  node_le._l = nullptr;
-  _u = node_le._u;
-  node_le._u = nullptr;
-}
-
-node_le_t::~node_le_t()
+node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds)
+    : _clockbounds(clockbounds), _cache(_clockbounds->local_lu_map())
 {
-  tchecker::clockbounds::deallocate_map(_l);
-  tchecker::clockbounds::deallocate_map(_u);
 }
 
-tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t const & node_le)
+node_le_t::node_le_t(tchecker::ta::system_t const & system)
+    : _clockbounds(tchecker::clockbounds::compute_clockbounds(system)), _cache(_clockbounds->local_lu_map())
 {
-  if (this != &node_le) {
-    _clockbounds = node_le._clockbounds;
-    _l = tchecker::clockbounds::clone_map(*node_le._l);
-    _u = tchecker::clockbounds::clone_map(*node_le._u);
-  }
-  return *this;
-}
-
-tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t && node_le)
-{
-  if (this != &node_le) {
-    _clockbounds = std::move(node_le._clockbounds);
-    _l = node_le._l;
-    node_le._l = nullptr;
-    _u = node_le._u;
-    node_le._u = nullptr;
-  }
-  return *this;
 }
 
 bool node_le_t::operator()(tchecker::tck_reach::concur19::node_t const & n1,
                            tchecker::tck_reach::concur19::node_t const & n2) const
 {
-  _clockbounds->local_lu(n2.state().vloc(), *_l, *_u);
-  return tchecker::refzg::is_sync_alu_le(n1.state(), n2.state(), *_l, *_u);
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _cache.bounds(n2.state().vloc(), l, u);
+  return tchecker::refzg::is_sync_alu_le(n1.state(), n2.state(), *l, *u);
 }
 
 /* edge_t */
@@ -180,28 +142,120 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::grap
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::ts::sharing_type_t sharing_type, std::size_t max_memory, std::size_t edges_cache_size)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
 
   std::shared_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
                                                                            tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
-                                                                           tchecker::refdbm::UNBOUNDED_SPREAD, block_size)};
+                                                                           tchecker::refdbm::UNBOUNDED_SPREAD, block_size,
+                                                                           sharing_type)};
 
   std::shared_ptr<tchecker::tck_reach::concur19::graph_t> graph{
       new tchecker::tck_reach::concur19::graph_t{refzg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::concur19::algorithm_t algorithm;
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> edges_cache{nullptr};
+  if (edges_cache_size > 0) {
+    edges_cache = std::make_shared<tchecker::syncprod::outgoing_edges_cache_t>(edges_cache_size);
+    refzg->set_outgoing_edges_cache(edges_cache);
+  }
+
+  tchecker::tck_reach::concur19::algorithm_t algorithm{max_memory};
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
 
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*refzg, *graph, accepting_labels, policy);
 
+  if (edges_cache.get() != nullptr) {
+    stats.edges_cache_hits() = edges_cache->hits();
+    stats.edges_cache_misses() = edges_cache->misses();
+  }
+
   return std::make_tuple(stats, graph);
 }
 
+/* por_run */
+
+std::tuple<tchecker::algorithms::covreach::por_stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
+por_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+        std::string const & search_order, std::size_t block_size, std::size_t table_size,
+        enum tchecker::ts::sharing_type_t sharing_type, std::size_t max_memory, std::size_t edges_cache_size)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::shared_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
+                                                                           tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+                                                                           tchecker::refdbm::UNBOUNDED_SPREAD, block_size,
+                                                                           sharing_type)};
+
+  std::shared_ptr<tchecker::tck_reach::concur19::graph_t> graph{
+      new tchecker::tck_reach::concur19::graph_t{refzg, block_size, table_size}};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::refzg::persistent_sets_t persistent_sets{*system, accepting_labels};
+
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> edges_cache{nullptr};
+  if (edges_cache_size > 0) {
+    edges_cache = std::make_shared<tchecker::syncprod::outgoing_edges_cache_t>(edges_cache_size);
+    refzg->set_outgoing_edges_cache(edges_cache);
+  }
+
+  tchecker::tck_reach::concur19::por_algorithm_t algorithm{max_memory};
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+
+  tchecker::algorithms::covreach::por_stats_t stats = algorithm.run(*refzg, *graph, persistent_sets, accepting_labels, policy);
+
+  if (edges_cache.get() != nullptr) {
+    stats.edges_cache_hits() = edges_cache->hits();
+    stats.edges_cache_misses() = edges_cache->misses();
+  }
+
+  return std::make_tuple(stats, graph);
+}
+
+/* parallel_run */
+
+tchecker::algorithms::covreach::stats_t
+parallel_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::size_t threads,
+             std::string const & labels, std::string const & search_order, std::size_t block_size, std::size_t table_size,
+             enum tchecker::ts::sharing_type_t sharing_type)
+{
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  // Each worker owns a copy of the system since evaluation of guards and
+  // statements is not thread-safe
+  std::vector<std::shared_ptr<tchecker::refzg::refzg_t>> refzgs;
+  std::vector<std::shared_ptr<tchecker::tck_reach::concur19::graph_t>> graphs;
+  for (std::size_t i = 0; i < threads; ++i) {
+    std::shared_ptr<tchecker::ta::system_t const> worker_system{
+        (i == 0 ? system : std::make_shared<tchecker::ta::system_t>(*system))};
+    std::shared_ptr<tchecker::refzg::refzg_t> refzg{
+        tchecker::refzg::factory(worker_system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
+                                 tchecker::refzg::SYNC_ELAPSED_SEMANTICS, tchecker::refdbm::UNBOUNDED_SPREAD, block_size,
+                                 sharing_type)};
+    graphs.emplace_back(new tchecker::tck_reach::concur19::graph_t{refzg, block_size, table_size});
+    refzgs.push_back(refzg);
+  }
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::concur19::parallel_algorithm_t algorithm;
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+
+  tchecker::algorithms::covreach::stats_t stats = algorithm.run(refzgs, graphs, accepting_labels, policy);
+
+  return stats;
+}
+
 } // end of namespace concur19
 
 } // end of namespace tck_reach
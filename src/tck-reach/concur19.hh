@@ -8,15 +8,19 @@
 #ifndef TCHECKER_CONCUR19_ALGORITHM_HH
 #define TCHECKER_CONCUR19_ALGORITHM_HH
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/parallel_algorithm.hh"
+#include "tchecker/algorithms/covreach/por_algorithm.hh"
 #include "tchecker/algorithms/covreach/stats.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/refzg/por.hh"
 #include "tchecker/refzg/refzg.hh"
 #include "tchecker/refzg/state.hh"
 #include "tchecker/refzg/transition.hh"
@@ -71,7 +75,22 @@ public:
   */
   inline tchecker::refzg::state_t const & state() const { return *_state; }
 
+  /*!
+  \brief Accessor
+  \return time of last use of this node
+  \note see tchecker::algorithms::covreach::algorithm_t
+  */
+  inline std::uint32_t last_use() const { return _last_use; }
+
+  /*!
+  \brief Setter
+  \param time : a time
+  \post time of last use of this node is time
+  */
+  inline void set_last_use(std::uint32_t time) { _last_use = time; }
+
 private:
+  std::uint32_t _last_use;                    /*!< Time of last use */
   tchecker::refzg::const_state_sptr_t _state; /*!< State of the local-time zone graph */
 };
 
@@ -114,27 +133,27 @@ public:
   /*!
   \brief Copy constructor
   */
-  node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le);
+  node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le) = default;
 
   /*!
   \brief Move constructor
   */
-  node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le);
+  node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le) = default;
 
   /*!
    \brief Destructor
   */
-  ~node_le_t();
+  ~node_le_t() = default;
 
   /*!
    \brief Assignment operator
   */
-  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t const & node_le);
+  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t const & node_le) = default;
 
   /*!
    \brief Move-assignment operator
   */
-  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t && node_le);
+  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t && node_le) = default;
 
   /*!
   \brief Covering predicate for nodes
@@ -147,8 +166,7 @@ public:
 
 private:
   std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds; /*!< Clock bounds */
-  tchecker::clockbounds::map_t * _l;                                  /*!< Clock lower bounds */
-  tchecker::clockbounds::map_t * _u;                                  /*!< Clock upper bounds */
+  mutable tchecker::clockbounds::local_lu_cache_t _cache;             /*!< Local LU clock bounds of tuples of locations */
 };
 
 /*!
@@ -248,6 +266,30 @@ public:
                                                     tchecker::tck_reach::concur19::graph_t>::algorithm_t;
 };
 
+/*!
+ \class parallel_algorithm_t
+ \brief Multi-threaded covering reachability algorithm over the local-time zone graph
+*/
+class parallel_algorithm_t : public tchecker::algorithms::covreach::parallel_algorithm_t<
+                                 tchecker::refzg::refzg_t, tchecker::tck_reach::concur19::graph_t> {
+public:
+  using tchecker::algorithms::covreach::parallel_algorithm_t<
+      tchecker::refzg::refzg_t, tchecker::tck_reach::concur19::graph_t>::parallel_algorithm_t;
+};
+
+/*!
+ \class por_algorithm_t
+ \brief Covering reachability algorithm with partial-order reduction over the
+ local-time zone graph
+*/
+class por_algorithm_t
+    : public tchecker::algorithms::covreach::por_algorithm_t<
+          tchecker::refzg::refzg_t, tchecker::tck_reach::concur19::graph_t, tchecker::refzg::persistent_sets_t> {
+public:
+  using tchecker::algorithms::covreach::por_algorithm_t<tchecker::refzg::refzg_t, tchecker::tck_reach::concur19::graph_t,
+                                                        tchecker::refzg::persistent_sets_t>::por_algorithm_t;
+};
+
 /*!
  \brief Run covering reachability algorithm on the local-time zone graph of a
  system
@@ -256,13 +298,71 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \param max_memory : memory budget in bytes (0: no budget)
+ \param edges_cache_size : memory bound of the cache of outgoing edges in bytes
+ (0: no cache)
  \pre labels must appear as node attributes in sysdecl
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and the covering reachability graph
+ \note nodes are evicted from the covering reachability graph when the memory
+ budget is exceeded (see tchecker::algorithms::covreach::algorithm_t)
+ \note if edges_cache_size is positive, outgoing edges are memoized for each
+ tuple of locations (see tchecker::syncprod::outgoing_edges_cache_t)
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING, std::size_t max_memory = 0,
+    std::size_t edges_cache_size = 0);
+
+/*!
+ \brief Run covering reachability algorithm with partial-order reduction on
+ the local-time zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \param max_memory : memory budget in bytes (0: no budget)
+ \param edges_cache_size : memory bound of the cache of outgoing edges in bytes
+ (0: no cache)
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ \return statistics on the run and the reduced covering reachability graph
+ \note successors are computed along persistent sets of transitions (see
+ tchecker::refzg::persistent_sets_t), which preserves reachability of labels
+ \note if edges_cache_size is positive, outgoing edges are memoized for each
+ tuple of locations (see tchecker::syncprod::outgoing_edges_cache_t)
+ */
+std::tuple<tchecker::algorithms::covreach::por_stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
+por_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
+        std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+        enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING, std::size_t max_memory = 0,
+    std::size_t edges_cache_size = 0);
+
+/*!
+ \brief Run multi-threaded covering reachability algorithm on the local-time zone graph of
+ a system
+ \param sysdecl : system declaration
+ \param threads : number of worker threads
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ threads must be positive
+ \return statistics on the run
+ \note no covering reachability graph is built, the nodes are spread over one
+ graph per worker thread and the edges are not recorded
+ */
+tchecker::algorithms::covreach::stats_t
+parallel_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::size_t threads,
+             std::string const & labels = "", std::string const & search_order = "bfs", std::size_t block_size = 10000,
+             std::size_t table_size = 65536, enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
 } // end of namespace concur19
 
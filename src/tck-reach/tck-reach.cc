@@ -15,7 +15,9 @@
 #include "concur19.hh"
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/parsing/parsing.hh"
+#include "tchecker/ts/sharing.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/spill.hh"
 #include "zg-covreach.hh"
 #include "zg-reach.hh"
 
@@ -27,13 +29,23 @@
 static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"certificate", no_argument, 0, 'C'},
                                        {"help", no_argument, 0, 'h'},
+                                       {"threads", required_argument, 0, 'j'},
                                        {"labels", required_argument, 0, 'l'},
                                        {"search-order", no_argument, 0, 's'},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
+                                       {"sharing", no_argument, 0, 0},
+                                       {"narrow-zones", no_argument, 0, 0},
+                                       {"reduced-zones", no_argument, 0, 0},
+                                       {"spill", required_argument, 0, 0},
+                                       {"bitstate", required_argument, 0, 0},
+                                       {"max-memory", required_argument, 0, 0},
+                                       {"por", no_argument, 0, 0},
+                                       {"symmetry", no_argument, 0, 0},
+                                       {"edges-cache", required_argument, 0, 0},
                                        {0, 0, 0, 0}};
 
-static char const * const options = (char *)"a:C:hl:s:";
+static char const * const options = (char *)"a:C:hj:l:s:";
 
 /*!
   \brief Display usage
@@ -48,10 +60,23 @@ void usage(char * progname)
   std::cerr << "          covreach:  reachability algorithm with covering over the zone graph" << std::endl;
   std::cerr << "   -C out_file   output a certificate (as a graph) in out_file" << std::endl;
   std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -j n          number of worker threads (no certificate if n > 1)" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of searched labels" << std::endl;
   std::cerr << "   -s bfs|dfs    search order" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "   --sharing     share equal components of states (saves memory)" << std::endl;
+  std::cerr << "   --narrow-zones  store shared zones with 16-bit bounds when possible (implies --sharing)" << std::endl;
+  std::cerr << "   --reduced-zones store shared zones as minimal sets of constraints (implies --sharing)" << std::endl;
+  std::cerr << "   --spill dir   store states and graphs in memory-mapped files in directory dir" << std::endl;
+  std::cerr << "   --bitstate n  (reach only) store visited states as bits in n megabytes (may miss states)" << std::endl;
+  std::cerr << "   --max-memory n  (covreach and concur19 only) evict visited nodes beyond n megabytes (no certificate)"
+            << std::endl;
+  std::cerr << "   --por         (concur19 only) partial-order reduction of independent transitions" << std::endl;
+  std::cerr << "                 (no reduction when all transitions synchronize with a same process)" << std::endl;
+  std::cerr << "   --symmetry    (reach and covreach only) explore one state per permutation of interchangeable processes"
+            << std::endl;
+  std::cerr << "   --edges-cache n  memoize outgoing edges of tuples of locations in n megabytes" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
 
@@ -69,6 +94,13 @@ static std::string search_order = "bfs";       /*!< Search order */
 static std::string labels = "";                /*!< Searched labels */
 static std::size_t block_size = 10000;         /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;         /*!< Size of hash tables */
+static std::size_t threads = 1;                /*!< Number of worker threads */
+static enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING; /*!< Sharing of state components */
+static std::size_t bitstate_size = 0;    /*!< Size of bitstate in megabytes (0: no bitstate hashing) */
+static std::size_t max_memory = 0;       /*!< Memory budget in megabytes (0: no budget) */
+static bool por = false;                 /*!< Partial-order reduction flag */
+static bool symmetry = false;            /*!< Symmetry reduction flag */
+static std::size_t edges_cache_size = 0; /*!< Size of cache of outgoing edges in megabytes (0: no cache) */
 
 /*!
  \brief Parse command-line arguments
@@ -109,6 +141,11 @@ int parse_command_line(int argc, char * argv[])
       case 'h':
         help = true;
         break;
+      case 'j':
+        threads = std::strtoull(optarg, nullptr, 10);
+        if (threads == 0)
+          throw std::runtime_error("Invalid number of threads: " + std::string(optarg));
+        break;
       case 'l':
         labels = optarg;
         break;
@@ -125,6 +162,35 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "sharing") == 0) {
+        if (sharing_type == tchecker::ts::NO_SHARING)
+          sharing_type = tchecker::ts::SHARING;
+      }
+      else if (strcmp(long_options[long_option_index].name, "narrow-zones") == 0)
+        sharing_type = tchecker::ts::SHARING_NARROW_ZONES;
+      else if (strcmp(long_options[long_option_index].name, "reduced-zones") == 0)
+        sharing_type = tchecker::ts::SHARING_REDUCED_ZONES;
+      else if (strcmp(long_options[long_option_index].name, "spill") == 0)
+        tchecker::spill::enable(optarg);
+      else if (strcmp(long_options[long_option_index].name, "bitstate") == 0) {
+        bitstate_size = std::strtoull(optarg, nullptr, 10);
+        if (bitstate_size == 0)
+          throw std::runtime_error("Invalid bitstate size: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "max-memory") == 0) {
+        max_memory = std::strtoull(optarg, nullptr, 10);
+        if (max_memory == 0)
+          throw std::runtime_error("Invalid memory budget: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "por") == 0)
+        por = true;
+      else if (strcmp(long_options[long_option_index].name, "symmetry") == 0)
+        symmetry = true;
+      else if (strcmp(long_options[long_option_index].name, "edges-cache") == 0) {
+        edges_cache_size = std::strtoull(optarg, nullptr, 10);
+        if (edges_cache_size == 0)
+          throw std::runtime_error("Invalid edges cache size: " + std::string(optarg));
+      }
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -163,7 +229,55 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
 */
 void reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size);
+  if (max_memory > 0)
+    throw std::runtime_error("Memory budget is only supported by algorithms covreach and concur19");
+
+  if (por)
+    throw std::runtime_error("Partial-order reduction is only supported by algorithm concur19");
+
+  if (symmetry) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with symmetry reduction");
+    if (threads > 1 || bitstate_size > 0)
+      throw std::runtime_error("Symmetry reduction is not supported with multiple threads or bitstate hashing");
+  }
+
+  if (edges_cache_size > 0 && (threads > 1 || bitstate_size > 0))
+    throw std::runtime_error("Edges cache is not supported with multiple threads or bitstate hashing");
+
+  if (bitstate_size > 0) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with bitstate hashing");
+    if (threads > 1)
+      throw std::runtime_error("Multiple threads are not supported with bitstate hashing");
+
+    tchecker::algorithms::reach::bitstate_stats_t stats =
+        tchecker::tck_reach::zg_reach::bitstate_run(sysdecl, bitstate_size * 8 * 1024 * 1024, labels, search_order, block_size);
+
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+    return;
+  }
+
+  if (threads > 1) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with multiple threads");
+
+    tchecker::algorithms::reach::stats_t stats =
+        tchecker::tck_reach::zg_reach::parallel_run(sysdecl, threads, labels, search_order, block_size, table_size,
+                                                    sharing_type);
+
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+    return;
+  }
+
+  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size,
+                                                              sharing_type, symmetry, edges_cache_size * 1024 * 1024);
 
   // stats
   std::map<std::string, std::string> m;
@@ -191,7 +305,62 @@ void reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysd
 */
 void concur19(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  auto && [stats, graph] = tchecker::tck_reach::concur19::run(sysdecl, labels, search_order, block_size, table_size);
+  if (bitstate_size > 0)
+    throw std::runtime_error("Bitstate hashing is only supported by algorithm reach");
+
+  if (symmetry)
+    throw std::runtime_error("Symmetry reduction is only supported by algorithms reach and covreach");
+
+  if (edges_cache_size > 0 && threads > 1)
+    throw std::runtime_error("Edges cache is not supported with multiple threads");
+
+  if (max_memory > 0) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with a memory budget");
+    if (threads > 1)
+      throw std::runtime_error("Memory budget is not supported with multiple threads");
+  }
+
+  if (threads > 1) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with multiple threads");
+    if (por)
+      throw std::runtime_error("Partial-order reduction is not supported with multiple threads");
+
+    tchecker::algorithms::covreach::stats_t stats =
+        tchecker::tck_reach::concur19::parallel_run(sysdecl, threads, labels, search_order, block_size, table_size,
+                                                    sharing_type);
+
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+    return;
+  }
+
+  if (por) {
+    auto && [stats, graph] = tchecker::tck_reach::concur19::por_run(sysdecl, labels, search_order, block_size, table_size,
+                                                                    sharing_type, max_memory * 1024 * 1024,
+                                                                    edges_cache_size * 1024 * 1024);
+
+    // stats
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+
+    // graph
+    if (output_file != "") {
+      std::ofstream ofs{output_file};
+      tchecker::tck_reach::concur19::dot_output(ofs, *graph, sysdecl->name());
+      ofs.close();
+    }
+    return;
+  }
+
+  auto && [stats, graph] = tchecker::tck_reach::concur19::run(sysdecl, labels, search_order, block_size, table_size,
+                                                              sharing_type, max_memory * 1024 * 1024,
+                                                              edges_cache_size * 1024 * 1024);
 
   // stats
   std::map<std::string, std::string> m;
@@ -216,7 +385,47 @@ void concur19(std::shared_ptr<tchecker::parsing::system_declaration_t> const & s
 */
 void covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_covreach::run(sysdecl, labels, search_order, block_size, table_size);
+  if (bitstate_size > 0)
+    throw std::runtime_error("Bitstate hashing is only supported by algorithm reach");
+
+  if (por)
+    throw std::runtime_error("Partial-order reduction is only supported by algorithm concur19");
+
+  if (symmetry) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with symmetry reduction");
+    if (threads > 1)
+      throw std::runtime_error("Symmetry reduction is not supported with multiple threads");
+  }
+
+  if (edges_cache_size > 0 && threads > 1)
+    throw std::runtime_error("Edges cache is not supported with multiple threads");
+
+  if (max_memory > 0) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with a memory budget");
+    if (threads > 1)
+      throw std::runtime_error("Memory budget is not supported with multiple threads");
+  }
+
+  if (threads > 1) {
+    if (output_file != "")
+      throw std::runtime_error("Certificate output is not supported with multiple threads");
+
+    tchecker::algorithms::covreach::stats_t stats =
+        tchecker::tck_reach::zg_covreach::parallel_run(sysdecl, threads, labels, search_order, block_size, table_size,
+                                                       sharing_type);
+
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+    return;
+  }
+
+  auto && [stats, graph] = tchecker::tck_reach::zg_covreach::run(sysdecl, labels, search_order, block_size, table_size,
+                                                                 sharing_type, max_memory * 1024 * 1024, symmetry,
+                                                                 edges_cache_size * 1024 * 1024);
 
   // stats
   std::map<std::string, std::string> m;
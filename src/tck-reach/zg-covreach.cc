@@ -5,10 +5,17 @@
  *
  */
 
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/syncprod/syncprod.hh"
 #include "tchecker/ta/state.hh"
+#include "tchecker/ta/symmetry.hh"
 #include "zg-covreach.hh"
 
 namespace tchecker {
@@ -19,9 +26,9 @@ namespace zg_covreach {
 
 /* node_t */
 
-node_t::node_t(tchecker::zg::state_sptr_t const & s) : _state(s) {}
+node_t::node_t(tchecker::zg::state_sptr_t const & s) : _last_use(0), _state(s) {}
 
-node_t::node_t(tchecker::zg::const_state_sptr_t const & s) : _state(s) {}
+node_t::node_t(tchecker::zg::const_state_sptr_t const & s) : _last_use(0), _state(s) {}
 
 /* node_hash_t */
 
@@ -40,6 +47,13 @@ bool node_le_t::operator()(tchecker::tck_reach::zg_covreach::node_t const & n1,
   return n1.state() <= n2.state();
 }
 
+/* node_summary_t */
+
+tchecker::zg::zone_summary_t node_summary_t::operator()(tchecker::tck_reach::zg_covreach::node_t const & n) const
+{
+  return tchecker::zg::zone_summary_t{n.state().zone()};
+}
+
 /* edge_t */
 
 edge_t::edge_t(tchecker::zg::transition_t const & t) : _vedge(t.vedge_ptr()) {}
@@ -49,9 +63,10 @@ edge_t::edge_t(tchecker::zg::transition_t const & t) : _vedge(t.vedge_ptr()) {}
 graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size)
     : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
                                             tchecker::tck_reach::zg_covreach::node_hash_t,
-                                            tchecker::tck_reach::zg_covreach::node_le_t>(
+                                            tchecker::tck_reach::zg_covreach::node_le_t,
+                                            tchecker::tck_reach::zg_covreach::node_summary_t>(
           block_size, table_size, tchecker::tck_reach::zg_covreach::node_hash_t(),
-          tchecker::tck_reach::zg_covreach::node_le_t()),
+          tchecker::tck_reach::zg_covreach::node_le_t(), tchecker::tck_reach::zg_covreach::node_summary_t()),
       _zg(zg)
 {
 }
@@ -60,7 +75,8 @@ graph_t::~graph_t()
 {
   tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
                                         tchecker::tck_reach::zg_covreach::node_hash_t,
-                                        tchecker::tck_reach::zg_covreach::node_le_t>::clear();
+                                        tchecker::tck_reach::zg_covreach::node_le_t,
+                                        tchecker::tck_reach::zg_covreach::node_summary_t>::clear();
 }
 
 void graph_t::attributes(tchecker::tck_reach::zg_covreach::node_t const & n, std::map<std::string, std::string> & m) const
@@ -125,27 +141,86 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::g
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::ts::sharing_type_t sharing_type, std::size_t max_memory, bool symmetry, std::size_t edges_cache_size)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
 
-  std::shared_ptr<tchecker::zg::zg_t> zg{
-      tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size)};
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, sharing_type)};
 
   std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t> graph{
       new tchecker::tck_reach::zg_covreach::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_covreach::algorithm_t algorithm;
+  if (symmetry)
+    zg->set_symmetry(std::make_shared<tchecker::ta::symmetry_t>(*system, accepting_labels));
+
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> edges_cache{nullptr};
+  if (edges_cache_size > 0) {
+    edges_cache = std::make_shared<tchecker::syncprod::outgoing_edges_cache_t>(edges_cache_size);
+    zg->set_outgoing_edges_cache(edges_cache);
+  }
+
+  tchecker::tck_reach::zg_covreach::algorithm_t algorithm{max_memory};
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
 
   tchecker::algorithms::covreach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
 
+  if (edges_cache.get() != nullptr) {
+    stats.edges_cache_hits() = edges_cache->hits();
+    stats.edges_cache_misses() = edges_cache->misses();
+  }
+  stats.set_successor_allocations(zg->successor_allocations());
+  stats.set_avoided_zone_copies(zg->avoided_zone_copies());
+
   return std::make_tuple(stats, graph);
 }
 
+/* parallel_run */
+
+tchecker::algorithms::covreach::stats_t
+parallel_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::size_t threads,
+             std::string const & labels, std::string const & search_order, std::size_t block_size, std::size_t table_size,
+             enum tchecker::ts::sharing_type_t sharing_type)
+{
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  // Clock bounds are computed once and shared by the zone graphs of all workers
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Clock bounds cannot be inferred from system");
+
+  // Each worker owns a copy of the system since evaluation of guards and
+  // statements is not thread-safe
+  std::vector<std::shared_ptr<tchecker::zg::zg_t>> zgs;
+  std::vector<std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>> graphs;
+  for (std::size_t i = 0; i < threads; ++i) {
+    std::shared_ptr<tchecker::ta::system_t const> worker_system{
+        (i == 0 ? system : std::make_shared<tchecker::ta::system_t>(*system))};
+    std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(worker_system, tchecker::zg::ELAPSED_SEMANTICS,
+                                                                 tchecker::zg::EXTRA_LU_PLUS_LOCAL, *clock_bounds, block_size,
+                                                                 sharing_type)};
+    graphs.emplace_back(new tchecker::tck_reach::zg_covreach::graph_t{zg, block_size, table_size});
+    zgs.push_back(zg);
+  }
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::zg_covreach::parallel_algorithm_t algorithm;
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
+
+  tchecker::algorithms::covreach::stats_t stats = algorithm.run(zgs, graphs, accepting_labels, policy);
+
+  return stats;
+}
+
 } // end of namespace zg_covreach
 
 } // end of namespace tck_reach
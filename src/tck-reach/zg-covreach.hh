@@ -13,7 +13,10 @@
  \brief Covering reachability algorithm over the zone graph with zone inclusion
 */
 
+#include <cstdint>
+
 #include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/parallel_algorithm.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/utils/shared_objects.hh"
@@ -60,7 +63,22 @@ public:
   */
   inline tchecker::zg::state_t const & state() const { return *_state; }
 
+  /*!
+  \brief Accessor
+  \return time of last use of this node
+  \note see tchecker::algorithms::covreach::algorithm_t
+  */
+  inline std::uint32_t last_use() const { return _last_use; }
+
+  /*!
+  \brief Setter
+  \param time : a time
+  \post time of last use of this node is time
+  */
+  inline void set_last_use(std::uint32_t time) { _last_use = time; }
+
 private:
+  std::uint32_t _last_use;                 /*!< Time of last use */
   tchecker::zg::const_state_sptr_t _state; /*!< State of the zone graph */
 };
 
@@ -97,6 +115,34 @@ public:
                   tchecker::tck_reach::zg_covreach::node_t const & n2) const;
 };
 
+/*!
+\class node_summary_t
+\brief Summary functor for nodes
+*/
+class node_summary_t {
+public:
+  /*!
+  \brief Type of summaries
+  */
+  using summary_t = tchecker::zg::zone_summary_t;
+
+  /*!
+  \brief Summary function
+  \param n : a node
+  \return summary of the zone in n, which is monotone w.r.t. zone inclusion
+  */
+  summary_t operator()(tchecker::tck_reach::zg_covreach::node_t const & n) const;
+
+  /*!
+  \brief Less-than-or-equal-to predicate on summaries
+  \param s1 : a summary
+  \param s2 : a summary
+  \return false if no node summarized by s1 is covered by a node summarized by
+  s2, true otherwise
+  */
+  inline bool le(summary_t const & s1, summary_t const & s2) const { return s1 <= s2; }
+};
+
 /*!
  \class edge_t
  \brief Edge of the covering reachability graph of a zone graph
@@ -132,7 +178,8 @@ private:
 */
 class graph_t : public tchecker::graph::subsumption::graph_t<
                     tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
-                    tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t> {
+                    tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t,
+                    tchecker::tck_reach::zg_covreach::node_summary_t> {
 public:
   /*!
    \brief Constructor
@@ -150,7 +197,8 @@ public:
 
   using tchecker::graph::subsumption::graph_t<
       tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
-      tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t>::attributes;
+      tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t,
+      tchecker::tck_reach::zg_covreach::node_summary_t>::attributes;
 
 protected:
   /*!
@@ -192,6 +240,17 @@ public:
   using tchecker::algorithms::covreach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t>::algorithm_t;
 };
 
+/*!
+ \class parallel_algorithm_t
+ \brief Multi-threaded covering reachability algorithm over the zone graph
+*/
+class parallel_algorithm_t : public tchecker::algorithms::covreach::parallel_algorithm_t<
+                                 tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t> {
+public:
+  using tchecker::algorithms::covreach::parallel_algorithm_t<
+      tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t>::parallel_algorithm_t;
+};
+
 /*!
  \brief Run covering reachability algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -199,13 +258,49 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \param max_memory : memory budget in bytes (0: no budget)
+ \param symmetry : symmetry reduction flag
+ \param edges_cache_size : memory bound of the cache of outgoing edges in bytes
+ (0: no cache)
  \pre labels must appear as node attributes in sysdecl
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and the covering reachability graph
+ \note nodes are evicted from the covering reachability graph when the memory
+ budget is exceeded (see tchecker::algorithms::covreach::algorithm_t)
+ \note if edges_cache_size is positive, outgoing edges are memoized for each
+ tuple of locations (see tchecker::syncprod::outgoing_edges_cache_t)
+ \note if symmetry is true, states are mapped to representatives w.r.t.
+ interchangeable processes (see tchecker::ta::symmetry_t), hence the edges of
+ the covering reachability graph may refer to processes in another order
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING, std::size_t max_memory = 0,
+    bool symmetry = false, std::size_t edges_cache_size = 0);
+
+/*!
+ \brief Run multi-threaded covering reachability algorithm on the zone graph of
+ a system
+ \param sysdecl : system declaration
+ \param threads : number of worker threads
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ threads must be positive
+ \return statistics on the run
+ \note no covering reachability graph is built, the nodes are spread over one
+ graph per worker thread and the edges are not recorded
+ */
+tchecker::algorithms::covreach::stats_t
+parallel_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::size_t threads,
+             std::string const & labels = "", std::string const & search_order = "bfs", std::size_t block_size = 10000,
+             std::size_t table_size = 65536, enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
 
 } // end of namespace zg_covreach
 
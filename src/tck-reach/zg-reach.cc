@@ -5,9 +5,16 @@
  *
  */
 
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/ta/symmetry.hh"
 #include "tchecker/ta/system.hh"
 #include "zg-reach.hh"
 
@@ -118,27 +125,102 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::grap
 
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::ts::sharing_type_t sharing_type, bool symmetry, std::size_t edges_cache_size)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
 
-  std::shared_ptr<tchecker::zg::zg_t> zg{
-      tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size)};
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, sharing_type)};
 
   std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> graph{
       new tchecker::tck_reach::zg_reach::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
+  if (symmetry)
+    zg->set_symmetry(std::make_shared<tchecker::ta::symmetry_t>(*system, accepting_labels));
+
+  std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> edges_cache{nullptr};
+  if (edges_cache_size > 0) {
+    edges_cache = std::make_shared<tchecker::syncprod::outgoing_edges_cache_t>(edges_cache_size);
+    zg->set_outgoing_edges_cache(edges_cache);
+  }
+
   tchecker::tck_reach::zg_reach::algorithm_t algorithm;
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
 
   tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
 
+  if (edges_cache.get() != nullptr) {
+    stats.edges_cache_hits() = edges_cache->hits();
+    stats.edges_cache_misses() = edges_cache->misses();
+  }
+  stats.set_successor_allocations(zg->successor_allocations());
+  stats.set_avoided_zone_copies(zg->avoided_zone_copies());
+
   return std::make_tuple(stats, graph);
 }
 
+/* parallel_run */
+
+tchecker::algorithms::reach::stats_t parallel_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
+                                                  std::size_t threads, std::string const & labels,
+                                                  std::string const & search_order, std::size_t block_size,
+                                                  std::size_t table_size, enum tchecker::ts::sharing_type_t sharing_type)
+{
+  if (threads == 0)
+    throw std::invalid_argument("Number of threads should be positive");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  // Clock bounds are computed once and shared by the zone graphs of all workers
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Clock bounds cannot be inferred from system");
+
+  // Each worker owns a copy of the system since evaluation of guards and
+  // statements is not thread-safe
+  std::vector<std::shared_ptr<tchecker::zg::zg_t>> zgs;
+  for (std::size_t i = 0; i < threads; ++i) {
+    std::shared_ptr<tchecker::ta::system_t const> worker_system{
+        (i == 0 ? system : std::make_shared<tchecker::ta::system_t>(*system))};
+    zgs.emplace_back(tchecker::zg::factory(worker_system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL,
+                                           *clock_bounds, block_size, sharing_type));
+  }
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::zg_reach::parallel_algorithm_t algorithm;
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+
+  return algorithm.run(zgs, accepting_labels, policy, block_size, table_size);
+}
+
+/* bitstate_run */
+
+tchecker::algorithms::reach::bitstate_stats_t
+bitstate_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::size_t bitstate_size,
+             std::string const & labels, std::string const & search_order, std::size_t block_size)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size)};
+
+  tchecker::bitstate_t visited{bitstate_size};
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::zg_reach::bitstate_algorithm_t algorithm;
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+
+  return algorithm.run(*zg, visited, accepting_labels, policy);
+}
+
 } // end of namespace zg_reach
 
 } // end of namespace tck_reach
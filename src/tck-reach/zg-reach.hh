@@ -14,10 +14,13 @@
 #include <tuple>
 
 #include "tchecker/algorithms/reach/algorithm.hh"
+#include "tchecker/algorithms/reach/bitstate_algorithm.hh"
+#include "tchecker/algorithms/reach/parallel_algorithm.hh"
 #include "tchecker/algorithms/reach/stats.hh"
 #include "tchecker/graph/reachability_graph.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/utils/allocation_size.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
 #include "tchecker/zg/state.hh"
@@ -190,6 +193,29 @@ public:
   using tchecker::algorithms::reach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::graph_t>::algorithm_t;
 };
 
+/*!
+ \class parallel_algorithm_t
+ \brief Multi-threaded reachability algorithm over the zone graph
+*/
+class parallel_algorithm_t
+    : public tchecker::algorithms::reach::parallel_algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::node_t,
+                                                               tchecker::tck_reach::zg_reach::node_hash_t,
+                                                               tchecker::tck_reach::zg_reach::node_equal_to_t> {
+public:
+  using tchecker::algorithms::reach::parallel_algorithm_t<
+      tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::node_hash_t,
+      tchecker::tck_reach::zg_reach::node_equal_to_t>::parallel_algorithm_t;
+};
+
+/*!
+ \class bitstate_algorithm_t
+ \brief Reachability algorithm over the zone graph with bitstate hashing
+*/
+class bitstate_algorithm_t : public tchecker::algorithms::reach::bitstate_algorithm_t<tchecker::zg::zg_t> {
+public:
+  using tchecker::algorithms::reach::bitstate_algorithm_t<tchecker::zg::zg_t>::bitstate_algorithm_t;
+};
+
 /*!
  \brief Run reachability algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -197,18 +223,89 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \param symmetry : symmetry reduction flag
+ \param edges_cache_size : memory bound of the cache of outgoing edges in bytes
+ (0: no cache)
  \pre labels must appear as node attributes in sysdecl
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and the reachability graph
+ \note if edges_cache_size is positive, outgoing edges are memoized for each
+ tuple of locations (see tchecker::syncprod::outgoing_edges_cache_t)
+ \note if symmetry is true, states are mapped to representatives w.r.t.
+ interchangeable processes (see tchecker::ta::symmetry_t), hence the edges of
+ the reachability graph may refer to processes in another order
  */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING, bool symmetry = false,
+    std::size_t edges_cache_size = 0);
+
+/*!
+ \brief Run multi-threaded reachability algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param threads : number of worker threads
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param sharing_type : type of sharing of state components
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ threads must be positive
+ \return statistics on the run
+ \note no reachability graph is built: the workers share the set of visited
+ nodes, and the edges are not recorded
+ */
+tchecker::algorithms::reach::stats_t parallel_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl,
+                                                  std::size_t threads, std::string const & labels = "",
+                                                  std::string const & search_order = "bfs", std::size_t block_size = 10000,
+                                                  std::size_t table_size = 65536,
+                                                  enum tchecker::ts::sharing_type_t sharing_type = tchecker::ts::NO_SHARING);
+
+/*!
+ \brief Run reachability algorithm with bitstate hashing on the zone graph of a
+ system
+ \param sysdecl : system declaration
+ \param bitstate_size : number of bits used to represent visited states
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ bitstate_size must be positive
+ \return statistics on the run
+ \note no reachability graph is built, and the exploration may miss states
+ (see tchecker::algorithms::reach::bitstate_algorithm_t)
+ \note components of states are not shared, since shared components would be
+ kept in memory for the whole run
+ */
+tchecker::algorithms::reach::bitstate_stats_t
+bitstate_run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::size_t bitstate_size,
+             std::string const & labels = "", std::string const & search_order = "bfs", std::size_t block_size = 10000);
 
 } // end of namespace zg_reach
 
 } // namespace tck_reach
 
+/*!
+ \class allocation_size_t
+ \brief Specialization of class tchecker::allocation_size_t for type
+ tchecker::tck_reach::zg_reach::node_t
+ */
+template <> class allocation_size_t<tchecker::tck_reach::zg_reach::node_t> {
+public:
+  /*!
+   \brief Allocation size for objects of type tchecker::tck_reach::zg_reach::node_t
+   \param args : parameters needed to determine the allocation size
+   */
+  template <class... ARGS> static std::size_t alloc_size(ARGS &&... args)
+  {
+    return sizeof(tchecker::tck_reach::zg_reach::node_t);
+  }
+};
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_ZG_REACH_ALGORITHM_HH
@@ -0,0 +1,87 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "tchecker/utils/bitstate.hh"
+
+namespace tchecker {
+
+/*!
+ \brief Second hash function for double hashing
+ \param hash : a hash value
+ \return an odd value derived from hash (finalizer of splitmix64)
+ */
+static inline std::uint64_t rehash(std::uint64_t hash)
+{
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return (hash ^ (hash >> 31)) | 1;
+}
+
+bitstate_t::bitstate_t(std::size_t size, unsigned int hash_count)
+    : _size(size), _hash_count(hash_count), _set_bits(0), _inserted(0), _expected_omissions(0.0)
+{
+  if (size == 0)
+    throw std::invalid_argument("Bitstate size should be positive");
+  if (hash_count == 0)
+    throw std::invalid_argument("Number of bits per hash value should be positive");
+  _words.resize((size + 63) / 64, 0);
+}
+
+bool bitstate_t::insert(std::size_t hash)
+{
+  std::uint64_t const step = tchecker::rehash(hash);
+  std::uint64_t position = hash;
+  bool is_new = false;
+  for (unsigned int k = 0; k < _hash_count; ++k, position += step) {
+    std::size_t const bit = position % _size;
+    std::uint64_t const mask = std::uint64_t{1} << (bit % 64);
+    if ((_words[bit / 64] & mask) == 0) {
+      _words[bit / 64] |= mask;
+      ++_set_bits;
+      is_new = true;
+    }
+  }
+  if (is_new) {
+    ++_inserted;
+    // conservative: the omission probability after insertion is used
+    double const p = omission_probability();
+    _expected_omissions += (p < 1.0 ? p / (1.0 - p) : std::numeric_limits<double>::infinity());
+  }
+  return is_new;
+}
+
+bool bitstate_t::contains(std::size_t hash) const
+{
+  std::uint64_t const step = tchecker::rehash(hash);
+  std::uint64_t position = hash;
+  for (unsigned int k = 0; k < _hash_count; ++k, position += step) {
+    std::size_t const bit = position % _size;
+    if ((_words[bit / 64] & (std::uint64_t{1} << (bit % 64))) == 0)
+      return false;
+  }
+  return true;
+}
+
+double bitstate_t::omission_probability() const
+{
+  return std::pow(static_cast<double>(_set_bits) / static_cast<double>(_size), _hash_count);
+}
+
+double bitstate_t::estimated_coverage() const
+{
+  if (_inserted == 0)
+    return 1.0;
+  if (std::isinf(_expected_omissions))
+    return 0.0;
+  return static_cast<double>(_inserted) / (static_cast<double>(_inserted) + _expected_omissions);
+}
+
+} // end of namespace tchecker
@@ -0,0 +1,209 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tchecker/utils/spill.hh"
+
+namespace tchecker {
+
+namespace spill {
+
+static std::string _directory;                  /*!< Spill directory (empty if spilling is disabled) */
+static std::atomic<std::size_t> _spilled_size{0}; /*!< Size of spilled memory blocks */
+
+/*!
+ \brief Size of the regions of spill files that are mapped at once
+ \note Spilled memory blocks are carved out of these regions, hence the number
+ of mappings is the spilled size divided by the region size, rather than the
+ number of blocks
+ */
+static std::size_t const REGION_SIZE = 64 * 1024 * 1024;
+
+/*!
+ \class spill_file_t
+ \brief Spill file, grown by regions from which spilled memory blocks are carved
+ \note Disk space is reserved for each region before it is mapped, hence writing
+ to spilled memory blocks cannot fail when the disk is full
+ */
+class spill_file_t {
+public:
+  /*!
+   \brief Constructor
+   \post this file has not been created yet
+   */
+  spill_file_t() : _fd(-1), _size(0), _region(nullptr), _region_free(0) {}
+
+  /*!
+   \brief Destructor
+   \post the file has been closed (its mapped regions remain valid)
+   */
+  ~spill_file_t() { close(); }
+
+  /*!
+   \brief Close
+   \post the file has been closed, and later allocations use a new file. Mapped
+   regions remain valid, and deallocated blocks can still be reused
+   */
+  void close()
+  {
+    if (_fd >= 0)
+      ::close(_fd);
+    _fd = -1;
+    _size = 0;
+    _region = nullptr;
+    _region_free = 0;
+  }
+
+  /*!
+   \brief Allocation
+   \param directory : spill directory
+   \param size : size of the block
+   \return a block of size bytes carved out of a region of the spill file in
+   directory, or a previously deallocated block of the same size
+   \throw std::bad_alloc : if the file cannot be created, grown or mapped
+   */
+  void * allocate(std::string const & directory, std::size_t size)
+  {
+    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    std::vector<void *> & free_blocks = _free_blocks[size];
+    if (!free_blocks.empty()) {
+      void * block = free_blocks.back();
+      free_blocks.pop_back();
+      return block;
+    }
+
+    if (size > _region_free) {
+      // blocks larger than regions get a region of their own
+      std::size_t const page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      std::size_t const region_size = std::max(REGION_SIZE, (size + page_size - 1) / page_size * page_size);
+      char * region = map_region(directory, region_size);
+      if (size > REGION_SIZE)
+        return region;
+      _region = region;
+      _region_free = region_size;
+    }
+
+    void * block = _region;
+    _region += size;
+    _region_free -= size;
+    return block;
+  }
+
+  /*!
+   \brief Deallocation
+   \param block : a memory block
+   \param size : size of block
+   \pre block has been allocated by allocate(size)
+   \post block will be reused by later allocations of size bytes
+   */
+  void deallocate(void * block, std::size_t size)
+  {
+    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    _free_blocks[size].push_back(block);
+  }
+
+private:
+  /*!
+   \brief Map a new region
+   \param directory : spill directory
+   \param size : size of the region, a multiple of the page size
+   \return a region of size bytes at the end of the spill file, which has been
+   created in directory if needed
+   \throw std::bad_alloc : if the file cannot be created, if disk space cannot be
+   reserved for the region, or if the region cannot be mapped
+   */
+  char * map_region(std::string const & directory, std::size_t size)
+  {
+    if (_fd < 0) {
+      std::string const pattern = directory + "/tchecker-spill-XXXXXX";
+      std::vector<char> path(pattern.begin(), pattern.end());
+      path.push_back('\0');
+      _fd = ::mkstemp(path.data());
+      if (_fd < 0)
+        throw std::bad_alloc();
+      ::unlink(path.data()); // the file is deleted when closed and unmapped
+    }
+
+    if (::posix_fallocate(_fd, static_cast<off_t>(_size), static_cast<off_t>(size)) != 0)
+      throw std::bad_alloc();
+
+    void * region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, static_cast<off_t>(_size));
+    if (region == MAP_FAILED)
+      throw std::bad_alloc();
+    _size += size;
+    return static_cast<char *>(region);
+  }
+
+  static std::size_t const ALIGNMENT = alignof(std::max_align_t); /*!< Alignment of blocks */
+
+  int _fd;                                                           /*!< File descriptor (-1 if not created) */
+  std::size_t _size;                                                 /*!< Size of the file */
+  char * _region;                                                    /*!< Free part of the current region */
+  std::size_t _region_free;                                          /*!< Size of the free part of the current region */
+  std::unordered_map<std::size_t, std::vector<void *>> _free_blocks; /*!< Deallocated blocks, by size */
+};
+
+static std::mutex _file_mutex;              /*!< Mutex on the spill file */
+static std::string _file_directory;         /*!< Directory of the spill file */
+static tchecker::spill::spill_file_t _file; /*!< Spill file */
+
+void enable(std::string const & directory)
+{
+  struct stat st;
+  if (directory.empty() || ::stat(directory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode) ||
+      ::access(directory.c_str(), W_OK) != 0)
+    throw std::invalid_argument("Spill directory " + directory + " is not a writable directory");
+  tchecker::spill::_directory = directory;
+
+  std::lock_guard<std::mutex> lock(tchecker::spill::_file_mutex);
+  if (directory != tchecker::spill::_file_directory) {
+    tchecker::spill::_file.close();
+    tchecker::spill::_file_directory = directory;
+  }
+}
+
+void disable() { tchecker::spill::_directory.clear(); }
+
+bool enabled() { return !tchecker::spill::_directory.empty(); }
+
+std::string const & directory() { return tchecker::spill::_directory; }
+
+void * allocate(std::size_t size)
+{
+  std::lock_guard<std::mutex> lock(tchecker::spill::_file_mutex);
+  void * block = tchecker::spill::_file.allocate(tchecker::spill::_file_directory, size);
+  tchecker::spill::_spilled_size += size;
+  return block;
+}
+
+void deallocate(void * block, std::size_t size)
+{
+  std::lock_guard<std::mutex> lock(tchecker::spill::_file_mutex);
+  tchecker::spill::_file.deallocate(block, size);
+  tchecker::spill::_spilled_size -= size;
+}
+
+std::size_t spilled_size() { return tchecker::spill::_spilled_size; }
+
+} // end of namespace spill
+
+} // end of namespace tchecker
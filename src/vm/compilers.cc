@@ -5,8 +5,11 @@
  *
  */
 
+#include <algorithm>
+#include <initializer_list>
 #include <limits>
 #include <tchecker/statement/static_analysis.hh>
+#include <utility>
 #include <vector>
 
 #include "tchecker/basictypes.hh"
@@ -1045,4 +1048,532 @@ tchecker::bytecode_t * compile(tchecker::typed_statement_t const & stmt)
   }
 }
 
+// Bytecode optimizer
+
+namespace details {
+
+/*!
+ \brief Type of decoded instructions
+ */
+struct decoded_instruction_t {
+  std::vector<tchecker::bytecode_t> code; /*!< Instruction and parameters */
+  std::size_t target;                     /*!< Index of the target instruction (jumps only) */
+};
+
+/*!
+ \brief Type of decoded bytecode
+ */
+using program_t = std::vector<tchecker::details::decoded_instruction_t>;
+
+/*!
+ \brief Check if an instruction is a jump
+ \param instruction : an instruction
+ \return true if instruction is VM_JMP or VM_JMPZ, false otherwise
+ */
+static inline bool is_jump(tchecker::bytecode_t instruction)
+{
+  return (instruction == tchecker::VM_JMP) || (instruction == tchecker::VM_JMPZ);
+}
+
+/*!
+ \brief Decode bytecode
+ \param bytecode : null-terminated bytecode
+ \return the sequence of instructions in bytecode, with jump offsets
+ translated to indices of target instructions
+ \throw std::invalid_argument : if bytecode contains a jump that does not
+ land on an instruction
+ */
+static tchecker::details::program_t decode(tchecker::bytecode_t const * bytecode)
+{
+  tchecker::details::program_t program;
+  std::vector<std::size_t> offsets;
+  std::size_t offset = 0;
+  for (bool stop = false; !stop;) {
+    stop = (bytecode[offset] == tchecker::VM_RET);
+    std::size_t const size = tchecker::instruction_size(bytecode + offset);
+    offsets.push_back(offset);
+    program.push_back({std::vector<tchecker::bytecode_t>(bytecode + offset, bytecode + offset + size), 0});
+    offset += size;
+  }
+
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    if (!tchecker::details::is_jump(program[i].code[0]))
+      continue;
+    tchecker::bytecode_t const target = static_cast<tchecker::bytecode_t>(offsets[i]) + 2 + program[i].code[1];
+    auto it = std::lower_bound(offsets.begin(), offsets.end(), static_cast<std::size_t>(target));
+    if (target < 0 || it == offsets.end() || *it != static_cast<std::size_t>(target))
+      throw std::invalid_argument("jump does not land on an instruction");
+    program[i].target = it - offsets.begin();
+  }
+
+  return program;
+}
+
+/*!
+ \brief Encode decoded bytecode
+ \param program : decoded bytecode
+ \return null-terminated bytecode for program, with jump offsets computed from
+ the indices of target instructions
+ \note the caller is responsible for deleting[] the returned value
+ */
+static tchecker::bytecode_t * encode(tchecker::details::program_t const & program)
+{
+  std::vector<std::size_t> offsets;
+  std::size_t size = 0;
+  for (tchecker::details::decoded_instruction_t const & instr : program) {
+    offsets.push_back(size);
+    size += instr.code.size();
+  }
+
+  tchecker::bytecode_t * b = new tchecker::bytecode_t[size];
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    std::copy(program[i].code.begin(), program[i].code.end(), b + offsets[i]);
+    if (tchecker::details::is_jump(program[i].code[0]))
+      b[offsets[i] + 1] = static_cast<tchecker::bytecode_t>(offsets[program[i].target]) -
+                          static_cast<tchecker::bytecode_t>(offsets[i] + 2);
+  }
+  return b;
+}
+
+/*!
+ \brief Remove instructions
+ \param program : decoded bytecode
+ \param removed : instructions to remove
+ \pre the last instruction in program is not removed, and removed
+ instructions have no effect on the execution paths that reach them through a
+ jump
+ \post the instructions in removed have been erased from program. Jumps to a
+ removed instruction have been redirected to the next instruction that is kept
+ */
+static void erase(tchecker::details::program_t & program, std::vector<bool> const & removed)
+{
+  std::vector<std::size_t> new_index(program.size());
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < program.size(); ++i)
+    if (!removed[i])
+      new_index[i] = next++;
+  for (std::size_t i = program.size(); i-- > 0;)
+    if (removed[i])
+      new_index[i] = (i + 1 < program.size() ? new_index[i + 1] : next);
+
+  tchecker::details::program_t result;
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    if (removed[i])
+      continue;
+    result.push_back(program[i]);
+    if (tchecker::details::is_jump(program[i].code[0]))
+      result.back().target = new_index[program[i].target];
+  }
+  program.swap(result);
+}
+
+/*!
+ \brief Compute jump targets
+ \param program : decoded bytecode
+ \return vector of booleans that tells, for every instruction in program,
+ if it is the target of a jump
+ */
+static std::vector<bool> jump_targets(tchecker::details::program_t const & program)
+{
+  std::vector<bool> targets(program.size(), false);
+  for (tchecker::details::decoded_instruction_t const & instr : program)
+    if (tchecker::details::is_jump(instr.code[0]))
+      targets[instr.target] = true;
+  return targets;
+}
+
+/*!
+ \brief Evaluate an arithmetic or logical instruction on constants
+ \param instruction : an instruction
+ \param left : left operand
+ \param right : right operand
+ \param result : result
+ \return true if instruction is a binary arithmetic or logical instruction,
+ left and right are integers, and (left instruction right) is an integer
+ stored in result, false otherwise
+ */
+static bool evaluate(tchecker::bytecode_t instruction, tchecker::bytecode_t left, tchecker::bytecode_t right,
+                     tchecker::bytecode_t & result)
+{
+  auto is_integer = [](tchecker::bytecode_t v) {
+    return (v >= std::numeric_limits<tchecker::integer_t>::min()) && (v <= std::numeric_limits<tchecker::integer_t>::max());
+  };
+  if (!is_integer(left) || !is_integer(right))
+    return false;
+
+  switch (instruction) {
+  case tchecker::VM_LAND:
+    result = (left && right);
+    break;
+  case tchecker::VM_MINUS:
+    result = left - right;
+    break;
+  case tchecker::VM_DIV:
+    if (right == 0)
+      return false;
+    result = left / right;
+    break;
+  case tchecker::VM_EQ:
+    result = (left == right);
+    break;
+  case tchecker::VM_GE:
+    result = (left >= right);
+    break;
+  case tchecker::VM_GT:
+    result = (left > right);
+    break;
+  case tchecker::VM_LT:
+    result = (left < right);
+    break;
+  case tchecker::VM_LE:
+    result = (left <= right);
+    break;
+  case tchecker::VM_MUL:
+    result = left * right;
+    break;
+  case tchecker::VM_MOD:
+    if (right == 0)
+      return false;
+    result = left % right;
+    break;
+  case tchecker::VM_NE:
+    result = (left != right);
+    break;
+  case tchecker::VM_SUM:
+    result = left + right;
+    break;
+  default:
+    return false;
+  }
+  return is_integer(result);
+}
+
+/*!
+ \brief Constant folding and peephole optimizations
+ \param program : decoded bytecode
+ \return true if program has been modified, false otherwise
+ \post sequences of instructions without jump target inside have been
+ simplified: arithmetic and logical instructions on constants are folded, range
+ checks on constants are removed, conditional jumps on constants are replaced
+ by an unconditional jump or removed, and no-operations and jumps to the next
+ instruction are removed
+ */
+static bool fold(tchecker::details::program_t & program)
+{
+  std::vector<bool> const targets = tchecker::details::jump_targets(program);
+  std::vector<bool> removed(program.size(), false);
+  bool modified = false;
+
+  auto is_push = [&](std::size_t i) { return program[i].code[0] == tchecker::VM_PUSH; };
+
+  for (std::size_t i = 0; i + 1 < program.size(); ++i) {
+    tchecker::bytecode_t const op = program[i].code[0];
+
+    if (op == tchecker::VM_NOP || (op == tchecker::VM_JMP && program[i].target == i + 1)) {
+      removed[i] = modified = true;
+      continue;
+    }
+
+    if (!is_push(i) || targets[i + 1])
+      continue;
+    tchecker::bytecode_t const v = program[i].code[1];
+    tchecker::bytecode_t const next = program[i + 1].code[0];
+    tchecker::bytecode_t result;
+
+    // PUSH v NEG / PUSH v LNOT -> PUSH result
+    if ((next == tchecker::VM_NEG && tchecker::details::evaluate(tchecker::VM_MINUS, 0, v, result)) ||
+        (next == tchecker::VM_LNOT && tchecker::details::evaluate(tchecker::VM_EQ, v, 0, result))) {
+      program[i].code[1] = result;
+      removed[i + 1] = modified = true;
+      ++i;
+    }
+    // PUSH v FAILNOTIN l h -> PUSH v   if l <= v <= h
+    else if (next == tchecker::VM_FAILNOTIN && program[i + 1].code[1] <= v && v <= program[i + 1].code[2]) {
+      removed[i + 1] = modified = true;
+      ++i;
+    }
+    // PUSH v JMPZ n -> JMP n   if v == 0, nothing otherwise
+    else if (next == tchecker::VM_JMPZ) {
+      if (v == 0)
+        program[i] = {{tchecker::VM_JMP, 0}, program[i + 1].target};
+      else
+        removed[i] = true;
+      removed[i + 1] = modified = true;
+      ++i;
+    }
+    // PUSH v1 PUSH v2 op -> PUSH result
+    else if (i + 2 < program.size() && is_push(i + 1) && !targets[i + 2] &&
+             tchecker::details::evaluate(program[i + 2].code[0], v, program[i + 1].code[1], result)) {
+      program[i].code[1] = result;
+      removed[i + 1] = removed[i + 2] = modified = true;
+      i += 2;
+    }
+  }
+
+  if (modified)
+    tchecker::details::erase(program, removed);
+  return modified;
+}
+
+/*!
+ \brief Type of intervals of values
+ */
+struct interval_t {
+  bool known;             /*!< Whether the bounds are known */
+  tchecker::bytecode_t lo; /*!< Lower bound */
+  tchecker::bytecode_t hi; /*!< Upper bound */
+};
+
+/*!
+ \brief Range-check elimination
+ \param program : decoded bytecode
+ \param domains : domain of each bounded integer variable (flattened)
+ \return true if program has been modified, false otherwise
+ \post VM_FAILNOTIN instructions that are statically known to succeed from
+ the domains of the integer variables have been removed
+ \note values are tracked in sequences of instructions without jump target
+ */
+static bool eliminate_range_checks(tchecker::details::program_t & program,
+                                   std::vector<std::pair<tchecker::integer_t, tchecker::integer_t>> const & domains)
+{
+  using interval_t = tchecker::details::interval_t;
+  interval_t const unknown{false, 0, 0};
+  auto exact = [](tchecker::bytecode_t v) { return interval_t{true, v, v}; };
+  auto boolean = interval_t{true, 0, 1};
+  auto fits = [](interval_t const & i) {
+    return i.known && i.lo >= std::numeric_limits<tchecker::integer_t>::min() &&
+           i.hi <= std::numeric_limits<tchecker::integer_t>::max();
+  };
+
+  std::vector<bool> const targets = tchecker::details::jump_targets(program);
+  std::vector<bool> removed(program.size(), false);
+  bool modified = false;
+
+  // abstract stack: values below the bottom of the stack are unknown
+  std::vector<interval_t> stack;
+  auto pop = [&]() {
+    if (stack.empty())
+      return unknown;
+    interval_t i = stack.back();
+    stack.pop_back();
+    return i;
+  };
+  // union of the domains of the variables in id
+  auto variable = [&](interval_t const & id) {
+    if (!id.known || id.lo < 0 || id.hi >= static_cast<tchecker::bytecode_t>(domains.size()))
+      return unknown;
+    interval_t value{true, domains[id.lo].first, domains[id.lo].second};
+    for (tchecker::bytecode_t k = id.lo + 1; k <= id.hi; ++k) {
+      value.lo = std::min<tchecker::bytecode_t>(value.lo, domains[k].first);
+      value.hi = std::max<tchecker::bytecode_t>(value.hi, domains[k].second);
+    }
+    return value;
+  };
+
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    if (targets[i])
+      stack.clear();
+
+    std::vector<tchecker::bytecode_t> const & code = program[i].code;
+    switch (code[0]) {
+    case tchecker::VM_PUSH:
+      stack.push_back(exact(code[1]));
+      break;
+    case tchecker::VM_VALUEAT:
+      stack.push_back(variable(pop()));
+      break;
+    case tchecker::VM_PUSH_VALUEAT:
+      stack.push_back(variable(exact(code[1])));
+      break;
+    case tchecker::VM_VALUEAT_FRAME:
+      pop();
+      stack.push_back(unknown);
+      break;
+    case tchecker::VM_FAILNOTIN: {
+      interval_t const top = pop();
+      if (top.known && code[1] <= top.lo && top.hi <= code[2])
+        removed[i] = modified = true;
+      // the value is within bounds after the check
+      stack.push_back(top.known ? interval_t{true, std::max(top.lo, code[1]), std::min(top.hi, code[2])}
+                                : interval_t{true, code[1], code[2]});
+      break;
+    }
+    case tchecker::VM_SUM:
+    case tchecker::VM_MINUS:
+    case tchecker::VM_MUL: {
+      interval_t const r = pop();
+      interval_t const l = pop();
+      interval_t result = unknown;
+      if (fits(l) && fits(r)) {
+        if (code[0] == tchecker::VM_SUM)
+          result = interval_t{true, l.lo + r.lo, l.hi + r.hi};
+        else if (code[0] == tchecker::VM_MINUS)
+          result = interval_t{true, l.lo - r.hi, l.hi - r.lo};
+        else {
+          std::initializer_list<tchecker::bytecode_t> const p = {l.lo * r.lo, l.lo * r.hi, l.hi * r.lo, l.hi * r.hi};
+          result = interval_t{true, std::min(p), std::max(p)};
+        }
+        if (!fits(result))
+          result = unknown;
+      }
+      stack.push_back(result);
+      break;
+    }
+    case tchecker::VM_DIV:
+    case tchecker::VM_MOD: {
+      interval_t const r = pop();
+      interval_t const l = pop();
+      interval_t result = unknown;
+      // only divisions by a positive constant, which are monotonic and do not overflow
+      if (fits(l) && fits(r) && r.lo == r.hi && r.lo > 0) {
+        if (code[0] == tchecker::VM_DIV)
+          result = interval_t{true, l.lo / r.lo, l.hi / r.lo};
+        else
+          result = interval_t{true, (l.lo < 0 ? -(r.lo - 1) : 0), (l.hi > 0 ? r.lo - 1 : 0)};
+      }
+      stack.push_back(result);
+      break;
+    }
+    case tchecker::VM_LAND:
+    case tchecker::VM_EQ:
+    case tchecker::VM_GE:
+    case tchecker::VM_GT:
+    case tchecker::VM_LT:
+    case tchecker::VM_LE:
+    case tchecker::VM_NE:
+      pop();
+      pop();
+      stack.push_back(boolean);
+      break;
+    case tchecker::VM_NEG: {
+      interval_t const v = pop();
+      stack.push_back(fits(v) && fits(interval_t{true, -v.hi, -v.lo}) ? interval_t{true, -v.hi, -v.lo} : unknown);
+      break;
+    }
+    case tchecker::VM_LNOT:
+      pop();
+      stack.push_back(boolean);
+      break;
+    case tchecker::VM_PUSH_VALUEAT_CMP:
+      stack.push_back(boolean);
+      break;
+    case tchecker::VM_ASSIGN:
+    case tchecker::VM_ASSIGN_FRAME:
+    case tchecker::VM_INIT_FRAME:
+      pop();
+      pop();
+      break;
+    case tchecker::VM_CLKCONSTR:
+    case tchecker::VM_CLKRESET:
+      pop();
+      pop();
+      pop();
+      break;
+    case tchecker::VM_JMPZ:
+      pop();
+      break;
+    case tchecker::VM_JMP:
+    case tchecker::VM_RET:
+      stack.clear(); // next instruction is only reachable by a jump
+      break;
+    default: // VM_RETZ, VM_PUSH_FRAME, VM_POP_FRAME, VM_CLKCONSTR_CONST, VM_CLKRESET_CONST, VM_NOP
+      break;
+    }
+  }
+
+  if (modified)
+    tchecker::details::erase(program, removed);
+  return modified;
+}
+
+/*!
+ \brief Jump threading
+ \param program : decoded bytecode
+ \return true if program has been modified, false otherwise
+ \post jumps to an unconditional jump have been redirected to the final
+ target
+ */
+static bool thread_jumps(tchecker::details::program_t & program)
+{
+  bool modified = false;
+  for (tchecker::details::decoded_instruction_t & instr : program) {
+    if (!tchecker::details::is_jump(instr.code[0]))
+      continue;
+    std::size_t target = instr.target;
+    for (std::size_t n = 0; n < program.size() && program[target].code[0] == tchecker::VM_JMP; ++n)
+      target = program[target].target;
+    // leave cycles of jumps unchanged
+    if (target != instr.target && program[target].code[0] != tchecker::VM_JMP) {
+      instr.target = target;
+      modified = true;
+    }
+  }
+  return modified;
+}
+
+/*!
+ \brief Dead code elimination
+ \param program : decoded bytecode
+ \return true if program has been modified, false otherwise
+ \post instructions that are not reachable from the first instruction have
+ been removed
+ */
+static bool eliminate_dead_code(tchecker::details::program_t & program)
+{
+  std::vector<bool> reachable(program.size(), false);
+  std::vector<std::size_t> waiting{0};
+  while (!waiting.empty()) {
+    std::size_t i = waiting.back();
+    waiting.pop_back();
+    if (i >= program.size() || reachable[i])
+      continue;
+    reachable[i] = true;
+    tchecker::bytecode_t const op = program[i].code[0];
+    if (tchecker::details::is_jump(op))
+      waiting.push_back(program[i].target);
+    if (op != tchecker::VM_JMP && op != tchecker::VM_RET)
+      waiting.push_back(i + 1);
+  }
+
+  // keep the last VM_RET to preserve null-termination
+  reachable.back() = true;
+
+  std::vector<bool> removed(program.size());
+  bool modified = false;
+  for (std::size_t i = 0; i < program.size(); ++i) {
+    removed[i] = !reachable[i];
+    modified |= removed[i];
+  }
+  if (modified)
+    tchecker::details::erase(program, removed);
+  return modified;
+}
+
+} // end of namespace details
+
+tchecker::bytecode_t * optimize(tchecker::bytecode_t const * bytecode, tchecker::integer_variables_t const & intvars)
+{
+  std::vector<std::pair<tchecker::integer_t, tchecker::integer_t>> domains;
+  for (auto && [id, name] : intvars.index()) {
+    tchecker::intvar_info_t const & info = intvars.info(id);
+    if (domains.size() < id + info.size())
+      domains.resize(id + info.size(), {std::numeric_limits<tchecker::integer_t>::min(),
+                                        std::numeric_limits<tchecker::integer_t>::max()});
+    for (tchecker::intvar_id_t k = id; k < id + info.size(); ++k)
+      domains[k] = {info.min(), info.max()};
+  }
+
+  tchecker::details::program_t program = tchecker::details::decode(bytecode);
+
+  bool modified = true;
+  while (modified) {
+    modified = tchecker::details::fold(program);
+    modified |= tchecker::details::eliminate_range_checks(program, domains);
+    modified |= tchecker::details::thread_jumps(program);
+    modified |= tchecker::details::eliminate_dead_code(program);
+  }
+
+  return tchecker::details::encode(program);
+}
+
 } // end of namespace tchecker
@@ -0,0 +1,577 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TCHECKER_NATIVE_CODE
+#include <cerrno>
+#include <dlfcn.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char ** environ;
+#endif
+
+#include "tchecker/vm/native.hh"
+
+namespace tchecker {
+
+static_assert(std::is_same<tchecker::clock_id_t, std::uint32_t>::value &&
+                  std::is_same<tchecker::intvar_id_t, std::uint32_t>::value,
+              "native environment expects 32 bits unsigned variable identifiers");
+
+namespace details {
+
+/*!
+ \brief Errors reported by native functions
+ */
+enum native_error_t {
+  NATIVE_OUT_OF_RANGE = 0,    /*!< Value out of the bounds of VM_FAILNOTIN */
+  NATIVE_VALUE_OUT_OF_BOUNDS, /*!< Value that does not fit its type */
+};
+
+/*!
+ \brief C++ literal
+ \param v : a value
+ \return C++ expression of type std::int64_t with value v
+ */
+static std::string literal(std::int64_t v)
+{
+  if (v == std::numeric_limits<std::int64_t>::min())
+    return "(-INT64_C(" + std::to_string(std::numeric_limits<std::int64_t>::max()) + ") - 1)";
+  return "INT64_C(" + std::to_string(v) + ")";
+}
+
+/*!
+ \brief C++ operator
+ \param instruction : a binary instruction
+ \return C++ operator corresponding to instruction, or nullptr if instruction
+ is not a binary instruction
+ */
+static char const * binary_operator(tchecker::bytecode_t instruction)
+{
+  switch (instruction) {
+  case VM_LAND:
+    return "&&";
+  case VM_MINUS:
+    return "-";
+  case VM_DIV:
+    return "/";
+  case VM_EQ:
+    return "==";
+  case VM_GE:
+    return ">=";
+  case VM_GT:
+    return ">";
+  case VM_LT:
+    return "<";
+  case VM_LE:
+    return "<=";
+  case VM_MUL:
+    return "*";
+  case VM_MOD:
+    return "%";
+  case VM_NE:
+    return "!=";
+  case VM_SUM:
+    return "+";
+  default:
+    return nullptr;
+  }
+}
+
+/*!
+ \brief Stack heights
+ \param bytecode : sequence of bytecode instructions
+ \param heights : map from positions of instructions to stack heights
+ \param targets : positions of jump targets
+ \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+ \post heights maps the position of each reachable instruction in bytecode to
+ the height of the stack before it is interpreted, and targets contains the
+ positions of the jump targets
+ \return true if stack heights are the same along all paths to each
+ instruction and bytecode does not access local variables, false otherwise
+ */
+static bool stack_heights(tchecker::bytecode_t const * bytecode, std::map<std::size_t, std::size_t> & heights,
+                          std::vector<std::size_t> & targets)
+{
+  std::size_t size = 0;
+  for (bool stop = false; !stop; size += tchecker::instruction_size(bytecode + size))
+    stop = (bytecode[size] == VM_RET);
+
+  std::vector<std::pair<std::size_t, std::size_t>> waiting{{0, 0}}; // (position, height)
+  while (!waiting.empty()) {
+    auto [pos, height] = waiting.back();
+    waiting.pop_back();
+
+    auto it = heights.find(pos);
+    if (it != heights.end()) {
+      if (it->second != height)
+        return false;
+      continue;
+    }
+    heights[pos] = height;
+
+    tchecker::bytecode_t const * instr = bytecode + pos;
+    std::size_t const next = pos + tchecker::instruction_size(instr);
+    std::size_t pops = 0, pushes = 0;
+    bool fallthrough = true;
+
+    switch (*instr) {
+    case VM_RET:
+      pops = 1;
+      fallthrough = false;
+      break;
+    case VM_RETZ:
+    case VM_FAILNOTIN:
+    case VM_VALUEAT:
+    case VM_NEG:
+    case VM_LNOT:
+      pops = pushes = 1;
+      break;
+    case VM_JMP:
+    case VM_JMPZ: {
+      tchecker::bytecode_t const target = static_cast<tchecker::bytecode_t>(next) + instr[1];
+      if (target < 0 || target >= static_cast<tchecker::bytecode_t>(size))
+        return false;
+      pops = (*instr == VM_JMPZ ? 1 : 0);
+      if (height < pops)
+        return false;
+      waiting.emplace_back(static_cast<std::size_t>(target), height - pops);
+      targets.push_back(static_cast<std::size_t>(target));
+      fallthrough = (*instr == VM_JMPZ);
+      break;
+    }
+    case VM_PUSH:
+    case VM_PUSH_VALUEAT:
+    case VM_PUSH_VALUEAT_CMP:
+      pushes = 1;
+      break;
+    case VM_ASSIGN:
+      pops = 2;
+      break;
+    case VM_CLKCONSTR:
+    case VM_CLKRESET:
+      pops = 3;
+      break;
+    case VM_CLKCONSTR_CONST:
+    case VM_CLKRESET_CONST:
+    case VM_NOP:
+      break;
+    default:
+      if (binary_operator(*instr) == nullptr)
+        return false; // local variables
+      pops = 2;
+      pushes = 1;
+      break;
+    }
+
+    if (height < pops)
+      return false;
+    if (fallthrough) {
+      if (next >= size)
+        return false;
+      waiting.emplace_back(next, height - pops + pushes);
+    }
+  }
+  return true;
+}
+
+/*!
+ \brief Hash
+ \param s : a string
+ \return FNV-1a hash of s
+ \note unlike std::hash, stable across runs and platforms
+ */
+static std::uint64_t hash(std::string const & s)
+{
+  std::uint64_t h = 14695981039346656037ULL;
+  for (char c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/*!
+ \brief Output a clock constraint from native code
+ */
+static void push_clkconstr(void * clkconstr, std::uint32_t id1, std::uint32_t id2, int cmp, std::int64_t bound)
+{
+  static_cast<tchecker::clock_constraint_container_t *>(clkconstr)->emplace_back(
+      id1, id2, (cmp == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE),
+      static_cast<tchecker::integer_t>(bound));
+}
+
+/*!
+ \brief Output a clock reset from native code
+ */
+static void push_clkreset(void * clkreset, std::uint32_t id1, std::uint32_t id2, std::int64_t value)
+{
+  static_cast<tchecker::clock_reset_container_t *>(clkreset)->emplace_back(id1, id2, static_cast<tchecker::integer_t>(value));
+}
+
+/*!
+ \brief Report an error from native code
+ \throw std::out_of_range or std::runtime_error : same exception as the VM
+ */
+[[noreturn]] static void fail(int error, std::int64_t value, std::int64_t min, std::int64_t max)
+{
+  if (error == tchecker::details::NATIVE_OUT_OF_RANGE) {
+    std::stringstream ss;
+    ss << value << " out of [" << min << ", " << max << "]";
+    throw std::out_of_range("out-of-bounds value: " + ss.str());
+  }
+  throw std::runtime_error("vm_t::run, value out-of-bounds");
+}
+
+#ifdef TCHECKER_NATIVE_CODE
+/*!
+ \brief Create a directory and its parents
+ \param dir : path to a directory
+ \post missing directories on the path to dir have been created, accessible to
+ the current user only
+ \throw std::runtime_error : if dir cannot be created
+ */
+static void make_directories(std::string const & dir)
+{
+  for (std::size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+    std::string const prefix = dir.substr(0, pos);
+    struct stat st;
+    if (::stat(prefix.c_str(), &st) != 0 && ::mkdir(prefix.c_str(), 0700) != 0 && ::stat(prefix.c_str(), &st) != 0)
+      throw std::runtime_error("cannot create directory " + prefix);
+    if (pos == std::string::npos)
+      break;
+  }
+}
+
+/*!
+ \brief Check that a file can be trusted
+ \param path : path to a file
+ \param directory : true if path is expected to be a directory, false if it is
+ expected to be a regular file
+ \throw std::runtime_error : if path does not exist, is not of the expected
+ type (symbolic links to regular files are rejected), is not owned by the
+ current user, or is writable by group or others
+ \note code loaded from a file that can be modified by another user would run
+ with the privileges of the current user
+ */
+static void check_private(std::string const & path, bool directory)
+{
+  struct stat st;
+  if ((directory ? ::stat(path.c_str(), &st) : ::lstat(path.c_str(), &st)) != 0)
+    throw std::runtime_error("cannot access " + path);
+  if ((directory ? !S_ISDIR(st.st_mode) : !S_ISREG(st.st_mode)) || st.st_uid != ::geteuid() ||
+      (st.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+    throw std::runtime_error("native code cache is not private: " + path +
+                             " should be owned by the current user and not writable by group or others");
+}
+
+/*!
+ \brief Run a command
+ \param args : command name followed by its arguments
+ \return exit status of the command, -1 if it could not be run or did not
+ terminate normally
+ \note the command is run without a shell, hence arguments are not subject to
+ word splitting or expansion. The command name is searched in PATH
+ */
+static int run_command(std::vector<std::string> const & args)
+{
+  std::vector<char *> argv;
+  for (std::string const & arg : args)
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  argv.push_back(nullptr);
+
+  pid_t pid;
+  if (argv[0] == nullptr || ::posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0)
+    return -1;
+  int status;
+  while (::waitpid(pid, &status, 0) == -1)
+    if (errno != EINTR)
+      return -1;
+  return (WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+#endif // TCHECKER_NATIVE_CODE
+
+} // end of namespace details
+
+void emit_native_prelude(std::ostream & os)
+{
+  using limits = std::numeric_limits<tchecker::integer_t>;
+
+  os << "#include <cstdint>" << std::endl << std::endl;
+  os << "typedef std::int" << 8 * sizeof(tchecker::integer_t) << "_t tck_integer_t;" << std::endl << std::endl;
+  os << "struct tck_env_t {" << std::endl
+     << "  void * clkconstr;" << std::endl
+     << "  void * clkreset;" << std::endl
+     << "  void (*push_clkconstr)(void *, std::uint32_t, std::uint32_t, int, std::int64_t);" << std::endl
+     << "  void (*push_clkreset)(void *, std::uint32_t, std::uint32_t, std::int64_t);" << std::endl
+     << "  void (*fail)(int, std::int64_t, std::int64_t, std::int64_t);" << std::endl
+     << "};" << std::endl
+     << std::endl;
+  os << "static inline tck_integer_t tck_integer(std::int64_t v, tck_env_t * env)" << std::endl
+     << "{" << std::endl
+     << "  if (v < " << tchecker::details::literal(limits::min()) << " || v > " << tchecker::details::literal(limits::max())
+     << ")" << std::endl
+     << "    env->fail(" << tchecker::details::NATIVE_VALUE_OUT_OF_BOUNDS << ", v, 0, 0);" << std::endl
+     << "  return static_cast<tck_integer_t>(v);" << std::endl
+     << "}" << std::endl
+     << std::endl;
+  os << "static inline std::uint32_t tck_id(std::int64_t v, tck_env_t * env)" << std::endl
+     << "{" << std::endl
+     << "  if (v < 0 || v > INT64_C(" << std::numeric_limits<std::uint32_t>::max() << "))" << std::endl
+     << "    env->fail(" << tchecker::details::NATIVE_VALUE_OUT_OF_BOUNDS << ", v, 0, 0);" << std::endl
+     << "  return static_cast<std::uint32_t>(v);" << std::endl
+     << "}" << std::endl
+     << std::endl;
+}
+
+bool emit_native_function(std::ostream & os, std::string const & name, tchecker::bytecode_t const * bytecode)
+{
+  std::map<std::size_t, std::size_t> heights;
+  std::vector<std::size_t> targets;
+  if (!tchecker::details::stack_heights(bytecode, heights, targets))
+    return false;
+
+  std::size_t depth = 0;
+  for (auto && [pos, height] : heights) {
+    tchecker::bytecode_t const instr = bytecode[pos];
+    bool const push = (instr == VM_PUSH || instr == VM_PUSH_VALUEAT || instr == VM_PUSH_VALUEAT_CMP);
+    depth = std::max(depth, height + (push ? 1 : 0));
+  }
+
+  // stack slot at height h
+  auto s = [](std::size_t h) { return "s" + std::to_string(h); };
+
+  os << "extern \"C\" tck_integer_t " << name << "(tck_integer_t * intval, tck_env_t * env)" << std::endl;
+  os << "{" << std::endl;
+  for (std::size_t h = 0; h < depth; ++h)
+    os << "  std::int64_t " << s(h) << ";" << std::endl;
+
+  for (auto && [pos, height] : heights) {
+    tchecker::bytecode_t const * instr = bytecode + pos;
+    std::string const top = (height > 0 ? s(height - 1) : ""), below = (height > 1 ? s(height - 2) : "");
+
+    if (std::find(targets.begin(), targets.end(), pos) != targets.end())
+      os << "L" << pos << ":" << std::endl;
+
+    switch (*instr) {
+    case VM_RET:
+      os << "  return tck_integer(" << top << ", env);" << std::endl;
+      break;
+    case VM_RETZ:
+      os << "  if (tck_integer(" << top << ", env) == 0)" << std::endl << "    return 0;" << std::endl;
+      break;
+    case VM_FAILNOTIN:
+      os << "  if (" << top << " < " << tchecker::details::literal(instr[1]) << " || " << top << " > "
+         << tchecker::details::literal(instr[2]) << ")" << std::endl
+         << "    env->fail(" << tchecker::details::NATIVE_OUT_OF_RANGE << ", " << top << ", "
+         << tchecker::details::literal(instr[1]) << ", " << tchecker::details::literal(instr[2]) << ");" << std::endl;
+      break;
+    case VM_JMP:
+      os << "  goto L" << pos + 2 + instr[1] << ";" << std::endl;
+      break;
+    case VM_JMPZ:
+      os << "  if (tck_integer(" << top << ", env) == 0)" << std::endl
+         << "    goto L" << pos + 2 + instr[1] << ";" << std::endl;
+      break;
+    case VM_PUSH:
+      os << "  " << s(height) << " = " << tchecker::details::literal(instr[1]) << ";" << std::endl;
+      break;
+    case VM_VALUEAT:
+      os << "  " << top << " = intval[tck_id(" << top << ", env)];" << std::endl;
+      break;
+    case VM_ASSIGN:
+      os << "  intval[tck_id(" << below << ", env)] = tck_integer(" << top << ", env);" << std::endl;
+      break;
+    case VM_NEG:
+      os << "  " << top << " = -tck_integer(" << top << ", env);" << std::endl;
+      break;
+    case VM_LNOT:
+      os << "  " << top << " = !tck_integer(" << top << ", env);" << std::endl;
+      break;
+    case VM_CLKCONSTR:
+      os << "  env->push_clkconstr(env->clkconstr, tck_id(" << s(height - 3) << ", env), tck_id(" << below << ", env), "
+         << instr[1] << ", tck_integer(" << top << ", env));" << std::endl;
+      break;
+    case VM_CLKRESET:
+      os << "  env->push_clkreset(env->clkreset, tck_id(" << s(height - 3) << ", env), tck_id(" << below
+         << ", env), tck_integer(" << top << ", env));" << std::endl;
+      break;
+    case VM_PUSH_VALUEAT:
+      os << "  " << s(height) << " = intval[" << instr[1] << "];" << std::endl;
+      break;
+    case VM_PUSH_VALUEAT_CMP:
+      os << "  " << s(height) << " = (intval[" << instr[1] << "] " << tchecker::details::binary_operator(instr[3]) << " "
+         << tchecker::details::literal(instr[2]) << ");" << std::endl;
+      break;
+    case VM_CLKCONSTR_CONST:
+      os << "  env->push_clkconstr(env->clkconstr, " << instr[1] << "u, " << instr[2] << "u, " << instr[4] << ", "
+         << tchecker::details::literal(instr[3]) << ");" << std::endl;
+      break;
+    case VM_CLKRESET_CONST:
+      os << "  env->push_clkreset(env->clkreset, " << instr[1] << "u, " << instr[2] << "u, "
+         << tchecker::details::literal(instr[3]) << ");" << std::endl;
+      break;
+    case VM_NOP:
+      break;
+    default: // binary operators
+      os << "  " << below << " = static_cast<tck_integer_t>(tck_integer(" << below << ", env) "
+         << tchecker::details::binary_operator(*instr) << " tck_integer(" << top << ", env));" << std::endl;
+      break;
+    }
+  }
+
+  os << "}" << std::endl << std::endl;
+  return true;
+}
+
+tchecker::integer_t run_native(tchecker::native_function_t f, tchecker::intvars_valuation_t & intval,
+                               tchecker::clock_constraint_container_t & clkconstr,
+                               tchecker::clock_reset_container_t & clkreset)
+{
+  tchecker::native_environment_t env{&clkconstr, &clkreset, tchecker::details::push_clkconstr,
+                                     tchecker::details::push_clkreset, tchecker::details::fail};
+  return f(intval.ptr(), &env);
+}
+
+/* native_library_t */
+
+#ifdef TCHECKER_NATIVE_CODE
+
+native_library_t::native_library_t(std::vector<tchecker::bytecode_t const *> const & programs, std::string const & cache_dir,
+                                   std::string const & compiler)
+    : _handle(nullptr), _functions(programs.size(), nullptr)
+{
+  std::vector<std::string> args;
+  std::istringstream words(compiler + " -std=c++11 -O2 -fPIC -shared -w");
+  for (std::string word; words >> word;)
+    args.push_back(word);
+  std::string command;
+  for (std::string const & arg : args)
+    command += (command.empty() ? "" : " ") + arg;
+
+  std::stringstream source;
+  source << "// Generated by TChecker, compiled with: " << command << std::endl << std::endl;
+  tchecker::emit_native_prelude(source);
+  std::vector<bool> translated(programs.size(), false);
+  for (std::size_t k = 0; k < programs.size(); ++k)
+    translated[k] = tchecker::emit_native_function(source, "tchecker_native_" + std::to_string(k), programs[k]);
+
+  std::stringstream basename;
+  basename << cache_dir << "/tchecker-native-" << std::hex << tchecker::details::hash(source.str());
+  _path = basename.str() + ".so";
+
+  tchecker::details::make_directories(cache_dir);
+  tchecker::details::check_private(cache_dir, true);
+
+  if (::access(_path.c_str(), R_OK) != 0) {
+    // build in temporary files renamed when complete, as several processes may share cache_dir
+    std::string const tmp = basename.str() + "." + std::to_string(::getpid());
+    std::ofstream ofs(tmp + ".cc");
+    ofs << source.str();
+    ofs.close();
+    if (!ofs)
+      throw std::runtime_error("cannot write native code to " + tmp + ".cc");
+
+    args.insert(args.end(), {"-o", tmp + ".so", tmp + ".cc"});
+    if (tchecker::details::run_command(args) != 0) {
+      std::remove((tmp + ".cc").c_str());
+      std::remove((tmp + ".so").c_str());
+      throw std::runtime_error("compilation of native code failed: " + command + " -o " + tmp + ".so " + tmp + ".cc");
+    }
+    std::rename((tmp + ".cc").c_str(), (basename.str() + ".cc").c_str());
+    if (std::rename((tmp + ".so").c_str(), _path.c_str()) != 0)
+      throw std::runtime_error("cannot store native code to " + _path);
+  }
+
+  tchecker::details::check_private(_path, false);
+
+  _handle = ::dlopen(_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (_handle == nullptr)
+    throw std::runtime_error("cannot load native code: " + std::string(::dlerror()));
+
+  for (std::size_t k = 0; k < programs.size(); ++k) {
+    if (!translated[k])
+      continue;
+    void * f = ::dlsym(_handle, ("tchecker_native_" + std::to_string(k)).c_str());
+    if (f == nullptr) {
+      ::dlclose(_handle);
+      throw std::runtime_error("cannot load native code: " + std::string(::dlerror()));
+    }
+    _functions[k] = reinterpret_cast<tchecker::native_function_t>(f);
+  }
+}
+
+native_library_t::~native_library_t()
+{
+  if (_handle != nullptr)
+    ::dlclose(_handle);
+}
+
+#else
+
+native_library_t::native_library_t(std::vector<tchecker::bytecode_t const *> const & programs, std::string const & cache_dir,
+                                   std::string const & compiler)
+    : _handle(nullptr)
+{
+  throw std::runtime_error("native code is not supported on this platform");
+}
+
+native_library_t::~native_library_t() = default;
+
+#endif // TCHECKER_NATIVE_CODE
+
+tchecker::native_function_t native_library_t::function(std::size_t k) const
+{
+  assert(k < _functions.size());
+  return _functions[k];
+}
+
+std::string const & native_library_t::path() const { return _path; }
+
+/* Configuration */
+
+bool native_code_requested()
+{
+  char const * value = std::getenv("TCHECKER_NATIVE");
+  return (value != nullptr) && (std::string(value) != "") && (std::string(value) != "0");
+}
+
+std::string native_cache_directory()
+{
+  char const * dir = std::getenv("TCHECKER_NATIVE_CACHE");
+  if (dir != nullptr && *dir != '\0')
+    return dir;
+  char const * xdg = std::getenv("XDG_CACHE_HOME");
+  if (xdg != nullptr && *xdg == '/')
+    return std::string(xdg) + "/tchecker";
+  char const * home = std::getenv("HOME");
+  if (home != nullptr && *home != '\0')
+    return std::string(home) + "/.cache/tchecker";
+  throw std::runtime_error("no directory for cached native code: set TCHECKER_NATIVE_CACHE, XDG_CACHE_HOME or HOME");
+}
+
+std::string native_compiler()
+{
+  char const * cxx = std::getenv("TCHECKER_NATIVE_CXX");
+  return (cxx != nullptr && *cxx != '\0' ? cxx : "c++");
+}
+
+} // end of namespace tchecker
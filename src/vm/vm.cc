@@ -5,7 +5,11 @@
  *
  */
 
+#include <algorithm>
 #include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "tchecker/vm/vm.hh"
@@ -154,6 +158,26 @@ size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * byteco
     os << "ASSIGN_FRAME";
     break;
 
+  case VM_PUSH_VALUEAT:
+    os << "PUSH_VALUEAT " << bytecode[1];
+    res++;
+    break;
+
+  case VM_PUSH_VALUEAT_CMP:
+    os << "PUSH_VALUEAT_CMP " << bytecode[1] << " " << bytecode[2] << " " << bytecode[3];
+    res += 3;
+    break;
+
+  case VM_CLKCONSTR_CONST:
+    os << "CLKCONSTR_CONST " << bytecode[1] << " " << bytecode[2] << " " << bytecode[3] << " " << bytecode[4];
+    res += 4;
+    break;
+
+  case VM_CLKRESET_CONST:
+    os << "CLKRESET_CONST " << bytecode[1] << " " << bytecode[2] << " " << bytecode[3];
+    res += 3;
+    break;
+
   default:
     throw std::runtime_error("incomplete switch statement");
   }
@@ -162,4 +186,417 @@ size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * byteco
   return res;
 }
 
+std::size_t instruction_size(tchecker::bytecode_t const * bytecode)
+{
+  switch (*bytecode) {
+  case VM_RET:
+  case VM_RETZ:
+  case VM_VALUEAT:
+  case VM_ASSIGN:
+  case VM_LAND:
+  case VM_MINUS:
+  case VM_DIV:
+  case VM_EQ:
+  case VM_GE:
+  case VM_GT:
+  case VM_LT:
+  case VM_LE:
+  case VM_MUL:
+  case VM_MOD:
+  case VM_NE:
+  case VM_SUM:
+  case VM_NEG:
+  case VM_LNOT:
+  case VM_CLKRESET:
+  case VM_PUSH_FRAME:
+  case VM_POP_FRAME:
+  case VM_VALUEAT_FRAME:
+  case VM_ASSIGN_FRAME:
+  case VM_INIT_FRAME:
+  case VM_NOP:
+    return 1;
+  case VM_JMP:
+  case VM_JMPZ:
+  case VM_PUSH:
+  case VM_CLKCONSTR:
+  case VM_PUSH_VALUEAT:
+    return 2;
+  case VM_FAILNOTIN:
+    return 3;
+  case VM_PUSH_VALUEAT_CMP:
+  case VM_CLKRESET_CONST:
+    return 4;
+  case VM_CLKCONSTR_CONST:
+    return 5;
+  default:
+    throw std::invalid_argument("unknown instruction");
+  }
+}
+
+/*!
+ \brief Check if an instruction is a comparison
+ \param instruction : an instruction
+ \return true if instruction is one of VM_EQ, VM_GE, VM_GT, VM_LT, VM_LE and
+ VM_NE, false otherwise
+ */
+static bool is_comparison(tchecker::bytecode_t instruction)
+{
+  return (instruction == VM_EQ) || (instruction == VM_GE) || (instruction == VM_GT) || (instruction == VM_LT) ||
+         (instruction == VM_LE) || (instruction == VM_NE);
+}
+
+/*!
+ \brief Check that a value can be represented by an integer type
+ \tparam T : integer type
+ \param val : value
+ \return true if val can be represented by type T, false otherwise
+ */
+template <class T> static bool fits(tchecker::bytecode_t val)
+{
+  return (val >= std::numeric_limits<T>::min()) && (val <= std::numeric_limits<T>::max());
+}
+
+tchecker::bytecode_t * fuse_superinstructions(tchecker::bytecode_t const * bytecode)
+{
+  // offsets of instructions and jump targets
+  std::vector<std::size_t> starts;
+  std::size_t size = 0;
+  for (bool stop = false; !stop; size += tchecker::instruction_size(bytecode + size)) {
+    stop = (bytecode[size] == VM_RET);
+    starts.push_back(size);
+  }
+
+  std::vector<bool> is_target(size, false);
+  for (std::size_t o : starts)
+    if (bytecode[o] == VM_JMP || bytecode[o] == VM_JMPZ) {
+      tchecker::bytecode_t const target = static_cast<tchecker::bytecode_t>(o) + 2 + bytecode[o + 1];
+      if (target < 0 || target >= static_cast<tchecker::bytecode_t>(size))
+        throw std::invalid_argument("jump out of bytecode");
+      is_target[target] = true;
+    }
+
+  // k-th instruction from position i, or VM_NOP if out of bytecode
+  auto op = [&](std::size_t i, std::size_t k) {
+    return (i + k < starts.size() ? bytecode[starts[i + k]] : static_cast<tchecker::bytecode_t>(VM_NOP));
+  };
+  // m-th parameter of k-th instruction from position i
+  auto param = [&](std::size_t i, std::size_t k, std::size_t m) { return bytecode[starts[i + k] + m]; };
+  // no jump lands inside the n instructions from position i
+  auto straight = [&](std::size_t i, std::size_t n) {
+    for (std::size_t k = 1; k < n; ++k)
+      if (is_target[starts[i + k]])
+        return false;
+    return true;
+  };
+
+  std::vector<tchecker::bytecode_t> fused;
+  std::vector<std::size_t> new_offset(size, 0);
+  std::vector<std::pair<std::size_t, std::size_t>> jumps; // new offset of jump, old offset of target
+
+  std::size_t i = 0;
+  while (i < starts.size()) {
+    new_offset[starts[i]] = fused.size();
+
+    // PUSH id1 PUSH id2 PUSH b [NEG] CLKCONSTR s -> CLKCONSTR_CONST id1 id2 b s
+    if (op(i, 0) == VM_PUSH && op(i, 1) == VM_PUSH && op(i, 2) == VM_PUSH) {
+      std::size_t const neg = (op(i, 3) == VM_NEG ? 1 : 0);
+      tchecker::bytecode_t const value = param(i, 2, 1);
+      tchecker::bytecode_t const bound = (neg && fits<tchecker::integer_t>(value) ? -value : value);
+      if (op(i, 3 + neg) == VM_CLKCONSTR && straight(i, 4 + neg) && fits<tchecker::clock_id_t>(param(i, 0, 1)) &&
+          fits<tchecker::clock_id_t>(param(i, 1, 1)) && fits<tchecker::integer_t>(value) && fits<tchecker::integer_t>(bound)) {
+        fused.insert(fused.end(), {VM_CLKCONSTR_CONST, param(i, 0, 1), param(i, 1, 1), bound, param(i, 3 + neg, 1)});
+        i += 4 + neg;
+        continue;
+      }
+    }
+
+    // PUSH id1 PUSH id2 PUSH v CLKRESET -> CLKRESET_CONST id1 id2 v
+    if (op(i, 0) == VM_PUSH && op(i, 1) == VM_PUSH && op(i, 2) == VM_PUSH && op(i, 3) == VM_CLKRESET && straight(i, 4) &&
+        fits<tchecker::clock_id_t>(param(i, 0, 1)) && fits<tchecker::clock_id_t>(param(i, 1, 1)) &&
+        fits<tchecker::integer_t>(param(i, 2, 1))) {
+      fused.insert(fused.end(), {VM_CLKRESET_CONST, param(i, 0, 1), param(i, 1, 1), param(i, 2, 1)});
+      i += 4;
+      continue;
+    }
+
+    // PUSH id VALUEAT PUSH v cmp -> PUSH_VALUEAT_CMP id v cmp
+    if (op(i, 0) == VM_PUSH && op(i, 1) == VM_VALUEAT && op(i, 2) == VM_PUSH && is_comparison(op(i, 3)) &&
+        straight(i, 4) && fits<tchecker::intvar_id_t>(param(i, 0, 1)) && fits<tchecker::integer_t>(param(i, 2, 1))) {
+      fused.insert(fused.end(), {VM_PUSH_VALUEAT_CMP, param(i, 0, 1), param(i, 2, 1), op(i, 3)});
+      i += 4;
+      continue;
+    }
+
+    // PUSH id VALUEAT -> PUSH_VALUEAT id
+    if (op(i, 0) == VM_PUSH && op(i, 1) == VM_VALUEAT && straight(i, 2) && fits<tchecker::intvar_id_t>(param(i, 0, 1))) {
+      fused.insert(fused.end(), {VM_PUSH_VALUEAT, param(i, 0, 1)});
+      i += 2;
+      continue;
+    }
+
+    if (op(i, 0) == VM_JMP || op(i, 0) == VM_JMPZ) {
+      tchecker::bytecode_t const target = static_cast<tchecker::bytecode_t>(starts[i]) + 2 + param(i, 0, 1);
+      jumps.emplace_back(fused.size(), static_cast<std::size_t>(target));
+    }
+    fused.insert(fused.end(), bytecode + starts[i], bytecode + starts[i] + tchecker::instruction_size(bytecode + starts[i]));
+    ++i;
+  }
+
+  // jumps are relative to the next instruction
+  for (auto && [offset, target] : jumps)
+    fused[offset + 1] = static_cast<tchecker::bytecode_t>(new_offset[target]) - static_cast<tchecker::bytecode_t>(offset + 2);
+
+  tchecker::bytecode_t * b = new tchecker::bytecode_t[fused.size()];
+  std::copy(fused.begin(), fused.end(), b);
+  return b;
+}
+
+/* vm_t */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TCHECKER_VM_THREADED_DISPATCH
+#endif
+
+tchecker::integer_t vm_t::run(tchecker::bytecode_t const * bytecode, tchecker::intvars_valuation_t & intval,
+                              tchecker::clock_constraint_container_t & clkconstr,
+                              tchecker::clock_reset_container_t & clkreset)
+{
+#ifdef TCHECKER_VM_THREADED_DISPATCH
+  // Labels in the order of enum tchecker::instruction_t
+  static void * const dispatch[] = {
+      &&L_RET,          &&L_RETZ,           &&L_FAILNOTIN,         &&L_JMP,
+      &&L_JMPZ,         &&L_PUSH,           &&L_VALUEAT,           &&L_ASSIGN,
+      &&L_LAND,         &&L_MINUS,          &&L_DIV,               &&L_EQ,
+      &&L_GE,           &&L_GT,             &&L_LT,                &&L_LE,
+      &&L_MUL,          &&L_MOD,            &&L_NE,                &&L_SUM,
+      &&L_NEG,          &&L_LNOT,           &&L_CLKCONSTR,         &&L_CLKRESET,
+      &&L_PUSH_FRAME,   &&L_POP_FRAME,      &&L_VALUEAT_FRAME,     &&L_ASSIGN_FRAME,
+      &&L_INIT_FRAME,   &&L_PUSH_VALUEAT,   &&L_PUSH_VALUEAT_CMP,  &&L_CLKCONSTR_CONST,
+      &&L_CLKRESET_CONST, &&L_NOP};
+  static_assert(sizeof(dispatch) / sizeof(dispatch[0]) == tchecker::VM_NOP + 1, "missing instructions in dispatch table");
+
+  // Assume stack=v1 ... vK where vK is the top symbol, sp points past vK
+  tchecker::bytecode_t * const base = _fixed_stack.data();
+  tchecker::bytecode_t * const limit = base + _fixed_stack.size();
+  tchecker::bytecode_t * sp = base;
+  tchecker::bytecode_t const * ip = bytecode;
+  clear_frames();
+
+#define TCHECKER_VM_NEXT(n)                                                                                                    \
+  do {                                                                                                                         \
+    ip += (n);                                                                                                                 \
+    assert(*ip >= 0 && *ip <= tchecker::VM_NOP);                                                                               \
+    goto *dispatch[*ip];                                                                                                       \
+  } while (0)
+
+#define TCHECKER_VM_PUSH(v)                                                                                                    \
+  do {                                                                                                                         \
+    if (sp == limit)                                                                                                           \
+      throw std::runtime_error("vm_t::run, stack overflow");                                                                 \
+    *sp++ = (v);                                                                                                               \
+  } while (0)
+
+  // stack = v1 ... vK-2 (vK-1 OP vK)
+#define TCHECKER_VM_BINARY(OP)                                                                                                 \
+  do {                                                                                                                         \
+    assert(sp - base >= 2);                                                                                                    \
+    auto const right = value_as<tchecker::integer_t>(sp[-1]);                                                                \
+    auto const left = value_as<tchecker::integer_t>(sp[-2]);                                                                 \
+    --sp;                                                                                                                      \
+    sp[-1] = static_cast<tchecker::integer_t>(left OP right);                                                                \
+    TCHECKER_VM_NEXT(1);                                                                                                       \
+  } while (0)
+
+  TCHECKER_VM_NEXT(0);
+
+  // end of operation, return vK
+L_RET : {
+  assert(sp - base == 1);
+  return value_as<tchecker::integer_t>(*--sp);
+}
+
+  // end of operation when vK==0, return 0
+L_RETZ : {
+  if (value_as<tchecker::integer_t>(sp[-1]) == 0)
+    return 0;
+  TCHECKER_VM_NEXT(1);
+}
+
+  // raise exception when not (l <= vK <= h) for parameters l and h
+L_FAILNOTIN : {
+  tchecker::bytecode_t const l = ip[1];
+  tchecker::bytecode_t const h = ip[2];
+  tchecker::bytecode_t const offset = sp[-1];
+  if ((offset < l) || (offset > h)) {
+    std::stringstream ss;
+    ss << offset << " out of [" << l << ", " << h << "]";
+    throw std::out_of_range("out-of-bounds value: " + ss.str());
+  }
+  TCHECKER_VM_NEXT(3);
+}
+
+  // unconditional jump relatively to next instruction
+L_JMP:
+  TCHECKER_VM_NEXT(2 + ip[1]);
+
+  // stack = v1 ... vK-1   jump if vK == 0
+L_JMPZ:
+  TCHECKER_VM_NEXT(value_as<tchecker::integer_t>(*--sp) == 0 ? 2 + ip[1] : 2);
+
+  // stack = v1 ... vK v   where v is a parameter of VM_PUSH
+L_PUSH:
+  TCHECKER_VM_PUSH(ip[1]);
+  TCHECKER_VM_NEXT(2);
+
+  // stack = v1 ... [vK]   vK replaced by value at ID vK in intvars valuation
+L_VALUEAT : {
+  auto const id = value_as<tchecker::intvar_id_t>(sp[-1]);
+  assert(id < intval.size());
+  sp[-1] = intval[id];
+  TCHECKER_VM_NEXT(1);
+}
+
+  // [vK-1] = vK, stack = v1 ... vK-2
+L_ASSIGN : {
+  auto const value = value_as<tchecker::integer_t>(sp[-1]);
+  auto const id = value_as<tchecker::intvar_id_t>(sp[-2]);
+  assert(id < intval.size());
+  intval[id] = value;
+  sp -= 2;
+  TCHECKER_VM_NEXT(1);
+}
+
+L_LAND:
+  TCHECKER_VM_BINARY(&&);
+L_MINUS:
+  TCHECKER_VM_BINARY(-);
+L_DIV:
+  TCHECKER_VM_BINARY(/);
+L_EQ:
+  TCHECKER_VM_BINARY(==);
+L_GE:
+  TCHECKER_VM_BINARY(>=);
+L_GT:
+  TCHECKER_VM_BINARY(>);
+L_LT:
+  TCHECKER_VM_BINARY(<);
+L_LE:
+  TCHECKER_VM_BINARY(<=);
+L_MUL:
+  TCHECKER_VM_BINARY(*);
+L_MOD:
+  TCHECKER_VM_BINARY(%);
+L_NE:
+  TCHECKER_VM_BINARY(!=);
+L_SUM:
+  TCHECKER_VM_BINARY(+);
+
+  // stack = v1 ... vK-1 (- vK)
+L_NEG:
+  sp[-1] = -value_as<tchecker::integer_t>(sp[-1]);
+  TCHECKER_VM_NEXT(1);
+
+  // stack = v1 ... vK-1 (! vK)
+L_LNOT:
+  sp[-1] = !value_as<tchecker::integer_t>(sp[-1]);
+  TCHECKER_VM_NEXT(1);
+
+  // stack = v1 ... vK-3   output (vK-2 vK-1 s vK)   where s is a parameter of
+  // VM_CLKCONSTR (strictness)
+L_CLKCONSTR : {
+  auto const bound = value_as<tchecker::integer_t>(sp[-1]);
+  auto const id2 = value_as<tchecker::clock_id_t>(sp[-2]);
+  auto const id1 = value_as<tchecker::clock_id_t>(sp[-3]);
+  sp -= 3;
+  clkconstr.emplace_back(id1, id2, (ip[1] == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE), bound);
+  TCHECKER_VM_NEXT(2);
+}
+
+  // stack = v1 ... vK-3    output (vK-2 vK-1 vK)
+L_CLKRESET : {
+  auto const value = value_as<tchecker::integer_t>(sp[-1]);
+  auto const right_id = value_as<tchecker::clock_id_t>(sp[-2]);
+  auto const left_id = value_as<tchecker::clock_id_t>(sp[-3]);
+  sp -= 3;
+  clkreset.emplace_back(left_id, right_id, value);
+  TCHECKER_VM_NEXT(1);
+}
+
+  // push a new frame for local variables
+L_PUSH_FRAME:
+  push_frame();
+  TCHECKER_VM_NEXT(1);
+
+  // pop the top-level frame
+L_POP_FRAME:
+  pop_frame();
+  TCHECKER_VM_NEXT(1);
+
+  // stack = v1 ... vK-1 [vK]   vK is replaced by the value of the local
+  // variable identified by vK
+L_VALUEAT_FRAME:
+  sp[-1] = slot_of(sp[-1]);
+  TCHECKER_VM_NEXT(1);
+
+  // stack = v1 ... vK-2   [vK-1] is assigned vK where vK-1 identifies a local
+  // variable
+L_ASSIGN_FRAME : {
+  auto const value = value_as<tchecker::integer_t>(sp[-1]);
+  auto const id = value_as<tchecker::intvar_id_t>(sp[-2]);
+  sp -= 2;
+  slot_of(id) = value;
+  TCHECKER_VM_NEXT(1);
+}
+
+  // stack = v1 ... vK-2   [vK-1] is initialized with vK where vK-1 identifies
+  // a local variable
+L_INIT_FRAME : {
+  auto const value = value_as<tchecker::integer_t>(sp[-1]);
+  auto const id = value_as<tchecker::intvar_id_t>(sp[-2]);
+  sp -= 2;
+  init_slot(id, value);
+  TCHECKER_VM_NEXT(1);
+}
+
+  // stack = v1 ... vK [id]   where id is a parameter of VM_PUSH_VALUEAT
+L_PUSH_VALUEAT:
+  assert(static_cast<tchecker::intvar_id_t>(ip[1]) < intval.size());
+  TCHECKER_VM_PUSH(intval[static_cast<tchecker::intvar_id_t>(ip[1])]);
+  TCHECKER_VM_NEXT(2);
+
+  // stack = v1 ... vK ([id] cmp v)   where id, v and cmp are parameters of
+  // VM_PUSH_VALUEAT_CMP
+L_PUSH_VALUEAT_CMP:
+  assert(static_cast<tchecker::intvar_id_t>(ip[1]) < intval.size());
+  TCHECKER_VM_PUSH(
+      compare(ip[3], intval[static_cast<tchecker::intvar_id_t>(ip[1])], static_cast<tchecker::integer_t>(ip[2])));
+  TCHECKER_VM_NEXT(4);
+
+  // stack = v1 ... vK   output (id1 id2 s b)   where id1, id2, b and s are
+  // parameters of VM_CLKCONSTR_CONST
+L_CLKCONSTR_CONST:
+  clkconstr.emplace_back(static_cast<tchecker::clock_id_t>(ip[1]), static_cast<tchecker::clock_id_t>(ip[2]),
+                         (ip[4] == 0 ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE),
+                         static_cast<tchecker::integer_t>(ip[3]));
+  TCHECKER_VM_NEXT(5);
+
+  // stack = v1 ... vK   output (id1 id2 v)   where id1, id2 and v are
+  // parameters of VM_CLKRESET_CONST
+L_CLKRESET_CONST:
+  clkreset.emplace_back(static_cast<tchecker::clock_id_t>(ip[1]), static_cast<tchecker::clock_id_t>(ip[2]),
+                        static_cast<tchecker::integer_t>(ip[3]));
+  TCHECKER_VM_NEXT(4);
+
+  // no-operation
+L_NOP:
+  TCHECKER_VM_NEXT(1);
+
+#undef TCHECKER_VM_BINARY
+#undef TCHECKER_VM_PUSH
+#undef TCHECKER_VM_NEXT
+#else
+  return run_switch(bytecode, intval, clkconstr, clkreset);
+#endif
+}
+
 } // end of namespace tchecker
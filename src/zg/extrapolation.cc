@@ -14,7 +14,8 @@ namespace zg {
 
 /* no_extrapolation_t */
 
-void no_extrapolation_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc) {}
+void no_extrapolation_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                     tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc) {}
 
 /* global_lu_extrapolation_t */
 
@@ -30,7 +31,8 @@ global_lu_extrapolation_t::global_lu_extrapolation_t(
 
 /* global_extra_lu_t */
 
-void global_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void global_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                    tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
   tchecker::dbm::extra_lu(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
@@ -38,10 +40,11 @@ void global_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_i
 
 /* global_extra_lu_plus_t */
 
-void global_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void global_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                         tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  tchecker::dbm::extra_lu_plus(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
+  dbm_operations.extra_lu_plus(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
 }
 
 /* local_lu_extrapolation_t */
@@ -50,76 +53,34 @@ namespace details {
 
 local_lu_extrapolation_t::local_lu_extrapolation_t(
     std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds)
-    : _l(nullptr), _u(nullptr), _clock_bounds(clock_bounds)
+    : _clock_bounds(clock_bounds), _cache(clock_bounds)
 {
-  _l = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
-}
-
-local_lu_extrapolation_t::local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e)
-    : _clock_bounds(e._clock_bounds)
-{
-  _l = tchecker::clockbounds::clone_map(*e._l);
-  _u = tchecker::clockbounds::clone_map(*e._u);
-}
-
-local_lu_extrapolation_t::local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e)
-    : _l(std::move(e._l)), _u(std::move(e._u)), _clock_bounds(std::move(e._clock_bounds))
-{
-  e._l = nullptr;
-  e._u = nullptr;
-}
-
-local_lu_extrapolation_t::~local_lu_extrapolation_t()
-{
-  tchecker::clockbounds::deallocate_map(_l);
-  tchecker::clockbounds::deallocate_map(_u);
-}
-
-tchecker::zg::details::local_lu_extrapolation_t &
-local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolation_t const & e)
-{
-  if (this != &e) {
-    _clock_bounds = e._clock_bounds;
-    tchecker::clockbounds::deallocate_map(_l);
-    _l = tchecker::clockbounds::clone_map(*e._l);
-    tchecker::clockbounds::deallocate_map(_u);
-    _u = tchecker::clockbounds::clone_map(*e._u);
-  }
-  return *this;
-}
-
-tchecker::zg::details::local_lu_extrapolation_t &
-local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolation_t && e)
-{
-  if (this != &e) {
-    _clock_bounds = std::move(e._clock_bounds);
-    _l = std::move(e._l);
-    _u = std::move(e._u);
-    e._l = nullptr;
-    e._u = nullptr;
-  }
-  return *this;
 }
 
 } // end of namespace details
 
 /* local_extra_lu_t */
 
-void local_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void local_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                   tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_l, *_u);
-  tchecker::dbm::extra_lu(dbm, dim, _l->ptr(), _u->ptr());
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _cache.bounds(vloc, l, u);
+  tchecker::dbm::extra_lu(dbm, dim, l->ptr(), u->ptr());
 }
 
 /* local_extra_lu_plus_t */
 
-void local_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void local_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                        tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_l, *_u);
-  tchecker::dbm::extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr());
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _cache.bounds(vloc, l, u);
+  dbm_operations.extra_lu_plus(dbm, dim, l->ptr(), u->ptr());
 }
 
 /* global_m_extrapolation_t */
@@ -136,7 +97,8 @@ global_m_extrapolation_t::global_m_extrapolation_t(
 
 /* global_extra_m_t */
 
-void global_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void global_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                   tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
   tchecker::dbm::extra_m(dbm, dim, _clock_bounds->M().ptr());
@@ -144,10 +106,12 @@ void global_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id
 
 /* global_extra_m_plus_t */
 
-void global_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void global_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                        tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  tchecker::dbm::extra_m_plus(dbm, dim, _clock_bounds->M().ptr());
+  tchecker::integer_t const * m = _clock_bounds->M().ptr();
+  dbm_operations.extra_lu_plus(dbm, dim, m, m); // ExtraM+ is ExtraLU+ with L = U = M
 }
 
 /* local_m_extrapolation_t */
@@ -156,65 +120,29 @@ namespace details {
 
 local_m_extrapolation_t::local_m_extrapolation_t(
     std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & clock_bounds)
-    : _m(nullptr), _clock_bounds(clock_bounds)
-{
-  _m = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
-}
-
-local_m_extrapolation_t::local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e)
-    : _m(nullptr), _clock_bounds(e._clock_bounds)
-{
-  _m = tchecker::clockbounds::clone_map(*e._m);
-}
-
-local_m_extrapolation_t::local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e)
-    : _m(std::move(e._m)), _clock_bounds(std::move(e._clock_bounds))
-{
-  e._m = nullptr;
-}
-
-local_m_extrapolation_t::~local_m_extrapolation_t() { tchecker::clockbounds::deallocate_map(_m); }
-
-tchecker::zg::details::local_m_extrapolation_t &
-local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_t const & e)
-{
-  if (this != &e) {
-    tchecker::clockbounds::deallocate_map(_m);
-    _m = tchecker::clockbounds::clone_map(*e._m);
-    _clock_bounds = e._clock_bounds;
-  }
-  return *this;
-}
-
-tchecker::zg::details::local_m_extrapolation_t &
-local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_t && e)
+    : _clock_bounds(clock_bounds), _cache(clock_bounds)
 {
-  if (this != &e) {
-    _m = std::move(e._m);
-    e._m = nullptr;
-    _clock_bounds = std::move(e._clock_bounds);
-  }
-  return *this;
 }
 
 } // namespace details
 
 /* local_extra_m_t */
 
-void local_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void local_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                  tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_m);
-  tchecker::dbm::extra_m(dbm, dim, _m->ptr());
+  tchecker::dbm::extra_m(dbm, dim, _cache.bounds(vloc).ptr());
 }
 
 /* local_extra_m_plus_t */
 
-void local_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+void local_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                       tchecker::dbm::operations_t const & dbm_operations, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_m);
-  tchecker::dbm::extra_m_plus(dbm, dim, _m->ptr());
+  tchecker::integer_t const * m = _cache.bounds(vloc).ptr();
+  dbm_operations.extra_lu_plus(dbm, dim, m, m); // ExtraM+ is ExtraLU+ with L = U = M
 }
 
 /* factories */
@@ -12,90 +12,128 @@ namespace tchecker {
 
 namespace zg {
 
+/*!
+ \brief Check if a clock constraint is disabled from a zone
+ \param zone : a zone
+ \param c : a clock constraint
+ \return true if no valuation in zone satisfies c, false otherwise
+ \note zone is not empty, hence tight
+ */
+static bool disabled(tchecker::zg::zone_t const & zone, tchecker::clock_constraint_t const & c)
+{
+  tchecker::clock_id_t id1 = (c.id1() == tchecker::REFCLOCK_ID ? 0 : c.id1() + 1);
+  tchecker::clock_id_t id2 = (c.id2() == tchecker::REFCLOCK_ID ? 0 : c.id2() + 1);
+  auto cmp = (c.comparator() == tchecker::clock_constraint_t::LT ? tchecker::dbm::LT : tchecker::dbm::LE);
+  return tchecker::dbm::sum(zone.dbm(id2, id1), tchecker::dbm::db(cmp, c.value())) < tchecker::dbm::LE_ZERO;
+}
+
 /* standard_semantics_t */
 
-tchecker::state_status_t standard_semantics_t::initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool delay_allowed,
+tchecker::state_status_t standard_semantics_t::initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                       tchecker::dbm::operations_t const & dbm_operations, bool delay_allowed,
                                                        tchecker::clock_constraint_container_t const & invariant)
 {
   tchecker::dbm::zero(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
 }
 
-tchecker::state_status_t standard_semantics_t::next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+tchecker::state_status_t standard_semantics_t::next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                    tchecker::dbm::operations_t const & dbm_operations, bool src_delay_allowed,
                                                     tchecker::clock_constraint_container_t const & src_invariant,
                                                     tchecker::clock_constraint_container_t const & guard,
                                                     tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                                     tchecker::clock_constraint_container_t const & tgt_invariant)
 {
   if (src_delay_allowed) {
-    tchecker::dbm::open_up(dbm, dim);
+    dbm_operations.open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+    if (dbm_operations.constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED; // should never occur
   }
 
-  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
-  tchecker::dbm::reset(dbm, dim, clkreset);
+  dbm_operations.reset(dbm, dim, clkreset);
 
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
 }
 
+bool standard_semantics_t::disabled(tchecker::zg::zone_t const & zone, bool src_delay_allowed,
+                                    tchecker::clock_constraint_container_t const & guard) const
+{
+  // delay only relaxes lower bounds (i.e. constraints 0 - x # c) in zone
+  for (tchecker::clock_constraint_t const & c : guard)
+    if ((!src_delay_allowed || c.id1() != tchecker::REFCLOCK_ID) && tchecker::zg::disabled(zone, c))
+      return true;
+  return false;
+}
+
 /* elapsed_semantics_t */
 
-tchecker::state_status_t elapsed_semantics_t::initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool delay_allowed,
+tchecker::state_status_t elapsed_semantics_t::initial(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                      tchecker::dbm::operations_t const & dbm_operations, bool delay_allowed,
                                                       tchecker::clock_constraint_container_t const & invariant)
 {
   tchecker::dbm::zero(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   if (delay_allowed) {
-    tchecker::dbm::open_up(dbm, dim);
+    dbm_operations.open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+    if (dbm_operations.constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
   }
 
   return tchecker::STATE_OK;
 }
 
-tchecker::state_status_t elapsed_semantics_t::next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, bool src_delay_allowed,
+tchecker::state_status_t elapsed_semantics_t::next(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                   tchecker::dbm::operations_t const & dbm_operations, bool src_delay_allowed,
                                                    tchecker::clock_constraint_container_t const & src_invariant,
                                                    tchecker::clock_constraint_container_t const & guard,
                                                    tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                                    tchecker::clock_constraint_container_t const & tgt_invariant)
 {
-  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
-  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
-  tchecker::dbm::reset(dbm, dim, clkreset);
+  dbm_operations.reset(dbm, dim, clkreset);
 
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+  if (dbm_operations.constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   if (tgt_delay_allowed) {
-    tchecker::dbm::open_up(dbm, dim);
+    dbm_operations.open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+    if (dbm_operations.constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
   }
 
   return tchecker::STATE_OK;
 }
 
+bool elapsed_semantics_t::disabled(tchecker::zg::zone_t const & zone, bool src_delay_allowed,
+                                   tchecker::clock_constraint_container_t const & guard) const
+{
+  for (tchecker::clock_constraint_t const & c : guard)
+    if (tchecker::zg::disabled(zone, c))
+      return true;
+  return false;
+}
+
 /* factory */
 
 tchecker::zg::semantics_t * semantics_factory(enum semantics_type_t semantics)
@@ -35,14 +35,14 @@ state_t::state_t(tchecker::ta::state_t const & s, tchecker::intrusive_shared_ptr
 
 bool operator==(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2)
 {
-  return tchecker::ta::operator==(s1, s2) && (s1.zone() == s2.zone());
+  return tchecker::ta::operator==(s1, s2) && (&s1.zone() == &s2.zone() || s1.zone() == s2.zone());
 }
 
 bool operator!=(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2) { return !(s1 == s2); }
 
 bool operator<=(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2)
 {
-  return tchecker::ta::operator==(s1, s2) && (s1.zone() <= s2.zone());
+  return tchecker::ta::operator==(s1, s2) && (&s1.zone() == &s2.zone() || s1.zone() <= s2.zone());
 }
 
 std::size_t hash_value(tchecker::zg::state_t const & s)
@@ -20,6 +20,7 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
                                  tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> const & zone,
                                  tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
                                  tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
+                                 tchecker::dbm::operations_t const & dbm_operations,
                                  tchecker::zg::extrapolation_t & extrapolation,
                                  tchecker::zg::initial_value_t const & initial_range)
 {
@@ -31,11 +32,11 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
   tchecker::clock_id_t dim = zone->dim();
   bool delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
 
-  status = semantics.initial(dbm, dim, delay_allowed, invariant);
+  status = semantics.initial(dbm, dim, dbm_operations, delay_allowed, invariant);
   if (status != tchecker::STATE_OK)
     return status;
 
-  extrapolation.extrapolate(dbm, dim, *vloc);
+  extrapolation.extrapolate(dbm, dim, dbm_operations, *vloc);
 
   return tchecker::STATE_OK;
 }
@@ -48,6 +49,7 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
+                              tchecker::dbm::operations_t const & dbm_operations,
                               tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::outgoing_edges_value_t const & edges)
 {
   bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
@@ -57,15 +59,29 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
   if (status != tchecker::STATE_OK)
     return status;
 
-  tchecker::dbm::db_t * dbm = zone->dbm();
-  tchecker::clock_id_t dim = zone->dim();
-  bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+  return tchecker::zg::next_zone(system, *vloc, *zone, src_delay_allowed, src_invariant, guard, reset, tgt_invariant,
+                                 semantics, dbm_operations, extrapolation);
+}
+
+tchecker::state_status_t next_zone(tchecker::ta::system_t const & system, tchecker::vloc_t const & vloc,
+                                   tchecker::zg::zone_t & zone, bool src_delay_allowed,
+                                   tchecker::clock_constraint_container_t const & src_invariant,
+                                   tchecker::clock_constraint_container_t const & guard,
+                                   tchecker::clock_reset_container_t const & reset,
+                                   tchecker::clock_constraint_container_t const & tgt_invariant,
+                                   tchecker::zg::semantics_t & semantics, tchecker::dbm::operations_t const & dbm_operations,
+                                   tchecker::zg::extrapolation_t & extrapolation)
+{
+  tchecker::dbm::db_t * dbm = zone.dbm();
+  tchecker::clock_id_t dim = zone.dim();
+  bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, vloc);
 
-  status = semantics.next(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant);
+  tchecker::state_status_t status = semantics.next(dbm, dim, dbm_operations, src_delay_allowed, src_invariant, guard, reset,
+                                                   tgt_delay_allowed, tgt_invariant);
   if (status != tchecker::STATE_OK)
     return status;
 
-  extrapolation.extrapolate(dbm, dim, *vloc);
+  extrapolation.extrapolate(dbm, dim, dbm_operations, vloc);
 
   return tchecker::STATE_OK;
 }
@@ -91,16 +107,34 @@ void attributes(tchecker::ta::system_t const & system, tchecker::zg::transition_
   tchecker::ta::attributes(system, t, m);
 }
 
+enum tchecker::zg::zone_storage_t shared_zone_storage(enum tchecker::ts::sharing_type_t sharing_type)
+{
+  switch (sharing_type) {
+  case tchecker::ts::SHARING_NARROW_ZONES:
+    return tchecker::zg::NARROW_STORAGE;
+  case tchecker::ts::SHARING_REDUCED_ZONES:
+    return tchecker::zg::REDUCED_STORAGE;
+  default:
+    return tchecker::zg::WIDE_STORAGE;
+  }
+}
+
 /* zg_t */
 
 zg_t::zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
            std::unique_ptr<tchecker::zg::semantics_t> && semantics,
-           std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size)
-    : _system(system), _semantics(std::move(semantics)), _extrapolation(std::move(extrapolation)),
+           std::unique_ptr<tchecker::zg::extrapolation_t> && extrapolation, std::size_t block_size,
+           enum tchecker::ts::sharing_type_t sharing_type)
+    : _system(system), _semantics(std::move(semantics)),
+      _dbm_operations(&tchecker::dbm::operations(_system->clocks_count(tchecker::VK_FLATTENED) + 1)),
+      _extrapolation(std::move(extrapolation)),
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
                        _system->intvars_count(tchecker::VK_FLATTENED), block_size,
-                       _system->clocks_count(tchecker::VK_FLATTENED) + 1),
-      _transition_allocator(block_size, block_size, _system->processes_count())
+                       _system->clocks_count(tchecker::VK_FLATTENED) + 1,
+                       tchecker::zg::shared_zone_storage(sharing_type)),
+      _transition_allocator(block_size, block_size, _system->processes_count()), _sharing_type(sharing_type),
+      _symmetry(nullptr), _edges_cache(nullptr), _next_state(_state_allocator.construct()),
+      _next_transition(_transition_allocator.construct()), _successor_allocations(0), _avoided_zone_copies(0)
 {
 }
 
@@ -110,12 +144,19 @@ void zg_t::initial(tchecker::zg::initial_value_t const & init_edge, std::vector<
 {
   tchecker::zg::state_sptr_t s = _state_allocator.construct();
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::initial(*_system, *s, *t, *_semantics, *_extrapolation, init_edge);
+  tchecker::state_status_t status = tchecker::zg::initial(*_system, *s, *t, *_semantics, *_dbm_operations, *_extrapolation,
+                                                            init_edge);
+  if (status == tchecker::STATE_OK)
+    canonicalize(*s);
+  if (_sharing_type != tchecker::ts::NO_SHARING && status == tchecker::STATE_OK)
+    _state_allocator.share(*s);
   v.push_back(std::make_tuple(status, s, t));
 }
 
 tchecker::zg::outgoing_edges_range_t zg_t::outgoing_edges(tchecker::zg::const_state_sptr_t const & s)
 {
+  if (_edges_cache.get() != nullptr)
+    return _edges_cache->outgoing_edges(_system->as_syncprod_system(), s->vloc_ptr());
   return tchecker::zg::outgoing_edges(*_system, s->vloc_ptr());
 }
 
@@ -124,10 +165,88 @@ void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoi
 {
   tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_extrapolation, out_edge);
+  tchecker::state_status_t status = tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_dbm_operations, *_extrapolation,
+                                                         out_edge);
+  if (status == tchecker::STATE_OK)
+    canonicalize(*nexts);
+  if (_sharing_type != tchecker::ts::NO_SHARING && status == tchecker::STATE_OK)
+    _state_allocator.share(*nexts);
+  ++_successor_allocations;
   v.push_back(std::make_tuple(status, nexts, t));
 }
 
+void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
+                std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  next(s, out_edge, v, mask, state_filter_t{});
+}
+
+void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
+                std::vector<sst_t> & v, tchecker::state_status_t mask, state_filter_t const & filter)
+{
+  tchecker::zg::shared_state_t & nexts = *_next_state;
+  tchecker::zg::shared_transition_t & t = *_next_transition;
+
+  static_cast<tchecker::vloc_t &>(*nexts.vloc_ptr()) = s->vloc();
+  static_cast<tchecker::intvars_valuation_t &>(*nexts.intval_ptr()) = s->intval();
+  t.src_invariant_container().clear();
+  t.guard_container().clear();
+  t.reset_container().clear();
+  t.tgt_invariant_container().clear();
+
+  bool src_delay_allowed = tchecker::ta::delay_allowed(*_system, s->vloc());
+
+  tchecker::state_status_t status =
+      tchecker::ta::next(*_system, nexts.vloc_ptr(), nexts.intval_ptr(), t.vedge_ptr(), t.src_invariant_container(),
+                         t.guard_container(), t.reset_container(), t.tgt_invariant_container(), out_edge);
+
+  // Discard successors before copying the zone of s when their status is known
+  // not to match mask. A guard that is disabled from the zone of s yields either
+  // tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED or
+  // tchecker::STATE_CLOCKS_GUARD_VIOLATED. Reduced zones would have to be expanded
+  // for each constraint, hence they are not checked
+  if (status == tchecker::STATE_OK &&
+      (mask & (tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED | tchecker::STATE_CLOCKS_GUARD_VIOLATED)) == 0 &&
+      s->zone().storage() != tchecker::zg::REDUCED_STORAGE &&
+      _semantics->disabled(s->zone(), src_delay_allowed, t.guard_container())) {
+    ++_avoided_zone_copies;
+    return;
+  }
+  if (status != tchecker::STATE_OK && (status & mask) == 0) {
+    ++_avoided_zone_copies;
+    return;
+  }
+
+  static_cast<tchecker::zg::zone_t &>(*nexts.zone_ptr()) = s->zone();
+  if (status == tchecker::STATE_OK)
+    status = tchecker::zg::next_zone(*_system, nexts.vloc(), *nexts.zone_ptr(), src_delay_allowed, t.src_invariant_container(),
+                                     t.guard_container(), t.reset_container(), t.tgt_invariant_container(), *_semantics,
+                                     *_dbm_operations, *_extrapolation);
+  if ((status & mask) == 0)
+    return;
+
+  if (status == tchecker::STATE_OK)
+    canonicalize(nexts);
+  if (status == tchecker::STATE_OK && filter && !filter(tchecker::zg::const_state_sptr_t{_next_state})) {
+    v.push_back(std::make_tuple(status, tchecker::zg::state_sptr_t{nullptr}, _transition_allocator.clone(t)));
+    return;
+  }
+  tchecker::zg::state_sptr_t next_state = _state_allocator.clone(nexts);
+  if (_sharing_type != tchecker::ts::NO_SHARING && status == tchecker::STATE_OK)
+    _state_allocator.share(*next_state);
+  tchecker::zg::transition_sptr_t next_transition = _transition_allocator.clone(t);
+  ++_successor_allocations;
+  v.push_back(std::make_tuple(status, next_state, next_transition));
+}
+
+tchecker::zg::state_sptr_t zg_t::clone_state(tchecker::zg::shared_state_t const & s)
+{
+  tchecker::zg::state_sptr_t clone = _state_allocator.clone(s);
+  if (_sharing_type != tchecker::ts::NO_SHARING)
+    _state_allocator.share(*clone);
+  return clone;
+}
+
 bool zg_t::satisfies(tchecker::zg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const
 {
   return tchecker::zg::satisfies(*_system, *s, labels);
@@ -145,31 +264,50 @@ void zg_t::attributes(tchecker::zg::const_transition_sptr_t const & t, std::map<
 
 tchecker::ta::system_t const & zg_t::system() const { return *_system; }
 
+std::size_t zg_t::memsize() const { return _state_allocator.memsize() + _transition_allocator.memsize(); }
+
+void zg_t::set_symmetry(std::shared_ptr<tchecker::ta::symmetry_t const> const & symmetry) { _symmetry = symmetry; }
+
+void zg_t::set_outgoing_edges_cache(std::shared_ptr<tchecker::syncprod::outgoing_edges_cache_t> const & cache)
+{
+  _edges_cache = cache;
+}
+
+void zg_t::canonicalize(tchecker::zg::state_t & s) const
+{
+  if (_symmetry.get() == nullptr)
+    return;
+  tchecker::zg::zone_t & zone = *s.zone_ptr();
+  _symmetry->canonicalize(*s.vloc_ptr(), *s.intval_ptr(), zone.dbm(), zone.dim());
+}
+
 /* factory */
 
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                              enum tchecker::zg::semantics_type_t semantics_type,
-                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size)
+                             enum tchecker::zg::extrapolation_type_t extrapolation_type, std::size_t block_size,
+                             enum tchecker::ts::sharing_type_t sharing_type)
 {
   std::unique_ptr<tchecker::zg::extrapolation_t> extrapolation{
       tchecker::zg::extrapolation_factory(extrapolation_type, *system)};
   if (extrapolation.get() == nullptr)
     return nullptr;
   std::unique_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(semantics_type)};
-  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size);
+  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size, sharing_type);
 }
 
 tchecker::zg::zg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                              enum tchecker::zg::semantics_type_t semantics_type,
                              enum tchecker::zg::extrapolation_type_t extrapolation_type,
-                             tchecker::clockbounds::clockbounds_t const & clock_bounds, std::size_t block_size)
+                             tchecker::clockbounds::clockbounds_t const & clock_bounds, std::size_t block_size,
+                             enum tchecker::ts::sharing_type_t sharing_type)
 {
   std::unique_ptr<tchecker::zg::extrapolation_t> extrapolation{
       tchecker::zg::extrapolation_factory(extrapolation_type, clock_bounds)};
   if (extrapolation.get() == nullptr)
     return nullptr;
   std::unique_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(semantics_type)};
-  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size);
+  return new tchecker::zg::zg_t(system, std::move(semantics), std::move(extrapolation), block_size, sharing_type);
 }
 
 } // end of namespace zg
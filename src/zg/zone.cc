@@ -5,30 +5,70 @@
  *
  */
 
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/operations.hh"
 #include "tchecker/zg/zone.hh"
 
 namespace tchecker {
 
 namespace zg {
 
+namespace {
+
+/* Access to wide and narrow difference bounds */
+
+inline tchecker::dbm::db_t wide(tchecker::dbm::db_t db) { return db; }
+
+inline tchecker::dbm::db_t wide(tchecker::dbm::narrow_db_t db) { return tchecker::dbm::widen(db); }
+
+/* Equality and inclusion of DBMs with wide or narrow difference bounds */
+
+template <class DB1, class DB2> bool is_equal(DB1 const * dbm1, DB2 const * dbm2, std::size_t size)
+{
+  for (std::size_t k = 0; k < size; ++k)
+    if (wide(dbm1[k]) != wide(dbm2[k]))
+      return false;
+  return true;
+}
+
+template <class DB1, class DB2> bool is_le(DB1 const * dbm1, DB2 const * dbm2, std::size_t size)
+{
+  for (std::size_t k = 0; k < size; ++k)
+    if (wide(dbm1[k]) > wide(dbm2[k]))
+      return false;
+  return true;
+}
+
+} // end of anonymous namespace
+
 tchecker::zg::zone_t & zone_t::operator=(tchecker::zg::zone_t const & zone)
 {
+  assert(_storage == tchecker::zg::WIDE_STORAGE);
+
   if (_dim != zone._dim)
     throw std::invalid_argument("Zone dimension mismatch");
 
   if (this != &zone)
-    memcpy(dbm_ptr(), zone.dbm_ptr(), _dim * _dim * sizeof(tchecker::dbm::db_t));
+    zone.to_dbm(dbm_ptr());
 
   return *this;
 }
 
-bool zone_t::is_empty() const { return tchecker::dbm::is_empty_0(dbm_ptr(), _dim); }
+bool zone_t::is_empty() const
+{
+  // reduced zones are built from non-empty zones only
+  return (_storage != tchecker::zg::REDUCED_STORAGE) && (dbm(0, 0) < tchecker::dbm::LE_ZERO);
+}
 
-bool zone_t::is_universal_positive() const { return tchecker::dbm::is_universal_positive(dbm_ptr(), _dim); }
+bool zone_t::is_universal_positive() const { return tchecker::dbm::is_universal_positive(wide_dbm_ptr(0), _dim); }
 
 bool zone_t::operator==(tchecker::zg::zone_t const & zone) const
 {
@@ -37,7 +77,19 @@ bool zone_t::operator==(tchecker::zg::zone_t const & zone) const
   bool empty1 = this->is_empty(), empty2 = zone.is_empty();
   if (empty1 || empty2)
     return (empty1 && empty2);
-  return tchecker::dbm::is_equal(dbm_ptr(), zone.dbm_ptr(), _dim);
+  if (_storage == tchecker::zg::WIDE_STORAGE && zone._storage == tchecker::zg::WIDE_STORAGE)
+    return tchecker::dbm::is_equal(dbm_ptr(), zone.dbm_ptr(), _dim);
+  if (_storage == tchecker::zg::NARROW_STORAGE && zone._storage == tchecker::zg::NARROW_STORAGE)
+    return tchecker::zg::is_equal(narrow_dbm_ptr(), zone.narrow_dbm_ptr(), _dim * _dim);
+  if (_storage == tchecker::zg::NARROW_STORAGE && zone._storage == tchecker::zg::WIDE_STORAGE)
+    return tchecker::zg::is_equal(narrow_dbm_ptr(), zone.dbm_ptr(), _dim * _dim);
+  if (_storage == tchecker::zg::WIDE_STORAGE && zone._storage == tchecker::zg::NARROW_STORAGE)
+    return tchecker::zg::is_equal(dbm_ptr(), zone.narrow_dbm_ptr(), _dim * _dim);
+  // reduced DBMs are canonical
+  if (_storage == tchecker::zg::REDUCED_STORAGE && zone._storage == tchecker::zg::REDUCED_STORAGE)
+    return (_reduced_size == zone._reduced_size) &&
+           (std::memcmp(reduced_dbm_ptr(), zone.reduced_dbm_ptr(), _reduced_size * sizeof(tchecker::dbm::reduced_db_t)) == 0);
+  return tchecker::dbm::is_equal(wide_dbm_ptr(0), zone.wide_dbm_ptr(1), _dim);
 }
 
 bool zone_t::operator!=(tchecker::zg::zone_t const & zone) const { return !(*this == zone); }
@@ -50,7 +102,18 @@ bool zone_t::operator<=(tchecker::zg::zone_t const & zone) const
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_le(dbm_ptr(), zone.dbm_ptr(), _dim);
+  if (_storage == tchecker::zg::WIDE_STORAGE && zone._storage == tchecker::zg::WIDE_STORAGE)
+    return tchecker::dbm::operations(_dim).is_le(dbm_ptr(), zone.dbm_ptr(), _dim);
+  if (_storage == tchecker::zg::NARROW_STORAGE && zone._storage == tchecker::zg::NARROW_STORAGE)
+    return tchecker::zg::is_le(narrow_dbm_ptr(), zone.narrow_dbm_ptr(), _dim * _dim);
+  if (_storage == tchecker::zg::NARROW_STORAGE && zone._storage == tchecker::zg::WIDE_STORAGE)
+    return tchecker::zg::is_le(narrow_dbm_ptr(), zone.dbm_ptr(), _dim * _dim);
+  if (_storage == tchecker::zg::WIDE_STORAGE && zone._storage == tchecker::zg::NARROW_STORAGE)
+    return tchecker::zg::is_le(dbm_ptr(), zone.narrow_dbm_ptr(), _dim * _dim);
+  // inclusion in a reduced zone is checked on its reduced DBM
+  if (zone._storage == tchecker::zg::REDUCED_STORAGE)
+    return tchecker::dbm::is_le(wide_dbm_ptr(0), _dim, zone.reduced_dbm_ptr(), zone._reduced_size);
+  return tchecker::dbm::operations(_dim).is_le(wide_dbm_ptr(0), zone.wide_dbm_ptr(1), _dim);
 }
 
 bool zone_t::is_am_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & m) const
@@ -59,7 +122,7 @@ bool zone_t::is_am_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_am_le(dbm_ptr(), zone.dbm_ptr(), _dim, m.ptr());
+  return tchecker::dbm::operations(_dim).is_alu_le(wide_dbm_ptr(0), zone.wide_dbm_ptr(1), _dim, m.ptr(), m.ptr());
 }
 
 bool zone_t::is_alu_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & l,
@@ -69,37 +132,139 @@ bool zone_t::is_alu_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds:
     return true;
   if (zone.is_empty())
     return false;
-  return tchecker::dbm::is_alu_le(dbm_ptr(), zone.dbm_ptr(), _dim, l.ptr(), u.ptr());
+  return tchecker::dbm::operations(_dim).is_alu_le(wide_dbm_ptr(0), zone.wide_dbm_ptr(1), _dim, l.ptr(), u.ptr());
 }
 
 int zone_t::lexical_cmp(tchecker::zg::zone_t const & zone) const
 {
-  return tchecker::dbm::lexical_cmp(dbm_ptr(), _dim, zone.dbm_ptr(), zone._dim);
+  return tchecker::dbm::lexical_cmp(wide_dbm_ptr(0), _dim, zone.wide_dbm_ptr(1), zone._dim);
 }
 
-std::size_t zone_t::hash() const { return tchecker::dbm::hash(dbm_ptr(), _dim); }
+std::size_t zone_t::hash() const { return tchecker::dbm::hash(wide_dbm_ptr(0), _dim); }
+
+bool zone_t::is_narrowable() const
+{
+  return (_storage == tchecker::zg::NARROW_STORAGE) || tchecker::dbm::is_narrow(wide_dbm_ptr(0), _dim);
+}
+
+std::size_t zone_t::reduced_size() const
+{
+  if (_storage == tchecker::zg::REDUCED_STORAGE)
+    return _reduced_size;
+  return tchecker::dbm::reduce(nullptr, wide_dbm_ptr(0), _dim);
+}
 
 std::ostream & zone_t::output(std::ostream & os, tchecker::clock_index_t const & index) const
 {
-  return tchecker::dbm::output(os, dbm_ptr(), _dim,
+  return tchecker::dbm::output(os, wide_dbm_ptr(0), _dim,
                                [&](tchecker::clock_id_t id) { return (id == 0 ? "0" : index.value(id - 1)); });
 }
 
-tchecker::dbm::db_t * zone_t::dbm() { return dbm_ptr(); }
+tchecker::dbm::db_t * zone_t::dbm()
+{
+  assert(_storage == tchecker::zg::WIDE_STORAGE);
+  return dbm_ptr();
+}
+
+tchecker::dbm::db_t const * zone_t::dbm() const
+{
+  assert(_storage == tchecker::zg::WIDE_STORAGE);
+  return dbm_ptr();
+}
 
-tchecker::dbm::db_t const * zone_t::dbm() const { return dbm_ptr(); }
+void zone_t::to_dbm(tchecker::dbm::db_t * dbm) const
+{
+  switch (_storage) {
+  case tchecker::zg::WIDE_STORAGE:
+    std::memcpy(dbm, dbm_ptr(), _dim * _dim * sizeof(*dbm));
+    break;
+  case tchecker::zg::NARROW_STORAGE:
+    tchecker::dbm::widen(dbm, narrow_dbm_ptr(), _dim);
+    break;
+  case tchecker::zg::REDUCED_STORAGE:
+    tchecker::dbm::expand(dbm, _dim, reduced_dbm_ptr(), _reduced_size);
+    break;
+  }
+}
 
-void zone_t::to_dbm(tchecker::dbm::db_t * dbm) const { std::memcpy(dbm, dbm_ptr(), _dim * _dim * sizeof(*dbm)); }
+zone_t::zone_t(tchecker::clock_id_t dim) : _dim(dim), _storage(tchecker::zg::WIDE_STORAGE), _reduced_size(0)
+{
+  tchecker::dbm::universal_positive(dbm_ptr(), _dim);
+}
+
+zone_t::zone_t(tchecker::zg::zone_t const & zone) : _dim(zone._dim), _storage(tchecker::zg::WIDE_STORAGE), _reduced_size(0)
+{
+  zone.to_dbm(dbm_ptr());
+}
 
-zone_t::zone_t(tchecker::clock_id_t dim) : _dim(dim) { tchecker::dbm::universal_positive(dbm_ptr(), _dim); }
+zone_t::zone_t(tchecker::zg::zone_t const & zone, enum tchecker::zg::zone_storage_t storage)
+    : _dim(zone._dim), _storage(storage), _reduced_size(0)
+{
+  if (storage == tchecker::zg::WIDE_STORAGE)
+    zone.to_dbm(dbm_ptr());
+  else if (storage == zone._storage) {
+    _reduced_size = zone._reduced_size;
+    std::memcpy(static_cast<void *>(this + 1), static_cast<void const *>(&zone + 1),
+                tchecker::allocation_size_t<tchecker::zg::zone_t>::alloc_size(_dim, storage, std::size_t{zone._reduced_size}) -
+                    sizeof(tchecker::zg::zone_t));
+  }
+  else if (storage == tchecker::zg::NARROW_STORAGE) {
+    tchecker::dbm::db_t const * dbm = zone.wide_dbm_ptr(0);
+    if (!tchecker::dbm::is_narrow(dbm, _dim))
+      throw std::invalid_argument("Zone cannot be narrowed");
+    tchecker::dbm::narrow(narrow_dbm_ptr(), dbm, _dim);
+  }
+  else {
+    if (zone.is_empty())
+      throw std::invalid_argument("Empty zone cannot be reduced");
+    _reduced_size = tchecker::dbm::reduce(reduced_dbm_ptr(), zone.wide_dbm_ptr(0), _dim);
+  }
+}
 
-zone_t::zone_t(tchecker::zg::zone_t const & zone) : _dim(zone._dim)
+zone_t::zone_t(tchecker::clock_id_t dim, tchecker::dbm::reduced_db_t const * rdbm, std::size_t size)
+    : _dim(dim), _storage(tchecker::zg::REDUCED_STORAGE), _reduced_size(size)
 {
-  memcpy(dbm_ptr(), zone.dbm_ptr(), _dim * _dim * sizeof(tchecker::dbm::db_t));
+  std::memcpy(static_cast<void *>(reduced_dbm_ptr()), static_cast<void const *>(rdbm),
+              size * sizeof(tchecker::dbm::reduced_db_t));
 }
 
 zone_t::~zone_t() = default;
 
+tchecker::dbm::db_t const * zone_t::wide_dbm_ptr(unsigned k) const
+{
+  if (_storage == tchecker::zg::WIDE_STORAGE)
+    return dbm_ptr();
+
+  assert(k < 2);
+  static thread_local std::vector<tchecker::dbm::db_t> buffers[2];
+  std::vector<tchecker::dbm::db_t> & buffer = buffers[k];
+  buffer.resize(_dim * _dim);
+  to_dbm(buffer.data());
+  return buffer.data();
+}
+
+/* zone_summary_t */
+
+zone_summary_t::zone_summary_t(tchecker::zg::zone_t const & zone) : _upper(0), _lower(0), _unbounded(0)
+{
+  // The empty zone is included in every zone
+  if (zone.is_empty()) {
+    _upper = std::numeric_limits<std::int64_t>::min();
+    _lower = std::numeric_limits<std::int64_t>::min();
+    return;
+  }
+
+  tchecker::clock_id_t const dim = zone.dim();
+  tchecker::dbm::db_t const * dbm = zone.wide_dbm_ptr(0);
+  for (tchecker::clock_id_t x = 1; x < dim; ++x) {
+    tchecker::dbm::db_t const upper = dbm[x * dim];
+    _upper += upper;
+    _lower += dbm[x];
+    if (upper == tchecker::dbm::LT_INFINITY)
+      _unbounded |= (std::uint64_t{1} << (x % 64));
+  }
+}
+
 // Allocation and deallocation
 
 void zone_destruct_and_deallocate(tchecker::zg::zone_t * zone)
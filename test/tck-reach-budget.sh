@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+
+# This script checks runs of tck-reach within a memory budget. It is invoked
+# as:
+#   tck-reach-budget.sh M [options] inputfile
+# and runs tck-reach with options, then with options and --max-memory M, on
+# inputfile, with labels extracted from inputfile as in tck-reach.sh.
+# It outputs the verdict of the run within the budget, and it fails if no state
+# has been evicted, or if the verdict differs from the run without a budget.
+# Other statistics are not output since they depend on the size of states in
+# memory.
+#
+
+if ! test -n "${TCK_REACH}";
+then
+    echo 1>&2 "missing variable TCK_REACH"
+    exit 1
+fi
+
+if test $# -lt 2;
+then
+    echo 1>&2 "usage: $0 megabytes [options] inputfile"
+    exit 1
+fi
+
+MAX_MEMORY="$1"
+shift
+
+COMMAND="${TCK_REACH}"
+while test $# != 1;
+do
+    COMMAND="${COMMAND} \"$1\""
+    shift
+done
+
+INPUTFILE="$1"
+if test -f ${INPUTFILE};
+then
+    LABELS=$(grep -e "^# *labels *= *\([a-zA-Z0-9_:]*\) *\$" ${INPUTFILE} | sed -e 's/^# *labels *= *//g' | tr : ,)
+    if test -n "${LABELS}";
+    then
+        COMMAND="${COMMAND} -l \"${LABELS}\""
+    fi
+else
+    echo 1>&2 "missing input file '${INPUTFILE}'"
+    exit 1
+fi
+
+EXPECTED=$(eval ${COMMAND} "\"${INPUTFILE}\"" | grep -e '^REACHABLE ')
+RESULT=$(eval ${COMMAND} --max-memory ${MAX_MEMORY} "\"${INPUTFILE}\"" | grep -v -e '^RUNNING_TIME_SECONDS ')
+
+echo "${RESULT}" | grep -e '^REACHABLE ' | sed -e 's@^@// @g'
+
+if ! echo "${RESULT}" | grep -q -e '^EVICTED_STATES [1-9]';
+then
+    echo 1>&2 "No state has been evicted within ${MAX_MEMORY} megabytes"
+    exit 1
+fi
+
+if test "$(echo "${RESULT}" | grep -e '^REACHABLE ')" != "${EXPECTED}";
+then
+    echo 1>&2 "Run within ${MAX_MEMORY} megabytes differs from run without budget:"
+    echo 1>&2 "${EXPECTED}"
+    exit 1
+fi
@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+
+# This script compares multi-threaded and single-threaded runs of tck-reach.
+# It is invoked as:
+#   tck-reach-threads.sh N [options] inputfile
+# and runs tck-reach with options and -j 1, then with options and -j N, on
+# inputfile, with labels extracted from inputfile as in tck-reach.sh.
+# It outputs the verdict and the number of stored states of the run with N
+# threads, and it fails if they differ from those of the run with 1 thread.
+# The number of stored states is only compared when the entire state-space is
+# explored (i.e. no state satisfies the labels), since runs that stop on an
+# accepting state store a number of states that depends on scheduling.
+#
+
+if ! test -n "${TCK_REACH}";
+then
+    echo 1>&2 "missing variable TCK_REACH"
+    exit 1
+fi
+
+if test $# -lt 2;
+then
+    echo 1>&2 "usage: $0 threads [options] inputfile"
+    exit 1
+fi
+
+THREADS="$1"
+shift
+
+COMMAND="${TCK_REACH}"
+while test $# != 1;
+do
+    COMMAND="${COMMAND} \"$1\""
+    shift
+done
+
+INPUTFILE="$1"
+if test -f ${INPUTFILE};
+then
+    LABELS=$(grep -e "^# *labels *= *\([a-zA-Z0-9_:]*\) *\$" ${INPUTFILE} | sed -e 's/^# *labels *= *//g' | tr : ,)
+    if test -n "${LABELS}";
+    then
+        COMMAND="${COMMAND} -l \"${LABELS}\""
+    fi
+else
+    echo 1>&2 "missing input file '${INPUTFILE}'"
+    exit 1
+fi
+
+# Verdict and number of stored states of a run
+# $1 : number of threads
+run() {
+    eval ${COMMAND} -j $1 "\"${INPUTFILE}\"" | grep -e '^REACHABLE ' -e '^STORED_STATES '
+}
+
+EXPECTED=$(run 1)
+RESULT=$(run ${THREADS})
+
+if echo "${EXPECTED}" | grep -q -e '^REACHABLE true$';
+then
+    EXPECTED=$(echo "${EXPECTED}" | grep -e '^REACHABLE ')
+    RESULT=$(echo "${RESULT}" | grep -e '^REACHABLE ')
+fi
+
+echo "${RESULT}" | sed -e 's@^@// @g'
+
+if test "${RESULT}" != "${EXPECTED}";
+then
+    echo 1>&2 "Run with ${THREADS} threads differs from run with 1 thread:"
+    echo 1>&2 "${EXPECTED}"
+    exit 1
+fi
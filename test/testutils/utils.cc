@@ -8,6 +8,7 @@
 #include <cstdio>
 #include <string>
 
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/parsing/parsing.hh"
 
@@ -43,6 +44,44 @@ tchecker::parsing::system_declaration_t const * parse(std::string const & model)
   return sysdecl;
 }
 
+void random_constraints(std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(-20, 20);
+  std::bernoulli_distribution strict(0.5);
+  std::uniform_int_distribution<tchecker::clock_id_t> count(0, dim);
+
+  dbm.resize(dim * dim);
+  tchecker::dbm::universal_positive(dbm.data(), dim);
+  if (dim == 1)
+    return;
+  for (tchecker::clock_id_t n = count(gen); n > 0; --n) {
+    tchecker::clock_id_t x = clock(gen), y = clock(gen);
+    if (x == y)
+      continue;
+    tchecker::dbm::db_t db = tchecker::dbm::db((strict(gen) ? tchecker::dbm::LT : tchecker::dbm::LE), value(gen));
+    dbm[x * dim + y] = tchecker::dbm::min(dbm[x * dim + y], db);
+  }
+}
+
+void random_dbm(std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  do
+    random_constraints(dbm, dim, gen);
+  while (tchecker::dbm::tighten(dbm.data(), dim) == tchecker::dbm::EMPTY);
+}
+
+void random_bounds(std::vector<tchecker::integer_t> & b, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::integer_t> value(-1, 20);
+  b.resize(dim - 1);
+  for (tchecker::integer_t & bx : b) {
+    bx = value(gen);
+    if (bx < 0)
+      bx = -tchecker::dbm::INF_VALUE;
+  }
+}
+
 } // end of namespace test
 
 } // end of namespace tchecker
@@ -8,8 +8,12 @@
 #ifndef TCHECKER_TESTUTILS_UTILS_HH
 #define TCHECKER_TESTUTILS_UTILS_HH
 
+#include <random>
 #include <string>
+#include <vector>
 
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/utils/log.hh"
 
@@ -31,6 +35,35 @@ namespace test {
  */
 tchecker::parsing::system_declaration_t const * parse(std::string const & model);
 
+/*!
+ \brief Random positive DBM
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param gen : random generator
+ \post dbm is the universal positive zone with random constraints added,
+ without tightening
+ */
+void random_constraints(std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim, std::mt19937 & gen);
+
+/*!
+ \brief Random positive tight DBM
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param gen : random generator
+ \post dbm is a non-empty positive tight DBM obtained from the universal
+ positive zone by adding random constraints
+ */
+void random_dbm(std::vector<tchecker::dbm::db_t> & dbm, tchecker::clock_id_t dim, std::mt19937 & gen);
+
+/*!
+ \brief Random clock bounds
+ \param b : clock bounds
+ \param dim : dimension of DBMs
+ \param gen : random generator
+ \post b contains dim-1 bounds in {-INF_VALUE} U [0,20]
+ */
+void random_bounds(std::vector<tchecker::integer_t> & b, tchecker::clock_id_t dim, std::mt19937 & gen);
+
 } // end of namespace test
 
 } // end of namespace tchecker
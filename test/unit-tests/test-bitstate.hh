@@ -0,0 +1,122 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <stdexcept>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/reach/bitstate_algorithm.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/bitstate.hh"
+#include "tchecker/waiting/waiting.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("bitstate hashing", "[bitstate]")
+{
+  SECTION("Bitstate of size 0 is rejected") { REQUIRE_THROWS_AS(tchecker::bitstate_t(0), std::invalid_argument); }
+
+  SECTION("Bitstate with no hash function is rejected")
+  {
+    REQUIRE_THROWS_AS(tchecker::bitstate_t(64, 0), std::invalid_argument);
+  }
+
+  SECTION("Inserted values are members")
+  {
+    tchecker::bitstate_t bitstate{1 << 16};
+    REQUIRE(bitstate.insert(1));
+    REQUIRE(bitstate.insert(2));
+    REQUIRE(bitstate.insert(12345678));
+    REQUIRE(bitstate.contains(1));
+    REQUIRE(bitstate.contains(2));
+    REQUIRE(bitstate.contains(12345678));
+    REQUIRE(bitstate.inserted() == 3);
+    REQUIRE(bitstate.set_bits() <= 3 * bitstate.hash_count());
+  }
+
+  SECTION("Values are inserted only once")
+  {
+    tchecker::bitstate_t bitstate{1 << 16};
+    REQUIRE(bitstate.insert(42));
+    REQUIRE_FALSE(bitstate.insert(42));
+    REQUIRE(bitstate.inserted() == 1);
+  }
+
+  SECTION("Empty bitstate has full coverage")
+  {
+    tchecker::bitstate_t bitstate{1 << 16};
+    REQUIRE(bitstate.set_bits() == 0);
+    REQUIRE(bitstate.omission_probability() == 0.0);
+    REQUIRE(bitstate.estimated_coverage() == 1.0);
+  }
+
+  SECTION("Full bitstate rejects all values")
+  {
+    tchecker::bitstate_t bitstate{1, 1};
+    REQUIRE(bitstate.insert(7));
+    REQUIRE_FALSE(bitstate.insert(8));
+    REQUIRE(bitstate.contains(9));
+    REQUIRE(bitstate.omission_probability() == 1.0);
+  }
+}
+
+TEST_CASE("bitstate reachability on zone graphs", "[bitstate]")
+{
+  std::string model = "system:bitstate \n\
+  event:a \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  location:P:l2{labels:goal} \n\
+  edge:P:l0:l1:a{provided: x>=1 : do: x=0} \n\
+  edge:P:l1:l0:a{provided: x>=2} \n\
+  edge:P:l1:l2:a{provided: x<1} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::unique_ptr<tchecker::zg::zg_t> zg{
+      tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100)};
+
+  tchecker::algorithms::reach::bitstate_algorithm_t<tchecker::zg::zg_t> algorithm;
+
+  SECTION("Large bitstate visits all states")
+  {
+    tchecker::bitstate_t visited{1 << 20};
+    boost::dynamic_bitset<> labels = system->as_syncprod_system().labels("");
+    tchecker::algorithms::reach::bitstate_stats_t stats = algorithm.run(*zg, visited, labels, tchecker::waiting::QUEUE);
+    REQUIRE_FALSE(stats.reachable());
+    REQUIRE(stats.visited_states() == 3);
+    REQUIRE(visited.inserted() == 3);
+    REQUIRE(stats.estimated_coverage() > 0.99);
+  }
+
+  SECTION("Accepting state is reached")
+  {
+    tchecker::bitstate_t visited{1 << 20};
+    boost::dynamic_bitset<> labels = system->as_syncprod_system().labels("goal");
+    tchecker::algorithms::reach::bitstate_stats_t stats = algorithm.run(*zg, visited, labels, tchecker::waiting::QUEUE);
+    REQUIRE(stats.reachable());
+  }
+
+  SECTION("Single bit bitstate visits the initial state only")
+  {
+    tchecker::bitstate_t visited{1, 1};
+    boost::dynamic_bitset<> labels = system->as_syncprod_system().labels("");
+    tchecker::algorithms::reach::bitstate_stats_t stats = algorithm.run(*zg, visited, labels, tchecker::waiting::QUEUE);
+    REQUIRE(stats.visited_states() == 1);
+    REQUIRE(stats.estimated_coverage() < 1.0);
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/syncprod/vloc.hh"
+
+TEST_CASE("caches of local clock bounds", "[clockbounds]")
+{
+  tchecker::loc_id_t const loc_nb = 4;
+  tchecker::clock_id_t const clock_nb = 3;
+
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t> lu_map{new tchecker::clockbounds::local_lu_map_t{loc_nb, clock_nb}};
+  std::shared_ptr<tchecker::clockbounds::local_m_map_t> m_map{new tchecker::clockbounds::local_m_map_t{loc_nb, clock_nb}};
+  for (tchecker::loc_id_t l = 0; l < loc_nb; ++l)
+    for (tchecker::clock_id_t x = 0; x < clock_nb; ++x) {
+      tchecker::clockbounds::update(lu_map->L(l), x, l + x);
+      tchecker::clockbounds::update(lu_map->U(l), x, 2 * l - x);
+      tchecker::clockbounds::update(m_map->M(l), x, (l == x ? tchecker::clockbounds::NO_BOUND : 3 * l));
+    }
+
+  tchecker::vloc_t * vloc1 = tchecker::vloc_allocate_and_construct(2, 2);
+  (*vloc1)[0] = 0;
+  (*vloc1)[1] = 3;
+  tchecker::vloc_t * vloc2 = tchecker::vloc_allocate_and_construct(2, 2);
+  (*vloc2)[0] = 1;
+  (*vloc2)[1] = 2;
+  tchecker::vloc_t * vloc3 = tchecker::vloc_allocate_and_construct(2, 2);
+  (*vloc3)[0] = 0;
+  (*vloc3)[1] = 3;
+
+  tchecker::clockbounds::map_t * L = tchecker::clockbounds::allocate_map(clock_nb);
+  tchecker::clockbounds::map_t * U = tchecker::clockbounds::allocate_map(clock_nb);
+  tchecker::clockbounds::map_t * M = tchecker::clockbounds::allocate_map(clock_nb);
+
+  SECTION("LU cache yields the bounds of the local LU map")
+  {
+    tchecker::clockbounds::local_lu_cache_t cache{lu_map};
+    tchecker::clockbounds::map_t const * L1 = nullptr;
+    tchecker::clockbounds::map_t const * U1 = nullptr;
+    tchecker::clockbounds::map_t const * L2 = nullptr;
+    tchecker::clockbounds::map_t const * U2 = nullptr;
+
+    for (tchecker::vloc_t const * vloc : {vloc1, vloc2}) {
+      cache.bounds(*vloc, L1, U1);
+      lu_map->bounds(*vloc, *L, *U);
+      for (tchecker::clock_id_t x = 0; x < clock_nb; ++x) {
+        REQUIRE((*L1)[x] == (*L)[x]);
+        REQUIRE((*U1)[x] == (*U)[x]);
+      }
+    }
+    REQUIRE(cache.size() == 2);
+
+    cache.bounds(*vloc1, L1, U1);
+    cache.bounds(*vloc3, L2, U2);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(L1 == L2);
+    REQUIRE(U1 == U2);
+
+    tchecker::clockbounds::local_lu_cache_t copy{cache};
+    copy.bounds(*vloc1, L2, U2);
+    REQUIRE(copy.size() == 2);
+    REQUIRE(L1 != L2);
+    for (tchecker::clock_id_t x = 0; x < clock_nb; ++x) {
+      REQUIRE((*L1)[x] == (*L2)[x]);
+      REQUIRE((*U1)[x] == (*U2)[x]);
+    }
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+  }
+
+  SECTION("M cache yields the bounds of the local M map")
+  {
+    tchecker::clockbounds::local_m_cache_t cache{m_map};
+
+    for (tchecker::vloc_t const * vloc : {vloc1, vloc2}) {
+      tchecker::clockbounds::map_t const & M1 = cache.bounds(*vloc);
+      m_map->bounds(*vloc, *M);
+      for (tchecker::clock_id_t x = 0; x < clock_nb; ++x)
+        REQUIRE(M1[x] == (*M)[x]);
+    }
+    REQUIRE(cache.size() == 2);
+    REQUIRE(&cache.bounds(*vloc1) == &cache.bounds(*vloc3));
+    REQUIRE(cache.size() == 2);
+  }
+
+  tchecker::clockbounds::deallocate_map(L);
+  tchecker::clockbounds::deallocate_map(U);
+  tchecker::clockbounds::deallocate_map(M);
+  tchecker::vloc_destruct_and_deallocate(vloc1);
+  tchecker::vloc_destruct_and_deallocate(vloc2);
+  tchecker::vloc_destruct_and_deallocate(vloc3);
+}
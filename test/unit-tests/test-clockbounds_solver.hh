@@ -0,0 +1,123 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("clock bounds solver", "[clockbounds]")
+{
+  std::string model = "system:solver \n\
+  event:a \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  clock:1:z \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=4} \n\
+  location:P:l1 \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:a{provided: x>=2 : do: y=x} \n\
+  edge:P:l1:l2:a{provided: y>3} \n\
+  edge:P:l2:l2:a{provided: z>=5} \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1 \n\
+  edge:Q:m0:m1:a{do: z=x} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  std::shared_ptr<tchecker::clockbounds::df_solver_t> solver = tchecker::clockbounds::solve(system);
+  REQUIRE(solver->has_solution());
+
+  tchecker::process_id_t const P = system.process_id("P"), Q = system.process_id("Q");
+  tchecker::loc_id_t const l0 = system.location(P, "l0")->id(), l1 = system.location(P, "l1")->id(),
+                           l2 = system.location(P, "l2")->id(), m0 = system.location(Q, "m0")->id(),
+                           m1 = system.location(Q, "m1")->id();
+  tchecker::clock_id_t const x = system.clock_id("x"), y = system.clock_id("y"), z = system.clock_id("z");
+  tchecker::clockbounds::bound_t const NO_BOUND = tchecker::clockbounds::NO_BOUND;
+
+  SECTION("Bounds from guards, invariants and assignments")
+  {
+    REQUIRE(solver->L(l0, x) == 3); // x>=2 on l0->l1 and y>3 on l1->l2 through y=x
+    REQUIRE(solver->U(l0, x) == 4);
+    REQUIRE(solver->L(l0, y) == NO_BOUND);
+    REQUIRE(solver->L(l1, x) == NO_BOUND);
+    REQUIRE(solver->L(l1, y) == 3);
+    REQUIRE(solver->U(l1, y) == NO_BOUND);
+    REQUIRE(solver->L(l2, y) == NO_BOUND);
+  }
+
+  SECTION("Bounds are propagated along edges that do not assign clocks")
+  {
+    REQUIRE(solver->L(l2, z) == 5);
+    REQUIRE(solver->L(l1, z) == 5);
+    REQUIRE(solver->L(l0, z) == 5);
+  }
+
+  SECTION("Bounds are propagated across processes by assignments")
+  {
+    REQUIRE(solver->L(m0, x) == 5); // z>=5 in P through z=x in Q
+    REQUIRE(solver->U(m0, x) == NO_BOUND);
+    REQUIRE(solver->L(m1, x) == NO_BOUND);
+    REQUIRE(solver->L(m0, z) == NO_BOUND);
+  }
+
+  SECTION("Solving again after clear yields no bound")
+  {
+    solver->clear();
+    solver->solve();
+    REQUIRE(solver->has_solution());
+    for (tchecker::loc_id_t l = 0; l < solver->loc_number(); ++l)
+      for (tchecker::clock_id_t c = 0; c < solver->clock_number(); ++c) {
+        REQUIRE(solver->L(l, c) == NO_BOUND);
+        REQUIRE(solver->U(l, c) == NO_BOUND);
+      }
+  }
+}
+
+TEST_CASE("clock bounds solver without solution", "[clockbounds]")
+{
+  std::string model = "system:no_solution \n\
+  event:a \n\
+  clock:1:x \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x>=1} \n\
+  edge:P:l1:l1:a \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  tchecker::loc_id_t const l0 = system.location(system.process_id("P"), "l0")->id(),
+                           l1 = system.location(system.process_id("P"), "l1")->id();
+  tchecker::clock_id_t const x = system.clock_id("x");
+
+  tchecker::clockbounds::df_solver_t solver{system};
+  solver.add_lower_bound_guard(l0, x, 1);
+  solver.add_no_assignement(l0, l1, x);
+  solver.add_no_assignement(l1, l1, x);
+  solver.solve();
+  REQUIRE(solver.has_solution());
+  REQUIRE(solver.L(l0, x) == 1);
+
+  solver.add_assignment(l1, l1, x, x, -1); // x := x - 1 on a loop yields unbounded L_{l1,x}
+  solver.solve();
+  REQUIRE_FALSE(solver.has_solution());
+}
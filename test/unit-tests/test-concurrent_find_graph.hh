@@ -0,0 +1,93 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "tchecker/graph/concurrent_find_graph.hh"
+
+using concurrent_int_graph_t = tchecker::graph::concurrent_find::graph_t<int, std::hash<int>, std::equal_to<int>>;
+
+TEST_CASE("Concurrent find graph, single thread", "[concurrent_find_graph]")
+{
+  std::vector<int> values{1, 2, 3, 2, 1};
+  concurrent_int_graph_t graph(2);
+
+  SECTION("Empty graph does not find")
+  {
+    REQUIRE(graph.size() == 0);
+    REQUIRE(graph.find(values[0]) == nullptr);
+  }
+
+  SECTION("Adding nodes")
+  {
+    auto && [new1, n1] = graph.add_node(&values[0]);
+    REQUIRE(new1);
+    REQUIRE(n1 == &values[0]);
+
+    auto && [new2, n2] = graph.add_node(&values[1]);
+    REQUIRE(new2);
+    REQUIRE(n2 == &values[1]);
+
+    auto && [new3, n3] = graph.add_node(&values[2]);
+    REQUIRE(new3);
+    REQUIRE(n3 == &values[2]);
+
+    auto && [new4, n4] = graph.add_node(&values[3]);
+    REQUIRE(!new4);
+    REQUIRE(n4 == &values[1]);
+
+    auto && [new5, n5] = graph.add_node(&values[4]);
+    REQUIRE(!new5);
+    REQUIRE(n5 == &values[0]);
+
+    REQUIRE(graph.size() == 3);
+    REQUIRE(graph.capacity() >= 4);
+    REQUIRE(graph.find(3) == &values[2]);
+    REQUIRE(graph.find(4) == nullptr);
+  }
+}
+
+TEST_CASE("Concurrent find graph, multiple threads", "[concurrent_find_graph]")
+{
+  std::size_t const threads_count = 4;
+  int const values_count = 20000;
+
+  // each thread adds all the values, starting from a distinct offset
+  std::vector<std::vector<int>> values(threads_count, std::vector<int>(values_count));
+  for (std::size_t t = 0; t < threads_count; ++t)
+    for (int i = 0; i < values_count; ++i)
+      values[t][i] = (i + static_cast<int>(t) * 1000) % values_count;
+
+  concurrent_int_graph_t graph(16); // forces several concurrent resizes
+  std::vector<int> added(threads_count, 0);
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < threads_count; ++t)
+    threads.emplace_back([&, t]() {
+      for (int const & v : values[t]) {
+        auto && [is_new, n] = graph.add_node(&v);
+        if (is_new)
+          ++added[t];
+      }
+    });
+  for (std::thread & thread : threads)
+    thread.join();
+
+  int total_added = 0;
+  for (int a : added)
+    total_added += a;
+
+  REQUIRE(total_added == values_count);
+  REQUIRE(graph.size() == static_cast<std::size_t>(values_count));
+  for (int i = 0; i < values_count; ++i) {
+    int const * n = graph.find(i);
+    REQUIRE(n != nullptr);
+    REQUIRE(*n == i);
+  }
+}
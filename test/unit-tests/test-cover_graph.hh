@@ -0,0 +1,211 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/graph/cover_graph.hh"
+#include "tchecker/zg/zone.hh"
+
+namespace {
+
+/*!
+ \brief Random zone
+ \param dim : dimension
+ \param gen : random generator
+ \return a non-empty zone of dimension dim obtained by adding random
+ constraints to the universal positive zone
+ \note the returned zone must be deallocated by the caller
+ */
+tchecker::zg::zone_t * random_zone(tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(-3, 6);
+  std::uniform_int_distribution<int> constraints(0, 3);
+  std::bernoulli_distribution strict(0.5);
+
+  tchecker::zg::zone_t * zone = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  tchecker::dbm::db_t * dbm = zone->dbm();
+  for (;;) {
+    tchecker::dbm::universal_positive(dbm, dim);
+    bool empty = false;
+    for (int k = constraints(gen); k > 0 && !empty; --k) {
+      tchecker::clock_id_t x = clock(gen), y = clock(gen);
+      if (x == y)
+        continue;
+      tchecker::dbm::comparator_t cmp = (strict(gen) ? tchecker::dbm::LT : tchecker::dbm::LE);
+      empty = (tchecker::dbm::constrain(dbm, dim, x, y, cmp, value(gen)) == tchecker::dbm::EMPTY);
+    }
+    if (!empty)
+      return zone;
+  }
+}
+
+/*!
+ \class zone_node_t
+ \brief Node with a discrete part and a zone
+ */
+class zone_node_t : public tchecker::graph::cover::node_t {
+public:
+  zone_node_t(unsigned int discrete, tchecker::zg::zone_t * zone) : _discrete(discrete), _zone(zone) {}
+
+  ~zone_node_t() { tchecker::zg::zone_destruct_and_deallocate(_zone); }
+
+  unsigned int _discrete;       /*!< Discrete part */
+  tchecker::zg::zone_t * _zone; /*!< Zone (owned) */
+};
+
+using zone_node_ptr_t = std::shared_ptr<zone_node_t>;
+
+struct zone_node_hash_t {
+  std::size_t operator()(zone_node_ptr_t const & n) const { return n->_discrete; }
+};
+
+struct zone_node_le_t {
+  bool operator()(zone_node_ptr_t const & n1, zone_node_ptr_t const & n2) const
+  {
+    return (n1->_discrete == n2->_discrete) && (*n1->_zone <= *n2->_zone);
+  }
+};
+
+struct zone_node_summary_t {
+  using summary_t = tchecker::zg::zone_summary_t;
+
+  summary_t operator()(zone_node_ptr_t const & n) const { return tchecker::zg::zone_summary_t{*n->_zone}; }
+
+  bool le(summary_t const & s1, summary_t const & s2) const { return s1 <= s2; }
+};
+
+using zone_cover_graph_t =
+    tchecker::graph::cover::graph_t<zone_node_ptr_t, zone_node_hash_t, zone_node_le_t, zone_node_summary_t>;
+
+/*!
+ \brief Covering by linear scan
+ \param n : a node
+ \param nodes : nodes
+ \return true if some node in nodes other than n covers n, false otherwise
+ */
+bool is_covered_linear_scan(zone_node_ptr_t const & n, std::vector<zone_node_ptr_t> const & nodes)
+{
+  for (zone_node_ptr_t const & m : nodes)
+    if (m != n && zone_node_le_t{}(n, m))
+      return true;
+  return false;
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("zone summaries are monotone w.r.t. zone inclusion", "[cover_graph]")
+{
+  std::mt19937 gen(4);
+  std::size_t included = 0;
+
+  for (tchecker::clock_id_t dim : {1, 2, 3, 5}) {
+    std::vector<tchecker::zg::zone_t *> zones;
+    for (int i = 0; i < 60; ++i)
+      zones.push_back(random_zone(dim, gen));
+
+    for (tchecker::zg::zone_t const * z1 : zones)
+      for (tchecker::zg::zone_t const * z2 : zones)
+        if (*z1 <= *z2) {
+          ++included;
+          REQUIRE(tchecker::zg::zone_summary_t{*z1} <= tchecker::zg::zone_summary_t{*z2});
+        }
+
+    for (tchecker::zg::zone_t * z : zones)
+      tchecker::zg::zone_destruct_and_deallocate(z);
+  }
+
+  REQUIRE(included > 4 * 60); // not only z <= z
+}
+
+TEST_CASE("covering with indexed nodes is covering by linear scan", "[cover_graph]")
+{
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<unsigned int> discrete(0, 3);
+  tchecker::clock_id_t const dim = 3;
+
+  std::vector<zone_node_ptr_t> nodes;
+  for (int i = 0; i < 200; ++i)
+    nodes.push_back(std::make_shared<zone_node_t>(discrete(gen), random_zone(dim, gen)));
+
+  zone_cover_graph_t graph(4, zone_node_hash_t{}, zone_node_le_t{}, zone_node_summary_t{});
+  for (zone_node_ptr_t const & n : nodes)
+    graph.add_node(n);
+  REQUIRE(graph.size() == nodes.size());
+
+  auto check_covering = [&]() {
+    std::size_t covered = 0;
+    for (zone_node_ptr_t const & n : nodes) {
+      zone_node_ptr_t covering_node;
+      bool const is_covered = graph.is_covered(n, covering_node);
+      REQUIRE(is_covered == is_covered_linear_scan(n, nodes));
+      if (is_covered) {
+        REQUIRE(covering_node != n);
+        REQUIRE(zone_node_le_t{}(n, covering_node));
+        ++covered;
+      }
+      else
+        REQUIRE(covering_node == nullptr);
+    }
+    return covered;
+  };
+
+  SECTION("Covering in the graph with all nodes")
+  {
+    REQUIRE(check_covering() > 0);
+  }
+
+  SECTION("Covering after nodes have been removed")
+  {
+    // removes covered nodes first, then random nodes
+    std::bernoulli_distribution remove(0.3);
+    for (int round = 0; round < 3; ++round) {
+      std::vector<zone_node_ptr_t> kept;
+      for (zone_node_ptr_t const & n : nodes) {
+        zone_node_ptr_t covering_node;
+        bool const removed = (round == 0 ? graph.is_covered(n, covering_node) : remove(gen));
+        if (removed)
+          graph.remove_node(n);
+        else
+          kept.push_back(n);
+      }
+      nodes.swap(kept);
+      REQUIRE(graph.size() == nodes.size());
+      check_covering();
+    }
+  }
+
+  SECTION("Groups are removed with their last node")
+  {
+    REQUIRE(graph.groups_count() == 4);
+    for (zone_node_ptr_t const & n : nodes)
+      if (n->_discrete != 2)
+        graph.remove_node(n);
+    REQUIRE(graph.groups_count() == 1);
+
+    std::size_t count = 0;
+    for (zone_node_ptr_t const & n : graph.nodes()) {
+      REQUIRE(n->_discrete == 2);
+      ++count;
+    }
+    REQUIRE(count == graph.size());
+
+    for (zone_node_ptr_t const & n : nodes)
+      if (n->_discrete != 2)
+        graph.add_node(n);
+    REQUIRE(graph.groups_count() == 4);
+    check_covering();
+
+    for (zone_node_ptr_t const & n : nodes)
+      graph.remove_node(n);
+    REQUIRE(graph.size() == 0);
+    REQUIRE(graph.groups_count() == 0);
+  }
+}
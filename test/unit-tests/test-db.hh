@@ -597,3 +597,38 @@ TEST_CASE("min et max", "[db]")
     REQUIRE(tchecker::dbm::max(tchecker::dbm::LE_ZERO, tchecker::dbm::LT_INFINITY) == tchecker::dbm::LT_INFINITY);
   }
 }
+
+TEST_CASE("narrow difference bounds", "[db]")
+{
+  tchecker::dbm::db_t const le_max = DB(DB_LE, 16382);
+  tchecker::dbm::db_t const lt_min = DB(DB_LT, -16384);
+
+  SECTION("narrowable bounds")
+  {
+    REQUIRE(tchecker::dbm::is_narrow(tchecker::dbm::LE_ZERO));
+    REQUIRE(tchecker::dbm::is_narrow(tchecker::dbm::LT_ZERO));
+    REQUIRE(tchecker::dbm::is_narrow(tchecker::dbm::LT_INFINITY));
+    REQUIRE(tchecker::dbm::is_narrow(le_max));
+    REQUIRE(tchecker::dbm::is_narrow(lt_min));
+    REQUIRE_FALSE(tchecker::dbm::is_narrow(DB(DB_LT, 16383)));
+    REQUIRE_FALSE(tchecker::dbm::is_narrow(DB(DB_LE, -16385)));
+    REQUIRE_THROWS_AS(tchecker::dbm::narrow(DB(DB_LE, 16383)), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::dbm::narrow(DB(DB_LT, -20000)), std::invalid_argument);
+  }
+
+  SECTION("narrowing and widening are inverse")
+  {
+    for (tchecker::dbm::db_t db : {tchecker::dbm::LE_ZERO, tchecker::dbm::LT_ZERO, tchecker::dbm::LT_INFINITY, le_max, lt_min,
+                                   DB(DB_LT, 7), DB(DB_LE, -3)})
+      REQUIRE(tchecker::dbm::widen(tchecker::dbm::narrow(db)) == db);
+    REQUIRE(tchecker::dbm::narrow(tchecker::dbm::LT_INFINITY) == tchecker::dbm::NARROW_LT_INFINITY);
+  }
+
+  SECTION("narrowing preserves the order of bounds")
+  {
+    REQUIRE(tchecker::dbm::narrow(DB(DB_LT, 1)) < tchecker::dbm::narrow(DB(DB_LE, 1)));
+    REQUIRE(tchecker::dbm::narrow(DB(DB_LE, -2)) < tchecker::dbm::narrow(DB(DB_LT, -1)));
+    REQUIRE(tchecker::dbm::narrow(le_max) < tchecker::dbm::narrow(tchecker::dbm::LT_INFINITY));
+    REQUIRE(tchecker::dbm::narrow(lt_min) < tchecker::dbm::narrow(tchecker::dbm::LE_ZERO));
+  }
+}
@@ -5,6 +5,8 @@
  *
  */
 
+#include <cstring>
+
 #include "tchecker/dbm/dbm.hh"
 
 #define DBM(i, j)  dbm[(i)*dim + (j)]
@@ -1736,3 +1738,81 @@ TEST_CASE("Zone inclusion w.r.t. abstraction aLU from LICS12", "[dbm]")
     REQUIRE(tchecker::dbm::is_alu_le(dbm_positive, dbm, dim, l_inf, u_inf));
   }
 }
+
+TEST_CASE("Reduced DBMs", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 4;
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::db_t dbm2[dim * dim];
+  tchecker::dbm::reduced_db_t rdbm[dim * (dim - 1)];
+
+  SECTION("Universal positive zone")
+  {
+    tchecker::dbm::universal_positive(dbm, dim);
+    std::size_t size = tchecker::dbm::reduce(rdbm, dbm, dim);
+    REQUIRE(size == dim - 1);
+    REQUIRE(tchecker::dbm::reduce(nullptr, dbm, dim) == size);
+    tchecker::dbm::expand(dbm2, dim, rdbm, size);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("Zone with a chain of bounds")
+  {
+    // 1 <= x1 - x2 < 2, 3 <= x2 <= 5, x3 <= 7
+    tchecker::dbm::universal_positive(dbm, dim);
+    tchecker::dbm::constrain(dbm, dim, 1, 2, tchecker::dbm::LT, 2);
+    tchecker::dbm::constrain(dbm, dim, 2, 1, tchecker::dbm::LE, -1);
+    tchecker::dbm::constrain(dbm, dim, 2, 0, tchecker::dbm::LE, 5);
+    tchecker::dbm::constrain(dbm, dim, 0, 2, tchecker::dbm::LE, -3);
+    tchecker::dbm::constrain(dbm, dim, 3, 0, tchecker::dbm::LE, 7);
+
+    std::size_t size = tchecker::dbm::reduce(rdbm, dbm, dim);
+    REQUIRE(size < dim * (dim - 1));
+    tchecker::dbm::expand(dbm2, dim, rdbm, size);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+    REQUIRE(tchecker::dbm::is_le(dbm, dim, rdbm, size));
+
+    // x1 - x2 < 2 and x2 <= 5 imply x1 < 7, hence the bound on x1 is not stored
+    for (std::size_t k = 0; k < size; ++k)
+      REQUIRE_FALSE(((rdbm[k].i == 1) && (rdbm[k].j == 0)));
+
+    // Inclusion is checked on the reduced DBM
+    std::memcpy(dbm2, dbm, sizeof(dbm));
+    tchecker::dbm::constrain(dbm2, dim, 3, 0, tchecker::dbm::LE, 4);
+    REQUIRE(tchecker::dbm::is_le(dbm2, dim, rdbm, size));
+    tchecker::dbm::universal_positive(dbm2, dim);
+    REQUIRE_FALSE(tchecker::dbm::is_le(dbm2, dim, rdbm, size));
+  }
+
+  SECTION("Zone with equal clocks")
+  {
+    // x1 = x2 = x3 <= 3
+    tchecker::dbm::universal_positive(dbm, dim);
+    tchecker::dbm::constrain(dbm, dim, 1, 2, tchecker::dbm::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, 2, 1, tchecker::dbm::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, 2, 3, tchecker::dbm::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, 3, 2, tchecker::dbm::LE, 0);
+    tchecker::dbm::constrain(dbm, dim, 1, 0, tchecker::dbm::LE, 3);
+
+    std::size_t size = tchecker::dbm::reduce(rdbm, dbm, dim);
+    REQUIRE(size == 5); // cycle x1 -> x2 -> x3 -> x1, and bounds on x1
+    tchecker::dbm::expand(dbm2, dim, rdbm, size);
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("Equal DBMs have equal reduced DBMs")
+  {
+    tchecker::dbm::reduced_db_t rdbm2[dim * (dim - 1)];
+    tchecker::dbm::universal_positive(dbm, dim);
+    tchecker::dbm::constrain(dbm, dim, 1, 0, tchecker::dbm::LE, 4);
+    tchecker::dbm::constrain(dbm, dim, 3, 1, tchecker::dbm::LT, 1);
+    std::size_t size = tchecker::dbm::reduce(rdbm, dbm, dim);
+    tchecker::dbm::expand(dbm2, dim, rdbm, size);
+    REQUIRE(tchecker::dbm::reduce(rdbm2, dbm2, dim) == size);
+    for (std::size_t k = 0; k < size; ++k) {
+      REQUIRE(rdbm[k].i == rdbm2[k].i);
+      REQUIRE(rdbm[k].j == rdbm2[k].j);
+      REQUIRE(rdbm[k].db == rdbm2[k].db);
+    }
+  }
+}
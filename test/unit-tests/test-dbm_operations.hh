@@ -0,0 +1,99 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <random>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/operations.hh"
+#include "tchecker/variables/clocks.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("DBM operations specialized by dimension agree with generic ones", "[dbm][operations]")
+{
+  tchecker::dbm::operations_t const & generic = tchecker::dbm::generic_operations();
+  std::mt19937 gen(54321);
+  std::uniform_int_distribution<tchecker::integer_t> value(0, 10);
+  std::bernoulli_distribution strict(0.5);
+  std::vector<tchecker::dbm::db_t> dbm1, dbm2, expected, result;
+  std::vector<tchecker::integer_t> l, u;
+
+  for (tchecker::clock_id_t dim = 1; dim <= tchecker::dbm::FIXED_DIM_MAX + 1; ++dim) {
+    tchecker::dbm::operations_t const & ops = tchecker::dbm::operations(dim);
+    REQUIRE(ops.dim == (dim <= tchecker::dbm::FIXED_DIM_MAX ? dim : 0));
+
+    // clocks are numbered from 0 in constraints and resets, the reference clock is tchecker::REFCLOCK_ID
+    std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+    auto clock_id = [](tchecker::clock_id_t x) { return (x == 0 ? tchecker::REFCLOCK_ID : x - 1); };
+
+    for (int k = 0; k < 20; ++k) {
+      tchecker::test::random_dbm(dbm1, dim, gen);
+      tchecker::test::random_dbm(dbm2, dim, gen);
+      tchecker::test::random_bounds(l, dim, gen);
+      tchecker::test::random_bounds(u, dim, gen);
+      if (k == 0)
+        dbm2 = dbm1;
+
+      REQUIRE(ops.is_le(dbm1.data(), dbm2.data(), dim) == generic.is_le(dbm1.data(), dbm2.data(), dim));
+      REQUIRE(ops.is_le(dbm2.data(), dbm1.data(), dim) == generic.is_le(dbm2.data(), dbm1.data(), dim));
+      REQUIRE(ops.is_alu_le(dbm1.data(), dbm2.data(), dim, l.data(), u.data()) ==
+              generic.is_alu_le(dbm1.data(), dbm2.data(), dim, l.data(), u.data()));
+      REQUIRE(ops.is_alu_le(dbm2.data(), dbm1.data(), dim, l.data(), u.data()) ==
+              generic.is_alu_le(dbm2.data(), dbm1.data(), dim, l.data(), u.data()));
+
+      tchecker::test::random_constraints(expected, dim, gen);
+      result = expected;
+      REQUIRE(ops.tighten(result.data(), dim) == generic.tighten(expected.data(), dim));
+      REQUIRE(result == expected);
+
+      expected = dbm1;
+      result = dbm1;
+      generic.open_up(expected.data(), dim);
+      ops.open_up(result.data(), dim);
+      REQUIRE(result == expected);
+
+      expected = dbm1;
+      result = dbm1;
+      generic.extra_lu_plus(expected.data(), dim, l.data(), u.data());
+      ops.extra_lu_plus(result.data(), dim, l.data(), u.data());
+      REQUIRE(result == expected);
+
+      if (dim == 1)
+        continue;
+
+      tchecker::clock_constraint_container_t constraints;
+      for (int n = 0; n < 3; ++n) {
+        tchecker::clock_id_t x = clock(gen), y = clock(gen);
+        if (x == y)
+          continue;
+        constraints.emplace_back(clock_id(x), clock_id(y),
+                                 (strict(gen) ? tchecker::clock_constraint_t::LT : tchecker::clock_constraint_t::LE),
+                                 (x == 0 ? -value(gen) : value(gen)));
+      }
+      expected = dbm1;
+      result = dbm1;
+      enum tchecker::dbm::status_t const status = generic.constrain(expected.data(), dim, constraints);
+      REQUIRE(ops.constrain(result.data(), dim, constraints) == status);
+      if (status == tchecker::dbm::EMPTY)
+        REQUIRE(result[0] == expected[0]);
+      else
+        REQUIRE(result == expected);
+
+      tchecker::clock_reset_container_t resets;
+      for (int n = 0; n < 3; ++n) {
+        tchecker::clock_id_t x = 1 + clock(gen) % (dim - 1), y = clock(gen);
+        resets.emplace_back(clock_id(x), clock_id(y), value(gen) % 3);
+      }
+      expected = dbm1;
+      result = dbm1;
+      generic.reset(expected.data(), dim, resets);
+      ops.reset(result.data(), dim, resets);
+      REQUIRE(result == expected);
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <random>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/simd.hh"
+#include "tchecker/variables/clocks.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("vectorized DBM operations agree with scalar ones", "[dbm][simd]")
+{
+  enum tchecker::dbm::simd::instruction_set_t const best = tchecker::dbm::simd::instruction_set();
+  REQUIRE(best == tchecker::dbm::simd::best_instruction_set());
+  REQUIRE(tchecker::dbm::simd::is_supported(tchecker::dbm::simd::SCALAR));
+
+  std::mt19937 gen(12345);
+  std::vector<tchecker::dbm::db_t> dbm1, dbm2, expected, result;
+  std::vector<tchecker::integer_t> l, u;
+
+  for (enum tchecker::dbm::simd::instruction_set_t is : {tchecker::dbm::simd::SSE42, tchecker::dbm::simd::AVX2}) {
+    if (!tchecker::dbm::simd::is_supported(is)) {
+      REQUIRE_THROWS_AS(tchecker::dbm::simd::select(is), std::invalid_argument);
+      continue;
+    }
+
+    for (tchecker::clock_id_t dim = 1; dim <= 64; ++dim) {
+      for (int k = 0; k < 2; ++k) {
+        tchecker::test::random_dbm(dbm1, dim, gen);
+        tchecker::test::random_dbm(dbm2, dim, gen);
+        tchecker::test::random_bounds(l, dim, gen);
+        tchecker::test::random_bounds(u, dim, gen);
+        if (k == 0)
+          dbm2 = dbm1;
+
+        tchecker::dbm::simd::select(tchecker::dbm::simd::SCALAR);
+        bool const le12 = tchecker::dbm::is_le(dbm1.data(), dbm2.data(), dim);
+        bool const le21 = tchecker::dbm::is_le(dbm2.data(), dbm1.data(), dim);
+        bool const eq = tchecker::dbm::is_equal(dbm1.data(), dbm2.data(), dim);
+
+        tchecker::dbm::simd::select(is);
+        REQUIRE(tchecker::dbm::simd::instruction_set() == is);
+        REQUIRE(tchecker::dbm::is_le(dbm1.data(), dbm2.data(), dim) == le12);
+        REQUIRE(tchecker::dbm::is_le(dbm2.data(), dbm1.data(), dim) == le21);
+        REQUIRE(tchecker::dbm::is_equal(dbm1.data(), dbm2.data(), dim) == eq);
+
+        expected.resize(dim * dim);
+        result.resize(dim * dim);
+
+        tchecker::dbm::simd::select(tchecker::dbm::simd::SCALAR);
+        enum tchecker::dbm::status_t const status = tchecker::dbm::intersection(expected.data(), dbm1.data(), dbm2.data(), dim);
+        tchecker::dbm::simd::select(is);
+        REQUIRE(tchecker::dbm::intersection(result.data(), dbm1.data(), dbm2.data(), dim) == status);
+        REQUIRE(result == expected);
+
+        tchecker::test::random_constraints(expected, dim, gen);
+        result = expected;
+        tchecker::dbm::simd::select(tchecker::dbm::simd::SCALAR);
+        enum tchecker::dbm::status_t const tighten_status = tchecker::dbm::tighten(expected.data(), dim);
+        tchecker::dbm::simd::select(is);
+        REQUIRE(tchecker::dbm::tighten(result.data(), dim) == tighten_status);
+        REQUIRE(result == expected);
+
+        if (dim > 1) {
+          tchecker::clock_id_t const x = k % dim, y = (k + dim / 2 + 1) % dim;
+          tchecker::integer_t const value = (x == 0 ? -3 : 3);
+          expected = dbm1;
+          result = dbm1;
+          tchecker::dbm::simd::select(tchecker::dbm::simd::SCALAR);
+          enum tchecker::dbm::status_t const constrain_status =
+              tchecker::dbm::constrain(expected.data(), dim, x, y, tchecker::dbm::LE, value);
+          tchecker::dbm::simd::select(is);
+          REQUIRE(tchecker::dbm::constrain(result.data(), dim, x, y, tchecker::dbm::LE, value) == constrain_status);
+          REQUIRE(result == expected);
+        }
+
+        expected = dbm1;
+        result = dbm1;
+        tchecker::dbm::simd::select(tchecker::dbm::simd::SCALAR);
+        tchecker::dbm::extra_lu(expected.data(), dim, l.data(), u.data());
+        tchecker::dbm::simd::select(is);
+        tchecker::dbm::extra_lu(result.data(), dim, l.data(), u.data());
+        REQUIRE(result == expected);
+
+        expected = dbm1;
+        result = dbm1;
+        tchecker::dbm::simd::select(tchecker::dbm::simd::SCALAR);
+        tchecker::dbm::extra_lu_plus(expected.data(), dim, l.data(), u.data());
+        tchecker::dbm::simd::select(is);
+        tchecker::dbm::extra_lu_plus(result.data(), dim, l.data(), u.data());
+        REQUIRE(result == expected);
+      }
+    }
+  }
+
+  tchecker::dbm::simd::select(best);
+}
+
+#if !defined(DBM_UNSAFE)
+TEST_CASE("vectorized tightening reports overflows", "[dbm][simd]")
+{
+  enum tchecker::dbm::simd::instruction_set_t const best = tchecker::dbm::simd::instruction_set();
+  tchecker::clock_id_t const dim = 17;
+  std::vector<tchecker::dbm::db_t> dbm(dim * dim);
+
+  for (enum tchecker::dbm::simd::instruction_set_t is :
+       {tchecker::dbm::simd::SCALAR, tchecker::dbm::simd::SSE42, tchecker::dbm::simd::AVX2}) {
+    if (!tchecker::dbm::simd::is_supported(is))
+      continue;
+    tchecker::dbm::simd::select(is);
+
+    tchecker::dbm::universal(dbm.data(), dim);
+    dbm[1 * dim + 2] = tchecker::dbm::db(tchecker::dbm::LE, tchecker::dbm::MAX_VALUE);
+    dbm[2 * dim + 10] = tchecker::dbm::db(tchecker::dbm::LE, tchecker::dbm::MAX_VALUE);
+    REQUIRE_THROWS_AS(tchecker::dbm::tighten(dbm.data(), dim), std::invalid_argument);
+  }
+
+  tchecker::dbm::simd::select(best);
+}
+#endif // DBM_UNSAFE
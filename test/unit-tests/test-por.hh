@@ -0,0 +1,289 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/por_algorithm.hh"
+#include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/refzg/por.hh"
+#include "tchecker/refzg/refzg.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/waiting/waiting.hh"
+
+#include "testutils/utils.hh"
+
+namespace {
+
+/*!
+ \class por_node_t
+ \brief Node of a subsumption graph over a zone graph with reference clocks
+ */
+class por_node_t : public tchecker::waiting::element_t {
+public:
+  por_node_t(tchecker::refzg::state_sptr_t const & s) : _last_use(0), _state(s) {}
+
+  por_node_t(tchecker::refzg::const_state_sptr_t const & s) : _last_use(0), _state(s) {}
+
+  inline tchecker::refzg::const_state_sptr_t state_ptr() const { return _state; }
+
+  inline tchecker::refzg::state_t const & state() const { return *_state; }
+
+  inline std::uint32_t last_use() const { return _last_use; }
+
+  inline void set_last_use(std::uint32_t time) { _last_use = time; }
+
+private:
+  std::uint32_t _last_use;
+  tchecker::refzg::const_state_sptr_t _state;
+};
+
+/*!
+ \class por_node_hash_t
+ \brief Hash functor for nodes
+ */
+class por_node_hash_t {
+public:
+  std::size_t operator()(por_node_t const & n) const { return tchecker::refzg::hash_value(n.state()); }
+};
+
+/*!
+ \class por_node_le_t
+ \brief Covering predicate for nodes: equality of states
+ */
+class por_node_le_t {
+public:
+  bool operator()(por_node_t const & n1, por_node_t const & n2) const { return n1.state() == n2.state(); }
+};
+
+/*!
+ \class por_edge_t
+ \brief Edge of a subsumption graph over a zone graph with reference clocks
+ */
+class por_edge_t {
+public:
+  por_edge_t(tchecker::refzg::transition_t const &) {}
+};
+
+/*!
+ \class por_graph_t
+ \brief Subsumption graph over a zone graph with reference clocks
+ */
+class por_graph_t : public tchecker::graph::subsumption::graph_t<por_node_t, por_edge_t, por_node_hash_t, por_node_le_t> {
+public:
+  por_graph_t() : tchecker::graph::subsumption::graph_t<por_node_t, por_edge_t, por_node_hash_t, por_node_le_t>(
+                      100, 1024, por_node_hash_t{}, por_node_le_t{})
+  {
+  }
+
+  virtual ~por_graph_t() { clear(); }
+
+protected:
+  virtual void attributes(por_node_t const &, std::map<std::string, std::string> &) const {}
+
+  virtual void attributes(por_edge_t const &, std::map<std::string, std::string> &) const {}
+};
+
+std::string const por_model = "system:por \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  int:1:0:1:0:v \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:p0{initial:} \n\
+  location:P:p1 \n\
+  location:P:p2{labels:goal} \n\
+  edge:P:p0:p1:a{do: x=0} \n\
+  edge:P:p1:p2:a{provided: x<=1} \n\
+  \n\
+  process:Q \n\
+  clock:1:y \n\
+  location:Q:q0{initial:} \n\
+  location:Q:q1 \n\
+  edge:Q:q0:q1:a{do: y=0} \n\
+  \n\
+  process:R \n\
+  location:R:r0{initial:} \n\
+  location:R:r1 \n\
+  edge:R:r0:r1:a{do: v=1} \n\
+  \n\
+  process:S \n\
+  location:S:s0{initial:} \n\
+  location:S:s1 \n\
+  location:S:s2{labels:bad} \n\
+  edge:S:s0:s1:b{provided: v==1} \n\
+  edge:S:s1:s2:b{provided: v==0} \n\
+  \n\
+  process:T \n\
+  location:T:t0{initial:} \n\
+  location:T:t1 \n\
+  edge:T:t0:t1:c \n\
+  \n\
+  process:U \n\
+  location:U:u0{initial:} \n\
+  location:U:u1 \n\
+  edge:U:u0:u1:c \n\
+  \n\
+  process:W \n\
+  location:W:w0{initial:} \n\
+  location:W:w1 \n\
+  edge:W:w0:w1:b{provided: v==1} \n\
+  \n\
+  sync:T@c:U@c \n\
+  ";
+
+} // namespace
+
+TEST_CASE("persistent sets in zone graphs with reference clocks", "[por]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(por_model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::unique_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
+                                                                           tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+                                                                           tchecker::refdbm::UNBOUNDED_SPREAD, 100)};
+
+  tchecker::process_id_t const P = system->process_id("P");
+  tchecker::process_id_t const Q = system->process_id("Q");
+  tchecker::process_id_t const R = system->process_id("R");
+  tchecker::process_id_t const S = system->process_id("S");
+  tchecker::process_id_t const T = system->process_id("T");
+  tchecker::process_id_t const U = system->process_id("U");
+  tchecker::process_id_t const W = system->process_id("W");
+
+  std::vector<tchecker::refzg::refzg_t::sst_t> v;
+  refzg->initial(v);
+  REQUIRE(v.size() == 1);
+  tchecker::refzg::const_state_sptr_t s{std::get<1>(v[0])};
+  v.clear();
+
+  // state reached from s when R writes v
+  refzg->next(s, v);
+  tchecker::refzg::const_state_sptr_t s_r;
+  for (auto && [status, next_s, next_t] : v)
+    if (next_s->vloc()[R] != s->vloc()[R])
+      s_r = tchecker::refzg::const_state_sptr_t{next_s};
+  REQUIRE(s_r.ptr() != nullptr);
+  v.clear();
+
+  auto set_of = [&](std::vector<tchecker::process_id_t> const & pids) {
+    boost::dynamic_bitset<> processes(system->processes_count());
+    for (tchecker::process_id_t pid : pids)
+      processes.set(pid);
+    return processes;
+  };
+
+  boost::dynamic_bitset<> processes;
+
+  SECTION("Independent processes are closed")
+  {
+    tchecker::refzg::persistent_sets_t persistent_sets{*system, system->as_syncprod_system().labels("")};
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), P, processes));
+    REQUIRE(processes == set_of({P}));
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), Q, processes));
+    REQUIRE(processes == set_of({Q}));
+  }
+
+  SECTION("Processes that write shared variables are closed with the processes that access them")
+  {
+    tchecker::refzg::persistent_sets_t persistent_sets{*system, system->as_syncprod_system().labels("")};
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), R, processes));
+    REQUIRE(processes == set_of({R, S, W}));
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), S, processes));
+    REQUIRE(processes == set_of({R, S, W}));
+  }
+
+  SECTION("Reads of shared variables are independent")
+  {
+    tchecker::refzg::persistent_sets_t persistent_sets{*system, system->as_syncprod_system().labels("")};
+    REQUIRE(persistent_sets.closed_processes(s_r->vloc(), S, processes));
+    REQUIRE(processes == set_of({S}));
+    REQUIRE(persistent_sets.closed_processes(s_r->vloc(), W, processes));
+    REQUIRE(processes == set_of({W}));
+  }
+
+  SECTION("Synchronized processes are closed together")
+  {
+    tchecker::refzg::persistent_sets_t persistent_sets{*system, system->as_syncprod_system().labels("")};
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), T, processes));
+    REQUIRE(processes == set_of({T, U}));
+  }
+
+  SECTION("Processes with visible edges are detected")
+  {
+    tchecker::refzg::persistent_sets_t persistent_sets{*system, system->as_syncprod_system().labels("goal")};
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), P, processes)); // p0 -> p1 is invisible
+    REQUIRE(persistent_sets.closed_processes(s->vloc(), Q, processes));
+
+    std::vector<tchecker::refzg::refzg_t::sst_t> sst;
+    persistent_sets.next(*refzg, s, sst);
+    REQUIRE(sst.size() == 1);
+    tchecker::refzg::const_state_sptr_t s_p{std::get<1>(sst[0])};
+    REQUIRE(s_p->vloc()[P] == system->location(P, "p1")->id());
+    // p1 -> p2 changes labels and has a clock guard
+    REQUIRE_FALSE(persistent_sets.closed_processes(s_p->vloc(), P, processes));
+  }
+
+  SECTION("Successors along a persistent set")
+  {
+    tchecker::refzg::persistent_sets_t persistent_sets{*system, system->as_syncprod_system().labels("")};
+
+    processes = persistent_sets.next(*refzg, s, v);
+    REQUIRE(processes == set_of({P}));
+    REQUIRE(v.size() == 1);
+    REQUIRE(std::get<1>(v[0])->vloc()[P] == system->location(P, "p1")->id());
+
+    v.clear();
+    persistent_sets.next_except(*refzg, s, processes, v);
+    REQUIRE(v.size() == 3); // Q, R and T with U (S and W are disabled)
+  }
+}
+
+TEST_CASE("covering reachability with partial-order reduction", "[por]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(por_model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::unique_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS,
+                                                                           tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+                                                                           tchecker::refdbm::UNBOUNDED_SPREAD, 100)};
+
+  for (std::string const labels : {"", "goal", "bad"}) {
+    DYNAMIC_SECTION("Same verdict with and without reduction for labels '" << labels << "'")
+    {
+      boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+      por_graph_t graph;
+      tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::refzg_t, por_graph_t> algorithm;
+      tchecker::algorithms::covreach::stats_t stats = algorithm.run(*refzg, graph, accepting_labels, tchecker::waiting::FAST_REMOVE_QUEUE);
+
+      por_graph_t por_graph;
+      tchecker::refzg::persistent_sets_t persistent_sets{*system, accepting_labels};
+      tchecker::algorithms::covreach::por_algorithm_t<tchecker::refzg::refzg_t, por_graph_t, tchecker::refzg::persistent_sets_t>
+          por_algorithm;
+      tchecker::algorithms::covreach::por_stats_t por_stats =
+          por_algorithm.run(*refzg, por_graph, persistent_sets, accepting_labels, tchecker::waiting::FAST_REMOVE_QUEUE);
+
+      REQUIRE(por_stats.reachable() == stats.reachable());
+      REQUIRE(por_stats.reachable() == (labels == "goal"));
+      REQUIRE(por_stats.reduced_expansions() > 0);
+      REQUIRE(por_stats.visited_states() < stats.visited_states());
+    }
+  }
+}
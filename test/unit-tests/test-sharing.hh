@@ -0,0 +1,231 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ts/sharing.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("sharing of state components in zone graphs", "[sharing]")
+{
+  std::string model = "system:sharing \n\
+  event:a \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  int:1:0:1:0:i \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a \n\
+  edge:P:l1:l0:a \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  SECTION("Equal states share their components")
+  {
+    std::unique_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(
+        system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, tchecker::ts::SHARING)};
+    std::vector<tchecker::zg::zg_t::sst_t> v;
+
+    zg->initial(v);
+    zg->initial(v);
+    REQUIRE(v.size() == 2);
+
+    tchecker::zg::const_state_sptr_t s1{zg->state(v[0])};
+    tchecker::zg::const_state_sptr_t s2{zg->state(v[1])};
+    REQUIRE(s1.ptr() != s2.ptr());
+    REQUIRE(&s1->vloc() == &s2->vloc());
+    REQUIRE(&s1->intval() == &s2->intval());
+    REQUIRE(&s1->zone() == &s2->zone());
+    REQUIRE(*s1 == *s2);
+
+    // l0 -> l1 -> l0 yields a state equal to the initial state
+    v.clear();
+    zg->next(s1, v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s3{zg->state(v[0])};
+    REQUIRE(&s3->vloc() != &s1->vloc());
+    REQUIRE(&s3->intval() == &s1->intval());
+
+    v.clear();
+    zg->next(s3, v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s4{zg->state(v[0])};
+    REQUIRE(&s4->vloc() == &s1->vloc());
+    REQUIRE(&s4->intval() == &s1->intval());
+    REQUIRE(&s4->zone() == &s1->zone());
+  }
+
+  SECTION("Shared zones are narrow when their bounds fit")
+  {
+    std::unique_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(
+        system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, tchecker::ts::SHARING_NARROW_ZONES)};
+    std::unique_ptr<tchecker::zg::zg_t> wide_zg{tchecker::zg::factory(
+        system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, tchecker::ts::SHARING)};
+    std::vector<tchecker::zg::zg_t::sst_t> v, wide_v;
+
+    zg->initial(v);
+    zg->initial(v);
+    wide_zg->initial(wide_v);
+    REQUIRE(v.size() == 2);
+    REQUIRE(wide_v.size() == 1);
+
+    tchecker::zg::const_state_sptr_t s1{zg->state(v[0])};
+    tchecker::zg::const_state_sptr_t s2{zg->state(v[1])};
+    tchecker::zg::const_state_sptr_t w1{wide_zg->state(wide_v[0])};
+    REQUIRE(s1->zone().is_narrow());
+    REQUIRE_FALSE(w1->zone().is_narrow());
+    REQUIRE(&s1->zone() == &s2->zone());
+    REQUIRE(s1->zone() == w1->zone());
+    REQUIRE(s1->zone().hash() == w1->zone().hash());
+    REQUIRE(*s1 == *w1);
+
+    v.clear();
+    zg->next(s1, v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s3{zg->state(v[0])};
+    REQUIRE(s3->zone().is_narrow());
+
+    v.clear();
+    zg->next(s3, v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s4{zg->state(v[0])};
+    REQUIRE(&s4->zone() == &s1->zone());
+  }
+
+  SECTION("Shared zones are reduced")
+  {
+    std::unique_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(
+        system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, tchecker::ts::SHARING_REDUCED_ZONES)};
+    std::unique_ptr<tchecker::zg::zg_t> wide_zg{tchecker::zg::factory(
+        system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, tchecker::ts::SHARING)};
+    std::vector<tchecker::zg::zg_t::sst_t> v, wide_v;
+
+    zg->initial(v);
+    zg->initial(v);
+    wide_zg->initial(wide_v);
+    REQUIRE(v.size() == 2);
+    REQUIRE(wide_v.size() == 1);
+
+    tchecker::zg::const_state_sptr_t s1{zg->state(v[0])};
+    tchecker::zg::const_state_sptr_t s2{zg->state(v[1])};
+    tchecker::zg::const_state_sptr_t w1{wide_zg->state(wide_v[0])};
+    REQUIRE(s1->zone().is_reduced());
+    REQUIRE(&s1->zone() == &s2->zone());
+    REQUIRE(s1->zone() == w1->zone());
+    REQUIRE(w1->zone() == s1->zone());
+    REQUIRE(w1->zone() <= s1->zone());
+    REQUIRE(s1->zone() <= w1->zone());
+    REQUIRE(s1->zone().hash() == w1->zone().hash());
+
+    v.clear();
+    zg->next(s1, v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s3{zg->state(v[0])};
+    REQUIRE(s3->zone().is_reduced());
+
+    v.clear();
+    zg->next(s3, v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s4{zg->state(v[0])};
+    REQUIRE(&s4->zone() == &s1->zone());
+  }
+
+  SECTION("States do not share components by default")
+  {
+    std::unique_ptr<tchecker::zg::zg_t> zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100)};
+    std::vector<tchecker::zg::zg_t::sst_t> v;
+
+    zg->initial(v);
+    zg->initial(v);
+    REQUIRE(v.size() == 2);
+
+    tchecker::zg::const_state_sptr_t s1{zg->state(v[0])};
+    tchecker::zg::const_state_sptr_t s2{zg->state(v[1])};
+    REQUIRE(&s1->vloc() != &s2->vloc());
+    REQUIRE(&s1->intval() != &s2->intval());
+    REQUIRE(&s1->zone() != &s2->zone());
+    REQUIRE(*s1 == *s2);
+  }
+}
+
+TEST_CASE("narrow zones fall back to wide zones", "[sharing]")
+{
+  std::string model = "system:narrow_fallback \n\
+  event:a \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x>=20000} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  std::unique_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::NO_EXTRAPOLATION, 100,
+                                                               tchecker::ts::SHARING_NARROW_ZONES)};
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+
+  zg->initial(v);
+  REQUIRE(v.size() == 1);
+  tchecker::zg::const_state_sptr_t s0{zg->state(v[0])};
+  REQUIRE(s0->zone().is_narrow());
+
+  // x>=20000 does not fit in a narrow difference bound
+  v.clear();
+  zg->next(s0, v);
+  REQUIRE(v.size() == 1);
+  tchecker::zg::const_state_sptr_t s1{zg->state(v[0])};
+  REQUIRE_FALSE(s1->zone().is_narrow());
+  REQUIRE_FALSE(s1->zone().is_narrowable());
+  REQUIRE(s1->zone().dbm(0, 1) == tchecker::dbm::db(tchecker::dbm::LE, -20000));
+}
+
+TEST_CASE("shared zones are only reduced when it saves memory", "[sharing]")
+{
+  tchecker::clock_id_t const dim = 5; // clocks 1 to 4
+  std::size_t const wide_size = dim * dim * sizeof(tchecker::dbm::db_t);
+  tchecker::zg::state_pool_allocator_t allocator(10, 10, 1, 10, 1, 10, dim, tchecker::zg::REDUCED_STORAGE);
+
+  tchecker::zg::state_sptr_t s = allocator.construct();
+  tchecker::dbm::db_t * dbm = s->zone_ptr()->dbm();
+
+  SECTION("Zones with a smaller reduced DBM are reduced")
+  {
+    REQUIRE(s->zone().reduced_size() * sizeof(tchecker::dbm::reduced_db_t) < wide_size);
+    allocator.share(*s);
+    REQUIRE(s->zone().is_reduced());
+  }
+
+  SECTION("Zones with a reduced DBM that is not smaller are kept wide")
+  {
+    // 0 <= x <= 3 for all clocks x, and -1 <= x1 - x2 <= 1 have no redundant bound
+    for (tchecker::clock_id_t x = 1; x < dim; ++x)
+      tchecker::dbm::constrain(dbm, dim, x, 0, tchecker::dbm::LE, 3);
+    tchecker::dbm::constrain(dbm, dim, 1, 2, tchecker::dbm::LE, 1);
+    tchecker::dbm::constrain(dbm, dim, 2, 1, tchecker::dbm::LE, 1);
+    REQUIRE(s->zone().reduced_size() == 10);
+    REQUIRE(s->zone().reduced_size() * sizeof(tchecker::dbm::reduced_db_t) >= wide_size);
+    allocator.share(*s);
+    REQUIRE(s->zone().storage() == tchecker::zg::WIDE_STORAGE);
+  }
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/spill.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("spilling of pool allocated memory to disk", "[spill]")
+{
+  char const * tmpdir = std::getenv("TMPDIR");
+  std::string const directory = (tmpdir != nullptr ? tmpdir : "/tmp");
+
+  SECTION("Spill directory should be writable")
+  {
+    REQUIRE_THROWS_AS(tchecker::spill::enable("/this/directory/does/not/exist"), std::invalid_argument);
+    REQUIRE_FALSE(tchecker::spill::enabled());
+  }
+
+  SECTION("Spilled memory blocks are carved out of large regions, and reused")
+  {
+    std::size_t const spilled_size = tchecker::spill::spilled_size();
+    std::size_t const size = 4096;
+    tchecker::spill::enable(directory);
+
+    std::vector<char *> blocks;
+    for (int k = 0; k < 1000; ++k)
+      blocks.push_back(static_cast<char *>(tchecker::spill::allocate(size)));
+    REQUIRE(tchecker::spill::spilled_size() == spilled_size + blocks.size() * size);
+
+    std::size_t contiguous = 0; // at most one region boundary
+    for (std::size_t k = 1; k < blocks.size(); ++k)
+      if (blocks[k] == blocks[k - 1] + size)
+        ++contiguous;
+    REQUIRE(contiguous + 2 >= blocks.size());
+
+    tchecker::spill::deallocate(blocks.back(), size);
+    REQUIRE(tchecker::spill::allocate(size) == blocks.back());
+
+    for (char * block : blocks)
+      tchecker::spill::deallocate(block, size);
+    REQUIRE(tchecker::spill::spilled_size() == spilled_size);
+    tchecker::spill::disable();
+  }
+
+  SECTION("Zone graphs compute the same states with spilled memory")
+  {
+    std::string model = "system:spill \n\
+    event:a \n\
+    \n\
+    process:P \n\
+    clock:1:x \n\
+    int:1:0:1:0:i \n\
+    location:P:l0{initial:} \n\
+    location:P:l1 \n\
+    edge:P:l0:l1:a{provided: x<=2 : do: i=1} \n\
+    edge:P:l1:l0:a{do: x=0} \n\
+    ";
+
+    std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+    REQUIRE(sysdecl != nullptr);
+    std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+    std::size_t const spilled_size = tchecker::spill::spilled_size();
+    std::unique_ptr<tchecker::zg::zg_t> zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100)};
+
+    tchecker::spill::enable(directory);
+    REQUIRE(tchecker::spill::enabled());
+    REQUIRE(tchecker::spill::directory() == directory);
+    std::unique_ptr<tchecker::zg::zg_t> spilled_zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100)};
+    tchecker::spill::disable();
+    REQUIRE_FALSE(tchecker::spill::enabled());
+
+    std::vector<tchecker::zg::zg_t::sst_t> v, spilled_v;
+    zg->initial(v);
+    spilled_zg->initial(spilled_v);
+    REQUIRE(tchecker::spill::spilled_size() > spilled_size);
+
+    for (int k = 0; k < 4; ++k) {
+      REQUIRE(v.size() == 1);
+      REQUIRE(spilled_v.size() == 1);
+      tchecker::zg::const_state_sptr_t s{zg->state(v[0])};
+      tchecker::zg::const_state_sptr_t spilled_s{spilled_zg->state(spilled_v[0])};
+      REQUIRE(*s == *spilled_s);
+      v.clear();
+      spilled_v.clear();
+      zg->next(s, v);
+      spilled_zg->next(spilled_s, spilled_v);
+    }
+
+    spilled_v.clear();
+    spilled_zg.reset();
+    REQUIRE(tchecker::spill::spilled_size() == spilled_size);
+  }
+}
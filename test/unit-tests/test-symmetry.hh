@@ -0,0 +1,107 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("symmetry classes of processes", "[symmetry]")
+{
+  std::string model = "system:symmetry \n\
+  event:a \n\
+  event:b \n\
+  int:1:0:3:0:id \n\
+  \n\
+  process:P1 \n\
+  clock:1:x1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{labels:cs} \n\
+  edge:P1:l0:l1:a{provided: id==0 : do: x1=0; id=1} \n\
+  edge:P1:l1:l0:a{provided: x1>=1 : do: id=0} \n\
+  \n\
+  process:P2 \n\
+  clock:1:x2 \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1{labels:cs} \n\
+  edge:P2:l0:l1:a{provided: id==0 : do: x2=0; id=1} \n\
+  edge:P2:l1:l0:a{provided: x2>=1 : do: id=0} \n\
+  \n\
+  process:P3 \n\
+  clock:1:x3 \n\
+  location:P3:l0{initial:} \n\
+  location:P3:l1{labels:cs3} \n\
+  edge:P3:l0:l1:a{provided: id==0 : do: x3=0; id=1} \n\
+  edge:P3:l1:l0:a{provided: x3>=1 : do: id=0} \n\
+  \n\
+  process:Q1 \n\
+  clock:1:y1 \n\
+  location:Q1:l0{initial:} \n\
+  location:Q1:l1 \n\
+  edge:Q1:l0:l1:b{provided: id==0 : do: y1=0; id=2} \n\
+  \n\
+  process:Q2 \n\
+  clock:1:y2 \n\
+  location:Q2:l0{initial:} \n\
+  location:Q2:l1 \n\
+  edge:Q2:l0:l1:b{provided: id==0 : do: y2=0; id=3} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+
+  SECTION("Processes that are equal up to private variables are interchangeable")
+  {
+    tchecker::ta::symmetry_t symmetry{*system, system->as_syncprod_system().labels("")};
+    REQUIRE(symmetry.classes_count() == 1);
+    REQUIRE(symmetry.symmetry_class(0) ==
+            std::vector<tchecker::process_id_t>{system->process_id("P1"), system->process_id("P2"), system->process_id("P3")});
+  }
+
+  SECTION("Processes with distinct accepting labels are not interchangeable")
+  {
+    tchecker::ta::symmetry_t symmetry{*system, system->as_syncprod_system().labels("cs")};
+    REQUIRE(symmetry.classes_count() == 1);
+    REQUIRE(symmetry.symmetry_class(0) ==
+            std::vector<tchecker::process_id_t>{system->process_id("P1"), system->process_id("P2")});
+  }
+
+  SECTION("Successors that are equal up to permutation of processes are canonicalized")
+  {
+    std::shared_ptr<tchecker::zg::zg_t> zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100)};
+    zg->set_symmetry(std::make_shared<tchecker::ta::symmetry_t>(*system, system->as_syncprod_system().labels("")));
+
+    std::vector<tchecker::zg::zg_t::sst_t> v;
+    zg->initial(v);
+    REQUIRE(v.size() == 1);
+    tchecker::zg::const_state_sptr_t s{std::get<1>(v[0])};
+
+    v.clear();
+    zg->next(s, v);
+    REQUIRE(v.size() == 5); // P1, P2, P3, Q1 and Q2 can move
+
+    std::vector<tchecker::zg::state_sptr_t> p_successors;
+    for (auto && [status, next_s, next_t] : v)
+      if (next_s->vloc()[system->process_id("Q1")] == system->location(system->process_id("Q1"), "l0")->id() &&
+          next_s->vloc()[system->process_id("Q2")] == system->location(system->process_id("Q2"), "l0")->id())
+        p_successors.push_back(next_s);
+    REQUIRE(p_successors.size() == 3);
+    REQUIRE(*p_successors[0] == *p_successors[1]);
+    REQUIRE(*p_successors[0] == *p_successors[2]);
+  }
+}
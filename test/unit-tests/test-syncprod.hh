@@ -0,0 +1,211 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/edges_iterators.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/syncprod/system.hh"
+#include "tchecker/syncprod/vloc.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("candidate synchronizations", "[syncprod]")
+{
+  std::string model = "system:candidates \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a \n\
+  edge:P:l1:l0:b \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1 \n\
+  edge:Q:m0:m1:a \n\
+  edge:Q:m0:m1:b \n\
+  edge:Q:m1:m0:c \n\
+  \n\
+  process:R \n\
+  location:R:n0{initial:} \n\
+  edge:R:n0:n0:c \n\
+  \n\
+  sync:P@a:Q@a \n\
+  sync:P@b:Q@b \n\
+  sync:Q@c:R@c? \n\
+  sync:P@a?:R@c? \n\
+  sync:P@c:Q@a \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::syncprod::system_t system{*sysdecl};
+  tchecker::process_id_t const P = system.process_id("P"), Q = system.process_id("Q"), R = system.process_id("R");
+
+  // Tuples of locations (l, m, n0) for l in P and m in Q
+  std::vector<tchecker::shared_vloc_t *> vlocs;
+  for (char const * p : {"l0", "l1"})
+    for (char const * q : {"m0", "m1"}) {
+      tchecker::shared_vloc_t * vloc = tchecker::shared_vloc_t::allocate_and_construct(system.processes_count());
+      (*vloc)[P] = system.location(P, p)->id();
+      (*vloc)[Q] = system.location(Q, q)->id();
+      (*vloc)[R] = system.location(R, "n0")->id();
+      vlocs.push_back(vloc);
+    }
+
+  // Synchronized edges as sets of edge identifiers
+  auto sync_edges = [&](tchecker::syncprod::vloc_synchronized_edges_iterator_t it) {
+    std::vector<std::set<tchecker::edge_id_t>> edges;
+    for (; it != tchecker::past_the_end_iterator; ++it) {
+      edges.emplace_back();
+      for (tchecker::system::edge_const_shared_ptr_t const & edge : *it)
+        edges.back().insert(edge->id());
+    }
+    return edges;
+  };
+
+  std::vector<tchecker::sync_id_t> syncs;
+
+  SECTION("Candidates only contain synchronizations indexed by locations in vloc")
+  {
+    system.candidate_synchronizations(*vlocs[0], syncs); // (l0, m0, n0)
+    REQUIRE(syncs == std::vector<tchecker::sync_id_t>{0, 3});
+
+    system.candidate_synchronizations(*vlocs[3], syncs); // (l1, m1, n0)
+    REQUIRE(syncs == std::vector<tchecker::sync_id_t>{1, 2, 3});
+  }
+
+  SECTION("Synchronizations that can never be enabled are not candidates")
+  {
+    for (tchecker::shared_vloc_t const * vloc : vlocs) {
+      system.candidate_synchronizations(*vloc, syncs);
+      REQUIRE(std::find(syncs.begin(), syncs.end(), 4) == syncs.end());
+    }
+  }
+
+  SECTION("Enumerating candidates yields the same synchronized edges as enumerating all synchronizations")
+  {
+    for (tchecker::shared_vloc_t const * v : vlocs) {
+      tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc{v};
+      auto all = system.synchronizations();
+      tchecker::syncprod::vloc_synchronized_edges_iterator_t it_all(vloc, system.outgoing_edges_maps(), all.begin(), all.end());
+      REQUIRE(sync_edges(it_all) == sync_edges(tchecker::syncprod::outgoing_synchronized_edges(system, vloc).begin()));
+    }
+  }
+
+  for (tchecker::shared_vloc_t * vloc : vlocs)
+    tchecker::shared_vloc_t::destruct_and_deallocate(vloc);
+}
+
+TEST_CASE("outgoing edges cache", "[syncprod]")
+{
+  std::string model = "system:edges_cache \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{committed:} \n\
+  edge:P:l0:l1:a \n\
+  edge:P:l1:l0:b \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1 \n\
+  edge:Q:m0:m1:a \n\
+  edge:Q:m1:m0:b \n\
+  edge:Q:m1:m1:b \n\
+  \n\
+  sync:P@a:Q@a \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::syncprod::system_t system{*sysdecl};
+  tchecker::process_id_t const P = system.process_id("P"), Q = system.process_id("Q");
+
+  // Tuples of locations (l, m) for l in P and m in Q
+  std::vector<tchecker::shared_vloc_t *> vlocs;
+  for (char const * p : {"l0", "l1"})
+    for (char const * q : {"m0", "m1"}) {
+      tchecker::shared_vloc_t * vloc = tchecker::shared_vloc_t::allocate_and_construct(system.processes_count());
+      (*vloc)[P] = system.location(P, p)->id();
+      (*vloc)[Q] = system.location(Q, q)->id();
+      vlocs.push_back(vloc);
+    }
+
+  // Outgoing edges as sequences of edge identifiers
+  auto edges = [](tchecker::syncprod::outgoing_edges_range_t range) {
+    std::vector<std::vector<tchecker::edge_id_t>> edges;
+    for (auto && vedge : range) {
+      edges.emplace_back();
+      for (tchecker::system::edge_const_shared_ptr_t const & edge : vedge)
+        edges.back().push_back(edge->id());
+    }
+    return edges;
+  };
+
+  SECTION("Cached outgoing edges are the outgoing edges")
+  {
+    tchecker::syncprod::outgoing_edges_cache_t cache{1024 * 1024};
+    for (unsigned int i = 0; i < 2; ++i)
+      for (tchecker::shared_vloc_t const * v : vlocs) {
+        tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc{v};
+        REQUIRE(edges(cache.outgoing_edges(system, vloc)) == edges(tchecker::syncprod::outgoing_edges(system, vloc)));
+      }
+    REQUIRE(cache.size() == vlocs.size());
+    REQUIRE(cache.misses() == vlocs.size());
+    REQUIRE(cache.hits() == vlocs.size());
+  }
+
+  SECTION("Cached outgoing edges only involve committed processes")
+  {
+    tchecker::syncprod::outgoing_edges_cache_t cache{1024 * 1024};
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc{vlocs[3]}; // (l1, m1)
+    cache.outgoing_edges(system, vloc);
+    std::vector<std::vector<tchecker::edge_id_t>> cached_edges = edges(cache.outgoing_edges(system, vloc));
+    REQUIRE(cached_edges.size() == 1);
+    REQUIRE(system.edge(cached_edges[0][0])->pid() == P);
+  }
+
+  SECTION("Outgoing edges are not cached beyond the memory bound")
+  {
+    tchecker::syncprod::outgoing_edges_cache_t cache{1};
+    for (tchecker::shared_vloc_t const * v : vlocs) {
+      tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc{v};
+      REQUIRE(edges(cache.outgoing_edges(system, vloc)) == edges(tchecker::syncprod::outgoing_edges(system, vloc)));
+      REQUIRE(edges(cache.outgoing_edges(system, vloc)) == edges(tchecker::syncprod::outgoing_edges(system, vloc)));
+    }
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.memsize() == 0);
+    REQUIRE(cache.hits() == 0);
+    REQUIRE(cache.misses() == 2 * vlocs.size());
+  }
+
+  SECTION("Ranges remain valid after the cache has been flushed")
+  {
+    tchecker::syncprod::outgoing_edges_cache_t cache{1024 * 1024};
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc{vlocs[0]};
+    tchecker::syncprod::outgoing_edges_range_t range = cache.outgoing_edges(system, vloc);
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(edges(range) == edges(tchecker::syncprod::outgoing_edges(system, vloc)));
+  }
+
+  for (tchecker::shared_vloc_t * vloc : vlocs)
+    tchecker::shared_vloc_t::destruct_and_deallocate(vloc);
+}
@@ -0,0 +1,425 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/compilers.hh"
+#include "tchecker/vm/native.hh"
+#include "tchecker/vm/vm.hh"
+
+#include "utils.hh"
+
+namespace {
+
+std::string const vm_model = "system:vm \n\
+  event:a \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  int:1:0:10:2:i \n\
+  int:1:-5:5:0:j \n\
+  int:4:0:20:3:A \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=10 && y<3} \n\
+  location:P:l1{invariant: i<5 && x-y<=4} \n\
+  edge:P:l0:l1:a{provided: x>=1 && i==2 && j!=1 : do: x=0; y=x; i=i+1} \n\
+  edge:P:l0:l1:a{provided: x==2 && (A[1]>A[i] && i<=3) : do: if i>1 then j=-j-1 else j=3 end; A[i]=A[0]*2} \n\
+  edge:P:l1:l0:a{provided: y>2 && -i<0 : do: local k; k=0; while (k<4) do A[k]=A[k]+k; k=k+1 end} \n\
+  edge:P:l1:l1:a{provided: !(i>=3) && j%2==0 : do: i=(i+7)/2; j=j-i+A[3]} \n\
+  edge:P:l1:l1:a{do: i=11} \n\
+  edge:P:l1:l1:a{do: local s=0; while (s<3) do local t; t=s+1; s=t end; local u[2]; u[1]=s*2; local n=-1; i=u[1]; j=n} \n\
+  edge:P:l0:l0:a{provided: x>1 && y<=2 : do: x=0; y=3} \n\
+  ";
+
+/*!
+ \brief Check that the threaded interpreter on optimized bytecode with
+ superinstructions and the reference interpreter on compiled bytecode agree
+ \param vm : virtual machine
+ \param compiled : compiled bytecode
+ \param fused : optimized bytecode with superinstructions
+ \param size : number of integer variables
+ \return true if both interpreters return the same value, compute the same
+ valuation of integer variables and output the same clock constraints and
+ clock resets, false otherwise
+ */
+bool same_interpretation(tchecker::vm_t & vm, tchecker::bytecode_t const * compiled, tchecker::bytecode_t const * fused,
+                         unsigned short size)
+{
+  tchecker::intvars_valuation_t * intval1 = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+  tchecker::intvars_valuation_t * intval2 = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+  tchecker::integer_t const init[] = {2, 0, 3, 1, 0, 5};
+  for (unsigned short k = 0; k < size; ++k)
+    (*intval1)[k] = (*intval2)[k] = init[k];
+
+  tchecker::clock_constraint_container_t c1, c2;
+  tchecker::clock_reset_container_t r1, r2;
+
+  tchecker::integer_t const v1 = vm.run_switch(compiled, *intval1, c1, r1);
+  tchecker::integer_t const v2 = vm.run(fused, *intval2, c2, r2);
+
+  bool same = ((v1 != 0) == (v2 != 0)) && (c1 == c2) && (r1 == r2);
+  for (unsigned short k = 0; k < size; ++k)
+    same = same && ((*intval1)[k] == (*intval2)[k]);
+
+  tchecker::intvars_valuation_destruct_and_deallocate(intval1);
+  tchecker::intvars_valuation_destruct_and_deallocate(intval2);
+  return same;
+}
+
+/*!
+ \brief Count instructions
+ \param bytecode : null-terminated bytecode
+ \param instruction : an instruction
+ \return number of occurrences of instruction in bytecode
+ */
+std::size_t count(tchecker::bytecode_t const * bytecode, enum tchecker::instruction_t instruction)
+{
+  std::size_t n = 0;
+  for (bool stop = false; !stop; bytecode += tchecker::instruction_size(bytecode)) {
+    stop = (*bytecode == tchecker::VM_RET);
+    n += (*bytecode == instruction ? 1 : 0);
+  }
+  return n;
+}
+
+} // namespace
+
+TEST_CASE("bytecode optimizer", "[vm]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(vm_model)};
+  REQUIRE(sysdecl != nullptr);
+  tchecker::ta::system_t system{*sysdecl};
+
+  auto optimize = [&](tchecker::typed_statement_t const & stmt) {
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(stmt)};
+    return std::unique_ptr<tchecker::bytecode_t[]>{tchecker::optimize(compiled.get(), system.integer_variables())};
+  };
+
+  SECTION("Range checks are removed when the assigned value is within bounds")
+  {
+    std::unique_ptr<tchecker::bytecode_t[]> statement = optimize(system.statement(3)); // i=(i+7)/2; j=j-i+A[3]
+    REQUIRE(count(statement.get(), tchecker::VM_FAILNOTIN) == 1);
+  }
+
+  SECTION("Range checks are kept when the assigned value may be out of bounds")
+  {
+    std::unique_ptr<tchecker::bytecode_t[]> statement = optimize(system.statement(0)); // x=0; y=x; i=i+1
+    REQUIRE(count(statement.get(), tchecker::VM_FAILNOTIN) == 1);
+
+    statement = optimize(system.statement(4)); // i=11
+    REQUIRE(count(statement.get(), tchecker::VM_FAILNOTIN) == 1);
+  }
+
+  SECTION("Constants are folded and no-operations are removed")
+  {
+    std::unique_ptr<tchecker::bytecode_t[]> statement = optimize(system.statement(1)); // ...; A[i]=A[0]*2
+    REQUIRE(count(statement.get(), tchecker::VM_SUM) == 1);                    // &A[i] only
+
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(system.statement(1))};
+    REQUIRE(count(compiled.get(), tchecker::VM_SUM) == 2);
+  }
+
+  SECTION("Conditional jumps on the constant value of clock constraints are removed")
+  {
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(system.guard(0))}; // x>=1 && i==2 && j!=1
+    std::unique_ptr<tchecker::bytecode_t[]> guard{tchecker::optimize(compiled.get(), system.integer_variables())};
+    REQUIRE(count(compiled.get(), tchecker::VM_JMPZ) == 2);
+    REQUIRE(count(guard.get(), tchecker::VM_JMPZ) == 1);
+  }
+}
+
+TEST_CASE("superinstructions", "[vm]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(vm_model)};
+  REQUIRE(sysdecl != nullptr);
+  tchecker::ta::system_t system{*sysdecl};
+
+  SECTION("Clock constraints and comparisons to constants are fused")
+  {
+    tchecker::bytecode_t const * guard = system.guard_bytecode(0);
+    REQUIRE(guard[0] == tchecker::VM_CLKCONSTR_CONST);
+    REQUIRE(guard[5] == tchecker::VM_PUSH_VALUEAT_CMP);
+    REQUIRE(guard[9] == tchecker::VM_JMPZ);
+
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(system.guard(0))};
+    REQUIRE(compiled[0] == tchecker::VM_PUSH);
+  }
+
+  SECTION("Clock resets are fused")
+  {
+    tchecker::bytecode_t const * statement = system.statement_bytecode(0);
+    REQUIRE(statement[0] == tchecker::VM_CLKRESET_CONST);
+    REQUIRE(statement[4] == tchecker::VM_CLKRESET_CONST);
+  }
+
+  SECTION("Optimized bytecode has the same semantics as compiled bytecode")
+  {
+    unsigned short const size = system.intvars_count(tchecker::VK_FLATTENED);
+    tchecker::vm_t vm;
+
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      std::unique_ptr<tchecker::bytecode_t[]> guard{tchecker::compile(system.guard(edge->id()))};
+      REQUIRE(same_interpretation(vm, guard.get(), system.guard_bytecode(edge->id()), size));
+
+      if (edge->id() == 4)
+        continue; // out-of-bounds assignment
+      std::unique_ptr<tchecker::bytecode_t[]> statement{tchecker::compile(system.statement(edge->id()))};
+      REQUIRE(same_interpretation(vm, statement.get(), system.statement_bytecode(edge->id()), size));
+    }
+
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+      std::unique_ptr<tchecker::bytecode_t[]> invariant{tchecker::compile(system.invariant(loc->id()))};
+      REQUIRE(same_interpretation(vm, invariant.get(), system.invariant_bytecode(loc->id()), size));
+    }
+  }
+
+  SECTION("Out-of-bounds assignments throw")
+  {
+    unsigned short const size = system.intvars_count(tchecker::VK_FLATTENED);
+    tchecker::intvars_valuation_t * intval = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+    tchecker::clock_constraint_container_t c;
+    tchecker::clock_reset_container_t r;
+    tchecker::vm_t vm;
+
+    std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(system.statement(4))};
+    REQUIRE_THROWS_AS(vm.run_switch(compiled.get(), *intval, c, r), std::out_of_range);
+    REQUIRE_THROWS_AS(vm.run(system.statement_bytecode(4), *intval, c, r), std::out_of_range);
+    REQUIRE(vm.run(system.guard_bytecode(4), *intval, c, r) == 1); // the VM is usable after an exception
+
+    tchecker::intvars_valuation_destruct_and_deallocate(intval);
+  }
+}
+
+TEST_CASE("local variables", "[vm]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(vm_model)};
+  REQUIRE(sysdecl != nullptr);
+  tchecker::ta::system_t system{*sysdecl};
+
+  unsigned short const size = system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::intvars_valuation_t * intval = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+  tchecker::clock_constraint_container_t c;
+  tchecker::clock_reset_container_t r;
+  tchecker::vm_t vm;
+
+  std::unique_ptr<tchecker::bytecode_t[]> compiled{tchecker::compile(system.statement(5))};
+
+  SECTION("Slots are reused by nested and subsequent frames")
+  {
+    for (int k = 0; k < 2; ++k) {
+      (*intval)[0] = (*intval)[1] = 0;
+      REQUIRE(vm.run_switch(compiled.get(), *intval, c, r) == 1);
+      REQUIRE((*intval)[0] == 6);
+      REQUIRE((*intval)[1] == -1);
+
+      (*intval)[0] = (*intval)[1] = 0;
+      REQUIRE(vm.run(system.statement_bytecode(5), *intval, c, r) == 1);
+      REQUIRE((*intval)[0] == 6);
+      REQUIRE((*intval)[1] == -1);
+    }
+  }
+
+  SECTION("Local variables are not accessible once their frame has been popped")
+  {
+    // local k=1 in a frame, then read k after the frame has been popped
+    tchecker::bytecode_t const bytecode[] = {tchecker::VM_PUSH_FRAME, tchecker::VM_PUSH,          0,
+                                             tchecker::VM_PUSH,       1,                          tchecker::VM_INIT_FRAME,
+                                             tchecker::VM_POP_FRAME,  tchecker::VM_PUSH,          0,
+                                             tchecker::VM_VALUEAT_FRAME, tchecker::VM_RET};
+    REQUIRE_THROWS_AS(vm.run_switch(bytecode, *intval, c, r), std::out_of_range);
+    REQUIRE_THROWS_AS(vm.run(bytecode, *intval, c, r), std::out_of_range);
+    REQUIRE(vm.run(system.statement_bytecode(5), *intval, c, r) == 1); // the VM is usable after an exception
+  }
+
+  tchecker::intvars_valuation_destruct_and_deallocate(intval);
+}
+
+TEST_CASE("constant evaluations", "[vm]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(vm_model)};
+  REQUIRE(sysdecl != nullptr);
+  tchecker::ta::system_t system{*sysdecl};
+
+  SECTION("Clock constraints and resets that do not depend on integer variables are precomputed")
+  {
+    REQUIRE(system.is_constant_invariant(system.location(system.process_id("P"), "l0")->id()));
+    REQUIRE(system.is_constant_guard(4));
+    REQUIRE(system.is_constant_guard(6));
+    REQUIRE(system.is_constant_statement(6));
+  }
+
+  SECTION("Bytecode that accesses integer variables is not precomputed")
+  {
+    REQUIRE_FALSE(system.is_constant_invariant(system.location(system.process_id("P"), "l1")->id()));
+    REQUIRE_FALSE(system.is_constant_guard(0));
+    REQUIRE_FALSE(system.is_constant_statement(0));
+    REQUIRE_FALSE(system.is_constant_statement(4));
+    REQUIRE_FALSE(system.is_constant_statement(5));
+  }
+
+  SECTION("Precomputed evaluations have the same semantics as bytecode")
+  {
+    unsigned short const size = system.intvars_count(tchecker::VK_FLATTENED);
+    tchecker::intvars_valuation_t * intval = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+    tchecker::clock_constraint_container_t c1, c2;
+    tchecker::clock_reset_container_t r1, r2;
+    tchecker::vm_t vm;
+
+    REQUIRE(system.run_guard(6, *intval, c1, r1) == vm.run(system.guard_bytecode(6), *intval, c2, r2));
+    REQUIRE(system.run_statement(6, *intval, c1, r1) == vm.run(system.statement_bytecode(6), *intval, c2, r2));
+    REQUIRE(c1.size() == 2);
+    REQUIRE(r1.size() == 2);
+    REQUIRE(c1 == c2);
+    REQUIRE(r1 == r2);
+
+    tchecker::intvars_valuation_destruct_and_deallocate(intval);
+  }
+}
+
+TEST_CASE("native code", "[vm]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(vm_model)};
+  REQUIRE(sysdecl != nullptr);
+  tchecker::ta::system_t system{*sysdecl};
+  system.compile_native(tchecker::native_cache_directory(), tchecker::native_compiler());
+  REQUIRE(system.native_library() != nullptr);
+
+  unsigned short const size = system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::intvars_valuation_t * intval1 = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+  tchecker::intvars_valuation_t * intval2 = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+  tchecker::clock_constraint_container_t c1, c2;
+  tchecker::clock_reset_container_t r1, r2;
+  tchecker::vm_t vm;
+
+  auto same = [&](auto && native, tchecker::bytecode_t const * bytecode) {
+    tchecker::integer_t const init[] = {2, 0, 3, 1, 0, 5};
+    for (unsigned short k = 0; k < size; ++k)
+      (*intval1)[k] = (*intval2)[k] = init[k];
+    c1.clear();
+    c2.clear();
+    r1.clear();
+    r2.clear();
+    bool result = ((native() != 0) == (vm.run(bytecode, *intval2, c2, r2) != 0)) && (c1 == c2) && (r1 == r2);
+    for (unsigned short k = 0; k < size; ++k)
+      result = result && ((*intval1)[k] == (*intval2)[k]);
+    return result;
+  };
+
+  SECTION("Native code has the same semantics as bytecode")
+  {
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      tchecker::edge_id_t const id = edge->id();
+      REQUIRE(same([&]() { return system.run_guard(id, *intval1, c1, r1); }, system.guard_bytecode(id)));
+      if (id != 4) // out-of-bounds assignment
+        REQUIRE(same([&]() { return system.run_statement(id, *intval1, c1, r1); }, system.statement_bytecode(id)));
+    }
+
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+      tchecker::loc_id_t const id = loc->id();
+      REQUIRE(same([&]() { return system.run_invariant(id, *intval1, c1, r1); }, system.invariant_bytecode(id)));
+    }
+  }
+
+  SECTION("Statements with local variables are interpreted")
+  {
+    std::size_t const statements = system.locations_count() + system.edges_count();
+    REQUIRE(system.native_library()->function(statements + 0) != nullptr);
+    REQUIRE(system.native_library()->function(statements + 5) == nullptr);
+  }
+
+  SECTION("Out-of-bounds assignments throw")
+  {
+    REQUIRE_THROWS_AS(system.run_statement(4, *intval1, c1, r1), std::out_of_range);
+  }
+
+  SECTION("Native code is shared by copies and cached")
+  {
+    tchecker::ta::system_t copy{system};
+    REQUIRE(copy.native_library() == system.native_library());
+
+    tchecker::ta::system_t other{*sysdecl};
+    other.compile_native(tchecker::native_cache_directory(), tchecker::native_compiler());
+    REQUIRE(other.native_library()->path() == system.native_library()->path());
+  }
+
+  SECTION("Native code is not loaded from a cache writable by others")
+  {
+    std::string const dir = tchecker::native_cache_directory() + "/shared-" + std::to_string(::getpid());
+    REQUIRE(::mkdir(dir.c_str(), 0700) == 0);
+    REQUIRE(::chmod(dir.c_str(), 0777) == 0);
+    tchecker::ta::system_t other{*sysdecl};
+    REQUIRE_THROWS_AS(other.compile_native(dir, tchecker::native_compiler()), std::runtime_error);
+    REQUIRE(other.native_library() == nullptr);
+    REQUIRE(::rmdir(dir.c_str()) == 0);
+  }
+
+  tchecker::intvars_valuation_destruct_and_deallocate(intval1);
+  tchecker::intvars_valuation_destruct_and_deallocate(intval2);
+}
+
+TEST_CASE("bytecode interpreters benchmark", "[.][vm-benchmark]")
+{
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(vm_model)};
+  REQUIRE(sysdecl != nullptr);
+  tchecker::ta::system_t system{*sysdecl};
+
+  unsigned short const size = system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::intvars_valuation_t * intval = tchecker::intvars_valuation_allocate_and_construct(size, size, 0);
+  tchecker::clock_constraint_container_t c;
+  tchecker::clock_reset_container_t r;
+  tchecker::vm_t vm;
+
+  std::unique_ptr<tchecker::bytecode_t[]> guards[2] = {
+      std::unique_ptr<tchecker::bytecode_t[]>{tchecker::compile(system.guard(0))},
+      std::unique_ptr<tchecker::bytecode_t[]>{tchecker::compile(system.guard(1))}};
+  std::unique_ptr<tchecker::bytecode_t[]> statement{tchecker::compile(system.statement(0))};
+
+  auto evaluate = [&](auto && run, auto g0, auto g1, auto s) {
+    tchecker::integer_t sum = 0;
+    for (int k = 0; k < 1000; ++k) {
+      (*intval)[0] = 2;
+      c.clear();
+      r.clear();
+      sum += run(g0) + run(g1) + run(s);
+    }
+    return sum;
+  };
+
+  BENCHMARK("switch dispatch on compiled bytecode")
+  {
+    return evaluate([&](tchecker::bytecode_t const * b) { return vm.run_switch(b, *intval, c, r); }, guards[0].get(),
+                    guards[1].get(), statement.get());
+  };
+
+  BENCHMARK("threaded dispatch on optimized bytecode with superinstructions")
+  {
+    return evaluate([&](tchecker::bytecode_t const * b) { return vm.run(b, *intval, c, r); }, system.guard_bytecode(0),
+                    system.guard_bytecode(1), system.statement_bytecode(0));
+  };
+
+  system.compile_native(tchecker::native_cache_directory(), tchecker::native_compiler());
+  tchecker::native_library_t const & native = *system.native_library();
+  std::size_t const guards_offset = system.locations_count(), statements_offset = guards_offset + system.edges_count();
+
+  BENCHMARK("native code")
+  {
+    return evaluate([&](tchecker::native_function_t f) { return tchecker::run_native(f, *intval, c, r); },
+                    native.function(guards_offset + 0), native.function(guards_offset + 1),
+                    native.function(statements_offset + 0));
+  };
+
+  tchecker::intvars_valuation_destruct_and_deallocate(intval);
+}
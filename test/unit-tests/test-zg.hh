@@ -0,0 +1,92 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/transition.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("successors in the zone graph", "[zg]")
+{
+  std::string model = "system:successors \n\
+  event:a \n\
+  int:1:0:1:0:i \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:l0{initial: : invariant: x<=2} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x>=3} \n\
+  edge:P:l0:l1:a{provided: i==1} \n\
+  edge:P:l0:l1:a{provided: x>=1 : do: x=0} \n\
+  edge:P:l0:l0:a{do: i=1} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100)};
+
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+  zg->initial(v);
+  REQUIRE(v.size() == 1);
+  tchecker::zg::const_state_sptr_t s{std::get<1>(v[0])};
+  v.clear();
+
+  SECTION("Only successors with selected status are allocated")
+  {
+    zg->next(s, v);
+    REQUIRE(v.size() == 2);
+    REQUIRE(zg->successor_allocations() == 2);
+  }
+
+  SECTION("Successors with selected status are the successors computed one edge at a time")
+  {
+    std::vector<tchecker::zg::zg_t::sst_t> all, selected;
+    for (auto && out_edge : zg->outgoing_edges(s)) {
+      zg->next(s, out_edge, all);
+      zg->next(s, out_edge, selected, tchecker::STATE_OK);
+    }
+    REQUIRE(all.size() == 4);
+    REQUIRE(zg->successor_allocations() == 4 + 2);
+
+    std::size_t k = 0;
+    for (auto && [status, next_s, next_t] : all) {
+      if (status != tchecker::STATE_OK)
+        continue;
+      REQUIRE(k < selected.size());
+      REQUIRE(std::get<0>(selected[k]) == tchecker::STATE_OK);
+      REQUIRE(*std::get<1>(selected[k]) == *next_s);
+      REQUIRE(*std::get<2>(selected[k]) == *next_t);
+      ++k;
+    }
+    REQUIRE(k == selected.size());
+  }
+
+  SECTION("Successors that do not match the mask are discarded before their zone is copied")
+  {
+    zg->next(s, v);
+    REQUIRE(zg->avoided_zone_copies() == 2); // guards x>=3 and i==1
+  }
+
+  SECTION("Successors with a disabled clock guard are computed if the mask selects them")
+  {
+    zg->next(s, v, tchecker::STATE_OK | tchecker::STATE_CLOCKS_GUARD_VIOLATED);
+    REQUIRE(v.size() == 3);
+    REQUIRE(std::get<0>(v[0]) == tchecker::STATE_CLOCKS_GUARD_VIOLATED);
+    REQUIRE(zg->avoided_zone_copies() == 1); // guard i==1
+  }
+}
@@ -6,17 +6,32 @@
  */
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
+#include "test-bitstate.hh"
 #include "test-cache.hh"
+#include "test-clockbounds_cache.hh"
+#include "test-clockbounds_solver.hh"
+#include "test-concurrent_find_graph.hh"
+#include "test-cover_graph.hh"
 #include "test-db.hh"
 #include "test-dbm.hh"
+#include "test-dbm_operations.hh"
+#include "test-dbm_simd.hh"
 #include "test-delay_allowed.hh"
 #include "test-extract_variables.hh"
 #include "test-guard_weak_sync.hh"
 #include "test-labels.hh"
 #include "test-ordering.hh"
+#include "test-por.hh"
 #include "test-refdbm.hh"
 #include "test-reference_clock_variables.hh"
+#include "test-sharing.hh"
+#include "test-spill.hh"
+#include "test-symmetry.hh"
+#include "test-syncprod.hh"
 #include "test-variables-access.hh"
+#include "test-vm.hh"
 #include "test-waiting.hh"
+#include "test-zg.hh"